@@ -4,7 +4,7 @@ find_package(Boost 1.40 REQUIRED)
 
 SET(2GEOM_DEPENDS gtk+-2.0 gtkmm-2.4 cairomm-1.0 cairo gsl pycairo)
 include(UsePkgConfig)
-# lib SpatialIndex is added only for tests/rtree-performance.cpp
+# lib SpatialIndex is used only by performance-tests/rtree-performance-test.cpp, when found
 
 FOREACH(dep ${2GEOM_DEPENDS})
     # This is a hack due to a bug in Cmake vars system,temp fix until cmake 2.4.4 is out //verbalshadow
@@ -34,4 +34,7 @@ ENDMACRO(CHECK_MATH_FUNCTION)
 
 CHECK_MATH_FUNCTION("sincos(a,&b,&c)" HAVE_SINCOS)
 
+# used to parse SVG path data files without copying
+CHECK_CXX_SOURCE_COMPILES("#include <sys/mman.h>\nint main() { return mmap(0, 1, PROT_READ, MAP_PRIVATE, 0, 0) == MAP_FAILED; }" HAVE_MMAP)
+
 CONFIGURE_FILE(${CMAKE_CURRENT_SOURCE_DIR}/src/2geom/config.h.cmake ${CMAKE_CURRENT_BINARY_DIR}/config.h)
@@ -11,6 +11,12 @@
 #include <2geom/polynomial.h>
 #include <2geom/utils.h>
 
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace Geom {
 
 /** Creates a Affine given an axis and origin point.
@@ -508,6 +514,133 @@ bool are_near(Affine const &a, Affine const &b, Coord eps)
            are_near(a[4], b[4], eps) && are_near(a[5], b[5], eps);
 }
 
+/* The kernels below evaluate x * c0 + y * c2 + c4 in the same order as
+ * Point::operator*=(Affine). Skipping a term with a zero coefficient only adds or removes
+ * a zero, so for finite coordinates the results are equal to those of the full formula,
+ * except possibly for the sign of zero. */
+
+void transform_points(Point *pts, std::size_t n, Affine const &m)
+{
+    Coord *c = &pts[0][X];
+    std::size_t i = 0;
+
+    if (m[0] == 1 && m[1] == 0 && m[2] == 0 && m[3] == 1) {
+        // translation
+#if defined(__AVX__)
+        __m256d t = _mm256_setr_pd(m[4], m[5], m[4], m[5]);
+        for (; i + 2 <= n; i += 2) {
+            _mm256_storeu_pd(c + 2*i, _mm256_add_pd(_mm256_loadu_pd(c + 2*i), t));
+        }
+#elif defined(__SSE2__)
+        __m128d t = _mm_setr_pd(m[4], m[5]);
+        for (; i < n; ++i) {
+            _mm_storeu_pd(c + 2*i, _mm_add_pd(_mm_loadu_pd(c + 2*i), t));
+        }
+#endif
+        for (; i < n; ++i) {
+            c[2*i] += m[4];
+            c[2*i + 1] += m[5];
+        }
+        return;
+    }
+
+    if (m[1] == 0 && m[2] == 0) {
+        // axis-aligned scaling and translation
+#if defined(__AVX__)
+        __m256d s = _mm256_setr_pd(m[0], m[3], m[0], m[3]);
+        __m256d t = _mm256_setr_pd(m[4], m[5], m[4], m[5]);
+        for (; i + 2 <= n; i += 2) {
+            __m256d p = _mm256_loadu_pd(c + 2*i);
+            _mm256_storeu_pd(c + 2*i, _mm256_add_pd(_mm256_mul_pd(p, s), t));
+        }
+#elif defined(__SSE2__)
+        __m128d s = _mm_setr_pd(m[0], m[3]);
+        __m128d t = _mm_setr_pd(m[4], m[5]);
+        for (; i < n; ++i) {
+            __m128d p = _mm_loadu_pd(c + 2*i);
+            _mm_storeu_pd(c + 2*i, _mm_add_pd(_mm_mul_pd(p, s), t));
+        }
+#endif
+        for (; i < n; ++i) {
+            c[2*i] = c[2*i] * m[0] + m[4];
+            c[2*i + 1] = c[2*i + 1] * m[3] + m[5];
+        }
+        return;
+    }
+
+#if defined(__AVX__)
+    __m256d cx = _mm256_setr_pd(m[0], m[1], m[0], m[1]);
+    __m256d cy = _mm256_setr_pd(m[2], m[3], m[2], m[3]);
+    __m256d t = _mm256_setr_pd(m[4], m[5], m[4], m[5]);
+    for (; i + 2 <= n; i += 2) {
+        __m256d p = _mm256_loadu_pd(c + 2*i);
+        __m256d x = _mm256_unpacklo_pd(p, p), y = _mm256_unpackhi_pd(p, p);
+        __m256d r = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(x, cx), _mm256_mul_pd(y, cy)), t);
+        _mm256_storeu_pd(c + 2*i, r);
+    }
+#elif defined(__SSE2__)
+    __m128d cx = _mm_setr_pd(m[0], m[1]);
+    __m128d cy = _mm_setr_pd(m[2], m[3]);
+    __m128d t = _mm_setr_pd(m[4], m[5]);
+    for (; i < n; ++i) {
+        __m128d p = _mm_loadu_pd(c + 2*i);
+        __m128d x = _mm_unpacklo_pd(p, p), y = _mm_unpackhi_pd(p, p);
+        _mm_storeu_pd(c + 2*i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(x, cx), _mm_mul_pd(y, cy)), t));
+    }
+#endif
+    for (; i < n; ++i) {
+        pts[i] *= m;
+    }
+}
+
+void transform_coords(Coord *xs, Coord *ys, std::size_t n, Affine const &m)
+{
+    std::size_t i = 0;
+
+    if (m[1] == 0 && m[2] == 0) {
+        // translation or axis-aligned scaling; the coordinates are independent
+        if (m[0] == 1 && m[3] == 1) {
+            for (; i < n; ++i) {
+                xs[i] += m[4];
+                ys[i] += m[5];
+            }
+        } else {
+            for (; i < n; ++i) {
+                xs[i] = xs[i] * m[0] + m[4];
+                ys[i] = ys[i] * m[3] + m[5];
+            }
+        }
+        return;
+    }
+
+#if defined(__AVX__)
+    __m256d c0 = _mm256_set1_pd(m[0]), c1 = _mm256_set1_pd(m[1]);
+    __m256d c2 = _mm256_set1_pd(m[2]), c3 = _mm256_set1_pd(m[3]);
+    __m256d c4 = _mm256_set1_pd(m[4]), c5 = _mm256_set1_pd(m[5]);
+    for (; i + 4 <= n; i += 4) {
+        __m256d x = _mm256_loadu_pd(xs + i), y = _mm256_loadu_pd(ys + i);
+        _mm256_storeu_pd(xs + i,
+            _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(x, c0), _mm256_mul_pd(y, c2)), c4));
+        _mm256_storeu_pd(ys + i,
+            _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(x, c1), _mm256_mul_pd(y, c3)), c5));
+    }
+#elif defined(__SSE2__)
+    __m128d c0 = _mm_set1_pd(m[0]), c1 = _mm_set1_pd(m[1]);
+    __m128d c2 = _mm_set1_pd(m[2]), c3 = _mm_set1_pd(m[3]);
+    __m128d c4 = _mm_set1_pd(m[4]), c5 = _mm_set1_pd(m[5]);
+    for (; i + 2 <= n; i += 2) {
+        __m128d x = _mm_loadu_pd(xs + i), y = _mm_loadu_pd(ys + i);
+        _mm_storeu_pd(xs + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(x, c0), _mm_mul_pd(y, c2)), c4));
+        _mm_storeu_pd(ys + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(x, c1), _mm_mul_pd(y, c3)), c5));
+    }
+#endif
+    for (; i < n; ++i) {
+        Coord x = xs[i], y = ys[i];
+        xs[i] = x * m[0] + y * m[2] + m[4];
+        ys[i] = x * m[1] + y * m[3] + m[5];
+    }
+}
+
 }  //namespace Geom
 
 /*
@@ -228,6 +228,19 @@ inline Affine Affine::identity() {
 
 bool are_near(Affine const &a1, Affine const &a2, Coord eps=EPSILON);
 
+/** @brief Apply an affine transformation to an array of points.
+ * For finite coordinates, the results are equal to those of multiplying each point
+ * by the matrix.
+ * Translations and axis-aligned scalings skip the terms which are known to be zero,
+ * and the loop uses vector instructions where available.
+ * @relates Affine */
+void transform_points(Point *pts, std::size_t n, Affine const &m);
+
+/** @brief Apply an affine transformation to points stored as separate coordinate arrays.
+ * @see transform_points()
+ * @relates Affine */
+void transform_coords(Coord *xs, Coord *ys, std::size_t n, Affine const &m);
+
 } // end namespace Geom
 
 #endif // LIB2GEOM_SEEN_AFFINE_H
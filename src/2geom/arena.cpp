@@ -0,0 +1,151 @@
+/** @file
+ * @brief Monotonic arena for short-lived allocations
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <algorithm>
+#include <2geom/arena.h>
+
+namespace Geom {
+
+namespace {
+// later blocks grow geometrically up to this size
+std::size_t const MAX_BLOCK_SIZE = 1 << 20;
+}
+
+std::size_t const MonotonicArena::ALIGNMENT;
+std::size_t const MonotonicArena::HEADER_SIZE;
+
+MonotonicArena::MonotonicArena(std::size_t block_size)
+    : _current(NULL)
+    , _end(NULL)
+    , _blocks(NULL)
+    , _free(NULL)
+    , _buffer(NULL)
+    , _buffer_size(0)
+    , _next_size(std::max<std::size_t>(block_size, ALIGNMENT))
+    , _used(0)
+    , _reserved(0)
+{}
+
+MonotonicArena::MonotonicArena(void *buffer, std::size_t size)
+    : _blocks(NULL)
+    , _free(NULL)
+    , _buffer(NULL)
+    , _buffer_size(0)
+    , _next_size(std::max<std::size_t>(size, 4096))
+    , _used(0)
+    , _reserved(0)
+{
+    // use the aligned part of the buffer
+    char *p = static_cast<char *>(buffer);
+    std::size_t skip = (ALIGNMENT - reinterpret_cast<std::size_t>(p) % ALIGNMENT) % ALIGNMENT;
+    if (skip < size) {
+        _buffer = p + skip;
+        _buffer_size = size - skip;
+    }
+    _current = _buffer;
+    _end = _buffer + _buffer_size;
+}
+
+MonotonicArena::~MonotonicArena()
+{
+    release();
+}
+
+void MonotonicArena::reset()
+{
+    while (_blocks) {
+        Block *b = _blocks;
+        _blocks = b->next;
+        b->next = _free;
+        _free = b;
+    }
+    _current = _buffer;
+    _end = _buffer + _buffer_size;
+    _used = 0;
+}
+
+void MonotonicArena::release()
+{
+    _freeBlocks(_blocks);
+    _freeBlocks(_free);
+    _blocks = _free = NULL;
+    _current = _buffer;
+    _end = _buffer + _buffer_size;
+    _used = 0;
+    _reserved = 0;
+}
+
+void *MonotonicArena::_allocateBlock(std::size_t size)
+{
+    // reuse a retained block if one is large enough
+    Block *b = NULL;
+    for (Block **pb = &_free; *pb; pb = &(*pb)->next) {
+        if ((*pb)->size >= size) {
+            b = *pb;
+            *pb = b->next;
+            break;
+        }
+    }
+    if (!b) {
+        std::size_t bsize = std::max(size, _next_size);
+        b = static_cast<Block *>(::operator new(HEADER_SIZE + bsize));
+        b->size = bsize;
+        _reserved += bsize;
+        _next_size = std::min(2 * _next_size, std::max(_next_size, MAX_BLOCK_SIZE));
+    }
+    b->next = _blocks;
+    _blocks = b;
+
+    char *data = _data(b);
+    _current = data + size;
+    _end = data + b->size;
+    return data;
+}
+
+void MonotonicArena::_freeBlocks(Block *b)
+{
+    while (b) {
+        Block *next = b->next;
+        ::operator delete(b);
+        b = next;
+    }
+}
+
+} // namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,204 @@
+/** @file
+ * @brief Monotonic arena for short-lived allocations
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#ifndef LIB2GEOM_SEEN_ARENA_H
+#define LIB2GEOM_SEEN_ARENA_H
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+namespace Geom {
+
+/** @brief Memory pool which releases all its allocations at once.
+ *
+ * Algorithms such as Boolean operations create many small objects whose lifetimes
+ * end together. Allocating them with operator new costs a call to the general-purpose
+ * allocator for each object, and the same again to free them. A monotonic arena hands
+ * out consecutive pieces of large blocks instead: an allocation is a pointer increment
+ * and deallocation does nothing. The memory is reclaimed when the arena is reset,
+ * released or destroyed.
+ *
+ * Calling reset() between operations keeps the blocks for reuse, so that an arena used
+ * for a series of similar operations stops allocating memory after the first one.
+ * The arena can also start with a caller-supplied buffer, for example on the stack.
+ *
+ * Objects created in the arena are not destroyed by it; use arena_new() and
+ * arena_delete() for objects with nontrivial destructors. The arena is not thread-safe.
+ *
+ * @ingroup Utilities */
+class MonotonicArena {
+public:
+    /// Alignment of every allocation, sufficient for all types used by the library.
+    static std::size_t const ALIGNMENT = 16;
+
+    /** @brief Create an arena which allocates blocks from the heap.
+     * @param block_size Size of the first block; later blocks are larger */
+    explicit MonotonicArena(std::size_t block_size = 4096);
+    /** @brief Create an arena using the given buffer before allocating from the heap.
+     * The buffer must outlive the arena and is not freed by it. */
+    MonotonicArena(void *buffer, std::size_t size);
+    ~MonotonicArena();
+
+    /// Allocate uninitialized memory aligned to ALIGNMENT.
+    void *allocate(std::size_t size) {
+        size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        _used += size;
+        if (size <= std::size_t(_end - _current)) {
+            void *result = _current;
+            _current += size;
+            return result;
+        }
+        return _allocateBlock(size);
+    }
+
+    /// Invalidate all allocations, keeping the heap blocks for reuse.
+    void reset();
+    /// Invalidate all allocations and free all heap blocks.
+    void release();
+
+    /// Total size of the allocations made since the last reset.
+    std::size_t bytesUsed() const { return _used; }
+    /// Total size of the heap blocks currently held.
+    std::size_t bytesReserved() const { return _reserved; }
+
+private:
+    struct Block {
+        Block *next;
+        std::size_t size; ///< Usable size, following the header
+    };
+    static std::size_t const HEADER_SIZE = (sizeof(Block) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+    void *_allocateBlock(std::size_t size);
+    static void _freeBlocks(Block *b);
+    static char *_data(Block *b) { return reinterpret_cast<char *>(b) + HEADER_SIZE; }
+
+    // not copyable
+    MonotonicArena(MonotonicArena const &);
+    MonotonicArena &operator=(MonotonicArena const &);
+
+    char *_current;
+    char *_end;
+    Block *_blocks; ///< Heap blocks in use, most recent first
+    Block *_free;   ///< Heap blocks retained by reset()
+    char *_buffer;  ///< Initial buffer supplied by the caller
+    std::size_t _buffer_size;
+    std::size_t _next_size;
+    std::size_t _used;
+    std::size_t _reserved;
+};
+
+/** @brief Standard allocator which obtains memory from a MonotonicArena.
+ *
+ * Containers using this allocator can be given an arena at construction. Deallocation
+ * is a no-op; the memory is reclaimed together with the arena. An allocator without
+ * an arena uses the global operator new, so the same container type can be used
+ * whether an arena is available or not.
+ *
+ * @ingroup Utilities */
+template <typename T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+    typedef T *pointer;
+    typedef T const *const_pointer;
+    typedef T &reference;
+    typedef T const &const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    template <typename U>
+    struct rebind { typedef ArenaAllocator<U> other; };
+
+    ArenaAllocator(MonotonicArena *arena = NULL) : _arena(arena) {}
+    template <typename U>
+    ArenaAllocator(ArenaAllocator<U> const &other) : _arena(other.arena()) {}
+
+    pointer allocate(size_type n, void const * = NULL) {
+        if (n > max_size()) throw std::bad_alloc();
+        if (_arena) return static_cast<pointer>(_arena->allocate(n * sizeof(T)));
+        return static_cast<pointer>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(pointer p, size_type) {
+        if (!_arena) ::operator delete(p);
+    }
+    void construct(pointer p, T const &value) { new (static_cast<void *>(p)) T(value); }
+    void destroy(pointer p) { p->~T(); }
+    pointer address(reference r) const { return &r; }
+    const_pointer address(const_reference r) const { return &r; }
+    size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+    MonotonicArena *arena() const { return _arena; }
+
+private:
+    MonotonicArena *_arena;
+};
+
+template <typename T, typename U>
+inline bool operator==(ArenaAllocator<T> const &a, ArenaAllocator<U> const &b) {
+    return a.arena() == b.arena();
+}
+template <typename T, typename U>
+inline bool operator!=(ArenaAllocator<T> const &a, ArenaAllocator<U> const &b) {
+    return a.arena() != b.arena();
+}
+
+/** @brief Create a default-constructed object in an arena.
+ * If the arena is null, the object is allocated with operator new.
+ * @relates MonotonicArena */
+template <typename T>
+inline T *arena_new(MonotonicArena *arena) {
+    return new (static_cast<void *>(ArenaAllocator<T>(arena).allocate(1))) T();
+}
+/// @relates MonotonicArena
+template <typename T, typename A1, typename A2>
+inline T *arena_new(MonotonicArena *arena, A1 const &a1, A2 const &a2) {
+    return new (static_cast<void *>(ArenaAllocator<T>(arena).allocate(1))) T(a1, a2);
+}
+
+/** @brief Destroy an object created with arena_new().
+ * @relates MonotonicArena */
+template <typename T>
+inline void arena_delete(MonotonicArena *arena, T *p) {
+    p->~T();
+    ArenaAllocator<T>(arena).deallocate(p, 1);
+}
+
+} // namespace Geom
+
+#endif // LIB2GEOM_SEEN_ARENA_H
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
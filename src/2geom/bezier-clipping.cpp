@@ -267,10 +267,25 @@ void portion (std::vector<Point> & B , Interval const& I)
 
 struct intersection_point_tag;
 struct collinear_normal_tag;
+
+/*
+ * Scratch storage shared by all clipping steps of a single solver call,
+ * so that they reuse the same buffers instead of allocating new ones.
+ */
+struct ClipWorkspace
+{
+    ClipWorkspace() : iterations(0) {}
+
+    std::vector<Point> distance;  // distance curve control points
+    ConvexHull hull;              // convex hull of the distance curve
+    size_t iterations;            // recursion limit counter; per call, so threads don't share it
+};
+
 template <typename Tag>
 OptInterval clip(std::vector<Point> const& A,
                  std::vector<Point> const& B,
-                 double precision);
+                 double precision,
+                 ClipWorkspace & ws);
 template <typename Tag>
 void iterate(std::vector<Interval>& domsA,
              std::vector<Interval>& domsB,
@@ -278,7 +293,8 @@ void iterate(std::vector<Interval>& domsA,
              std::vector<Point> const& B,
              Interval const& domA,
              Interval const& domB,
-             double precision );
+             double precision,
+             ClipWorkspace & ws);
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -387,11 +403,14 @@ double intersect (Point const& p1, Point const& p2, double y)
  */
 OptInterval clip_interval (std::vector<Point> const& B,
                            Line const &l,
-                           Interval const &bound)
+                           Interval const &bound,
+                           ClipWorkspace & ws)
 {
     double n = B.size() - 1;  // number of sub-intervals
-    std::vector<Point> D;     // distance curve control points
-    D.reserve (B.size());
+    std::vector<Point> & D = ws.distance;
+    D.clear();
+    // the convex hull construction appends one more point
+    D.reserve (B.size() + 1);
     for (size_t i = 0; i < B.size(); ++i)
     {
         const double d = signed_distance(B[i], l);
@@ -399,7 +418,9 @@ OptInterval clip_interval (std::vector<Point> const& B,
     }
     //print(D);
 
-    ConvexHull p;
+    // the hull takes over the buffer of D and gives back its previous one,
+    // so both buffers are reused by the next clipping step
+    ConvexHull & p = ws.hull;
     p.swap(D);
     //print(p);
 
@@ -488,7 +509,8 @@ OptInterval clip_interval (std::vector<Point> const& B,
 template <>
 OptInterval clip<intersection_point_tag> (std::vector<Point> const& A,
                                           std::vector<Point> const& B,
-                                          double precision)
+                                          double precision,
+                                          ClipWorkspace & ws)
 {
     Line bl;
     if (is_constant(A, precision)) {
@@ -499,7 +521,7 @@ OptInterval clip<intersection_point_tag> (std::vector<Point> const& A,
     }
     bl.normalize();
     Interval bound = fat_line_bounds(A, bl);
-    return clip_interval(B, bl, bound);
+    return clip_interval(B, bl, bound, ws);
 }
 
 
@@ -699,7 +721,8 @@ OptInterval clip_interval (std::vector<Point> const& B,
 template <>
 OptInterval clip<collinear_normal_tag> (std::vector<Point> const& A,
                                         std::vector<Point> const& B,
-                                        double /*precision*/)
+                                        double /*precision*/,
+                                        ClipWorkspace & /*ws*/)
 {
     std::vector<Point> F;
     make_focus(F, A);
@@ -739,12 +762,12 @@ void iterate<intersection_point_tag> (std::vector<Interval>& domsA,
                                       std::vector<Point> const& B,
                                       Interval const& domA,
                                       Interval const& domB,
-                                      double precision )
+                                      double precision,
+                                      ClipWorkspace & ws)
 {
     // in order to limit recursion
-    static size_t counter = 0;
-    if (domA.extent() == 1 && domB.extent() == 1) counter  = 0;
-    if (++counter > 100) return;
+    if (domA.extent() == 1 && domB.extent() == 1) ws.iterations = 0;
+    if (++ws.iterations > 100) return;
 #if VERBOSE
     std::cerr << std::fixed << std::setprecision(16);
     std::cerr << ">> curve subdision performed <<" << std::endl;
@@ -786,7 +809,7 @@ void iterate<intersection_point_tag> (std::vector<Interval>& domsA,
 #if VERBOSE
         std::cerr << "iter: " << iter << std::endl;
 #endif
-        dom = clip<intersection_point_tag>(*C1, *C2, precision);
+        dom = clip<intersection_point_tag>(*C1, *C2, precision, ws);
 
         if (dom.empty())
         {
@@ -842,9 +865,9 @@ void iterate<intersection_point_tag> (std::vector<Interval>& domsA,
                 map_to(dompC1, H1_INTERVAL);
                 map_to(dompC2, H2_INTERVAL);
                 iterate<intersection_point_tag>(domsA, domsB, pC1, pB,
-                                                dompC1, dompB, precision);
+                                                dompC1, dompB, precision, ws);
                 iterate<intersection_point_tag>(domsA, domsB, pC2, pB,
-                                                dompC2, dompB, precision);
+                                                dompC2, dompB, precision, ws);
             }
             else
             {
@@ -855,9 +878,9 @@ void iterate<intersection_point_tag> (std::vector<Interval>& domsA,
                 map_to(dompC1, H1_INTERVAL);
                 map_to(dompC2, H2_INTERVAL);
                 iterate<intersection_point_tag>(domsB, domsA, pC1, pA,
-                                                dompC1, dompA, precision);
+                                                dompC1, dompA, precision, ws);
                 iterate<intersection_point_tag>(domsB, domsA, pC2, pA,
-                                                dompC2, dompA, precision);
+                                                dompC2, dompA, precision, ws);
             }
             return;
         }
@@ -898,12 +921,12 @@ void iterate<collinear_normal_tag> (std::vector<Interval>& domsA,
                                     std::vector<Point> const& B,
                                     Interval const& domA,
                                     Interval const& domB,
-                                    double precision)
+                                    double precision,
+                                    ClipWorkspace & ws)
 {
     // in order to limit recursion
-    static size_t counter = 0;
-    if (domA.extent() == 1 && domB.extent() == 1) counter  = 0;
-    if (++counter > 100) return;
+    if (domA.extent() == 1 && domB.extent() == 1) ws.iterations = 0;
+    if (++ws.iterations > 100) return;
 #if VERBOSE
     std::cerr << std::fixed << std::setprecision(16);
     std::cerr << ">> curve subdision performed <<" << std::endl;
@@ -935,7 +958,7 @@ void iterate<collinear_normal_tag> (std::vector<Interval>& domsA,
 #if VERBOSE
         std::cerr << "iter: " << iter << std::endl;
 #endif
-        dom = clip<collinear_normal_tag>(*C1, *C2, precision);
+        dom = clip<collinear_normal_tag>(*C1, *C2, precision, ws);
 
         if (dom.empty()) {
 #if VERBOSE
@@ -1007,9 +1030,9 @@ void iterate<collinear_normal_tag> (std::vector<Interval>& domsA,
                 map_to(dompC1, H1_INTERVAL);
                 map_to(dompC2, H2_INTERVAL);
                 iterate<collinear_normal_tag>(domsA, domsB, pC1, pB,
-                                              dompC1, dompB, precision);
+                                              dompC1, dompB, precision, ws);
                 iterate<collinear_normal_tag>(domsA, domsB, pC2, pB,
-                                              dompC2, dompB, precision);
+                                              dompC2, dompB, precision, ws);
             }
             else
             {
@@ -1038,9 +1061,9 @@ void iterate<collinear_normal_tag> (std::vector<Interval>& domsA,
                 map_to(dompC1, H1_INTERVAL);
                 map_to(dompC2, H2_INTERVAL);
                 iterate<collinear_normal_tag>(domsB, domsA, pC1, pA,
-                                              dompC1, dompA, precision);
+                                              dompC1, dompA, precision, ws);
                 iterate<collinear_normal_tag>(domsB, domsA, pC2, pA,
-                                              dompC2, dompA, precision);
+                                              dompC2, dompA, precision, ws);
             }
             return;
         }
@@ -1077,7 +1100,8 @@ void get_solutions (std::vector< std::pair<double, double> >& xs,
 {
     std::pair<double, double> ci;
     std::vector<Interval> domsA, domsB;
-    iterate<Tag> (domsA, domsB, A, B, UNIT_INTERVAL, UNIT_INTERVAL, precision);
+    ClipWorkspace ws;
+    iterate<Tag> (domsA, domsB, A, B, UNIT_INTERVAL, UNIT_INTERVAL, precision, ws);
     if (domsA.size() != domsB.size())
     {
         assert (domsA.size() == domsB.size());
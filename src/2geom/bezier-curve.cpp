@@ -35,6 +35,9 @@
 #include <2geom/path-sink.h>
 #include <2geom/basic-intersection.h>
 #include <2geom/nearest-time.h>
+#include <2geom/predicates.h>
+#include <algorithm>
+#include <limits>
 
 namespace Geom 
 {
@@ -153,13 +156,19 @@ std::vector<CurveIntersection>
 BezierCurve::intersect(Curve const &other, Coord eps) const
 {
     std::vector<CurveIntersection> result;
+    intersect(other, result, eps);
+    return result;
+}
 
+void BezierCurve::intersect(Curve const &other, std::vector<CurveIntersection> &out,
+                            Coord eps) const
+{
     // in case we encounter an order-1 curve created from a vector
     // or a degenerate elliptical arc
     if (isLineSegment()) {
         LineSegment ls(initialPoint(), finalPoint());
-        result = ls.intersect(other);
-        return result;
+        ls.intersect(other, out, eps);
+        return;
     }
 
     // here we are sure that this curve is at least a quadratic Bezier
@@ -167,17 +176,17 @@ BezierCurve::intersect(Curve const &other, Coord eps) const
     if (bez) {
         std::vector<std::pair<double, double> > xs;
         find_intersections(xs, inner, bez->inner, eps);
+        out.reserve(out.size() + xs.size());
         for (unsigned i = 0; i < xs.size(); ++i) {
-            CurveIntersection x(*this, other, xs[i].first, xs[i].second);
-            result.push_back(x);
+            out.push_back(CurveIntersection(*this, other, xs[i].first, xs[i].second));
         }
-        return result;
+        return;
     }
 
     // pass other intersection types to the other curve
-    result = other.intersect(*this, eps);
-    transpose_in_place(result);
-    return result;
+    std::size_t start = out.size();
+    other.intersect(*this, out, eps);
+    transpose_in_place(out, start);
 }
 
 bool BezierCurve::isNear(Curve const &c, Coord precision) const
@@ -298,20 +307,37 @@ template <>
 std::vector<CurveIntersection> BezierCurveN<1>::intersect(Curve const &other, Coord eps) const
 {
     std::vector<CurveIntersection> result;
+    intersect(other, result, eps);
+    return result;
+}
 
+template <>
+void BezierCurveN<1>::intersect(Curve const &other, std::vector<CurveIntersection> &out,
+                                Coord eps) const
+{
     // only handle intersections with other LineSegments here
     if (other.isLineSegment()) {
-        Line this_line(initialPoint(), finalPoint());
-        Line other_line(other.initialPoint(), other.finalPoint());
-        result = this_line.intersect(other_line);
-        filter_line_segment_intersections(result, true, true);
-        return result;
+        Point a0 = initialPoint(), a1 = finalPoint();
+        Point b0 = other.initialPoint(), b1 = other.finalPoint();
+        // decide exactly whether the segments intersect, since the rounded times
+        // of an intersection at an endpoint can be slightly outside of the unit interval
+        if (!segments_intersect(a0, a1, b0, b1)) return;
+
+        // same computation as Line::intersect(), without the temporary vector
+        Coord cp = cross_difference(a0, a1, b0, b1);
+        if (cp != 0) {
+            Point odiff = b0 - a0;
+            Coord ta = std::min(std::max(cross(odiff, b1 - b0) / cp, 0.), 1.);
+            Coord tb = std::min(std::max(cross(odiff, a1 - a0) / cp, 0.), 1.);
+            out.push_back(CurveIntersection(*this, other, ta, tb));
+        }
+        return;
     }
 
     // pass all other types to the other curve
-    result = other.intersect(*this, eps);
-    transpose_in_place(result);
-    return result;
+    std::size_t start = out.size();
+    other.intersect(*this, out, eps);
+    transpose_in_place(out, start);
 }
 
 template <>
@@ -320,15 +346,13 @@ int BezierCurveN<1>::winding(Point const &p) const
     Point ip = inner.at0(), fp = inner.at1();
     if (p[Y] == std::max(ip[Y], fp[Y])) return 0;
 
-    Point v = fp - ip;
-    assert(v[Y] != 0);
-    Coord t = (p[Y] - ip[Y]) / v[Y];
-    assert(t >= 0 && t <= 1);
-    Coord xcross = lerp(t, ip[X], fp[X]);
-    if (xcross > p[X]) {
-        return v[Y] > 0 ? 1 : -1;
+    // the ray crosses the segment to the right of p exactly when p is on the left side
+    // of the segment directed towards increasing Y; this avoids computing the crossing
+    assert(ip[Y] != fp[Y]);
+    if (ip[Y] < fp[Y]) {
+        return orient2d(ip, fp, p) > 0 ? 1 : 0;
     }
-    return 0;
+    return orient2d(fp, ip, p) > 0 ? -1 : 0;
 }
 
 template <>
@@ -359,6 +383,459 @@ void BezierCurveN<3>::feed(PathSink &sink, bool moveto_initial) const
 }
 
 
+// optimized specializations for quadratic and cubic Beziers, and the remaining ones
+// for LineSegment; these work on control points in local variables and never allocate,
+// except for the returned vectors
+
+namespace {
+
+// binomial coefficients up to the degree of the nearest time polynomial of a cubic
+Coord const binomials[6][6] = {
+    {1},
+    {1, 1},
+    {1, 2, 1},
+    {1, 3, 3, 1},
+    {1, 4, 6, 4, 1},
+    {1, 5, 10, 10, 5, 1}
+};
+
+/* Value of a polynomial of degree N in Bernstein form, whose coefficients have been
+ * multiplied by the binomial coefficients. This is exact at 0 and 1. */
+template <unsigned N>
+inline Coord scaled_bernstein_value(Coord const *b, Coord t)
+{
+    Coord u = 1 - t, tn = 1, tmp = b[0] * u;
+    for (unsigned i = 1; i < N; ++i) {
+        tn *= t;
+        tmp = (tmp + tn * b[i]) * u;
+    }
+    return tmp + tn * t * b[N];
+}
+
+/* Evaluate the blossom of a Bezier polynomial or curve, which is the de Casteljau algorithm
+ * with a different time value at each level. */
+template <unsigned N, typename T>
+T bezier_blossom(T const *c, Coord const *t)
+{
+    T tmp[N+1];
+    std::copy(c, c + N + 1, tmp);
+    for (unsigned level = 0; level < N; ++level) {
+        for (unsigned i = 0; i < N - level; ++i) {
+            tmp[i] = lerp(t[level], tmp[i], tmp[i+1]);
+        }
+    }
+    return tmp[0];
+}
+
+// the coefficients of the portion of a Bezier polynomial or curve between f and t
+// are the values of its blossom at (f, ..., f, t, ..., t)
+template <unsigned N, typename T>
+void bezier_portion(T const *c, Coord f, Coord t, T *result)
+{
+    for (unsigned i = 0; i <= N; ++i) {
+        Coord args[N];
+        for (unsigned k = 0; k < N; ++k) {
+            args[k] = k < N - i ? f : t;
+        }
+        result[i] = bezier_blossom<N>(c, args);
+    }
+}
+
+/* Polynomials of degree N in Bernstein form, with N+1 coefficients. The roots are isolated
+ * with the Bernstein version of Descartes' rule of signs: the number of sign changes in
+ * the coefficients bounds the number of roots in the open interval. Intervals with several
+ * sign changes are subdivided, and the single root of an interval with one sign change
+ * is refined with Newton's method safeguarded by bisection. When rising_only is true,
+ * only the roots where the polynomial changes sign from negative to positive are found. */
+template <unsigned N>
+struct BernsteinRoots {
+    static unsigned find(Coord const *c, Coord l, Coord r, Coord *out, bool rising_only = false) {
+        Coord local[N+1];
+        if (l == 0 && r == 1) {
+            std::copy(c, c + N + 1, local);
+        } else {
+            bezier_portion<N>(c, l, r, local);
+        }
+
+        unsigned n = 0;
+        if (local[0] == 0) {
+            out[n++] = l;
+        }
+        isolate(local, l, r, out, n, rising_only, 0);
+        if (local[N] == 0 && r != l) {
+            out[n++] = r;
+        }
+        return n;
+    }
+
+    // find the roots in the open interval (a, b), given the coefficients over that interval
+    static void isolate(Coord const *c, Coord a, Coord b, Coord *out, unsigned &n,
+                        bool rising_only, unsigned depth)
+    {
+        unsigned changes = 0;
+        Coord first = 0, last = 0;
+        for (unsigned i = 0; i <= N; ++i) {
+            if (c[i] == 0) continue;
+            if (last != 0 && (last < 0) != (c[i] < 0)) {
+                ++changes;
+            }
+            if (first == 0) {
+                first = c[i];
+            }
+            last = c[i];
+        }
+        if (changes == 0 || n >= N) return;
+
+        if (changes == 1) {
+            if (!rising_only || first < 0) {
+                out[n++] = a + (b - a) * refine(c, first < 0);
+            }
+            return;
+        }
+
+        Coord mid = (a + b) / 2;
+        if (depth >= 52 || mid <= a || mid >= b) {
+            // multiple root
+            out[n++] = mid;
+            return;
+        }
+        Coord left[N+1], right[N+1];
+        casteljau_subdivision(0.5, c, left, right, N);
+        isolate(left, a, mid, out, n, rising_only, depth + 1);
+        if (right[0] == 0 && n < N) {
+            out[n++] = mid;
+        }
+        isolate(right, mid, b, out, n, rising_only, depth + 1);
+    }
+
+    // find the single root in (0, 1) of a polynomial with one sign change in its coefficients
+    static Coord refine(Coord const *c, bool increasing) {
+        Coord sc[N+1], sd[N];
+        for (unsigned i = 0; i <= N; ++i) {
+            sc[i] = binomials[N][i] * c[i];
+        }
+        for (unsigned i = 0; i < N; ++i) {
+            sd[i] = binomials[N-1][i] * N * (c[i+1] - c[i]);
+        }
+
+        Coord a = 0, b = 1;
+        // start from the secant, which is already close for nearly linear pieces
+        Coord t = c[0] / (c[0] - c[N]);
+        if (!(t > a && t < b)) {
+            t = 0.5;
+        }
+        for (unsigned iter = 0; iter < 100; ++iter) {
+            Coord f = scaled_bernstein_value<N>(sc, t);
+            if (f == 0) break;
+            if ((f < 0) == increasing) {
+                a = t;
+            } else {
+                b = t;
+            }
+            Coord next = t - f / scaled_bernstein_value<N-1>(sd, t);
+            if (std::fabs(next - t) <= 1e-10 && next > a && next < b) {
+                t = next;
+                break;
+            }
+            if (!(next > a && next < b)) {
+                next = (a + b) / 2;
+                if (next <= a || next >= b) break;
+            }
+            t = next;
+        }
+        return t;
+    }
+};
+
+template <>
+struct BernsteinRoots<1> {
+    static unsigned find(Coord const *c, Coord l, Coord r, Coord *out) {
+        if (c[0] == c[1]) return 0;
+        Coord t = c[0] / (c[0] - c[1]);
+        if (t < l || t > r) return 0;
+        out[0] = t;
+        return 1;
+    }
+};
+
+// quadratics are solved in closed form, using the numerically stable variant of the formula
+template <>
+struct BernsteinRoots<2> {
+    static unsigned find(Coord const *c, Coord l, Coord r, Coord *out) {
+        Coord a = c[0] - 2 * c[1] + c[2], b = 2 * (c[1] - c[0]), k = c[0];
+        Coord roots[2];
+        unsigned n = 0;
+        if (a == 0) {
+            if (b == 0) return 0;
+            roots[n++] = -k / b;
+        } else {
+            Coord delta = b * b - 4 * a * k;
+            if (delta < 0) return 0;
+            Coord delta_sqrt = std::sqrt(delta);
+            Coord q = -0.5 * (b < 0 ? b - delta_sqrt : b + delta_sqrt);
+            roots[n++] = q / a;
+            if (q != 0) {
+                roots[n++] = k / q;
+            }
+        }
+        if (n == 2 && roots[1] < roots[0]) {
+            std::swap(roots[0], roots[1]);
+        }
+
+        unsigned found = 0;
+        for (unsigned i = 0; i < n; ++i) {
+            if (roots[i] < l || roots[i] > r) continue;
+            if (found > 0 && out[found-1] == roots[i]) continue;
+            out[found++] = roots[i];
+        }
+        return found;
+    }
+};
+
+template <unsigned N>
+std::vector<Coord> bezier_roots(Coord const *c, Coord v)
+{
+    Coord shifted[N+1], roots[N+1];
+    bool constant = true;
+    for (unsigned i = 0; i <= N; ++i) {
+        shifted[i] = c[i] - v;
+        constant = constant && shifted[i] == 0;
+    }
+    // like the generic version, return no roots when the coordinate is constant
+    if (constant) return std::vector<Coord>();
+    unsigned n = BernsteinRoots<N>::find(shifted, 0, 1, roots);
+    return std::vector<Coord>(roots, roots + n);
+}
+
+/* Find the time in [from, to] closest to p. The squared distance has its extrema at the roots
+ * of (B(t) - p) . B'(t), a polynomial of degree 2N-1, whose Bernstein coefficients are computed
+ * with the product rule for Bernstein polynomials. */
+template <unsigned N>
+Coord bezier_nearest_time(Point const *pts, Point const &p, Coord from, Coord to)
+{
+    if (from > to) std::swap(from, to);
+
+    Coord h[2*N];
+    for (unsigned k = 0; k < 2*N; ++k) {
+        h[k] = 0;
+    }
+    for (unsigned i = 0; i <= N; ++i) {
+        for (unsigned j = 0; j < N; ++j) {
+            Point d = N * (pts[j+1] - pts[j]);
+            h[i+j] += binomials[N][i] * binomials[N-1][j] * dot(pts[i] - p, d);
+        }
+    }
+    for (unsigned k = 0; k < 2*N; ++k) {
+        h[k] /= binomials[2*N-1][k];
+    }
+
+    // only the minima of the distance are needed, where the derivative is rising
+    Coord roots[2*N];
+    unsigned n = BernsteinRoots<2*N-1>::find(h, from, to, roots, true);
+
+    Coord best = from;
+    Coord best_dist = distanceSq(bernstein_value_at(from, pts, N), p);
+    for (unsigned i = 0; i < n; ++i) {
+        Coord d = distanceSq(bernstein_value_at(roots[i], pts, N), p);
+        if (d < best_dist) {
+            best = roots[i];
+            best_dist = d;
+        }
+    }
+    if (distanceSq(bernstein_value_at(to, pts, N), p) < best_dist) {
+        best = to;
+    }
+    return best;
+}
+
+// bounds of one coordinate of a Bezier curve, from the roots of its derivative
+template <unsigned N>
+Interval bezier_bounds(Coord const *c)
+{
+    Interval result(c[0], c[N]);
+    Coord dc[N], roots[N];
+    for (unsigned i = 0; i < N; ++i) {
+        dc[i] = N * (c[i+1] - c[i]);
+    }
+    unsigned n = BernsteinRoots<N-1>::find(dc, 0, 1, roots);
+    for (unsigned i = 0; i < n; ++i) {
+        result.expandTo(bernstein_value_at(roots[i], c, N));
+    }
+    return result;
+}
+
+// point and the first n derivatives, from the derivatives of the control points
+template <unsigned N>
+std::vector<Point> bezier_point_and_derivatives(Point const *pts, Coord t, unsigned n)
+{
+    std::vector<Point> result(n + 1, Point(0, 0));
+    Point d[N+1];
+    std::copy(pts, pts + N + 1, d);
+    for (unsigned k = 0; k <= n && k <= N; ++k) {
+        result[k] = bernstein_value_at(t, d, N - k);
+        for (unsigned i = 0; i < N - k; ++i) {
+            d[i] = (N - k) * (d[i+1] - d[i]);
+        }
+    }
+    return result;
+}
+
+template <unsigned N>
+void control_points(D2<Bezier> const &c, Point *pts)
+{
+    for (unsigned i = 0; i <= N; ++i) {
+        pts[i] = Point(c[X][i], c[Y][i]);
+    }
+}
+
+} // end anonymous namespace
+
+template <>
+Point BezierCurveN<1>::pointAt(Coord t) const
+{
+    return lerp(t, controlPoint(0), controlPoint(1));
+}
+
+template <>
+Point BezierCurveN<2>::pointAt(Coord t) const
+{
+    Coord s = 1 - t;
+    return s * s * controlPoint(0) + 2 * s * t * controlPoint(1) + t * t * controlPoint(2);
+}
+
+template <>
+Point BezierCurveN<3>::pointAt(Coord t) const
+{
+    Coord s = 1 - t;
+    return s * s * s * controlPoint(0) + 3 * s * s * t * controlPoint(1)
+         + 3 * s * t * t * controlPoint(2) + t * t * t * controlPoint(3);
+}
+
+template <>
+Coord BezierCurveN<1>::valueAt(Coord t, Dim2 d) const
+{
+    return lerp(t, inner[d][0], inner[d][1]);
+}
+
+template <>
+Coord BezierCurveN<2>::valueAt(Coord t, Dim2 d) const
+{
+    Coord s = 1 - t;
+    return s * s * inner[d][0] + 2 * s * t * inner[d][1] + t * t * inner[d][2];
+}
+
+template <>
+Coord BezierCurveN<3>::valueAt(Coord t, Dim2 d) const
+{
+    Coord s = 1 - t;
+    return s * s * s * inner[d][0] + 3 * s * s * t * inner[d][1]
+         + 3 * s * t * t * inner[d][2] + t * t * t * inner[d][3];
+}
+
+template <>
+std::vector<Point> BezierCurveN<1>::pointAndDerivatives(Coord t, unsigned n) const
+{
+    Point pts[2];
+    control_points<1>(inner, pts);
+    return bezier_point_and_derivatives<1>(pts, t, n);
+}
+
+template <>
+std::vector<Point> BezierCurveN<2>::pointAndDerivatives(Coord t, unsigned n) const
+{
+    Point pts[3];
+    control_points<2>(inner, pts);
+    return bezier_point_and_derivatives<2>(pts, t, n);
+}
+
+template <>
+std::vector<Point> BezierCurveN<3>::pointAndDerivatives(Coord t, unsigned n) const
+{
+    Point pts[4];
+    control_points<3>(inner, pts);
+    return bezier_point_and_derivatives<3>(pts, t, n);
+}
+
+template <>
+Rect BezierCurveN<1>::boundsExact() const
+{
+    return Rect(controlPoint(0), controlPoint(1));
+}
+
+template <>
+Rect BezierCurveN<2>::boundsExact() const
+{
+    Coord cx[3] = { inner[X][0], inner[X][1], inner[X][2] };
+    Coord cy[3] = { inner[Y][0], inner[Y][1], inner[Y][2] };
+    return Rect(bezier_bounds<2>(cx), bezier_bounds<2>(cy));
+}
+
+template <>
+Rect BezierCurveN<3>::boundsExact() const
+{
+    Coord cx[4] = { inner[X][0], inner[X][1], inner[X][2], inner[X][3] };
+    Coord cy[4] = { inner[Y][0], inner[Y][1], inner[Y][2], inner[Y][3] };
+    return Rect(bezier_bounds<3>(cx), bezier_bounds<3>(cy));
+}
+
+template <>
+std::vector<Coord> BezierCurveN<1>::roots(Coord v, Dim2 d) const
+{
+    Coord c[2] = { inner[d][0], inner[d][1] };
+    return bezier_roots<1>(c, v);
+}
+
+template <>
+std::vector<Coord> BezierCurveN<2>::roots(Coord v, Dim2 d) const
+{
+    Coord c[3] = { inner[d][0], inner[d][1], inner[d][2] };
+    return bezier_roots<2>(c, v);
+}
+
+template <>
+std::vector<Coord> BezierCurveN<3>::roots(Coord v, Dim2 d) const
+{
+    Coord c[4] = { inner[d][0], inner[d][1], inner[d][2], inner[d][3] };
+    return bezier_roots<3>(c, v);
+}
+
+template <>
+Coord BezierCurveN<2>::nearestTime(Point const &p, Coord from, Coord to) const
+{
+    Point pts[3];
+    control_points<2>(inner, pts);
+    return bezier_nearest_time<2>(pts, p, from, to);
+}
+
+template <>
+Coord BezierCurveN<3>::nearestTime(Point const &p, Coord from, Coord to) const
+{
+    Point pts[4];
+    control_points<3>(inner, pts);
+    return bezier_nearest_time<3>(pts, p, from, to);
+}
+
+template <>
+Curve *BezierCurveN<2>::portion(Coord f, Coord t) const
+{
+    Point pts[3];
+    control_points<2>(inner, pts);
+    Point r[3];
+    bezier_portion<2>(pts, f, t, r);
+    return new BezierCurveN<2>(r[0], r[1], r[2]);
+}
+
+template <>
+Curve *BezierCurveN<3>::portion(Coord f, Coord t) const
+{
+    Point pts[4];
+    control_points<3>(inner, pts);
+    Point r[4];
+    bezier_portion<3>(pts, f, t, r);
+    return new BezierCurveN<3>(r[0], r[1], r[2], r[3]);
+}
+
+
 static Coord bezier_length_internal(std::vector<Point> &v1, Coord tolerance, int level)
 {
     /* The Bezier length algorithm used in 2Geom utilizes a simple fact:
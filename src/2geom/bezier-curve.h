@@ -143,9 +143,7 @@ public:
         }
     }
     virtual void operator*=(Affine const &m) {
-        for (unsigned i = 0; i < size(); ++i) {
-            setPoint(i, controlPoint(i) * m);
-        }
+        transform_coords(&inner[X][0], &inner[Y][0], size(), m);
     }
 
     virtual Curve *derivative() const {
@@ -160,6 +158,8 @@ public:
     virtual Coord nearestTime(Point const &p, Coord from = 0, Coord to = 1) const;
     virtual Coord length(Coord tolerance) const;
     virtual std::vector<CurveIntersection> intersect(Curve const &other, Coord eps = EPSILON) const;
+    virtual void intersect(Curve const &other, std::vector<CurveIntersection> &out,
+                           Coord eps = EPSILON) const;
     virtual Point pointAt(Coord t) const { return inner.pointAt(t); }
     virtual std::vector<Point> pointAndDerivatives(Coord t, unsigned n) const {
         return inner.valueAndDerivatives(t, n);
@@ -308,6 +308,22 @@ public:
     }
     virtual Curve *derivative() const;
 
+    // the following methods call super; they are implemented only to allow specializations
+    virtual Point pointAt(Coord t) const {
+        return BezierCurve::pointAt(t);
+    }
+    virtual Coord valueAt(Coord t, Dim2 d) const {
+        return BezierCurve::valueAt(t, d);
+    }
+    virtual std::vector<Point> pointAndDerivatives(Coord t, unsigned n) const {
+        return BezierCurve::pointAndDerivatives(t, n);
+    }
+    virtual Rect boundsExact() const {
+        return BezierCurve::boundsExact();
+    }
+    virtual std::vector<Coord> roots(Coord v, Dim2 d) const {
+        return BezierCurve::roots(v, d);
+    }
     virtual Coord nearestTime(Point const &p, Coord from = 0, Coord to = 1) const {
         return BezierCurve::nearestTime(p, from, to);
     }
@@ -315,6 +331,10 @@ public:
         // call super. this is implemented only to allow specializations
         return BezierCurve::intersect(other, eps);
     }
+    virtual void intersect(Curve const &other, std::vector<CurveIntersection> &out,
+                           Coord eps = EPSILON) const {
+        BezierCurve::intersect(other, out, eps);
+    }
     virtual int winding(Point const &p) const {
         return Curve::winding(p);
     }
@@ -354,7 +374,28 @@ template <> inline bool BezierCurveN<1>::isDegenerate() const {
 template <> inline bool BezierCurveN<1>::isLineSegment() const { return true; }
 template <> Curve *BezierCurveN<1>::derivative() const;
 template <> Coord BezierCurveN<1>::nearestTime(Point const &, Coord, Coord) const;
+template <> Coord BezierCurveN<2>::nearestTime(Point const &, Coord, Coord) const;
+template <> Coord BezierCurveN<3>::nearestTime(Point const &, Coord, Coord) const;
+template <> Point BezierCurveN<1>::pointAt(Coord) const;
+template <> Point BezierCurveN<2>::pointAt(Coord) const;
+template <> Point BezierCurveN<3>::pointAt(Coord) const;
+template <> Coord BezierCurveN<1>::valueAt(Coord, Dim2) const;
+template <> Coord BezierCurveN<2>::valueAt(Coord, Dim2) const;
+template <> Coord BezierCurveN<3>::valueAt(Coord, Dim2) const;
+template <> std::vector<Point> BezierCurveN<1>::pointAndDerivatives(Coord, unsigned) const;
+template <> std::vector<Point> BezierCurveN<2>::pointAndDerivatives(Coord, unsigned) const;
+template <> std::vector<Point> BezierCurveN<3>::pointAndDerivatives(Coord, unsigned) const;
+template <> Rect BezierCurveN<1>::boundsExact() const;
+template <> Rect BezierCurveN<2>::boundsExact() const;
+template <> Rect BezierCurveN<3>::boundsExact() const;
+template <> std::vector<Coord> BezierCurveN<1>::roots(Coord, Dim2) const;
+template <> std::vector<Coord> BezierCurveN<2>::roots(Coord, Dim2) const;
+template <> std::vector<Coord> BezierCurveN<3>::roots(Coord, Dim2) const;
+template <> Curve *BezierCurveN<2>::portion(Coord, Coord) const;
+template <> Curve *BezierCurveN<3>::portion(Coord, Coord) const;
 template <> std::vector<CurveIntersection> BezierCurveN<1>::intersect(Curve const &, Coord) const;
+template <> void BezierCurveN<1>::intersect(Curve const &, std::vector<CurveIntersection> &,
+                                            Coord) const;
 template <> int BezierCurveN<1>::winding(Point const &) const;
 template <> void BezierCurveN<1>::feed(PathSink &sink, bool moveto_initial) const;
 template <> void BezierCurveN<2>::feed(PathSink &sink, bool moveto_initial) const;
@@ -49,10 +49,7 @@ std::vector<Coord> Bezier::valueAndDerivatives(Coord t, unsigned n_derivs) const
     std::vector<Coord> val_n_der(n_derivs + 1, Coord(0.0));
 
     // initialize temp storage variables
-    std::valarray<Coord> d_(order()+1);
-    for(unsigned i = 0; i < size(); i++) {
-        d_[i] = c_[i];
-    }
+    Bezier d_(*this);
 
     unsigned nn = n_derivs + 1;
     if(n_derivs > order()) {
@@ -75,16 +72,16 @@ void Bezier::subdivide(Coord t, Bezier *left, Bezier *right) const
         left->c_.resize(size());
         if (right) {
             right->c_.resize(size());
-            casteljau_subdivision<double>(t, &const_cast<std::valarray<Coord>&>(c_)[0],
-                &left->c_[0], &right->c_[0], order());
+            casteljau_subdivision<double>(t, c_.data(),
+                left->c_.data(), right->c_.data(), order());
         } else {
-            casteljau_subdivision<double>(t, &const_cast<std::valarray<Coord>&>(c_)[0],
-                &left->c_[0], NULL, order());
+            casteljau_subdivision<double>(t, c_.data(),
+                left->c_.data(), NULL, order());
         }
     } else if (right) {
         right->c_.resize(size());
-        casteljau_subdivision<double>(t, &const_cast<std::valarray<Coord>&>(c_)[0],
-            NULL, &right->c_[0], order());
+        casteljau_subdivision<double>(t, c_.data(),
+            NULL, right->c_.data(), order());
     }
 }
 
@@ -141,7 +138,7 @@ std::vector<Coord> Bezier::roots() const
 std::vector<Coord> Bezier::roots(Interval const &ivl) const
 {
     std::vector<Coord> solutions;
-    find_bernstein_roots(&const_cast<std::valarray<Coord>&>(c_)[0], order(), solutions, 0, ivl.min(), ivl.max());
+    find_bernstein_roots(c_.data(), order(), solutions, 0, ivl.min(), ivl.max());
     std::sort(solutions.begin(), solutions.end());
     return solutions;
 }
@@ -279,19 +276,19 @@ Bezier portion(Bezier const &a, double from, double to)
             if (to == 1) {
                 break;
             }
-            casteljau_subdivision<double>(to, &ret.c_[0], &ret.c_[0], NULL, ret.order());
+            casteljau_subdivision<double>(to, ret.c_.data(), ret.c_.data(), NULL, ret.order());
             break; 
         }
-        casteljau_subdivision<double>(from, &ret.c_[0], NULL, &ret.c_[0], ret.order());
+        casteljau_subdivision<double>(from, ret.c_.data(), NULL, ret.c_.data(), ret.order());
         if (to == 1) break;
-        casteljau_subdivision<double>((to - from) / (1 - from), &ret.c_[0], &ret.c_[0], NULL, ret.order());
+        casteljau_subdivision<double>((to - from) / (1 - from), ret.c_.data(), ret.c_.data(), NULL, ret.order());
         // to protect against numerical inaccuracy in the above expression, we manually set
         // the last coefficient to a value evaluated directly from the original polynomial
         ret.c_[ret.order()] = a.valueAt(to);
     } while(0);
 
     if (reverse_result) {
-        std::reverse(&ret.c_[0], &ret.c_[0] + ret.c_.size());
+        std::reverse(ret.c_.data(), ret.c_.data() + ret.c_.size());
     }
     return ret;
 }
@@ -321,7 +318,7 @@ Bezier integral(Bezier const &a)
 
 OptInterval bounds_fast(Bezier const &b)
 {
-    OptInterval ret = Interval::from_array(&const_cast<Bezier&>(b).c_[0], b.size());
+    OptInterval ret = Interval::from_array(b.c_.data(), b.size());
     return ret;
 }
 
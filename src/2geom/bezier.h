@@ -39,7 +39,6 @@
 #define LIB2GEOM_SEEN_BEZIER_H
 
 #include <algorithm>
-#include <valarray>
 #include <boost/optional.hpp>
 #include <2geom/choose.h>
 #include <2geom/coord.h>
@@ -117,6 +116,114 @@ inline T casteljau_subdivision(double t, T const *v, T *left, T *right, unsigned
     return right[0];
 }
 
+/**
+ * @brief Coefficient storage for Bezier polynomials.
+ *
+ * Up to INLINE_SIZE coefficients are stored within the object itself, so polynomials
+ * of degree 7 or lower never allocate memory. This covers the curves found in paths
+ * together with their derivatives, portions and subdivisions, which are created
+ * as temporaries in tight loops. Polynomials of higher degree use heap storage.
+ * As with std::valarray, resize() discards the previous contents.
+ */
+class BezierCoeffs {
+public:
+    static std::size_t const INLINE_SIZE = 8;
+
+    BezierCoeffs()
+        : _data(_inline), _size(0), _capacity(INLINE_SIZE)
+    {}
+    BezierCoeffs(Coord v, std::size_t n)
+        : _data(_inline), _size(0), _capacity(INLINE_SIZE)
+    {
+        resize(n, v);
+    }
+    BezierCoeffs(Coord const *c, std::size_t n)
+        : _data(_inline), _size(0), _capacity(INLINE_SIZE)
+    {
+        _allocate(n);
+        std::copy(c, c + n, _data);
+    }
+    BezierCoeffs(BezierCoeffs const &other)
+        : _data(_inline), _size(0), _capacity(INLINE_SIZE)
+    {
+        _allocate(other._size);
+        std::copy(other._data, other._data + _size, _data);
+    }
+    ~BezierCoeffs() {
+        if (_data != _inline) {
+            delete[] _data;
+        }
+    }
+    BezierCoeffs &operator=(BezierCoeffs const &other) {
+        if (this != &other) {
+            _allocate(other._size);
+            std::copy(other._data, other._data + _size, _data);
+        }
+        return *this;
+    }
+
+    std::size_t size() const { return _size; }
+    /// Change the number of coefficients and set all of them to the given value.
+    void resize(std::size_t n, Coord v = 0) {
+        _allocate(n);
+        std::fill(_data, _data + n, v);
+    }
+
+    Coord *data() { return _data; }
+    Coord const *data() const { return _data; }
+    Coord &operator[](std::size_t i) { return _data[i]; }
+    Coord const &operator[](std::size_t i) const { return _data[i]; }
+
+    BezierCoeffs &operator+=(Coord v) {
+        for (std::size_t i = 0; i < _size; ++i) _data[i] += v;
+        return *this;
+    }
+    BezierCoeffs &operator-=(Coord v) {
+        for (std::size_t i = 0; i < _size; ++i) _data[i] -= v;
+        return *this;
+    }
+    BezierCoeffs &operator*=(Coord v) {
+        for (std::size_t i = 0; i < _size; ++i) _data[i] *= v;
+        return *this;
+    }
+    BezierCoeffs &operator/=(Coord v) {
+        for (std::size_t i = 0; i < _size; ++i) _data[i] /= v;
+        return *this;
+    }
+    /// Add coefficients elementwise. Both operands must have the same size.
+    BezierCoeffs &operator+=(BezierCoeffs const &other) {
+        assert(other._size == _size);
+        for (std::size_t i = 0; i < _size; ++i) _data[i] += other._data[i];
+        return *this;
+    }
+    /// Subtract coefficients elementwise. Both operands must have the same size.
+    BezierCoeffs &operator-=(BezierCoeffs const &other) {
+        assert(other._size == _size);
+        for (std::size_t i = 0; i < _size; ++i) _data[i] -= other._data[i];
+        return *this;
+    }
+
+private:
+    // make room for n coefficients, without preserving the current ones
+    void _allocate(std::size_t n) {
+        if (n > _capacity) {
+            // allocate first, so that a throwing new leaves the old buffer in place
+            Coord *data = new Coord[n];
+            if (_data != _inline) {
+                delete[] _data;
+            }
+            _data = data;
+            _capacity = n;
+        }
+        _size = n;
+    }
+
+    Coord *_data;
+    std::size_t _size;
+    std::size_t _capacity;
+    Coord _inline[INLINE_SIZE];
+};
+
 /**
  * @brief Polynomial in Bernstein-Bezier basis
  * @ingroup Fragments
@@ -127,7 +234,7 @@ class Bezier
       > >
 {
 private:
-    std::valarray<Coord> c_;
+    BezierCoeffs c_;
 
     friend Bezier portion(const Bezier & a, Coord from, Coord to);
     friend OptInterval bounds_fast(Bezier const & b);
@@ -151,9 +258,6 @@ public:
     Bezier() {}
     Bezier(const Bezier& b) :c_(b.c_) {}
     Bezier &operator=(Bezier const &other) {
-        if ( c_.size() != other.c_.size() ) {
-            c_.resize(other.c_.size());
-        }
         c_ = other.c_;
         return *this;
     }
@@ -214,8 +318,9 @@ public:
     }
 
     template <typename Iter>
-    Bezier(Iter first, Iter last) {
-        c_.resize(std::distance(first, last));
+    Bezier(Iter first, Iter last)
+        : c_(0., std::distance(first, last))
+    {
         for (std::size_t i = 0; first != last; ++first, ++i) {
             c_[i] = *first;
         }
@@ -258,14 +363,14 @@ public:
     Coord &at1() { return c_[order()]; }
 
     Coord valueAt(double t) const {
-        return bernstein_value_at(t, &c_[0], order());
+        return bernstein_value_at(t, c_.data(), order());
     }
     Coord operator()(double t) const { return valueAt(t); }
 
     SBasis toSBasis() const;
 
     Coord &operator[](unsigned ix) { return c_[ix]; }
-    Coord const &operator[](unsigned ix) const { return const_cast<std::valarray<Coord>&>(c_)[ix]; }
+    Coord const &operator[](unsigned ix) const { return c_[ix]; }
 
     void setCoeff(unsigned ix, double val) { c_[ix] = val; }
 
@@ -0,0 +1,551 @@
+/** @file
+ * @brief Compact binary serialization of path data
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <stdint.h>
+
+#include "config.h"
+#include <2geom/binary-path.h>
+#include <2geom/exception.h>
+#include <2geom/math-utils.h>
+#include <2geom/packed-pathvector.h>
+#include <2geom/pathvector.h>
+
+#ifdef HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Geom {
+
+namespace {
+
+char const MAGIC[4] = { '2', 'G', 'P', 'B' };
+unsigned char const VERSION = 1;
+std::size_t const HEADER_SIZE = 8;
+
+enum Tag {
+    TAG_MOVETO = 0,
+    TAG_LINETO,
+    TAG_QUADTO,
+    TAG_CURVETO,
+    TAG_ARCTO,
+    TAG_CLOSEPATH,
+    TAG_KIND_MASK = 7,
+    // arc flags are stored in the tag
+    TAG_LARGE_ARC = 8,
+    TAG_SWEEP = 16
+};
+
+// Largest magnitude of a quantized coordinate. Integers up to this value
+// are exactly representable as doubles.
+Coord const MAX_QUANTIZED = 9007199254740992.0;
+
+/* The byte-by-byte loads and stores below are endian-independent.
+ * Optimizing compilers turn them into single moves on little-endian machines. */
+
+inline char *store_u32(char *p, uint32_t v)
+{
+    for (unsigned i = 0; i < 4; ++i) {
+        p[i] = char(v >> (8 * i));
+    }
+    return p + 4;
+}
+
+inline char *store_u64(char *p, uint64_t v)
+{
+    for (unsigned i = 0; i < 8; ++i) {
+        p[i] = char(v >> (8 * i));
+    }
+    return p + 8;
+}
+
+inline char *store_double(char *p, double v)
+{
+    uint64_t u;
+    std::memcpy(&u, &v, sizeof(u));
+    return store_u64(p, u);
+}
+
+inline char *store_float(char *p, double v)
+{
+    float f = v;
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return store_u32(p, u);
+}
+
+inline char *store_varint(char *p, int64_t v)
+{
+    // zigzag encoding maps small negative values to small unsigned ones
+    uint64_t u = (uint64_t(v) << 1) ^ uint64_t(v >> 63);
+    while (u >= 0x80) {
+        *p++ = char(u | 0x80);
+        u >>= 7;
+    }
+    *p++ = char(u);
+    return p;
+}
+
+inline uint32_t load_u32(unsigned char const *p)
+{
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16)
+         | (uint32_t(p[3]) << 24);
+}
+
+inline uint64_t load_u64(unsigned char const *p)
+{
+    return uint64_t(load_u32(p)) | (uint64_t(load_u32(p + 4)) << 32);
+}
+
+inline double load_double(unsigned char const *p)
+{
+    uint64_t u = load_u64(p);
+    double v;
+    std::memcpy(&v, &u, sizeof(v));
+    return v;
+}
+
+inline float load_float(unsigned char const *p)
+{
+    uint32_t u = load_u32(p);
+    float v;
+    std::memcpy(&v, &u, sizeof(v));
+    return v;
+}
+
+// Readers of the coordinate encodings.
+class Float64Values {
+public:
+    Float64Values(Coord) {}
+    static Coord value(unsigned char const *&p, unsigned char const *end) {
+        if (end - p < 8) throw BinaryPathFormatError();
+        Coord v = load_double(p);
+        p += 8;
+        return v;
+    }
+    Point point(unsigned char const *&p, unsigned char const *end) {
+        if (end - p < 16) throw BinaryPathFormatError();
+        Point r(load_double(p), load_double(p + 8));
+        p += 16;
+        return r;
+    }
+};
+
+class Float32Values {
+public:
+    Float32Values(Coord) {}
+    static Coord value(unsigned char const *&p, unsigned char const *end) {
+        if (end - p < 4) throw BinaryPathFormatError();
+        Coord v = load_float(p);
+        p += 4;
+        return v;
+    }
+    Point point(unsigned char const *&p, unsigned char const *end) {
+        if (end - p < 8) throw BinaryPathFormatError();
+        Point r(load_float(p), load_float(p + 4));
+        p += 8;
+        return r;
+    }
+};
+
+class QuantizedValues {
+public:
+    QuantizedValues(Coord quantum) : _quantum(quantum) {
+        _last[X] = _last[Y] = 0;
+    }
+    static Coord value(unsigned char const *&p, unsigned char const *end) {
+        return Float64Values::value(p, end);
+    }
+    Point point(unsigned char const *&p, unsigned char const *end) {
+        Point r;
+        for (unsigned d = 0; d < 2; ++d) {
+            // wrap around instead of overflowing on corrupted data
+            _last[d] = int64_t(uint64_t(_last[d]) + uint64_t(_varint(p, end)));
+            r[d] = Coord(_last[d]) * _quantum;
+        }
+        return r;
+    }
+private:
+    static int64_t _varint(unsigned char const *&p, unsigned char const *end) {
+        uint64_t u = 0;
+        for (unsigned shift = 0; ; shift += 7) {
+            if (p == end || shift > 63) throw BinaryPathFormatError();
+            unsigned char b = *p++;
+            u |= uint64_t(b & 0x7f) << shift;
+            if (b < 0x80) break;
+        }
+        return int64_t(u >> 1) ^ -int64_t(u & 1);
+    }
+    Coord _quantum;
+    int64_t _last[2];
+};
+
+// Outputs of the decoder.
+class SinkOutput {
+public:
+    SinkOutput(PathSink &sink) : _sink(sink) {}
+    void moveTo(Point const &p) { _sink.moveTo(p); }
+    void lineTo(Point const &p) { _sink.lineTo(p); }
+    void quadTo(Point const &c, Point const &p) { _sink.quadTo(c, p); }
+    void curveTo(Point const &c0, Point const &c1, Point const &p) { _sink.curveTo(c0, c1, p); }
+    void arcTo(Coord rx, Coord ry, Coord angle, bool large_arc, bool sweep, Point const &p) {
+        _sink.arcTo(rx, ry, angle, large_arc, sweep, p);
+    }
+    void closePath() { _sink.closePath(); }
+    void finish() { _sink.flush(); }
+private:
+    PathSink &_sink;
+};
+
+class PackedOutput {
+public:
+    PackedOutput(PackedPathVector &out) : _out(out) {}
+    void moveTo(Point const &p) { _out.start(p); }
+    void lineTo(Point const &p) { _out.appendLine(p); }
+    void quadTo(Point const &c, Point const &p) { _out.appendQuadratic(c, p); }
+    void curveTo(Point const &c0, Point const &c1, Point const &p) {
+        _out.appendCubic(c0, c1, p);
+    }
+    void arcTo(Coord rx, Coord ry, Coord angle, bool large_arc, bool sweep, Point const &p) {
+        _out.appendArc(rx, ry, angle, large_arc, sweep, p);
+    }
+    void closePath() { _out.close(); }
+    void finish() {}
+private:
+    PackedPathVector &_out;
+};
+
+template <typename Values, typename Output>
+void decode_commands(unsigned char const *p, unsigned char const *end,
+                     Values values, Output &out)
+{
+    bool in_path = false;
+    while (p != end) {
+        unsigned tag = *p++;
+        unsigned kind = tag & TAG_KIND_MASK;
+        if (kind == TAG_MOVETO) {
+            if (tag != kind) throw BinaryPathFormatError();
+            out.moveTo(values.point(p, end));
+            in_path = true;
+            continue;
+        }
+        // the writer always starts paths with an explicit moveto
+        if (!in_path || (tag != kind && kind != TAG_ARCTO)) {
+            throw BinaryPathFormatError();
+        }
+        switch (kind) {
+        case TAG_LINETO:
+            out.lineTo(values.point(p, end));
+            break;
+        case TAG_QUADTO: {
+            Point c = values.point(p, end);
+            out.quadTo(c, values.point(p, end));
+            } break;
+        case TAG_CURVETO: {
+            Point c0 = values.point(p, end);
+            Point c1 = values.point(p, end);
+            out.curveTo(c0, c1, values.point(p, end));
+            } break;
+        case TAG_ARCTO: {
+            if (tag & ~(TAG_KIND_MASK | TAG_LARGE_ARC | TAG_SWEEP)) {
+                throw BinaryPathFormatError();
+            }
+            Coord rx = values.value(p, end);
+            Coord ry = values.value(p, end);
+            Coord angle = values.value(p, end);
+            out.arcTo(rx, ry, angle, tag & TAG_LARGE_ARC, tag & TAG_SWEEP, values.point(p, end));
+            } break;
+        case TAG_CLOSEPATH:
+            out.closePath();
+            in_path = false;
+            break;
+        default:
+            throw BinaryPathFormatError();
+        }
+    }
+    out.finish();
+}
+
+template <typename Output>
+void decode(char const *data, std::size_t len, Output &out)
+{
+    unsigned char const *p = reinterpret_cast<unsigned char const *>(data);
+    unsigned char const *end = p + len;
+    if (len < HEADER_SIZE || std::memcmp(p, MAGIC, 4) != 0 || p[4] != VERSION
+        || p[6] != 0 || p[7] != 0)
+    {
+        throw BinaryPathFormatError();
+    }
+    unsigned encoding = p[5];
+    p += HEADER_SIZE;
+
+    switch (encoding) {
+    case BINARY_PATH_FLOAT64:
+        decode_commands(p, end, Float64Values(0), out);
+        break;
+    case BINARY_PATH_FLOAT32:
+        decode_commands(p, end, Float32Values(0), out);
+        break;
+    case BINARY_PATH_QUANTIZED: {
+        Coord quantum = Float64Values::value(p, end);
+        if (!(quantum > 0) || !IS_FINITE(quantum)) throw BinaryPathFormatError();
+        decode_commands(p, end, QuantizedValues(quantum), out);
+        } break;
+    default:
+        throw BinaryPathFormatError();
+    }
+}
+
+} // end anonymous namespace
+
+BinaryPathWriter::BinaryPathWriter(BinaryPathEncoding enc, Coord quantum)
+    : _out(&_s)
+    , _start(0)
+{
+    _init(enc, quantum);
+}
+
+BinaryPathWriter::BinaryPathWriter(std::string &out, BinaryPathEncoding enc, Coord quantum)
+    : _out(&out)
+    , _start(out.size())
+{
+    _init(enc, quantum);
+}
+
+void BinaryPathWriter::moveTo(Point const &p)
+{
+    _out->push_back(char(TAG_MOVETO));
+    _writePoint(p);
+    _subpath_start = p;
+    _in_path = true;
+}
+
+void BinaryPathWriter::lineTo(Point const &p)
+{
+    _startSegment(TAG_LINETO);
+    _writePoint(p);
+}
+
+void BinaryPathWriter::quadTo(Point const &c, Point const &p)
+{
+    _startSegment(TAG_QUADTO);
+    _writePoint(c);
+    _writePoint(p);
+}
+
+void BinaryPathWriter::curveTo(Point const &c0, Point const &c1, Point const &p)
+{
+    _startSegment(TAG_CURVETO);
+    _writePoint(c0);
+    _writePoint(c1);
+    _writePoint(p);
+}
+
+void BinaryPathWriter::arcTo(Coord rx, Coord ry, Coord angle,
+                             bool large_arc, bool sweep, Point const &p)
+{
+    _startSegment(TAG_ARCTO | (large_arc ? TAG_LARGE_ARC : 0) | (sweep ? TAG_SWEEP : 0));
+    _writeValue(rx);
+    _writeValue(ry);
+    _writeValue(angle);
+    _writePoint(p);
+}
+
+void BinaryPathWriter::closePath()
+{
+    if (_in_path) {
+        _out->push_back(char(TAG_CLOSEPATH));
+        _in_path = false;
+    }
+}
+
+void BinaryPathWriter::flush()
+{
+    _in_path = false;
+}
+
+void BinaryPathWriter::clear()
+{
+    _out->erase(_start);
+    _writeHeader();
+}
+
+void BinaryPathWriter::_init(BinaryPathEncoding enc, Coord quantum)
+{
+    if (enc == BINARY_PATH_QUANTIZED && (!(quantum > 0) || !IS_FINITE(quantum))) {
+        THROW_RANGEERROR("Quantum must be positive and finite");
+    }
+    _encoding = enc;
+    _quantum = quantum;
+    _writeHeader();
+}
+
+void BinaryPathWriter::_writeHeader()
+{
+    char header[HEADER_SIZE + 8] = { MAGIC[0], MAGIC[1], MAGIC[2], MAGIC[3],
+                                     char(VERSION), char(_encoding), 0, 0 };
+    std::size_t size = HEADER_SIZE;
+    if (_encoding == BINARY_PATH_QUANTIZED) {
+        size = store_double(header + HEADER_SIZE, _quantum) - header;
+    }
+    _out->append(header, size);
+    _last[X] = _last[Y] = 0;
+    _subpath_start = Point();
+    _in_path = false;
+}
+
+void BinaryPathWriter::_startSegment(unsigned char tag)
+{
+    // output an explicit moveto, like PathIteratorSink does implicitly
+    if (!_in_path) {
+        moveTo(_subpath_start);
+    }
+    _out->push_back(char(tag));
+}
+
+void BinaryPathWriter::_writePoint(Point const &p)
+{
+    char buf[20];
+    char *end = buf;
+    switch (_encoding) {
+    case BINARY_PATH_FLOAT64:
+        end = store_double(store_double(buf, p[X]), p[Y]);
+        break;
+    case BINARY_PATH_FLOAT32:
+        end = store_float(store_float(buf, p[X]), p[Y]);
+        break;
+    default:
+        for (unsigned d = 0; d < 2; ++d) {
+            Coord q = std::floor(p[d] / _quantum + 0.5);
+            if (!(std::fabs(q) <= MAX_QUANTIZED)) {
+                THROW_RANGEERROR("Coordinate cannot be represented with the given quantum");
+            }
+            end = store_varint(end, int64_t(q) - int64_t(_last[d]));
+            _last[d] = q;
+        }
+        break;
+    }
+    _out->append(buf, end - buf);
+}
+
+void BinaryPathWriter::_writeValue(Coord v)
+{
+    char buf[8];
+    char *end = _encoding == BINARY_PATH_FLOAT32 ? store_float(buf, v) : store_double(buf, v);
+    _out->append(buf, end - buf);
+}
+
+std::string write_binary_path(PathVector const &pv, BinaryPathEncoding enc, Coord quantum)
+{
+    BinaryPathWriter writer(enc, quantum);
+    writer.feed(pv);
+    return writer.str();
+}
+
+void read_binary_path(char const *data, std::size_t len, PathSink &sink)
+{
+    SinkOutput out(sink);
+    decode(data, len, out);
+}
+
+void read_binary_path(char const *data, std::size_t len, PackedPathVector &out)
+{
+    PackedOutput packed(out);
+    decode(data, len, packed);
+}
+
+PathVector read_binary_path(char const *data, std::size_t len)
+{
+    PathVector pv;
+    PathBuilder builder(pv);
+    read_binary_path(data, len, builder);
+    return pv;
+}
+
+void read_binary_path_file(char const *filename, PackedPathVector &out)
+{
+#ifdef HAVE_MMAP
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error("Error opening file");
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        std::size_t size = st.st_size;
+        void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data != MAP_FAILED) {
+            posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+            try {
+                read_binary_path(static_cast<char const *>(data), size, out);
+            } catch (...) {
+                munmap(data, size);
+                throw;
+            }
+            munmap(data, size);
+            return;
+        }
+    } else {
+        close(fd);
+    }
+    // fall back to reading through stdio, e.g. for pipes or empty files
+#endif
+    FILE *fi = fopen(filename, "rb");
+    if (fi == NULL) {
+        throw std::runtime_error("Error opening file");
+    }
+    std::vector<char> data;
+    char buf[65536];
+    std::size_t bytes_read;
+    while ((bytes_read = fread(buf, 1, sizeof(buf), fi)) > 0) {
+        data.insert(data.end(), buf, buf + bytes_read);
+    }
+    fclose(fi);
+    read_binary_path(data.empty() ? NULL : &data[0], data.size(), out);
+}
+
+} // namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
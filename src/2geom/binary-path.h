@@ -0,0 +1,172 @@
+/** @file
+ * @brief Compact binary serialization of path data
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#ifndef LIB2GEOM_SEEN_BINARY_PATH_H
+#define LIB2GEOM_SEEN_BINARY_PATH_H
+
+#include <cstddef>
+#include <string>
+#include <2geom/forward.h>
+#include <2geom/path-sink.h>
+#include <2geom/point.h>
+
+namespace Geom {
+
+/** @brief Coordinate encodings of the binary path format.
+ * @ingroup Paths */
+enum BinaryPathEncoding {
+    /// IEEE double precision values, which preserve all values exactly
+    BINARY_PATH_FLOAT64 = 0,
+    /// IEEE single precision values
+    BINARY_PATH_FLOAT32 = 1,
+    /** Coordinates rounded to a multiple of a fixed quantum and stored
+     * as variable-length differences from the previous point */
+    BINARY_PATH_QUANTIZED = 2
+};
+
+/** @brief Serialize paths to a compact binary format.
+ *
+ * The binary format avoids the cost of formatting and parsing numbers, which dominates
+ * the time needed to exchange paths as SVG path data. It consists of an 8-byte header
+ * followed by a sequence of commands. Each command is a one-byte tag identifying
+ * the segment type, followed by its coordinates in the encoding given in the header.
+ * All values are little-endian. Every path starts with an explicit moveto, so the data
+ * can be decoded without tracking implicit movetos.
+ *
+ * Header:
+ * - bytes 0-3: the characters "2GPB"
+ * - byte 4: format version, currently 1
+ * - byte 5: coordinate encoding, one of BinaryPathEncoding
+ * - bytes 6-7: reserved, must be zero
+ * - for BINARY_PATH_QUANTIZED: the quantum, as a double
+ *
+ * Commands are moveto, lineto, quadratic and cubic Bezier (followed by 1, 1, 2 and 3
+ * points), elliptical arc (followed by the radii, the rotation angle and the final point;
+ * the flags are stored in the tag) and closepath (no arguments).
+ *
+ * In the quantized encoding, each point is stored as the difference between its
+ * coordinates and those of the previously stored point, in units of the quantum,
+ * using zigzag variable-length integers. Arc radii and angles are not points, so they
+ * are stored as doubles. Decoded coordinates differ from the written ones by at most
+ * half of the quantum.
+ *
+ * @ingroup Paths */
+class BinaryPathWriter
+    : public PathSink
+{
+public:
+    /** @brief Create a writer which stores the data internally.
+     * @param quantum Coordinate step for BINARY_PATH_QUANTIZED, ignored otherwise */
+    explicit BinaryPathWriter(BinaryPathEncoding enc = BINARY_PATH_FLOAT64, Coord quantum = 0);
+    /** @brief Create a writer which appends binary data to the given string.
+     * The string must outlive the writer. Its existing content is not modified. */
+    explicit BinaryPathWriter(std::string &out, BinaryPathEncoding enc = BINARY_PATH_FLOAT64,
+                              Coord quantum = 0);
+    ~BinaryPathWriter() {}
+
+    void moveTo(Point const &p);
+    void lineTo(Point const &p);
+    void quadTo(Point const &c, Point const &p);
+    void curveTo(Point const &c0, Point const &c1, Point const &p);
+    void arcTo(Coord rx, Coord ry, Coord angle,
+               bool large_arc, bool sweep, Point const &p);
+    void closePath();
+    void flush();
+
+    /// Clear any path data written so far.
+    void clear();
+
+    /// Retrieve the binary data, including the header.
+    std::string str() const { return _out->substr(_start); }
+
+private:
+    // not copyable, since _out can point to _s
+    BinaryPathWriter(BinaryPathWriter const &);
+    BinaryPathWriter &operator=(BinaryPathWriter const &);
+
+    void _init(BinaryPathEncoding enc, Coord quantum);
+    void _writeHeader();
+    void _startSegment(unsigned char tag);
+    void _writePoint(Point const &p);
+    void _writeValue(Coord v);
+
+    std::string _s;
+    std::string *_out; ///< Output string, either _s or one supplied by the caller
+    std::size_t _start; ///< Length of the output string before anything was written
+    Coord _quantum;
+    Point _subpath_start;
+    Coord _last[2]; ///< Last stored point in units of the quantum
+    BinaryPathEncoding _encoding;
+    bool _in_path;
+};
+
+/** @brief Serialize a path vector to the binary path format.
+ * @relates BinaryPathWriter */
+std::string write_binary_path(PathVector const &pv,
+                              BinaryPathEncoding enc = BINARY_PATH_FLOAT64, Coord quantum = 0);
+
+/** @brief Feed binary path data to the specified sink.
+ * The data is read in place, so it can be a memory-mapped file.
+ * @throw BinaryPathFormatError if the data is not valid
+ * @relates BinaryPathWriter */
+void read_binary_path(char const *data, std::size_t len, PathSink &sink);
+/** @brief Decode binary path data directly into packed storage.
+ * The paths are appended to the existing content of @a out.
+ * @throw BinaryPathFormatError if the data is not valid
+ * @relates BinaryPathWriter */
+void read_binary_path(char const *data, std::size_t len, PackedPathVector &out);
+/** @brief Create a path vector from binary path data.
+ * @throw BinaryPathFormatError if the data is not valid
+ * @relates BinaryPathWriter */
+PathVector read_binary_path(char const *data, std::size_t len);
+
+inline PathVector read_binary_path(std::string const &data) {
+    return read_binary_path(data.data(), data.size());
+}
+
+/** @brief Decode binary path data stored in a file into packed storage.
+ * Regular files are memory-mapped where supported and decoded without copying.
+ * @throw std::runtime_error if the file cannot be opened
+ * @throw BinaryPathFormatError if the data is not valid
+ * @relates BinaryPathWriter */
+void read_binary_path_file(char const *filename, PackedPathVector &out);
+
+} // namespace Geom
+
+#endif // LIB2GEOM_SEEN_BINARY_PATH_H
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -2,5 +2,6 @@
 #define SEEN_2GEOM_CONFIG_H
 
 #cmakedefine HAVE_SINCOS
+#cmakedefine HAVE_MMAP
 
 #endif
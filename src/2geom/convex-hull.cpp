@@ -34,6 +34,7 @@
 
 #include <2geom/convex-hull.h>
 #include <2geom/exception.h>
+#include <2geom/predicates.h>
 #include <algorithm>
 #include <map>
 #include <iostream>
@@ -107,7 +108,8 @@ ConvexHull::ConvexHull(std::vector<Point> const &pts)
 bool ConvexHull::_is_clockwise_turn(Point const &a, Point const &b, Point const &c)
 {
     if (b == c) return false;
-    return cross(b-a, c-a) > 0;
+    // equivalent to cross(b-a, c-a) > 0, but immune to rounding errors
+    return orient2d(a, b, c) > 0;
 }
 
 void ConvexHull::_construct()
@@ -215,9 +217,9 @@ bool below_x_monotonic_polyline(Point const &p, Iter first, Iter last, Lex lex)
     if (a[X] == b[X]) {
         if (above(p[Y], a[Y]) || above(b[Y], p[Y])) return false;
     } else {
-        // TODO: maybe there is a more numerically stable method
-        Coord y = lerp((p[X] - a[X]) / (b[X] - a[X]), a[Y], b[Y]);
-        if (above(p[Y], y)) return false;
+        // p is outside exactly when it lies on the right side of the segment, both for
+        // the upper hull traversed left to right and the lower hull traversed right to left
+        if (orient2d(a, b, p) < 0) return false;
     }
     return true;
 }
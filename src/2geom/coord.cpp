@@ -69,6 +69,13 @@
 #include <climits>
 #include <cstdarg>
 #include <cmath>
+#include <cfloat>
+#include <clocale>
+#include <cstdio>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #ifndef ASSERT
 #define ASSERT(condition)         \
@@ -3582,7 +3589,7 @@ double StringToDoubleConverter::StringToDouble(
 
 } // end anonymous namespace
 
-std::string format_coord_shortest(Coord x)
+char *format_coord_shortest(Coord x, char *out)
 {
     char buf[20];
     bool sign;
@@ -3593,54 +3600,191 @@ std::string format_coord_shortest(Coord x)
 
     int exponent = point - length;
 
-    std::string ret;
-    ret.reserve(32);
-
     if (sign) {
-        ret += '-';
+        *out++ = '-';
     }
 
     if (exponent == 0) {
         // return digits without any changes
-        ret += buf;
+        std::memcpy(out, buf, length);
+        out += length;
     } else if (point >= 0 && point <= length) {
         // insert decimal point
-        ret.append(buf, point);
-        ret += '.';
-        ret.append(&buf[point], length - point);
+        std::memcpy(out, buf, point);
+        out += point;
+        *out++ = '.';
+        std::memcpy(out, buf + point, length - point);
+        out += length - point;
     } else if (exponent > 0 && exponent <= 2) {
         // add trailing zeroes
-        ret += buf;
-        ret.append(exponent, '0');
+        std::memcpy(out, buf, length);
+        out += length;
+        std::memset(out, '0', exponent);
+        out += exponent;
     } else if (point >= -3 && point <= -1) {
         // add leading zeroes
-        ret += '.';
-        ret.append(-point, '0');
-        ret += buf;
+        *out++ = '.';
+        std::memset(out, '0', -point);
+        out += -point;
+        std::memcpy(out, buf, length);
+        out += length;
     } else {
         // exponential form
-        ret += buf;
-        ret += 'e';
+        std::memcpy(out, buf, length);
+        out += length;
+        *out++ = 'e';
         if (exponent < 0) {
-            ret += '-';
+            *out++ = '-';
             exponent = -exponent;
         }
 
-        /* Convert exponent by hand.
-         * Using ostringstream is ~3x slower */
-        int const buflen = 6;
+        // convert exponent by hand
+        char expdigits[4];
         int i = 0;
-        char expdigits[buflen+1];
-        expdigits[buflen] = 0;
-
-        for (; exponent && i < buflen; ++i) {
-            expdigits[buflen - 1 - i] = '0' + (exponent % 10);
+        for (; exponent; ++i) {
+            expdigits[i] = '0' + (exponent % 10);
             exponent /= 10;
         }
-        ret.append(&expdigits[buflen - i]);
+        while (i) {
+            *out++ = expdigits[--i];
+        }
     }
 
-    return ret;
+    return out;
+}
+
+std::string format_coord_shortest(Coord x)
+{
+    char buf[32];
+    char *end = format_coord_shortest(x, buf);
+    return std::string(buf, end);
+}
+
+char *format_coord_precision(Coord x, int precision, char *out)
+{
+    // the same as printf
+    if (precision == 0) {
+        precision = 1;
+    }
+
+    char buf[20];
+    bool sign = false;
+    int length = 0, point = 0;
+    bool fast = false;
+
+    if (precision <= 14 && !Double(x).IsSpecial() && (x == 0 || std::fabs(x) >= DBL_MIN)) {
+        DoubleToStringConverter::DoubleToAscii(x, DoubleToStringConverter::SHORTEST,
+            0, buf, 20, &sign, &length, &point);
+        if (length <= precision) {
+            // a short representation is also the closest number with the requested precision
+            fast = true;
+        } else {
+            /* The shortest representation is within half an ulp of x, so rounding it
+             * to the requested precision gives the correctly rounded result, unless x
+             * is very close to halfway between two numbers with that precision. */
+            uint64_t digits = 0, scale = 1;
+            for (int i = 0; i < length; ++i) {
+                digits = digits * 10 + (buf[i] - '0');
+            }
+            for (int i = precision; i < length; ++i) {
+                scale *= 10;
+            }
+            uint64_t prefix = digits / scale, tail = digits % scale, half = scale / 2;
+            uint64_t distance = tail > half ? tail - half : half - tail;
+            // bound on half an ulp of x, in units of the last digit, with a large margin
+            Coord margin = digits * 2.3e-16 + 1;
+
+            if (distance > margin) {
+                if (tail > half) {
+                    ++prefix;
+                }
+                length = 0;
+                for (uint64_t p = prefix; p != 0; p /= 10) {
+                    ++length;
+                }
+                // rounding up can add a digit, as in 9.99 -> 10.0
+                point += length - precision;
+                for (int i = length - 1; i >= 0; --i) {
+                    buf[i] = '0' + prefix % 10;
+                    prefix /= 10;
+                }
+                fast = true;
+            } else if (length != precision + 1 || buf[precision] != '5') {
+                /* Up to 15 significant digits, two different decimal numbers never round
+                 * to the same normal double. Then a value which lies exactly halfway
+                 * between two numbers with the requested precision has a shortest
+                 * representation with one more digit, ending in 5. All other values
+                 * can be rounded exactly. Ties are left to printf, since their rounding
+                 * differs. */
+                DoubleToStringConverter::DoubleToAscii(x, DoubleToStringConverter::PRECISION,
+                    precision, buf, 20, &sign, &length, &point);
+                fast = true;
+            }
+            while (fast && length > 1 && buf[length - 1] == '0') {
+                --length;
+            }
+        }
+    }
+
+    if (!fast) {
+        int n = std::sprintf(out, "%.*g", precision, x);
+        // printf uses the decimal point of the current locale
+        char const *decimal_point = std::localeconv()->decimal_point;
+        if (std::strcmp(decimal_point, ".") != 0) {
+            char *pos = std::strstr(out, decimal_point);
+            if (pos) {
+                std::size_t len = std::strlen(decimal_point);
+                *pos = '.';
+                std::memmove(pos + 1, pos + len, out + n - (pos + len));
+                n -= len - 1;
+            }
+        }
+        return out + n;
+    }
+
+    if (sign) {
+        *out++ = '-';
+    }
+
+    int exponent = point - 1;
+    if (exponent < -4 || exponent >= precision) {
+        // exponential form, with at least two digits in the exponent
+        *out++ = buf[0];
+        if (length > 1) {
+            *out++ = '.';
+            std::memcpy(out, buf + 1, length - 1);
+            out += length - 1;
+        }
+        *out++ = 'e';
+        *out++ = exponent < 0 ? '-' : '+';
+        if (exponent < 0) {
+            exponent = -exponent;
+        }
+        if (exponent >= 100) {
+            *out++ = '0' + exponent / 100;
+        }
+        *out++ = '0' + exponent / 10 % 10;
+        *out++ = '0' + exponent % 10;
+    } else if (point <= 0) {
+        *out++ = '0';
+        *out++ = '.';
+        std::memset(out, '0', -point);
+        out += -point;
+        std::memcpy(out, buf, length);
+        out += length;
+    } else if (point >= length) {
+        std::memcpy(out, buf, length);
+        out += length;
+        std::memset(out, '0', point - length);
+        out += point - length;
+    } else {
+        std::memcpy(out, buf, point);
+        out += point;
+        *out++ = '.';
+        std::memcpy(out, buf + point, length - point);
+        out += length - point;
+    }
+    return out;
 }
 
 std::string format_coord_nice(Coord x)
@@ -3665,6 +3809,181 @@ Coord parse_coord(std::string const &s)
     return conv.StringToDouble(s.c_str(), s.length(), &dummy);
 }
 
+namespace {
+
+// The fast path below relies on each double operation being rounded to double precision.
+// This does not hold when intermediate results are kept in extended precision, as on x87.
+#if (defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD < 0 || FLT_EVAL_METHOD > 1)) || \
+    (defined(__FLT_EVAL_METHOD__) && (__FLT_EVAL_METHOD__ < 0 || __FLT_EVAL_METHOD__ > 1))
+#define GEOM_NO_FAST_COORD_PARSING
+#endif
+
+#ifndef GEOM_NO_FAST_COORD_PARSING
+
+// Powers of ten which are exactly representable as doubles.
+double const exact_powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+int const max_exact_power_of_ten = 22;
+uint64_t const max_exact_integer = uint64_t(1) << 53;
+
+// Longest literal handled by the fast path.
+std::size_t const max_fast_length = 32;
+
+/* Bit i of the result is set when str[i] is a decimal digit.
+ * With SSE2, all characters are classified at once. */
+inline uint64_t digit_mask(char const *str, std::size_t len)
+{
+#if defined(__SSE2__)
+    char buf[max_fast_length];
+    std::memset(buf, 0, sizeof(buf));
+    std::memcpy(buf, str, len);
+    // Shift '0'...'9' to the bottom of the signed char range, so that a single
+    // signed comparison selects them.
+    __m128i const offset = _mm_set1_epi8(static_cast<char>(0x80 - '0'));
+    __m128i const limit = _mm_set1_epi8(static_cast<char>(0x80 + 10));
+    __m128i lo = _mm_add_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const *>(buf)), offset);
+    uint64_t mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmplt_epi8(lo, limit)));
+    if (len > 16) {
+        __m128i hi = _mm_add_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const *>(buf + 16)),
+                                  offset);
+        mask |= uint64_t(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmplt_epi8(hi, limit)))) << 16;
+    }
+    return mask;
+#else
+    uint64_t mask = 0;
+    for (std::size_t i = 0; i < len; ++i) {
+        if (static_cast<unsigned>(str[i] - '0') < 10) {
+            mask |= uint64_t(1) << i;
+        }
+    }
+    return mask;
+#endif
+}
+
+// Number of consecutive digits starting at position pos, given the mask from digit_mask().
+inline std::size_t digit_run(uint64_t mask, std::size_t pos)
+{
+    uint64_t x = ~(mask >> pos);
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    std::size_t n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+inline void accumulate_digits(char const *str, std::size_t n, uint64_t &mantissa, int &significant)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        mantissa = mantissa * 10 + (str[i] - '0');
+        if (mantissa != 0) {
+            ++significant;
+        }
+    }
+}
+
+/* Convert short decimal literals whose digits fit exactly in a double, using a single
+ * correctly rounded multiplication or division by an exact power of ten (Clinger's
+ * fast path). Returns false if the literal cannot be handled this way. */
+bool parse_coord_fast(char const *str, std::size_t len, Coord &result)
+{
+    if (len == 0 || len > max_fast_length) return false;
+
+    uint64_t const digits = digit_mask(str, len);
+    std::size_t pos = 0;
+    bool negative = false;
+    if (str[0] == '-' || str[0] == '+') {
+        negative = str[0] == '-';
+        ++pos;
+    }
+
+    uint64_t mantissa = 0;
+    int significant = 0;
+    int exponent = 0;
+
+    std::size_t n = digit_run(digits, pos);
+    std::size_t total_digits = n;
+    accumulate_digits(str + pos, n, mantissa, significant);
+    pos += n;
+
+    if (pos < len && str[pos] == '.') {
+        ++pos;
+        n = digit_run(digits, pos);
+        total_digits += n;
+        accumulate_digits(str + pos, n, mantissa, significant);
+        exponent -= static_cast<int>(n);
+        pos += n;
+    }
+    if (total_digits == 0) return false;
+
+    if (pos < len && (str[pos] == 'e' || str[pos] == 'E')) {
+        ++pos;
+        bool exp_negative = false;
+        if (pos < len && (str[pos] == '-' || str[pos] == '+')) {
+            exp_negative = str[pos] == '-';
+            ++pos;
+        }
+        n = digit_run(digits, pos);
+        if (n == 0 || n > 3) return false;
+        int e = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            e = e * 10 + (str[pos + i] - '0');
+        }
+        exponent += exp_negative ? -e : e;
+        pos += n;
+    }
+
+    // 19 digits always fit in 64 bits
+    if (pos != len || significant > 19) return false;
+
+    if (mantissa == 0) {
+        result = negative ? -0.0 : 0.0;
+        return true;
+    }
+    if (mantissa > max_exact_integer) return false;
+
+    // Move the excess of a large exponent into the mantissa, as long as it stays exact.
+    while (exponent > max_exact_power_of_ten) {
+        mantissa *= 10;
+        if (mantissa > max_exact_integer) return false;
+        --exponent;
+    }
+    if (exponent < -max_exact_power_of_ten) return false;
+
+    Coord value = static_cast<Coord>(static_cast<int64_t>(mantissa));
+    if (exponent < 0) {
+        value /= exact_powers_of_ten[-exponent];
+    } else {
+        value *= exact_powers_of_ten[exponent];
+    }
+    result = negative ? -value : value;
+    return true;
+}
+
+#endif // GEOM_NO_FAST_COORD_PARSING
+
+} // end anonymous namespace
+
+Coord parse_coord(char const *begin, char const *end)
+{
+#ifndef GEOM_NO_FAST_COORD_PARSING
+    Coord result;
+    if (parse_coord_fast(begin, end - begin, result)) {
+        return result;
+    }
+#endif
+    static StringToDoubleConverter conv(StringToDoubleConverter::NO_FLAGS,
+        0.0, nan(""), "inf", "NaN");
+    int dummy;
+    return conv.StringToDouble(begin, end - begin, &dummy);
+}
+
 } // namespace Geom
 
 /*
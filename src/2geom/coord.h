@@ -185,6 +185,26 @@ struct CoordTraits<Coord> {
  * @relates Coord */
 std::string format_coord_shortest(Coord x);
 
+/** @brief Convert coordinate to shortest possible string, writing it to a buffer.
+ * The output is the same as that of format_coord_shortest(Coord), but no memory
+ * is allocated. The string is not null-terminated.
+ * @param x Coordinate to convert
+ * @param buf Buffer with space for at least 32 characters
+ * @return Pointer to the character after the last one written
+ * @relates Coord */
+char *format_coord_shortest(Coord x, char *buf);
+
+/** @brief Convert coordinate to string with the given number of significant digits.
+ * The output is the same as that of printf's "%.*g" conversion in the C locale.
+ * Precisions up to 14 digits are handled without calling printf. The string
+ * is not null-terminated.
+ * @param x Coordinate to convert
+ * @param precision Number of significant digits
+ * @param buf Buffer with space for at least precision + 32 characters
+ * @return Pointer to the character after the last one written
+ * @relates Coord */
+char *format_coord_precision(Coord x, int precision, char *buf);
+
 /** @brief Convert coordinate to human-readable string.
  * Unlike format_coord_shortest, this function will not omit a leading zero
  * before a decimal point or use small negative exponents. The output format
@@ -198,6 +218,15 @@ std::string format_coord_nice(Coord x);
  * @relates Coord */
 Coord parse_coord(std::string const &s);
 
+/** @brief Parse a number stored in a range of characters.
+ * The range must contain only the number, written as in SVG path data,
+ * and does not need to be null-terminated. Numbers with at most 19 significant
+ * digits and small exponents, which cover almost all coordinates found in practice,
+ * are converted by a fast path; the result is always correctly rounded.
+ * @return Parsed value, or NaN if the range does not contain a valid number
+ * @relates Coord */
+Coord parse_coord(char const *begin, char const *end);
+
 } // end namespace Geom
 
 #endif // LIB2GEOM_SEEN_COORD_H
@@ -0,0 +1,286 @@
+/** @file
+ * @brief Anti-aliased coverage rasterization of paths
+ *//*
+ * Copyright 2016 authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <2geom/bezier-curve.h>
+#include <2geom/coverage-rasterizer.h>
+#include <2geom/elliptical-arc.h>
+
+namespace Geom {
+
+namespace {
+
+inline void store_coverage(float c, unsigned char &out)
+{
+    out = static_cast<unsigned char>(c * 255.0f + 0.5f);
+}
+inline void store_coverage(float c, float &out)
+{
+    out = c;
+}
+
+} // end anonymous namespace
+
+CoverageRasterizer::CoverageRasterizer(IntRect const &area, Coord tolerance)
+    : _area(area)
+    , _stride(area.width() + 2)
+    , _cells(_stride * area.height(), 0.0f)
+    , _flattener(tolerance)
+    , _in_path(false)
+{}
+
+void CoverageRasterizer::moveTo(Point const &p)
+{
+    flush();
+    _start = _current = p;
+    _in_path = true;
+}
+
+void CoverageRasterizer::lineTo(Point const &p)
+{
+    // implicit moveto after closePath()
+    if (!_in_path) {
+        moveTo(_start);
+    }
+    _addLine(_current, p);
+    _current = p;
+}
+
+void CoverageRasterizer::quadTo(Point const &c, Point const &p)
+{
+    if (!_in_path) {
+        moveTo(_start);
+    }
+    _addCurve(QuadraticBezier(_current, c, p));
+}
+
+void CoverageRasterizer::curveTo(Point const &c0, Point const &c1, Point const &p)
+{
+    if (!_in_path) {
+        moveTo(_start);
+    }
+    _addCurve(CubicBezier(_current, c0, c1, p));
+}
+
+void CoverageRasterizer::arcTo(Coord rx, Coord ry, Coord angle,
+                               bool large_arc, bool sweep, Point const &p)
+{
+    if (!_in_path) {
+        moveTo(_start);
+    }
+    _addCurve(EllipticalArc(_current, rx, ry, angle, large_arc, sweep, p));
+}
+
+void CoverageRasterizer::closePath()
+{
+    if (_in_path) {
+        _addLine(_current, _start);
+        _current = _start;
+        _in_path = false;
+    }
+}
+
+void CoverageRasterizer::flush()
+{
+    closePath();
+}
+
+void CoverageRasterizer::reset()
+{
+    std::fill(_cells.begin(), _cells.end(), 0.0f);
+    _in_path = false;
+}
+
+void CoverageRasterizer::render(unsigned char *buffer, std::size_t stride, FillRule rule)
+{
+    _render(buffer, stride, rule);
+}
+
+void CoverageRasterizer::render(float *buffer, std::size_t stride, FillRule rule)
+{
+    _render(buffer, stride, rule);
+}
+
+template <typename T>
+void CoverageRasterizer::_render(T *buffer, std::size_t stride, FillRule rule)
+{
+    flush();
+
+    IntCoord w = _area.width(), h = _area.height();
+    for (IntCoord y = 0; y < h; ++y) {
+        float const *row = &_cells[y * _stride];
+        T *out = buffer + y * stride;
+        float acc = 0;
+        if (rule == FILL_NONZERO) {
+            for (IntCoord x = 0; x < w; ++x) {
+                acc += row[x];
+                store_coverage(std::min(std::fabs(acc), 1.0f), out[x]);
+            }
+        } else {
+            for (IntCoord x = 0; x < w; ++x) {
+                acc += row[x];
+                float c = std::fmod(std::fabs(acc), 2.0f);
+                store_coverage(c > 1.0f ? 2.0f - c : c, out[x]);
+            }
+        }
+    }
+}
+
+void CoverageRasterizer::_addCurve(Curve const &c)
+{
+    _points.clear();
+    _flattener.flatten(c, _points);
+    for (std::size_t i = 0; i < _points.size(); ++i) {
+        _addLine(_current, _points[i]);
+        _current = _points[i];
+    }
+}
+
+/* Add a line segment given in user coordinates. The segment is translated to the pixel grid
+ * and split at the left and right edges of the area. The parts to the left of the area are
+ * moved onto its left edge, where they still affect the coverage of whole scanlines;
+ * the parts to the right cannot affect any pixel and are dropped. */
+void CoverageRasterizer::_addLine(Point const &a, Point const &b)
+{
+    Point origin(_area.min());
+    Point p0 = a - origin, p1 = b - origin;
+    Coord h = _area.height(), w = _area.width();
+
+    if (p0[Y] == p1[Y]) return;
+    if (std::max(p0[Y], p1[Y]) <= 0 || std::min(p0[Y], p1[Y]) >= h) return;
+    if (std::min(p0[X], p1[X]) >= w) return;
+
+    if (p0[X] > p1[X]) {
+        std::swap(p0, p1);
+    }
+    Coord edges[2] = { 0, w };
+    Point parts[4];
+    unsigned np = 0;
+    parts[np++] = p0;
+    for (unsigned i = 0; i < 2; ++i) {
+        if (p0[X] < edges[i] && edges[i] < p1[X]) {
+            Coord t = (edges[i] - p0[X]) / (p1[X] - p0[X]);
+            parts[np++] = Point(edges[i], lerp(t, p0[Y], p1[Y]));
+        }
+    }
+    parts[np++] = p1;
+
+    for (unsigned i = 0; i + 1 < np; ++i) {
+        Point q0 = parts[i], q1 = parts[i+1];
+        if (q0[X] >= w) break;
+        q0[X] = std::max(q0[X], 0.0);
+        q1[X] = std::max(q1[X], 0.0);
+        // restore the original direction
+        if (a[X] > b[X]) {
+            _accumulate(q1, q0);
+        } else {
+            _accumulate(q0, q1);
+        }
+    }
+}
+
+/* Accumulate the signed area of a line segment within the pixel grid into the cells.
+ * The X coordinates must be between 0 and the width of the area. For each scanline,
+ * the cell containing the segment gets its signed coverage, and the cell to its right
+ * gets the remainder, so that the running sum of the cells is the coverage of the pixels.
+ * Segments spanning several cells in one scanline distribute the area trapezoid-wise. */
+void CoverageRasterizer::_accumulate(Point const &a, Point const &b)
+{
+    if (a[Y] == b[Y]) return;
+
+    Coord dir = 1;
+    Point p0 = a, p1 = b;
+    if (p0[Y] > p1[Y]) {
+        std::swap(p0, p1);
+        dir = -1;
+    }
+
+    Coord dxdy = (p1[X] - p0[X]) / (p1[Y] - p0[Y]);
+    Coord x = p0[X];
+    if (p0[Y] < 0) {
+        x -= p0[Y] * dxdy;
+    }
+    Coord w = _area.width();
+    IntCoord ystart = static_cast<IntCoord>(std::max(std::floor(p0[Y]), 0.0));
+    IntCoord yend = static_cast<IntCoord>(std::min(std::ceil(p1[Y]), Coord(_area.height())));
+
+    for (IntCoord y = ystart; y < yend; ++y) {
+        float *row = &_cells[y * _stride];
+        Coord dy = std::min(Coord(y + 1), p1[Y]) - std::max(Coord(y), p0[Y]);
+        Coord xnext = x + dxdy * dy;
+        Coord d = dy * dir;
+        // clamp to the area, in case rounding errors pushed the ends outside
+        Coord x0 = std::max(std::min(x, xnext), 0.0);
+        Coord x1 = std::min(std::max(x, xnext), w);
+        Coord x0floor = std::floor(x0), x1ceil = std::ceil(x1);
+        IntCoord x0i = static_cast<IntCoord>(x0floor), x1i = static_cast<IntCoord>(x1ceil);
+
+        if (x1i <= x0i + 1) {
+            // the segment stays within one pixel
+            Coord xmf = 0.5 * (x0 + x1) - x0floor;
+            row[x0i] += d - d * xmf;
+            row[x0i + 1] += d * xmf;
+        } else {
+            Coord s = 1 / (x1 - x0);
+            Coord x0f = x0 - x0floor;
+            Coord a0 = 0.5 * s * (1 - x0f) * (1 - x0f);
+            Coord x1f = x1 - x1ceil + 1;
+            Coord am = 0.5 * s * x1f * x1f;
+            row[x0i] += d * a0;
+            if (x1i == x0i + 2) {
+                row[x0i + 1] += d * (1 - a0 - am);
+            } else {
+                Coord a1 = s * (1.5 - x0f);
+                row[x0i + 1] += d * (a1 - a0);
+                for (IntCoord xi = x0i + 2; xi < x1i - 1; ++xi) {
+                    row[xi] += d * s;
+                }
+                Coord a2 = a1 + (x1i - x0i - 3) * s;
+                row[x1i - 1] += d * (1 - a2 - am);
+            }
+            row[x1i] += d * am;
+        }
+        x = xnext;
+    }
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
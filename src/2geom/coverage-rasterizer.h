@@ -0,0 +1,128 @@
+/** @file
+ * @brief Anti-aliased coverage rasterization of paths
+ *//*
+ * Copyright 2016 authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#ifndef LIB2GEOM_SEEN_COVERAGE_RASTERIZER_H
+#define LIB2GEOM_SEEN_COVERAGE_RASTERIZER_H
+
+#include <vector>
+#include <2geom/int-rect.h>
+#include <2geom/path-flattener.h>
+#include <2geom/path-sink.h>
+#include <2geom/pathvector.h>
+
+namespace Geom {
+
+/** @brief Rasterize paths into anti-aliased coverage masks.
+ *
+ * This path sink computes, for each pixel of a given area, the fraction of the pixel
+ * covered by the fed paths. It does not depend on any graphics library, so it can be used
+ * to render paths in headless programs and tests, for example:
+ * @code
+   CoverageRasterizer r(IntRect(0, 0, width, height));
+   r.feed(pv);
+   std::vector<unsigned char> mask(width * height);
+   r.render(&mask[0], width, FILL_EVENODD);
+   @endcode
+ *
+ * Curves are flattened into line segments with the given tolerance using PathFlattener. The signed area of each
+ * line segment is accumulated into a buffer of cells, so that the coverage of a scanline
+ * is the running sum of its cells. This yields exact coverage for pixels crossed by a single
+ * edge; pixels crossed by several edges are approximated by the sum of their contributions.
+ * Open subpaths are implicitly closed, as when filling.
+ *
+ * The pixel with coordinates (x, y) spans the unit square whose top left corner is (x, y).
+ *
+ * @ingroup Paths */
+class CoverageRasterizer
+    : public PathSink
+{
+public:
+    /** @brief Create a rasterizer for the given pixel area.
+     * @param area Pixels to compute coverage for
+     * @param tolerance Maximum distance between a curve and its flattening, in pixels */
+    explicit CoverageRasterizer(IntRect const &area, Coord tolerance = 0.1);
+
+    void moveTo(Point const &p);
+    void lineTo(Point const &p);
+    void curveTo(Point const &c0, Point const &c1, Point const &p);
+    void quadTo(Point const &c, Point const &p);
+    void arcTo(Coord rx, Coord ry, Coord angle,
+               bool large_arc, bool sweep, Point const &p);
+    void closePath();
+    void flush();
+
+    using PathSink::feed;
+
+    IntRect const &area() const { return _area; }
+    Coord tolerance() const { return _flattener.tolerance(); }
+    void setTolerance(Coord tolerance) { _flattener.setTolerance(tolerance); }
+
+    /// Discard all paths fed so far.
+    void reset();
+
+    /** @brief Write the coverage of each pixel as an 8-bit value.
+     * The current subpath is finished first.
+     * @param buffer Destination with at least area().height() rows of area().width() pixels
+     * @param stride Distance between the starts of consecutive rows, in pixels
+     * @param rule Rule determining which regions are inside */
+    void render(unsigned char *buffer, std::size_t stride, FillRule rule = FILL_NONZERO);
+    /** @brief Write the coverage of each pixel as a value between 0 and 1.
+     * @see render(unsigned char *, std::size_t, FillRule) */
+    void render(float *buffer, std::size_t stride, FillRule rule = FILL_NONZERO);
+
+private:
+    template <typename T>
+    void _render(T *buffer, std::size_t stride, FillRule rule);
+    void _addLine(Point const &a, Point const &b);
+    void _accumulate(Point const &a, Point const &b);
+    void _addCurve(Curve const &c);
+
+    IntRect _area;
+    std::size_t _stride;
+    std::vector<float> _cells; ///< Signed area deltas, _stride cells per row
+    std::vector<Point> _points; ///< Reused storage for flattened curves
+    PathFlattener _flattener;
+    Point _start, _current;
+    bool _in_path;
+};
+
+} // end namespace Geom
+
+#endif // LIB2GEOM_SEEN_COVERAGE_RASTERIZER_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -102,6 +102,12 @@ std::vector<CurveIntersection> Curve::intersect(Curve const &/*other*/, Coord /*
     THROW_NOTIMPLEMENTED();
 }
 
+void Curve::intersect(Curve const &other, std::vector<CurveIntersection> &out, Coord eps) const
+{
+    std::vector<CurveIntersection> xs = intersect(other, eps);
+    out.insert(out.end(), xs.begin(), xs.end());
+}
+
 std::vector<CurveIntersection> Curve::intersectSelf(Coord eps) const
 {
     std::vector<CurveIntersection> result;
@@ -124,6 +130,7 @@ std::vector<CurveIntersection> Curve::intersectSelf(Coord eps) const
         previous = splits[i];
     }
 
+    std::vector<CurveIntersection> xs;
     Coord prev_i = 0;
     for (unsigned i = 0; i < parts.size()-1; ++i) {
         Interval dom_i(prev_i, splits[i]);
@@ -134,7 +141,8 @@ std::vector<CurveIntersection> Curve::intersectSelf(Coord eps) const
             Interval dom_j(prev_j, splits[j]);
             prev_j = splits[j];
 
-            std::vector<CurveIntersection> xs = parts[i].intersect(parts[j], eps);
+            xs.clear();
+            parts[i].intersect(parts[j], xs, eps);
             for (unsigned k = 0; k < xs.size(); ++k) {
                 // to avoid duplicated intersections, skip values at exactly 1
                 if (xs[k].first == 1. || xs[k].second == 1.) continue;
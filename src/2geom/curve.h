@@ -304,6 +304,14 @@ public:
     /// Compute intersections with another curve.
     virtual std::vector<CurveIntersection> intersect(Curve const &other, Coord eps = EPSILON) const;
 
+    /** @brief Append intersections with another curve to a vector.
+     * Existing elements of @a out are kept, so a single vector can collect the intersections
+     * of many curve pairs without being reallocated for each of them. The default
+     * implementation appends the result of intersect(Curve const &, Coord); the built-in
+     * curve types override both methods and write directly to @a out. */
+    virtual void intersect(Curve const &other, std::vector<CurveIntersection> &out,
+                           Coord eps = EPSILON) const;
+
     /// Compute intersections of this curve with itself.
     virtual std::vector<CurveIntersection> intersectSelf(Coord eps = EPSILON) const;
 
@@ -583,10 +583,19 @@ void EllipticalArc::_filterIntersections(std::vector<ShapeIntersection> &xs, boo
 }
 
 std::vector<CurveIntersection> EllipticalArc::intersect(Curve const &other, Coord eps) const
+{
+    std::vector<CurveIntersection> result;
+    intersect(other, result, eps);
+    return result;
+}
+
+void EllipticalArc::intersect(Curve const &other, std::vector<CurveIntersection> &out,
+                              Coord eps) const
 {
     if (isLineSegment()) {
         LineSegment ls(_initial_point, _final_point);
-        return ls.intersect(other, eps);
+        ls.intersect(other, out, eps);
+        return;
     }
 
     std::vector<CurveIntersection> result;
@@ -595,28 +604,21 @@ std::vector<CurveIntersection> EllipticalArc::intersect(Curve const &other, Coor
         LineSegment ls(other.initialPoint(), other.finalPoint());
         result = _ellipse.intersect(ls);
         _filterIntersections(result, true);
-        return result;
-    }
-
-    BezierCurve const *bez = dynamic_cast<BezierCurve const *>(&other);
-    if (bez) {
+    } else if (BezierCurve const *bez = dynamic_cast<BezierCurve const *>(&other)) {
         result = _ellipse.intersect(bez->fragment());
         _filterIntersections(result, true);
-        return result;
-    }
-
-    EllipticalArc const *arc = dynamic_cast<EllipticalArc const *>(&other);
-    if (arc) {
+    } else if (EllipticalArc const *arc = dynamic_cast<EllipticalArc const *>(&other)) {
         result = _ellipse.intersect(arc->_ellipse);
         _filterIntersections(result, true);
         arc->_filterIntersections(result, false);
-        return result;
+    } else {
+        // in case someone wants to make a custom curve type
+        std::size_t start = out.size();
+        other.intersect(*this, out, eps);
+        transpose_in_place(out, start);
+        return;
     }
-
-    // in case someone wants to make a custom curve type
-    result = other.intersect(*this, eps);
-    transpose_in_place(result);
-    return result;
+    out.insert(out.end(), result.begin(), result.end());
 }
 
 
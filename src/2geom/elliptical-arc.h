@@ -285,6 +285,8 @@ public:
     }
 #endif
     virtual std::vector<CurveIntersection> intersect(Curve const &other, Coord eps=EPSILON) const;
+    virtual void intersect(Curve const &other, std::vector<CurveIntersection> &out,
+                           Coord eps=EPSILON) const;
     virtual int degreesOfFreedom() const { return 7; }
     virtual Curve *derivative() const;
 
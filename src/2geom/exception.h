@@ -127,6 +127,10 @@ struct SVGPathParseError : public std::exception {
     char const *what() const throw() { return "parse error"; }
 };
 
+struct BinaryPathFormatError : public std::exception {
+    char const *what() const throw() { return "invalid binary path data"; }
+};
+
 
 } // namespace Geom
 
@@ -81,6 +81,8 @@ class EllipticalArc;
 // paths and path sequences
 class Path;
 class PathVector;
+class PackedPathVector;
+class MonotoneDecomposition;
 struct PathTime;
 class PathInterval;
 struct PathVectorTime;
@@ -108,6 +110,7 @@ template <typename> class D2;
 template <typename> class Piecewise;
 
 // misc
+class MonotonicArena;
 class SVGPathSink;
 template <typename> class SVGPathGenerator;
 
@@ -32,14 +32,34 @@
  */
 
 #include <2geom/intersection-graph.h>
+#include <2geom/exception.h>
+#include <2geom/parallel.h>
 #include <2geom/path.h>
 #include <2geom/pathvector.h>
+#include <2geom/polygon-intersection-graph.h>
 #include <2geom/utils.h>
+#include <algorithm>
 #include <iostream>
 #include <iterator>
 
 namespace Geom {
 
+namespace {
+
+struct WindingTask : public ParallelTask {
+    WindingTask(PackedPathVector const &pv, Point const *points, int *out)
+        : _pv(pv), _points(points), _out(out)
+    {}
+    void run(std::size_t i) {
+        _out[i] = _pv.winding(_points[i]);
+    }
+    PackedPathVector const &_pv;
+    Point const *_points;
+    int *_out;
+};
+
+} // end anonymous namespace
+
 struct PathIntersectionGraph::IntersectionVertexLess {
     bool operator()(IntersectionVertex const &a, IntersectionVertex const &b) const {
         return a.pos < b.pos;
@@ -53,76 +73,218 @@ struct PathIntersectionGraph::IntersectionVertexLess {
  * with improvements inspired by Foster and Overfelt as well as some
  * original contributions.
  *
+ * The intersection vertices and other data of the graph are allocated from a monotonic
+ * arena. By default the graph has its own arena, which is released together with it.
+ * A caller performing many operations can instead supply an arena which it resets
+ * between them, so that the memory is reused. Such an arena must outlive the graph,
+ * and it accumulates the data of every rebuild done by replacePaths().
+ *
  * @ingroup Paths
  */
 
-PathIntersectionGraph::PathIntersectionGraph(PathVector const &a, PathVector const &b, Coord precision)
-    : _graph_valid(true)
+PathIntersectionGraph::PathIntersectionGraph(PathVector const &a, PathVector const &b,
+                                             Coord precision, MonotonicArena *arena)
+    : _arena(arena ? arena : &_own_arena)
+    , _precision(precision)
+    , _graph_valid(true)
 {
     if (a.empty() || b.empty()) return;
 
     _pv[0] = a;
     _pv[1] = b;
 
-    _prepareArguments();
-    bool has_intersections = _prepareIntersectionLists(precision);
-    if (!has_intersections) return;
-
-    _assignEdgeWindingParities(precision);
-    _assignComponentStatusFromDegenerateIntersections();
-    _removeDegenerateIntersections();
-    if (_graph_valid) {
-        _verify();
+    for (int w = 0; w < 2; ++w) {
+        for (std::size_t i = 0; i < _pv[w].size(); ++i) {
+            _preparePath(_pv[w][i]);
+        }
+        _packed[w].insert(_pv[w]);
+        _cache[w].resize(_pv[w].size());
     }
+    _pv[0].intersect(_pv[1], _crossings, precision);
+    _buildGraph();
 }
 
-void PathIntersectionGraph::_prepareArguments()
+/** @brief Replace some paths of one operand and update the graph.
+ *
+ * This is much faster than constructing a new graph when only a small part of the operands
+ * changes, for example when the user drags a few shapes in an editor. Intersections
+ * are computed only for the new paths, and winding numbers only for the edges of paths
+ * whose intersections changed. The inside / outside flags of the remaining edges
+ * of the other operand are updated using the winding numbers of the old and new paths.
+ * The result is the same as for a graph constructed from the modified operands.
+ *
+ * @param which 0 to replace paths of the first operand, 1 for the second one
+ * @param indices Distinct indices of the replaced paths in the operand
+ * @param paths New paths, in the same order as the indices */
+void PathIntersectionGraph::replacePaths(unsigned which, std::vector<std::size_t> const &indices,
+                                         PathVector const &paths)
 {
-    // all paths must be closed, otherwise we will miss some intersections
-    for (int w = 0; w < 2; ++w) {
-        for (std::size_t i = 0; i < _pv[w].size(); ++i) {
-            _pv[w][i].close();
+    if (which > 1 || indices.size() != paths.size()) {
+        THROW_RANGEERROR("Invalid arguments to PathIntersectionGraph::replacePaths");
+    }
+    unsigned w = which;
+    unsigned ow = (w+1) % 2;
+
+    std::vector<bool> replaced(_pv[w].size(), false);
+    PathVector old_paths, new_paths;
+    for (std::size_t k = 0; k < indices.size(); ++k) {
+        std::size_t i = indices[k];
+        if (i >= _pv[w].size() || replaced[i]) {
+            THROW_RANGEERROR("Invalid path index in PathIntersectionGraph::replacePaths");
         }
+        replaced[i] = true;
+        old_paths.push_back(_pv[w][i]);
+        new_paths.push_back(paths[k]);
+        _preparePath(new_paths.back());
     }
-    // remove degenerate segments
-    for (int w = 0; w < 2; ++w) {
-        for (std::size_t i = _pv[w].size(); i > 0; --i) {
-            if (_pv[w][i-1].empty()) {
-                _pv[w].erase(_pv[w].begin() + (i-1));
-            }
-            for (std::size_t j = _pv[w][i-1].size(); j > 0; --j) {
-                if (_pv[w][i-1][j-1].isDegenerate()) {
-                    _pv[w][i-1].erase(_pv[w][i-1].begin() + (j-1));
+    if (indices.empty()) return;
+
+    // Drop the intersections of the replaced paths. The paths of the other operand
+    // which they intersected get different edges.
+    std::vector<PVIntersection> crossings;
+    crossings.reserve(_crossings.size());
+    for (std::size_t k = 0; k < _crossings.size(); ++k) {
+        PVIntersection const &x = _crossings[k];
+        if (replaced[(w == 0 ? x.first : x.second).path_index]) {
+            _cache[ow][(w == 0 ? x.second : x.first).path_index].dirty = true;
+        } else {
+            crossings.push_back(x);
+        }
+    }
+
+    for (std::size_t k = 0; k < indices.size(); ++k) {
+        _pv[w][indices[k]] = new_paths[k];
+        _cache[w][indices[k]] = PathCache();
+    }
+    _packed[w].clear();
+    _packed[w].insert(_pv[w]);
+
+    // intersect the new paths with the paths of the other operand near them
+    OptRect new_bounds = new_paths.boundsFast();
+    PathVector nearby;
+    std::vector<std::size_t> nearby_index;
+    for (std::size_t j = 0; new_bounds && j < _pv[ow].size(); ++j) {
+        if (new_bounds->intersects(_pv[ow][j].boundsFast())) {
+            nearby.push_back(_pv[ow][j]);
+            nearby_index.push_back(j);
+        }
+    }
+    std::size_t kept = crossings.size();
+    if (w == 0) {
+        new_paths.intersect(nearby, crossings, _precision);
+    } else {
+        nearby.intersect(new_paths, crossings, _precision);
+    }
+    for (std::size_t k = kept; k < crossings.size(); ++k) {
+        PathVectorTime &pos = w == 0 ? crossings[k].first : crossings[k].second;
+        PathVectorTime &opos = w == 0 ? crossings[k].second : crossings[k].first;
+        pos.path_index = indices[pos.path_index];
+        opos.path_index = nearby_index[opos.path_index];
+        _cache[ow][opos.path_index].dirty = true;
+    }
+    std::sort(crossings.begin() + kept, crossings.end());
+    std::inplace_merge(crossings.begin(), crossings.begin() + kept, crossings.end());
+    _crossings.swap(crossings);
+
+    // The winding numbers with respect to the modified operand change by the difference
+    // between the winding numbers of the new and old paths, so an edge of the other
+    // operand changes its inside / outside status when that difference is odd.
+    PackedPathVector changed(old_paths);
+    changed.insert(new_paths);
+    OptRect changed_bounds = old_paths.boundsFast() | new_bounds;
+    for (std::size_t j = 0; changed_bounds && j < _cache[ow].size(); ++j) {
+        PathCache &pc = _cache[ow][j];
+        if (!pc.dirty) {
+            for (std::size_t k = 0; k < pc.winding_points.size(); ++k) {
+                Point const &p = pc.winding_points[k];
+                if (changed_bounds->contains(p) && changed.winding(p) % 2) {
+                    pc.inside[k] = !pc.inside[k];
                 }
             }
         }
+        if (pc.initial_inside >= 0) {
+            Point p = _pv[ow][j].initialPoint();
+            if (changed_bounds->contains(p) && changed.winding(p) % 2) {
+                pc.initial_inside = !pc.initial_inside;
+            }
+        }
     }
+
+    _buildGraph();
 }
 
-bool PathIntersectionGraph::_prepareIntersectionLists(Coord precision)
+PathIntersectionGraph::~PathIntersectionGraph()
 {
-    std::vector<PVIntersection> pxs = _pv[0].intersect(_pv[1], precision);
-    // NOTE: this early return means that the path data structures will not be created
-    // if there are no intersections at all!
-    if (pxs.empty()) return false;
+    _clearGraph();
+}
 
+void PathIntersectionGraph::_preparePath(Path &path)
+{
+    // all paths must be closed, otherwise we will miss some intersections
+    path.close();
+    // remove degenerate segments
+    for (std::size_t j = path.size(); j > 0; --j) {
+        if (path[j-1].isDegenerate()) {
+            path.erase(path.begin() + (j-1));
+        }
+    }
+}
+
+void PathIntersectionGraph::_clearGraph()
+{
+    _ulist.clear();
+    // the paths are destroyed first, so that the vertices are no longer linked
+    for (unsigned w = 0; w < 2; ++w) {
+        for (std::size_t i = 0; i < _components[w].size(); ++i) {
+            arena_delete(_arena, &_components[w][i]);
+        }
+        _components[w].clear();
+    }
+    for (std::size_t i = 0; i < _xs.size(); ++i) {
+        arena_delete(_arena, &_xs[i]);
+    }
+    _xs.clear();
+    if (_arena == &_own_arena) {
+        _own_arena.reset();
+    }
+}
+
+void PathIntersectionGraph::_buildGraph()
+{
+    _clearGraph();
+    _winding_points.clear();
+    _graph_valid = true;
+
+    _prepareIntersectionLists();
+    _assignEdgeWindingParities();
+    _assignComponentStatusFromDegenerateIntersections();
+    _removeDegenerateIntersections();
+    if (_graph_valid) {
+        _verify();
+    }
+}
+
+void PathIntersectionGraph::_prepareIntersectionLists()
+{
     // prepare intersection lists for each path component
     for (unsigned w = 0; w < 2; ++w) {
+        _components[w].reserve(_pv[w].size());
         for (std::size_t i = 0; i < _pv[w].size(); ++i) {
-            _components[w].push_back(new PathData(w, i));
+            _components[w].push_back(arena_new<PathData>(_arena, w, i));
         }
     }
 
     // create intersection vertices
-    for (std::size_t i = 0; i < pxs.size(); ++i) {
+    _xs.reserve(2 * _crossings.size());
+    for (std::size_t i = 0; i < _crossings.size(); ++i) {
         IntersectionVertex *xa, *xb;
-        xa = new IntersectionVertex();
-        xb = new IntersectionVertex();
+        xa = arena_new<IntersectionVertex>(_arena);
+        xb = arena_new<IntersectionVertex>(_arena);
         //xa->processed = xb->processed = false;
         xa->which = 0; xb->which = 1;
-        xa->pos = pxs[i].first;
-        xb->pos = pxs[i].second;
-        xa->p = xb->p = pxs[i].point();
+        xa->pos = _crossings[i].first;
+        xb->pos = _crossings[i].second;
+        xa->p = xb->p = _crossings[i].point();
         xa->neighbor = xb;
         xb->neighbor = xa;
         xa->next_edge = xb->next_edge = OUTSIDE;
@@ -139,34 +301,55 @@ bool PathIntersectionGraph::_prepareIntersectionLists(Coord precision)
             _components[w][i].xlist.sort(IntersectionVertexLess());
         }
     }
-
-    return true;
 }
 
-void PathIntersectionGraph::_assignEdgeWindingParities(Coord precision)
+void PathIntersectionGraph::_assignEdgeWindingParities()
 {
     // determine the winding numbers of path portions between intersections
     for (unsigned w = 0; w < 2; ++w) {
         unsigned ow = (w+1) % 2;
+        std::vector<Point, ArenaAllocator<Point> > points(_arena);
 
+        // only the edges of paths with changed intersections need new winding numbers
         for (unsigned li = 0; li < _components[w].size(); ++li) {
+            PathCache &pc = _cache[w][li];
+            if (!pc.dirty) continue;
+            pc.winding_points.clear();
             IntersectionList &xl = _components[w][li].xlist;
             for (ILIter i = xl.begin(); i != xl.end(); ++i) {
                 ILIter n = cyclic_next(i, xl);
-                std::size_t pi = i->pos.path_index;
+                PathInterval ival = forward_interval(i->pos, n->pos, _pv[w][li].size());
+                PathTime mid = ival.inside(_precision);
+                pc.winding_points.push_back(_pv[w][li].pointAt(mid));
+            }
+            points.insert(points.end(), pc.winding_points.begin(), pc.winding_points.end());
+        }
 
-                PathInterval ival = forward_interval(i->pos, n->pos, _pv[w][pi].size());
-                PathTime mid = ival.inside(precision);
+        // the winding queries are independent, so they can be run in parallel
+        std::vector<int, ArenaAllocator<int> > windings(points.size(), 0, _arena);
+        if (!points.empty()) {
+            WindingTask task(_packed[ow], &points[0], &windings[0]);
+            parallel_run(task, windings.size());
+        }
 
-                Point wpoint = _pv[w][pi].pointAt(mid);
-                _winding_points.push_back(wpoint);
-                int wdg = _pv[ow].winding(wpoint);
-                if (wdg % 2) {
-                    i->next_edge = INSIDE;
-                } else {
-                    i->next_edge = OUTSIDE;
+        std::size_t k = 0;
+        for (unsigned li = 0; li < _components[w].size(); ++li) {
+            PathCache &pc = _cache[w][li];
+            if (pc.dirty) {
+                pc.inside.resize(pc.winding_points.size());
+                for (std::size_t j = 0; j < pc.inside.size(); ++j, ++k) {
+                    pc.inside[j] = windings[k] % 2 != 0;
                 }
+                pc.dirty = false;
+            }
+
+            IntersectionList &xl = _components[w][li].xlist;
+            std::size_t j = 0;
+            for (ILIter i = xl.begin(); i != xl.end(); ++i, ++j) {
+                i->next_edge = pc.inside[j] ? INSIDE : OUTSIDE;
             }
+            _winding_points.insert(_winding_points.end(),
+                                   pc.winding_points.begin(), pc.winding_points.end());
         }
     }
 }
@@ -313,7 +496,7 @@ std::vector<Point> PathIntersectionGraph::intersectionPoints(bool defective) con
 
 void PathIntersectionGraph::fragments(PathVector &in, PathVector &out) const
 {
-    typedef boost::ptr_vector<PathData>::const_iterator PIter;
+    typedef PathDataList::const_iterator PIter;
     for (unsigned w = 0; w < 2; ++w) {
         for (PIter li = _components[w].begin(); li != _components[w].end(); ++li) {
             for (CILIter k = li->xlist.begin(); k != li->xlist.end(); ++k) {
@@ -335,7 +518,7 @@ void PathIntersectionGraph::fragments(PathVector &in, PathVector &out) const
 
 PathVector PathIntersectionGraph::_getResult(bool enter_a, bool enter_b)
 {
-    typedef boost::ptr_vector<PathData>::iterator PIter;
+    typedef PathDataList::iterator PIter;
     PathVector result;
     if (_xs.empty()) return result;
 
@@ -430,20 +613,23 @@ void PathIntersectionGraph::_handleNonintersectingPaths(PathVector &result, unsi
     unsigned ow = (w+1) % 2;
 
     for (std::size_t i = 0; i < _pv[w].size(); ++i) {
-        // the path data vector might have been left empty if there were no intersections at all
-        bool has_path_data = !_components[w].empty();
-        // Skip if the path has intersections
-        if (has_path_data && !_components[w][i].xlist.empty()) continue;
+        // Skip if the path has intersections or contains only degenerate segments
+        if (!_components[w][i].xlist.empty() || _pv[w][i].empty()) continue;
         bool path_inside = false;
 
         // Use the in/out determination from constructor, if available
-        if (has_path_data && _components[w][i].status == INSIDE) {
+        if (_components[w][i].status == INSIDE) {
             path_inside = true;
-        } else if (has_path_data && _components[w][i].status == OUTSIDE) {
+        } else if (_components[w][i].status == OUTSIDE) {
             path_inside = false;
         } else {
-            int wdg = _pv[ow].winding(_pv[w][i].initialPoint());
-            path_inside = wdg % 2 != 0;
+            // the result is kept, since it is only invalidated by changes of the other operand
+            PathCache &pc = _cache[w][i];
+            if (pc.initial_inside < 0) {
+                int wdg = _packed[ow].winding(_pv[w][i].initialPoint());
+                pc.initial_inside = wdg % 2 != 0;
+            }
+            path_inside = pc.initial_inside;
         }
 
         if (path_inside == inside) {
@@ -479,6 +665,30 @@ std::ostream &operator<<(std::ostream &os, PathIntersectionGraph const &pig)
     return os;
 }
 
+PathVector boolean_operation(PathVector const &a, PathVector const &b, BooleanOp op,
+                             Coord precision, MonotonicArena *arena)
+{
+    if (PolygonIntersectionGraph::isPolygonal(a) && PolygonIntersectionGraph::isPolygonal(b)) {
+        PolygonIntersectionGraph pig(a, b, arena);
+        switch (op) {
+        case BOOLEAN_UNION: return pig.getUnion();
+        case BOOLEAN_INTERSECTION: return pig.getIntersection();
+        case BOOLEAN_A_MINUS_B: return pig.getAminusB();
+        case BOOLEAN_B_MINUS_A: return pig.getBminusA();
+        default: return pig.getXOR();
+        }
+    }
+
+    PathIntersectionGraph pig(a, b, precision, arena);
+    switch (op) {
+    case BOOLEAN_UNION: return pig.getUnion();
+    case BOOLEAN_INTERSECTION: return pig.getIntersection();
+    case BOOLEAN_A_MINUS_B: return pig.getAminusB();
+    case BOOLEAN_B_MINUS_A: return pig.getBminusA();
+    default: return pig.getXOR();
+    }
+}
+
 } // namespace Geom
 
 /*
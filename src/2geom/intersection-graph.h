@@ -38,17 +38,28 @@
 #include <vector>
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <boost/intrusive/list.hpp>
+#include <2geom/arena.h>
 #include <2geom/forward.h>
 #include <2geom/pathvector.h>
+#include <2geom/packed-pathvector.h>
 
 namespace Geom {
 
 class PathIntersectionGraph
 {
     // this is called PathIntersectionGraph so that we can also have a class for polygons,
-    // e.g. PolygonIntersectionGraph, which is going to be significantly faster
+    // PolygonIntersectionGraph, which is significantly faster; see boolean_operation()
 public:
-    PathIntersectionGraph(PathVector const &a, PathVector const &b, Coord precision = EPSILON);
+    PathIntersectionGraph(PathVector const &a, PathVector const &b, Coord precision = EPSILON,
+                          MonotonicArena *arena = NULL);
+    ~PathIntersectionGraph();
+
+    void replacePaths(unsigned which, std::vector<std::size_t> const &indices,
+                      PathVector const &paths);
+    /// Replace a single path of one operand and update the graph.
+    void replacePath(unsigned which, std::size_t index, Path const &path) {
+        replacePaths(which, std::vector<std::size_t>(1, index), PathVector(path));
+    }
 
     PathVector getUnion();
     PathVector getIntersection();
@@ -114,15 +125,32 @@ private:
         {}
     };
 
+    /* Values kept between updates of the graph for each path. The edges of a path
+     * are its portions between consecutive intersections, in the order of the sorted
+     * intersection list. */
+    struct PathCache {
+        std::vector<Point> winding_points; ///< Point in the interior of each edge
+        std::vector<bool> inside;          ///< Whether each edge is inside the other operand
+        int initial_inside;                ///< Same for the initial point; -1 if not known yet
+        bool dirty;                        ///< Whether the edges must be recomputed
+
+        PathCache() : initial_inside(-1), dirty(true) {}
+    };
+
     struct IntersectionVertexLess;
     typedef IntersectionList::iterator ILIter;
     typedef IntersectionList::const_iterator CILIter;
+    // the objects are owned by the graph and allocated from _arena
+    typedef boost::ptr_vector<IntersectionVertex, boost::view_clone_allocator> VertexList;
+    typedef boost::ptr_vector<PathData, boost::view_clone_allocator> PathDataList;
 
     PathVector _getResult(bool enter_a, bool enter_b);
     void _handleNonintersectingPaths(PathVector &result, unsigned which, bool inside);
-    void _prepareArguments();
-    bool _prepareIntersectionLists(Coord precision);
-    void _assignEdgeWindingParities(Coord precision);
+    static void _preparePath(Path &path);
+    void _buildGraph();
+    void _clearGraph();
+    void _prepareIntersectionLists();
+    void _assignEdgeWindingParities();
     void _assignComponentStatusFromDegenerateIntersections();
     void _removeDegenerateIntersections();
     void _verify();
@@ -131,9 +159,15 @@ private:
     PathData &_getPathData(ILIter iter);
 
     PathVector _pv[2];
-    boost::ptr_vector<IntersectionVertex> _xs;
-    boost::ptr_vector<PathData> _components[2];
+    PackedPathVector _packed[2]; // copies of _pv used for winding queries
+    std::vector<PVIntersection> _crossings; // all intersections between _pv[0] and _pv[1]
+    std::vector<PathCache> _cache[2];
+    MonotonicArena _own_arena;
+    MonotonicArena *_arena; ///< Either _own_arena or an arena supplied by the caller
+    VertexList _xs;
+    PathDataList _components[2];
     UnprocessedList _ulist;
+    Coord _precision;
     bool _graph_valid;
     std::vector<Point> _winding_points;
 
@@ -142,6 +176,23 @@ private:
 
 std::ostream &operator<<(std::ostream &os, PathIntersectionGraph const &pig);
 
+/// Boolean operations on two path vectors.
+enum BooleanOp {
+    BOOLEAN_UNION,
+    BOOLEAN_INTERSECTION,
+    BOOLEAN_A_MINUS_B,
+    BOOLEAN_B_MINUS_A,
+    BOOLEAN_XOR
+};
+
+/** @brief Compute a Boolean operation on two path vectors.
+ * When both operands consist only of line segments, the result is computed
+ * with PolygonIntersectionGraph; otherwise PathIntersectionGraph is used
+ * with the given precision. Temporary data is allocated from the arena, if given.
+ * @relates PathIntersectionGraph */
+PathVector boolean_operation(PathVector const &a, PathVector const &b, BooleanOp op,
+                             Coord precision = EPSILON, MonotonicArena *arena = NULL);
+
 } // namespace Geom
 
 #endif // SEEN_LIB2GEOM_PATH_GRAPH_H
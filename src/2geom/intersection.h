@@ -122,9 +122,10 @@ std::vector< Intersection<A, B> > transpose(std::vector< Intersection<B, A> > co
     return result;
 }
 
+/// Swap the time values of the intersections starting at index @a from.
 template <typename T> inline
-void transpose_in_place(std::vector< Intersection<T, T> > &xs) {
-    for (std::size_t i = 0; i < xs.size(); ++i) {
+void transpose_in_place(std::vector< Intersection<T, T> > &xs, std::size_t from = 0) {
+    for (std::size_t i = from; i < xs.size(); ++i) {
         std::swap(xs[i].first, xs[i].second);
     }
 }
@@ -31,6 +31,7 @@
 #include <algorithm>
 #include <2geom/line.h>
 #include <2geom/math-utils.h>
+#include <2geom/predicates.h>
 
 namespace Geom
 {
@@ -255,7 +256,8 @@ std::vector<ShapeIntersection> Line::intersect(Line const &other) const
 
     Point v1 = vector();
     Point v2 = other.vector();
-    Coord cp = cross(v1, v2);
+    // test for parallel lines exactly, since cross(v1, v2) rounds the differences
+    Coord cp = cross_difference(_initial, _final, other._initial, other._final);
     if (cp == 0) return result;
 
     Point odiff = other.initialPoint() - initialPoint();
@@ -507,18 +509,17 @@ OptCrossing intersection( LineSegment const& ls1, LineSegment const& ls2 )
 
     if (crossing)
     {
-        if ( crossing->getTime(0) < 0
-             || crossing->getTime(0) > 1
-             || crossing->getTime(1) < 0
-             || crossing->getTime(1) > 1 )
+        // the rounded times can be outside of the unit interval at the endpoints,
+        // so decide whether the segments intersect exactly
+        if (!segments_intersect(ls1.initialPoint(), ls1.finalPoint(),
+                                ls2.initialPoint(), ls2.finalPoint()))
         {
             OptCrossing no_crossing;
             return no_crossing;
         }
-        else
-        {
-            return crossing;
-        }
+        crossing->ta = std::min(std::max(crossing->ta, 0.), 1.);
+        crossing->tb = std::min(std::max(crossing->tb, 0.), 1.);
+        return crossing;
     }
 
     bool eqvs = (dot(direction1, direction2) > 0);
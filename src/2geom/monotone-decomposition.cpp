@@ -0,0 +1,111 @@
+/** @file
+ * @brief Decomposition of paths into monotonic pieces
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/monotone-decomposition.h>
+#include <2geom/curve.h>
+#include <2geom/path.h>
+#include <algorithm>
+#include <limits>
+
+namespace Geom {
+
+MonotoneDecomposition::MonotoneDecomposition(Path const &path)
+{
+    _first.reserve(path.size_closed() + 1);
+    _first.push_back(0);
+    for (Path::const_iterator i = path.begin(); i != path.end_closed(); ++i) {
+        addCurve(*i);
+    }
+}
+
+void MonotoneDecomposition::addCurve(Curve const &c)
+{
+    std::vector<Coord> ts;
+    ts.push_back(0);
+    // line segments are always monotonic
+    if (!c.isLineSegment() && !c.isDegenerate()) {
+        Curve *deriv = c.derivative();
+        std::vector<Coord> roots = deriv->roots(0, X);
+        std::vector<Coord> yroots = deriv->roots(0, Y);
+        delete deriv;
+        roots.insert(roots.end(), yroots.begin(), yroots.end());
+        std::sort(roots.begin(), roots.end());
+        for (std::size_t i = 0; i < roots.size(); ++i) {
+            if (roots[i] > ts.back() && roots[i] < 1) {
+                ts.push_back(roots[i]);
+            }
+        }
+    }
+    ts.push_back(1);
+
+    Point last = c.initialPoint();
+    for (std::size_t i = 1; i < ts.size(); ++i) {
+        Point next = i + 1 == ts.size() ? c.finalPoint() : c.pointAt(ts[i]);
+        Piece piece;
+        piece.t0 = ts[i - 1];
+        piece.t1 = ts[i];
+        piece.p0 = last;
+        piece.p1 = next;
+        _pieces.push_back(piece);
+        last = next;
+    }
+    _first.push_back(_pieces.size());
+}
+
+void MonotoneDecomposition::splitTimes(std::size_t curve, std::vector<Coord> &out) const
+{
+    for (const_iterator i = begin(curve) + 1; i < end(curve); ++i) {
+        out.push_back(i->t0);
+    }
+}
+
+Coord MonotoneDecomposition::distanceBound(std::size_t curve, Point const &p) const
+{
+    Coord result = std::numeric_limits<Coord>::max();
+    for (const_iterator i = begin(curve); i != end(curve); ++i) {
+        // the bounds are only as accurate as the split times, see Path::_windingInBounds()
+        Rect bounds = i->bounds();
+        bounds.expandBy(EPSILON * (1 + bounds.maxExtent()));
+        result = std::min(result, distance(p, bounds));
+    }
+    return result;
+}
+
+} // namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,103 @@
+/** @file
+ * @brief Decomposition of paths into monotonic pieces
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#ifndef LIB2GEOM_SEEN_MONOTONE_DECOMPOSITION_H
+#define LIB2GEOM_SEEN_MONOTONE_DECOMPOSITION_H
+
+#include <cstddef>
+#include <vector>
+#include <2geom/forward.h>
+#include <2geom/rect.h>
+
+namespace Geom {
+
+/** @brief Split of the curves of a path into pieces monotonic in both coordinates.
+ *
+ * Each curve is split at the roots of the derivatives of its X and Y coordinates.
+ * Since both coordinates are monotonic on a piece, its bounding box is spanned by its
+ * endpoints, and a horizontal or vertical line crosses it at most once. This makes
+ * the pieces useful for culling in winding number, crossing and nearest point queries.
+ *
+ * Paths compute their decomposition once and cache it; see Path::monotoneDecomposition().
+ *
+ * @ingroup Paths */
+class MonotoneDecomposition {
+public:
+    struct Piece {
+        Coord t0, t1; ///< Time interval on the curve
+        Point p0, p1; ///< Points at t0 and t1
+
+        /// Bounding box of the piece, spanned by its endpoints.
+        Rect bounds() const { return Rect(p0, p1); }
+    };
+    typedef std::vector<Piece>::const_iterator const_iterator;
+
+    MonotoneDecomposition() { _first.push_back(0); }
+    /// Decompose all curves of the path, including the closing segment.
+    explicit MonotoneDecomposition(Path const &path);
+
+    /// Append the pieces of a curve.
+    void addCurve(Curve const &c);
+
+    /// Number of decomposed curves.
+    std::size_t size() const { return _first.size() - 1; }
+    /// Total number of pieces.
+    std::size_t pieceCount() const { return _pieces.size(); }
+
+    /// First piece of the curve with the given index. Pieces are ordered by time.
+    const_iterator begin(std::size_t curve) const { return _pieces.begin() + _first[curve]; }
+    /// Past-the-end piece of the curve with the given index.
+    const_iterator end(std::size_t curve) const { return _pieces.begin() + _first[curve + 1]; }
+
+    /** @brief Times at which a curve was split, excluding 0 and 1.
+     * The times are appended to @a out in increasing order. */
+    void splitTimes(std::size_t curve, std::vector<Coord> &out) const;
+    /** @brief Lower bound of the distance between a point and a curve.
+     * This is the smallest distance to the bounding boxes of the curve's pieces, which are
+     * widened by a small margin to account for the inexact split times. */
+    Coord distanceBound(std::size_t curve, Point const &p) const;
+
+private:
+    std::vector<Piece> _pieces;
+    std::vector<std::size_t> _first; ///< Index of the first piece of each curve
+};
+
+} // namespace Geom
+
+#endif // LIB2GEOM_SEEN_MONOTONE_DECOMPOSITION_H
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
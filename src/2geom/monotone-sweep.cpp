@@ -0,0 +1,451 @@
+/** @file
+ * @brief Event-driven sweep over the monotonic pieces of a path - implementation
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+
+#include <2geom/monotone-sweep.h>
+#include <2geom/curve.h>
+#include <2geom/monotone-decomposition.h>
+#include <2geom/path.h>
+#include <algorithm>
+#include <queue>
+#include <set>
+#include <boost/intrusive/set.hpp>
+
+namespace Geom {
+
+namespace {
+
+// Events at the same X are processed in this order. Pieces which start at X are inserted
+// before the ones ending at X are removed, so that pieces meeting at an endpoint are tested.
+enum SweepEventType {
+    SWEEP_INSERT,
+    SWEEP_CROSS,
+    SWEEP_VERTICAL,
+    SWEEP_REMOVE
+};
+
+struct SweepEvent {
+    Coord x;
+    SweepEventType type;
+    std::size_t a, b;
+
+    SweepEvent(Coord x_, SweepEventType type_, std::size_t a_, std::size_t b_ = 0)
+        : x(x_), type(type_), a(a_), b(b_)
+    {}
+};
+
+struct SweepEventLater {
+    bool operator()(SweepEvent const &a, SweepEvent const &b) const {
+        if (a.x != b.x) return a.x > b.x;
+        return a.type > b.type;
+    }
+};
+
+// A piece oriented from left to right.
+struct SweepRecord {
+    boost::intrusive::set_member_hook<> hook;
+    MonotoneSweep::Piece const *piece;
+    Coord xl, xr, yl, yr;
+    Coord ymin, ymax;
+    Coord tl, tr; ///< Times of the left and right endpoints
+    bool line;
+    mutable Coord cached_x, cached_t, cached_y;
+
+    Coord timeAt(Coord x) const;
+    Coord yAt(Coord x) const;
+    Point directionAt(Coord x) const;
+};
+
+// Time at which the piece crosses a vertical line.
+Coord SweepRecord::timeAt(Coord x) const
+{
+    if (x <= xl) return tl;
+    if (x >= xr) return tr;
+    if (x == cached_x) return cached_t;
+
+    Coord t;
+    if (line) {
+        t = lerp((x - xl) / (xr - xl), tl, tr);
+    } else {
+        // X is monotonic on the piece, so solve x(t) = x using the Illinois variant
+        // of regula falsi, which keeps the root bracketed
+        Curve const &c = *piece->curve;
+        Coord a = tl, b = tr, fa = xl - x, fb = xr - x;
+        int side = 0;
+        t = a;
+        for (unsigned i = 0; i < 64; ++i) {
+            t = (a * fb - b * fa) / (fb - fa);
+            Coord ft = c.valueAt(t, X) - x;
+            if (ft == 0) break;
+            if (ft < 0) {
+                a = t; fa = ft;
+                if (side == -1) fb /= 2;
+                side = -1;
+            } else {
+                b = t; fb = ft;
+                if (side == 1) fa /= 2;
+                side = 1;
+            }
+            if (std::fabs(b - a) < 1e-15) break;
+        }
+    }
+    cached_x = x;
+    cached_t = t;
+    cached_y = line ? lerp((x - xl) / (xr - xl), yl, yr) : piece->curve->valueAt(t, Y);
+    return t;
+}
+
+Coord SweepRecord::yAt(Coord x) const
+{
+    if (x <= xl) return yl;
+    if (x >= xr) return yr;
+    if (x != cached_x) timeAt(x);
+    return cached_y;
+}
+
+// Unit tangent in the direction of increasing X.
+Point SweepRecord::directionAt(Coord x) const
+{
+    if (line) return unit_vector(Point(xr - xl, yr - yl));
+    Point d = piece->curve->unitTangentAt(timeAt(x));
+    return tl < tr ? d : -d;
+}
+
+// Ordering of pieces which meet at x, a bit to the right of x: first by their tangents,
+// then, if they are tangent, by their position halfway to the nearer right end.
+inline bool sweep_order_right(SweepRecord const &a, SweepRecord const &b, Coord x)
+{
+    Coord c = cross(a.directionAt(x), b.directionAt(x));
+    if (std::fabs(c) > 1e-9) return c > 0;
+
+    Coord xm = x + (std::min(a.xr, b.xr) - x) / 2;
+    if (xm > x) {
+        Coord ya = a.yAt(xm), yb = b.yAt(xm);
+        if (ya != yb) return ya < yb;
+    }
+    return a.piece->index < b.piece->index;
+}
+
+// Order of the pieces crossed by the sweepline. Pieces which meet at the sweepline,
+// up to the precision, are ordered by their position a bit to the right of it.
+struct SweepStatusOrder {
+    Coord const *x;
+    Coord precision;
+
+    SweepStatusOrder(Coord const *x_, Coord prec) : x(x_), precision(prec) {}
+    bool operator()(SweepRecord const &a, SweepRecord const &b) const {
+        // pieces are monotonic, so disjoint Y ranges decide the order without evaluation
+        if (a.ymax < b.ymin - precision) return true;
+        if (b.ymax < a.ymin - precision) return false;
+        Coord ya = a.yAt(*x), yb = b.yAt(*x);
+        if (std::fabs(ya - yb) > precision) return ya < yb;
+        return sweep_order_right(a, b, *x);
+    }
+};
+
+// Compares pieces crossed by the sweepline to a Y coordinate.
+struct SweepKeyOrder {
+    Coord x;
+
+    explicit SweepKeyOrder(Coord x_) : x(x_) {}
+    bool operator()(SweepRecord const &r, Coord y) const { return r.yAt(x) < y; }
+    bool operator()(Coord y, SweepRecord const &r) const { return y < r.yAt(x); }
+};
+
+typedef boost::intrusive::multiset<SweepRecord,
+    boost::intrusive::member_hook<SweepRecord, boost::intrusive::set_member_hook<>,
+                                  &SweepRecord::hook>,
+    boost::intrusive::compare<SweepStatusOrder> > SweepStatus;
+
+class SweepState {
+public:
+    SweepState(std::vector<MonotoneSweep::Piece> const &pieces,
+               MonotoneSweep::PairHandler &handler, Coord precision, bool closed);
+    ~SweepState() { _status.clear(); }
+    void run();
+
+private:
+    typedef SweepStatus::iterator iterator;
+
+    void _insert(SweepRecord &r);
+    void _cross(SweepRecord &a, SweepRecord &b);
+    void _erase(SweepRecord &r);
+    void _testRange(SweepRecord const &r, Coord ymin, Coord ymax);
+    void _test(SweepRecord const &a, SweepRecord const &b);
+
+    std::vector<MonotoneSweep::Piece> const &_pieces;
+    MonotoneSweep::PairHandler &_handler;
+    Coord _precision;
+    bool _closed;
+    Coord _x; ///< Position of the sweepline
+    std::vector<SweepRecord> _records;
+    std::priority_queue<SweepEvent, std::vector<SweepEvent>, SweepEventLater> _events;
+    SweepStatus _status;
+    std::set<std::pair<std::size_t, std::size_t> > _tested;
+    std::vector<SweepRecord const *> _verticals; ///< Vertical pieces at the sweepline
+    std::vector<Coord> _xs;
+};
+
+SweepState::SweepState(std::vector<MonotoneSweep::Piece> const &pieces,
+                       MonotoneSweep::PairHandler &handler, Coord precision, bool closed)
+    : _pieces(pieces)
+    , _handler(handler)
+    , _precision(precision)
+    , _closed(closed)
+    , _x(0)
+    , _records(pieces.size())
+    , _status(SweepStatusOrder(&_x, precision))
+{
+    for (std::size_t i = 0; i < pieces.size(); ++i) {
+        MonotoneSweep::Piece const &p = pieces[i];
+        SweepRecord &r = _records[i];
+        bool forward = p.p0[X] <= p.p1[X];
+        Point const &left = forward ? p.p0 : p.p1;
+        Point const &right = forward ? p.p1 : p.p0;
+        r.piece = &p;
+        r.xl = left[X];
+        r.yl = left[Y];
+        r.xr = right[X];
+        r.yr = right[Y];
+        r.tl = forward ? p.t0 : p.t1;
+        r.tr = forward ? p.t1 : p.t0;
+        r.ymin = std::min(r.yl, r.yr);
+        r.ymax = std::max(r.yl, r.yr);
+        r.line = p.curve->isLineSegment();
+        r.cached_x = r.xl;
+        r.cached_t = r.tl;
+        r.cached_y = r.yl;
+
+        if (r.xl == r.xr) {
+            // vertical pieces are tested against everything crossed by the sweepline
+            _events.push(SweepEvent(r.xl, SWEEP_VERTICAL, i));
+        } else {
+            _events.push(SweepEvent(r.xl, SWEEP_INSERT, i));
+            _events.push(SweepEvent(r.xr, SWEEP_REMOVE, i));
+        }
+    }
+}
+
+void SweepState::run()
+{
+    while (!_events.empty()) {
+        _x = _events.top().x;
+        _verticals.clear();
+
+        while (!_events.empty() && _events.top().x == _x) {
+            SweepEvent e = _events.top();
+            _events.pop();
+
+            switch (e.type) {
+            case SWEEP_INSERT:
+                _insert(_records[e.a]);
+                break;
+            case SWEEP_CROSS:
+                _cross(_records[e.a], _records[e.b]);
+                break;
+            case SWEEP_VERTICAL: {
+                SweepRecord const &v = _records[e.a];
+                _testRange(v, v.ymin, v.ymax);
+                for (std::size_t i = 0; i < _verticals.size(); ++i) {
+                    _test(v, *_verticals[i]);
+                }
+                _verticals.push_back(&v);
+                } break;
+            case SWEEP_REMOVE:
+                _erase(_records[e.a]);
+                break;
+            }
+        }
+    }
+}
+
+void SweepState::_insert(SweepRecord &r)
+{
+    iterator it = _status.insert(r);
+    Coord y = r.yAt(_x);
+
+    // test the neighbours, and all pieces which touch this one at the sweepline,
+    // since they are not necessarily neighbours
+    iterator i = it;
+    while (i != _status.begin()) {
+        --i;
+        _test(*i, r);
+        if (i->yAt(_x) < y - _precision) break;
+    }
+    for (i = it, ++i; i != _status.end(); ++i) {
+        _test(r, *i);
+        if (i->yAt(_x) > y + _precision) break;
+    }
+}
+
+void SweepState::_cross(SweepRecord &a, SweepRecord &b)
+{
+    if (!a.hook.is_linked() || !b.hook.is_linked()) return;
+    if (a.xr <= _x || b.xr <= _x) return;
+
+    iterator ia = _status.iterator_to(a), ib = _status.iterator_to(b);
+    iterator next = ia;
+    ++next;
+    if (next != ib) {
+        next = ib;
+        ++next;
+        if (next != ia) {
+            // other pieces pass through the crossing point, so reinsert the pair
+            _status.erase(ia);
+            _status.erase(ib);
+            _insert(a);
+            _insert(b);
+            return;
+        }
+        std::swap(ia, ib);
+    }
+
+    // the pieces are neighbours with ia below ib; swap them in place if their order
+    // changes, since their Y coordinates at the crossing may differ only by rounding
+    SweepRecord &lower = *ia, &upper = *ib;
+    if (!sweep_order_right(upper, lower, _x)) return;
+    _status.erase(ib);
+    ib = _status.insert_before(ia, upper);
+    if (ib != _status.begin()) {
+        iterator prev = ib;
+        --prev;
+        _test(*prev, upper);
+    }
+    next = ia;
+    ++next;
+    if (next != _status.end()) {
+        _test(lower, *next);
+    }
+}
+
+void SweepState::_erase(SweepRecord &r)
+{
+    iterator next = _status.erase(_status.iterator_to(r));
+    if (next != _status.begin() && next != _status.end()) {
+        iterator prev = next;
+        --prev;
+        _test(*prev, *next);
+    }
+}
+
+void SweepState::_testRange(SweepRecord const &r, Coord ymin, Coord ymax)
+{
+    SweepKeyOrder key(_x);
+    for (iterator it = _status.lower_bound(ymin - _precision, key);
+         it != _status.end() && it->yAt(_x) <= ymax + _precision; ++it)
+    {
+        _test(r, *it);
+    }
+}
+
+void SweepState::_test(SweepRecord const &a, SweepRecord const &b)
+{
+    std::size_t i = a.piece->index, j = b.piece->index;
+    if (i == j) return;
+    // pieces are monotonic, so their bounding boxes are spanned by the endpoints
+    if (a.xr < b.xl - _precision || b.xr < a.xl - _precision
+        || a.ymax < b.ymin - _precision || b.ymax < a.ymin - _precision) return;
+    // pieces joined by the path can only meet elsewhere when both coordinates turn back
+    // at the joint; otherwise their ranges in one of the coordinates only share the joint
+    if (j == i + 1 || (_closed && i == 0 && j + 1 == _pieces.size())) {
+        if (std::min(a.xr, b.xr) - std::max(a.xl, b.xl) <= _precision
+            || std::min(a.ymax, b.ymax) - std::max(a.ymin, b.ymin) <= _precision) return;
+    }
+    if (i > j) std::swap(i, j);
+    // all intersections of a pair are found at once
+    if (!_tested.insert(std::make_pair(i, j)).second) return;
+
+    _xs.clear();
+    _handler.intersect(_pieces[i], _pieces[j], _xs);
+
+    Coord xmax = std::min(_records[i].xr, _records[j].xr);
+    for (std::size_t k = 0; k < _xs.size(); ++k) {
+        if (_xs[k] > _x && _xs[k] < xmax) {
+            _events.push(SweepEvent(_xs[k], SWEEP_CROSS, i, j));
+        }
+    }
+}
+
+} // anonymous namespace
+
+MonotoneSweep::MonotoneSweep(Path const &path, Coord precision)
+    : _precision(precision)
+    , _closed(path.closed())
+{
+    MonotoneDecomposition const &md = path.monotoneDecomposition();
+    for (std::size_t i = 0; i < path.size_default(); ++i) {
+        for (MonotoneDecomposition::const_iterator j = md.begin(i); j != md.end(i); ++j) {
+            if (j->p0 == j->p1) continue;
+            Piece p;
+            p.curve = &path[i];
+            p.curve_index = i;
+            p.index = _pieces.size();
+            p.t0 = j->t0;
+            p.t1 = j->t1;
+            p.p0 = j->p0;
+            p.p1 = j->p1;
+            _pieces.push_back(p);
+        }
+    }
+}
+
+void MonotoneSweep::process(PairHandler &handler) const
+{
+    SweepState state(_pieces, handler, _precision, _closed);
+    state.run();
+}
+
+bool MonotoneSweep::atJoint(Piece const &a, Coord ta, Piece const &b, Coord tb,
+                            Point const &p) const
+{
+    if (b.index < a.index) return atJoint(b, tb, a, ta, p);
+
+    if (b.index == a.index + 1) {
+        return are_near(p, a.p1, _precision)
+            || (are_near(ta, a.t1) && are_near(tb, b.t0));
+    }
+    if (_closed && a.index == 0 && b.index + 1 == _pieces.size()) {
+        return are_near(p, a.p0, _precision)
+            || (are_near(ta, a.t0) && are_near(tb, b.t1));
+    }
+    return false;
+}
+
+} // namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
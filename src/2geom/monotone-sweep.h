@@ -0,0 +1,118 @@
+/** @file
+ * @brief Event-driven sweep over the monotonic pieces of a path
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+
+#ifndef LIB2GEOM_SEEN_MONOTONE_SWEEP_H
+#define LIB2GEOM_SEEN_MONOTONE_SWEEP_H
+
+#include <cstddef>
+#include <vector>
+#include <2geom/forward.h>
+#include <2geom/point.h>
+
+namespace Geom {
+
+/** @brief Bentley-Ottmann sweep over the monotonic pieces of a path.
+ *
+ * The pieces of the path's monotone decomposition are swept from left to right.
+ * Pieces crossed by the sweepline are kept in a status structure ordered by their
+ * Y coordinate at the sweepline, and a pair of pieces is passed to the handler only when
+ * the pieces become neighbours in that order, or when they touch at the sweepline.
+ * The intersections reported back by the handler are scheduled as events which swap
+ * the pieces. Since monotonic pieces can only change their order where they intersect,
+ * this finds all intersecting pairs in O((n+k) log n) time for n pieces
+ * and k intersections, compared to the quadratic behavior of bounding box culling
+ * on long paths that overlap themselves many times.
+ *
+ * The sweep refers to the curves of the path, which must outlive it.
+ *
+ * @ingroup Paths */
+class MonotoneSweep {
+public:
+    /// A monotonic piece of a curve of the swept path.
+    struct Piece {
+        Curve const *curve;
+        std::size_t curve_index; ///< Index of the curve in the path
+        std::size_t index; ///< Position of the piece in the path
+        Coord t0, t1; ///< Time interval on the curve
+        Point p0, p1; ///< Points at t0 and t1
+    };
+
+    /// Computes the intersections of the pairs of pieces found by the sweep.
+    class PairHandler {
+    public:
+        virtual ~PairHandler() {}
+        /** @brief Intersect two pieces.
+         * Each pair is passed at most once, with a.index < b.index. Consecutive pieces
+         * are skipped when they can only meet at their joint. The X coordinates
+         * of all intersections found must be appended to @a xs; the sweep relies
+         * on them to keep the pieces in order. */
+        virtual void intersect(Piece const &a, Piece const &b, std::vector<Coord> &xs) = 0;
+    };
+
+    /** @brief Prepare the sweep of a path.
+     * The pieces are taken from Path::monotoneDecomposition(). The closing segment
+     * is included if it is not degenerate, while zero-length pieces are skipped.
+     * @param precision Distance at which pieces crossing the sweepline are considered
+     *                  to touch */
+    explicit MonotoneSweep(Path const &path, Coord precision = EPSILON);
+
+    /// Run the sweep, passing all pairs of pieces which may intersect to the handler.
+    void process(PairHandler &handler) const;
+
+    std::vector<Piece> const &pieces() const { return _pieces; }
+
+    /** @brief Check whether an intersection of two pieces is a point where the path joins them.
+     * This is the case when one piece follows the other, or the path is closed and they are
+     * its first and last piece, and the intersection is at their shared endpoint: either
+     * within the precision, or at the corresponding times. Handlers usually skip such points.
+     * @param ta Time of the intersection on the curve of @a a
+     * @param tb Time of the intersection on the curve of @a b
+     * @param p Intersection point */
+    bool atJoint(Piece const &a, Coord ta, Piece const &b, Coord tb, Point const &p) const;
+
+private:
+    std::vector<Piece> _pieces;
+    Coord _precision;
+    bool _closed;
+};
+
+} // namespace Geom
+
+#endif // LIB2GEOM_SEEN_MONOTONE_SWEEP_H
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
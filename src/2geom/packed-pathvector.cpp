@@ -0,0 +1,671 @@
+/** @file
+ * @brief Path sequence stored in packed, type-segregated arrays
+ *//*
+ * Copyright 2016 authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/packed-pathvector.h>
+#include <2geom/exception.h>
+#include <2geom/predicates.h>
+#include <algorithm>
+
+namespace Geom {
+
+namespace {
+
+Rect point_hull(Point const *p, unsigned n)
+{
+    Rect r(p[0], p[0]);
+    for (unsigned i = 1; i < n; ++i) {
+        r.expandTo(p[i]);
+    }
+    return r;
+}
+
+/* Shared part of the per-segment winding computation, mirroring Path::winding().
+ * Returns true if the point is inside the segment's bounding box,
+ * which means the exact winding routine of the curve has to be used. */
+inline bool winding_prefilter(Rect const &bounds, Point const &ip, Point const &fp,
+                              Point const &p, int &wind)
+{
+    if (bounds.height() == 0) return false;
+    if (p[X] > bounds.right() || !(bounds.top() <= p[Y] && p[Y] < bounds.bottom())) {
+        return false;
+    }
+    if (p[X] < bounds.left()) {
+        // the contribution is the same as that of a line segment between the endpoints
+        Coord ymin = std::min(ip[Y], fp[Y]), ymax = std::max(ip[Y], fp[Y]);
+        if (ymin <= p[Y] && p[Y] < ymax) {
+            wind += ip[Y] < fp[Y] ? 1 : -1;
+        }
+        return false;
+    }
+    return true;
+}
+
+// same as Path::winding() applied to a single LineSegment
+inline int line_winding(Point const &ip, Point const &fp, Point const &p)
+{
+    int wind = 0;
+    if (!winding_prefilter(Rect(ip, fp), ip, fp, p, wind)) return wind;
+
+    // see BezierCurveN<1>::winding()
+    if (p[Y] == std::max(ip[Y], fp[Y])) return 0;
+    if (ip[Y] < fp[Y]) {
+        return orient2d(ip, fp, p) > 0 ? 1 : 0;
+    }
+    return orient2d(fp, ip, p) > 0 ? -1 : 0;
+}
+
+inline int curve_winding(Curve const &c, Point const &p)
+{
+    int wind = 0;
+    if (winding_prefilter(c.boundsFast(), c.initialPoint(), c.finalPoint(), p, wind)) {
+        wind += c.winding(p);
+    }
+    return wind;
+}
+
+template <unsigned degree>
+BezierCurveN<degree> &materialize(boost::optional<BezierCurveN<degree> > &holder,
+                                  Point const *pts)
+{
+    if (!holder) {
+        holder = BezierCurveN<degree>();
+    }
+    for (unsigned i = 0; i <= degree; ++i) {
+        holder->setPoint(i, pts[i]);
+    }
+    return *holder;
+}
+
+template <unsigned degree>
+inline int bezier_winding(Point const *pts, Point const &p,
+                          boost::optional<BezierCurveN<degree> > &holder)
+{
+    int wind = 0;
+    if (winding_prefilter(point_hull(pts, degree + 1), pts[0], pts[degree], p, wind)) {
+        wind += materialize(holder, pts).winding(p);
+    }
+    return wind;
+}
+
+// expand the rectangle to include the extrema of a quadratic Bezier
+void expand_quadratic(Rect &r, Point const *p)
+{
+    r.expandTo(p[0]);
+    r.expandTo(p[2]);
+    for (unsigned d = 0; d < 2; ++d) {
+        Coord den = p[0][d] - 2 * p[1][d] + p[2][d];
+        if (den == 0) continue;
+        Coord t = (p[0][d] - p[1][d]) / den;
+        if (t > 0 && t < 1) {
+            Coord s = 1 - t;
+            r[d].expandTo(s*s*p[0][d] + 2*s*t*p[1][d] + t*t*p[2][d]);
+        }
+    }
+}
+
+// expand the rectangle to include the extrema of a cubic Bezier
+void expand_cubic(Rect &r, Point const *p)
+{
+    r.expandTo(p[0]);
+    r.expandTo(p[3]);
+    for (unsigned d = 0; d < 2; ++d) {
+        // the derivative divided by 3 is a*t^2 + b*t + c
+        Coord a = -p[0][d] + 3 * p[1][d] - 3 * p[2][d] + p[3][d];
+        Coord b = 2 * (p[0][d] - 2 * p[1][d] + p[2][d]);
+        Coord c = p[1][d] - p[0][d];
+        Coord ts[2];
+        unsigned nroots = 0;
+        if (a == 0) {
+            if (b != 0) {
+                ts[nroots++] = -c / b;
+            }
+        } else {
+            Coord disc = b*b - 4*a*c;
+            if (disc >= 0) {
+                Coord sq = std::sqrt(disc);
+                ts[nroots++] = (-b + sq) / (2*a);
+                ts[nroots++] = (-b - sq) / (2*a);
+            }
+        }
+        for (unsigned i = 0; i < nroots; ++i) {
+            Coord t = ts[i];
+            if (t > 0 && t < 1) {
+                Coord s = 1 - t;
+                r[d].expandTo(s*s*s*p[0][d] + 3*s*s*t*p[1][d] + 3*s*t*t*p[2][d] + t*t*t*p[3][d]);
+            }
+        }
+    }
+}
+
+} // end anonymous namespace
+
+PackedPathVector::SegmentKind PackedPathVector::PathView::kind(size_type i) const
+{
+    if (i >= size_open()) return LINE_SEGMENT;
+    return _pv->_segmentKind(_path, i);
+}
+
+Path PackedPathVector::PathView::toPath() const
+{
+    if (empty()) {
+        Path result(initialPoint());
+        result.close(closed());
+        return result;
+    }
+    return Path(begin(), end_open(), closed());
+}
+
+void PackedPathVector::clear()
+{
+    _paths.clear();
+    _segments.clear();
+    _lines.clear();
+    _quads.clear();
+    _cubics.clear();
+    _arcs.clear();
+    _others.clear();
+}
+
+void PackedPathVector::reserve(size_type paths, size_type segments)
+{
+    _paths.reserve(paths);
+    _segments.reserve(segments);
+}
+
+void PackedPathVector::push_back(Path const &path)
+{
+    start(path.initialPoint());
+    for (Path::const_iterator i = path.begin(); i != path.end_open(); ++i) {
+        append(*i);
+    }
+    // do not use close(), since it could remove the last segment
+    _paths.back().closed = path.closed();
+}
+
+void PackedPathVector::insert(PathVector const &pv)
+{
+    _paths.reserve(_paths.size() + pv.size());
+    for (PathVector::const_iterator i = pv.begin(); i != pv.end(); ++i) {
+        push_back(*i);
+    }
+}
+
+void PackedPathVector::start(Point const &p)
+{
+    PathRecord r;
+    for (unsigned k = 0; k < SEGMENT_KIND_COUNT; ++k) {
+        r.first[k] = _kindSize(static_cast<SegmentKind>(k));
+    }
+    r.first_segment = _segments.size();
+    r.initial = r.final = p;
+    r.closed = false;
+    _paths.push_back(r);
+}
+
+void PackedPathVector::appendLine(Point const &p)
+{
+    _ensurePath();
+    Point ip = _paths.back().final;
+    _lines.push_back(ip);
+    _lines.push_back(p);
+    _pushSegment(LINE_SEGMENT, Rect(ip, p));
+}
+
+void PackedPathVector::appendQuadratic(Point const &c, Point const &p)
+{
+    _ensurePath();
+    _quads.push_back(_paths.back().final);
+    _quads.push_back(c);
+    _quads.push_back(p);
+    _pushSegment(QUADRATIC_BEZIER, point_hull(&_quads[_quads.size() - 3], 3));
+}
+
+void PackedPathVector::appendCubic(Point const &c0, Point const &c1, Point const &p)
+{
+    _ensurePath();
+    _cubics.push_back(_paths.back().final);
+    _cubics.push_back(c0);
+    _cubics.push_back(c1);
+    _cubics.push_back(p);
+    _pushSegment(CUBIC_BEZIER, point_hull(&_cubics[_cubics.size() - 4], 4));
+}
+
+void PackedPathVector::appendArc(Coord rx, Coord ry, Coord angle,
+                                 bool large_arc, bool sweep, Point const &p)
+{
+    _ensurePath();
+    _arcs.push_back(EllipticalArc(_paths.back().final, rx, ry, angle, large_arc, sweep, p));
+    _pushSegment(ELLIPTICAL_ARC, _arcs.back().boundsFast());
+}
+
+void PackedPathVector::append(Curve const &c)
+{
+    _ensurePath();
+    if (c.initialPoint() != _paths.back().final) {
+        THROW_CONTINUITYERROR();
+    }
+
+    BezierCurve const *bez = dynamic_cast<BezierCurve const *>(&c);
+    if (bez && bez->order() >= 1 && bez->order() <= 3) {
+        SegmentKind k = static_cast<SegmentKind>(bez->order() - 1);
+        std::vector<Point> &pts = k == LINE_SEGMENT ? _lines
+                                : k == QUADRATIC_BEZIER ? _quads : _cubics;
+        for (unsigned i = 0; i <= bez->order(); ++i) {
+            pts.push_back(bez->controlPoint(i));
+        }
+        _pushSegment(k, point_hull(&pts[pts.size() - bez->size()], bez->size()));
+        return;
+    }
+
+    EllipticalArc const *arc = dynamic_cast<EllipticalArc const *>(&c);
+    if (arc) {
+        _arcs.push_back(*arc);
+        _pushSegment(ELLIPTICAL_ARC, arc->boundsFast());
+        return;
+    }
+
+    _others.push_back(c.duplicate());
+    _pushSegment(OTHER_CURVE, c.boundsFast());
+}
+
+void PackedPathVector::close(bool c)
+{
+    _ensurePath();
+    PathRecord &r = _paths.back();
+    if (c == r.closed) return;
+    if (c) {
+        // when closing, if last segment is linear and ends at initial point,
+        // replace it with the closing segment
+        size_type n = _segmentCount(_paths.size() - 1);
+        if (n > 0 && _segmentKind(_paths.size() - 1, n - 1) == LINE_SEGMENT
+            && r.final == r.initial)
+        {
+            eraseLast();
+        }
+    }
+    r.closed = c;
+}
+
+bool PackedPathVector::eraseLast()
+{
+    if (_paths.empty()) return false;
+    size_type path = _paths.size() - 1;
+    size_type n = _segmentCount(path);
+    if (n == 0) return false;
+
+    PathRecord &r = _paths.back();
+    switch (_segmentKind(path, n - 1)) {
+    case LINE_SEGMENT:
+    case QUADRATIC_BEZIER:
+    case CUBIC_BEZIER: {
+        SegmentKind k = _segmentKind(path, n - 1);
+        std::vector<Point> &pts = k == LINE_SEGMENT ? _lines
+                                : k == QUADRATIC_BEZIER ? _quads : _cubics;
+        r.final = pts[pts.size() - _pointsPerSegment(k)];
+        pts.resize(pts.size() - _pointsPerSegment(k));
+        } break;
+    case ELLIPTICAL_ARC:
+        r.final = _arcs.back().initialPoint();
+        _arcs.pop_back();
+        break;
+    default:
+        r.final = _others.back().initialPoint();
+        _others.pop_back();
+        break;
+    }
+    _segments.pop_back();
+    _updateBounds(path);
+    return true;
+}
+
+PathVector PackedPathVector::toPathVector() const
+{
+    PathVector result;
+    for (size_type i = 0; i < _paths.size(); ++i) {
+        result.push_back((*this)[i].toPath());
+    }
+    return result;
+}
+
+void PackedPathVector::feed(PathSink &sink) const
+{
+    for (size_type pi = 0; pi < _paths.size(); ++pi) {
+        PathRecord const &r = _paths[pi];
+        sink.flush();
+        sink.moveTo(r.initial);
+        for (size_type i = 0, n = _segmentCount(pi); i < n; ++i) {
+            size_type ix = _segmentIndex(pi, i);
+            switch (_segmentKind(pi, i)) {
+            case LINE_SEGMENT:
+                sink.lineTo(_lines[2*ix + 1]);
+                break;
+            case QUADRATIC_BEZIER:
+                sink.quadTo(_quads[3*ix + 1], _quads[3*ix + 2]);
+                break;
+            case CUBIC_BEZIER:
+                sink.curveTo(_cubics[4*ix + 1], _cubics[4*ix + 2], _cubics[4*ix + 3]);
+                break;
+            case ELLIPTICAL_ARC:
+                _arcs[ix].feed(sink, false);
+                break;
+            default:
+                _others[ix].feed(sink, false);
+                break;
+            }
+        }
+        if (r.closed) {
+            sink.closePath();
+        }
+        sink.flush();
+    }
+}
+
+OptRect PackedPathVector::boundsFast() const
+{
+    OptRect bound;
+    for (size_type i = 0; i < _paths.size(); ++i) {
+        bound.unionWith(_paths[i].bounds);
+    }
+    return bound;
+}
+
+OptRect PackedPathVector::boundsExact() const
+{
+    OptRect bound;
+    for (size_type i = 0; i < _paths.size(); ++i) {
+        bound.unionWith(_boundsExact(i));
+    }
+    return bound;
+}
+
+int PackedPathVector::winding(Point const &p) const
+{
+    int wind = 0;
+    for (size_type i = 0; i < _paths.size(); ++i) {
+        if (!_paths[i].bounds.contains(p)) continue;
+        wind += _winding(i, p);
+    }
+    return wind;
+}
+
+PackedPathVector::size_type PackedPathVector::_kindSize(SegmentKind k) const
+{
+    switch (k) {
+    case LINE_SEGMENT: return _lines.size() / 2;
+    case QUADRATIC_BEZIER: return _quads.size() / 3;
+    case CUBIC_BEZIER: return _cubics.size() / 4;
+    case ELLIPTICAL_ARC: return _arcs.size();
+    default: return _others.size();
+    }
+}
+
+PackedPathVector::size_type PackedPathVector::_kindEnd(size_type path, SegmentKind k) const
+{
+    if (path + 1 < _paths.size()) {
+        return _paths[path + 1].first[k];
+    }
+    return _kindSize(k);
+}
+
+PackedPathVector::size_type PackedPathVector::_segmentCount(size_type path) const
+{
+    size_type last = path + 1 < _paths.size()
+        ? _paths[path + 1].first_segment
+        : _segments.size();
+    return last - _paths[path].first_segment;
+}
+
+PackedPathVector::SegmentKind PackedPathVector::_segmentKind(size_type path, size_type i) const
+{
+    return static_cast<SegmentKind>(_segments[_paths[path].first_segment + i] & 7);
+}
+
+PackedPathVector::size_type PackedPathVector::_segmentIndex(size_type path, size_type i) const
+{
+    return _segments[_paths[path].first_segment + i] >> 3;
+}
+
+void PackedPathVector::_pushSegment(SegmentKind k, Rect const &bounds)
+{
+    PathRecord &r = _paths.back();
+    size_type ix = _kindSize(k) - 1;
+    _segments.push_back((ix << 3) | k);
+    switch (k) {
+    case LINE_SEGMENT: r.final = _lines.back(); break;
+    case QUADRATIC_BEZIER: r.final = _quads.back(); break;
+    case CUBIC_BEZIER: r.final = _cubics.back(); break;
+    case ELLIPTICAL_ARC: r.final = _arcs.back().finalPoint(); break;
+    default: r.final = _others.back().finalPoint(); break;
+    }
+    r.bounds.unionWith(bounds);
+}
+
+void PackedPathVector::_ensurePath()
+{
+    if (_paths.empty()) {
+        start(Point());
+    }
+}
+
+void PackedPathVector::_updateBounds(size_type path)
+{
+    PathRecord &r = _paths[path];
+    OptRect bounds;
+    for (size_type i = r.first[LINE_SEGMENT], e = _kindEnd(path, LINE_SEGMENT); i < e; ++i) {
+        bounds.unionWith(Rect(_lines[2*i], _lines[2*i + 1]));
+    }
+    for (size_type i = r.first[QUADRATIC_BEZIER], e = _kindEnd(path, QUADRATIC_BEZIER); i < e; ++i) {
+        bounds.unionWith(point_hull(&_quads[3*i], 3));
+    }
+    for (size_type i = r.first[CUBIC_BEZIER], e = _kindEnd(path, CUBIC_BEZIER); i < e; ++i) {
+        bounds.unionWith(point_hull(&_cubics[4*i], 4));
+    }
+    for (size_type i = r.first[ELLIPTICAL_ARC], e = _kindEnd(path, ELLIPTICAL_ARC); i < e; ++i) {
+        bounds.unionWith(_arcs[i].boundsFast());
+    }
+    for (size_type i = r.first[OTHER_CURVE], e = _kindEnd(path, OTHER_CURVE); i < e; ++i) {
+        bounds.unionWith(_others[i].boundsFast());
+    }
+    r.bounds = bounds;
+}
+
+/* Transform the stored points, which must be done after transforming the other curves.
+ * Transforms which do not rotate or shear map the bounding box of the control points
+ * of a Bezier segment to the bounding box of the transformed control points,
+ * so the bounds of paths consisting of Bezier segments are transformed directly. */
+void PackedPathVector::_transformPoints(Affine const &m)
+{
+    std::vector<Point> *pts[3] = { &_lines, &_quads, &_cubics };
+    for (unsigned k = 0; k < 3; ++k) {
+        if (!pts[k]->empty()) {
+            transform_points(&(*pts[k])[0], pts[k]->size(), m);
+        }
+    }
+
+    bool axis_aligned = m[1] == 0 && m[2] == 0;
+    for (size_type i = 0; i < _paths.size(); ++i) {
+        PathRecord &r = _paths[i];
+        r.initial *= m;
+        r.final *= m;
+        if (axis_aligned
+            && r.first[ELLIPTICAL_ARC] == _kindEnd(i, ELLIPTICAL_ARC)
+            && r.first[OTHER_CURVE] == _kindEnd(i, OTHER_CURVE))
+        {
+            if (r.bounds) {
+                *r.bounds *= m;
+            }
+        } else {
+            _updateBounds(i);
+        }
+    }
+}
+
+OptRect PackedPathVector::_boundsExact(size_type path) const
+{
+    if (_segmentCount(path) == 0) return OptRect();
+
+    PathRecord const &r = _paths[path];
+    Rect bounds(r.initial, r.initial);
+    for (size_type i = r.first[LINE_SEGMENT], e = _kindEnd(path, LINE_SEGMENT); i < e; ++i) {
+        bounds.expandTo(_lines[2*i]);
+        bounds.expandTo(_lines[2*i + 1]);
+    }
+    for (size_type i = r.first[QUADRATIC_BEZIER], e = _kindEnd(path, QUADRATIC_BEZIER); i < e; ++i) {
+        expand_quadratic(bounds, &_quads[3*i]);
+    }
+    for (size_type i = r.first[CUBIC_BEZIER], e = _kindEnd(path, CUBIC_BEZIER); i < e; ++i) {
+        expand_cubic(bounds, &_cubics[4*i]);
+    }
+    for (size_type i = r.first[ELLIPTICAL_ARC], e = _kindEnd(path, ELLIPTICAL_ARC); i < e; ++i) {
+        bounds.unionWith(_arcs[i].boundsExact());
+    }
+    for (size_type i = r.first[OTHER_CURVE], e = _kindEnd(path, OTHER_CURVE); i < e; ++i) {
+        bounds.unionWith(_others[i].boundsExact());
+    }
+    return bounds;
+}
+
+int PackedPathVector::_winding(size_type path, Point const &p) const
+{
+    PathRecord const &r = _paths[path];
+    int wind = 0;
+
+    for (size_type i = r.first[LINE_SEGMENT], e = _kindEnd(path, LINE_SEGMENT); i < e; ++i) {
+        wind += line_winding(_lines[2*i], _lines[2*i + 1], p);
+    }
+    // Beziers are only materialized when the point falls within their bounding box
+    boost::optional<QuadraticBezier> quad;
+    for (size_type i = r.first[QUADRATIC_BEZIER], e = _kindEnd(path, QUADRATIC_BEZIER); i < e; ++i) {
+        wind += bezier_winding(&_quads[3*i], p, quad);
+    }
+    boost::optional<CubicBezier> cubic;
+    for (size_type i = r.first[CUBIC_BEZIER], e = _kindEnd(path, CUBIC_BEZIER); i < e; ++i) {
+        wind += bezier_winding(&_cubics[4*i], p, cubic);
+    }
+    for (size_type i = r.first[ELLIPTICAL_ARC], e = _kindEnd(path, ELLIPTICAL_ARC); i < e; ++i) {
+        wind += curve_winding(_arcs[i], p);
+    }
+    for (size_type i = r.first[OTHER_CURVE], e = _kindEnd(path, OTHER_CURVE); i < e; ++i) {
+        wind += curve_winding(_others[i], p);
+    }
+    // the closing segment is always included, like in Path::winding()
+    wind += line_winding(r.final, r.initial, p);
+    return wind;
+}
+
+Curve const &PackedPathVector::_curveAt(size_type path, size_type i,
+                                        CurveIterator const &cache) const
+{
+    if (i >= _segmentCount(path)) {
+        // closing segment
+        Point pts[2] = { _paths[path].final, _paths[path].initial };
+        return materialize(cache._line, pts);
+    }
+    size_type ix = _segmentIndex(path, i);
+    switch (_segmentKind(path, i)) {
+    case LINE_SEGMENT:
+        return materialize(cache._line, &_lines[2*ix]);
+    case QUADRATIC_BEZIER:
+        return materialize(cache._quad, &_quads[3*ix]);
+    case CUBIC_BEZIER:
+        return materialize(cache._cubic, &_cubics[4*ix]);
+    case ELLIPTICAL_ARC:
+        return _arcs[ix];
+    default:
+        return _others[ix];
+    }
+}
+
+void PackedPathBuilder::moveTo(Point const &p)
+{
+    flush();
+    _out->start(p);
+    _start_p = p;
+    _in_path = true;
+}
+
+void PackedPathBuilder::lineTo(Point const &p)
+{
+    // check for implicit moveto, like in: "M 1,1 L 2,2 z l 2,2 z"
+    _implicitMoveTo();
+    _out->appendLine(p);
+}
+
+void PackedPathBuilder::quadTo(Point const &c, Point const &p)
+{
+    _implicitMoveTo();
+    _out->appendQuadratic(c, p);
+}
+
+void PackedPathBuilder::curveTo(Point const &c0, Point const &c1, Point const &p)
+{
+    _implicitMoveTo();
+    _out->appendCubic(c0, c1, p);
+}
+
+void PackedPathBuilder::arcTo(Coord rx, Coord ry, Coord angle,
+                              bool large_arc, bool sweep, Point const &p)
+{
+    _implicitMoveTo();
+    _out->appendArc(rx, ry, angle, large_arc, sweep, p);
+}
+
+void PackedPathBuilder::closePath()
+{
+    if (_in_path) {
+        _out->close();
+        flush();
+    }
+}
+
+void PackedPathBuilder::flush()
+{
+    _in_path = false;
+}
+
+bool PackedPathBuilder::backspace()
+{
+    if (_in_path) {
+        return _out->eraseLast();
+    }
+    return false;
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
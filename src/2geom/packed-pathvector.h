@@ -0,0 +1,320 @@
+/** @file
+ * @brief Path sequence stored in packed, type-segregated arrays
+ *//*
+ * Copyright 2016 authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#ifndef LIB2GEOM_SEEN_PACKED_PATHVECTOR_H
+#define LIB2GEOM_SEEN_PACKED_PATHVECTOR_H
+
+#include <vector>
+#include <boost/concept/requires.hpp>
+#include <boost/optional.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+#include <2geom/forward.h>
+#include <2geom/curves.h>
+#include <2geom/pathvector.h>
+#include <2geom/path-sink.h>
+#include <2geom/transforms.h>
+
+namespace Geom {
+
+/** @brief Sequence of paths stored in contiguous arrays.
+ *
+ * Path keeps every segment in a separate heap allocation behind a virtual pointer.
+ * This is convenient for editing, but loops over millions of segments spend most
+ * of their time chasing pointers. PackedPathVector stores the same data in packed
+ * arrays segregated by segment type: line segments, quadratic and cubic Beziers
+ * are kept as runs of control points, elliptical arcs as an array of values.
+ * Other curve types, such as higher-order Beziers, are stored out of line.
+ *
+ * Bounding boxes, winding numbers and transforms are computed by looping over
+ * the arrays directly, without virtual calls or allocations. The results are
+ * identical to the ones obtained from the equivalent PathVector.
+ *
+ * Individual paths can be inspected through PathView, which provides a subset
+ * of the Path interface, including iteration over <tt>Curve const &</tt>.
+ * Curves other than arcs are materialized on demand inside the iterator, so
+ * the returned reference is only valid until the iterator is modified or destroyed.
+ *
+ * @ingroup Paths */
+class PackedPathVector {
+public:
+    typedef std::size_t size_type;
+
+    /// Types of segments stored in the segment table.
+    enum SegmentKind {
+        LINE_SEGMENT = 0,
+        QUADRATIC_BEZIER,
+        CUBIC_BEZIER,
+        ELLIPTICAL_ARC,
+        OTHER_CURVE,
+        SEGMENT_KIND_COUNT
+    };
+
+    class PathView;
+
+    /** @brief Iterator over the curves of a single packed path.
+     * Dereferencing yields a curve materialized inside the iterator. */
+    class CurveIterator {
+    public:
+        CurveIterator() : _pv(NULL), _path(0), _index(0) {}
+
+        Curve const &operator*() const { return _pv->_curveAt(_path, _index, *this); }
+        Curve const *operator->() const { return &**this; }
+
+        CurveIterator &operator++() { ++_index; return *this; }
+        CurveIterator operator++(int) { CurveIterator r(*this); ++_index; return r; }
+        CurveIterator &operator--() { --_index; return *this; }
+        CurveIterator operator--(int) { CurveIterator r(*this); --_index; return r; }
+
+        bool operator==(CurveIterator const &other) const {
+            return _pv == other._pv && _path == other._path && _index == other._index;
+        }
+        bool operator!=(CurveIterator const &other) const { return !(*this == other); }
+
+    private:
+        CurveIterator(PackedPathVector const &pv, size_type path, size_type index)
+            : _pv(&pv), _path(path), _index(index) {}
+
+        PackedPathVector const *_pv;
+        size_type _path;
+        size_type _index;
+        mutable boost::optional<LineSegment> _line;
+        mutable boost::optional<QuadraticBezier> _quad;
+        mutable boost::optional<CubicBezier> _cubic;
+
+        friend class PackedPathVector;
+        friend class PathView;
+    };
+
+    /** @brief Lightweight read-only view of a single packed path.
+     * The view is invalidated when the underlying PackedPathVector is modified. */
+    class PathView {
+    public:
+        typedef CurveIterator const_iterator;
+
+        size_type size_open() const { return _pv->_segmentCount(_path); }
+        size_type size_closed() const {
+            return size_open() + (_closingDegenerate() ? 0 : 1);
+        }
+        size_type size() const { return closed() ? size_closed() : size_open(); }
+        bool empty() const { return size_open() == 0; }
+        bool closed() const { return _pv->_paths[_path].closed; }
+
+        Point initialPoint() const { return _pv->_paths[_path].initial; }
+        Point finalPoint() const {
+            PathRecord const &r = _pv->_paths[_path];
+            return r.closed ? r.initial : r.final;
+        }
+
+        const_iterator begin() const { return const_iterator(*_pv, _path, 0); }
+        const_iterator end() const { return const_iterator(*_pv, _path, size()); }
+        const_iterator end_open() const { return const_iterator(*_pv, _path, size_open()); }
+        const_iterator end_closed() const { return const_iterator(*_pv, _path, size_closed()); }
+
+        /// Kind of the segment at the given index, including the closing segment.
+        SegmentKind kind(size_type i) const;
+
+        OptRect boundsFast() const { return _pv->_paths[_path].bounds; }
+        OptRect boundsExact() const { return _pv->_boundsExact(_path); }
+        int winding(Point const &p) const { return _pv->_winding(_path, p); }
+
+        /// Create a regular path with the same contents.
+        Path toPath() const;
+
+    private:
+        PathView(PackedPathVector const &pv, size_type path) : _pv(&pv), _path(path) {}
+        bool _closingDegenerate() const {
+            PathRecord const &r = _pv->_paths[_path];
+            return r.initial == r.final;
+        }
+
+        PackedPathVector const *_pv;
+        size_type _path;
+
+        friend class PackedPathVector;
+    };
+
+    PackedPathVector() {}
+    explicit PackedPathVector(PathVector const &pv) { insert(pv); }
+    explicit PackedPathVector(Path const &p) { push_back(p); }
+
+    /// Number of paths.
+    size_type size() const { return _paths.size(); }
+    bool empty() const { return _paths.empty(); }
+    /// Total number of stored segments, excluding closing segments.
+    size_type curveCount() const { return _segments.size(); }
+    /// Number of stored segments of the given kind.
+    size_type curveCount(SegmentKind kind) const { return _kindSize(kind); }
+
+    PathView operator[](size_type i) const { return PathView(*this, i); }
+    PathView front() const { return PathView(*this, 0); }
+    PathView back() const { return PathView(*this, _paths.size() - 1); }
+
+    void clear();
+    void reserve(size_type paths, size_type segments);
+
+    /// Append a copy of a regular path.
+    void push_back(Path const &path);
+    /// Append copies of all paths in a path vector.
+    void insert(PathVector const &pv);
+
+    /// @name Build the last path incrementally
+    /// @{
+    /// Start a new, empty path at the given point.
+    void start(Point const &p);
+    void appendLine(Point const &p);
+    void appendQuadratic(Point const &c, Point const &p);
+    void appendCubic(Point const &c0, Point const &c1, Point const &p);
+    void appendArc(Coord rx, Coord ry, Coord angle, bool large_arc, bool sweep, Point const &p);
+    /** @brief Append a copy of a curve to the last path.
+     * The curve's initial point must be equal to the last path's final point. */
+    void append(Curve const &c);
+    /** @brief Set whether the last path is closed.
+     * Works the same way as Path::close(). */
+    void close(bool closed = true);
+    /// Remove the last segment of the last path, if there is one.
+    bool eraseLast();
+    /// @}
+
+    /// Convert back to a regular path vector.
+    PathVector toPathVector() const;
+    /// Output all paths to a sink.
+    void feed(PathSink &sink) const;
+
+    OptRect boundsFast() const;
+    OptRect boundsExact() const;
+
+    /** @brief Determine the winding number at the specified point.
+     * The result is the same as for PathVector::winding(). */
+    int winding(Point const &p) const;
+
+    /** @brief Apply a transform to all stored data.
+     * The control points of all Bezier segments are transformed in a single pass
+     * over the packed arrays. */
+    template <typename T>
+    BOOST_CONCEPT_REQUIRES(((TransformConcept<T>)), (PackedPathVector &))
+    operator*=(T const &tr) {
+        for (size_type i = 0; i < _arcs.size(); ++i) {
+            _arcs[i] *= tr;
+        }
+        for (size_type i = 0; i < _others.size(); ++i) {
+            _others[i] *= tr;
+        }
+        _transformPoints(tr);
+        return *this;
+    }
+
+private:
+    struct PathRecord {
+        size_type first[SEGMENT_KIND_COUNT]; ///< Start index in each typed array
+        size_type first_segment;             ///< Start index in the segment table
+        Point initial;
+        Point final;                         ///< Final point of the last stored segment
+        OptRect bounds;
+        bool closed;
+    };
+
+    // number of control points stored per segment of each Bezier kind
+    static size_type _pointsPerSegment(SegmentKind k) { return k + 2; }
+
+    size_type _kindSize(SegmentKind k) const;
+    size_type _kindEnd(size_type path, SegmentKind k) const;
+    size_type _segmentCount(size_type path) const;
+    SegmentKind _segmentKind(size_type path, size_type i) const;
+    size_type _segmentIndex(size_type path, size_type i) const;
+    void _pushSegment(SegmentKind k, Rect const &bounds);
+    void _ensurePath();
+    void _updateBounds(size_type path);
+    void _transformPoints(Affine const &m);
+    OptRect _boundsExact(size_type path) const;
+    int _winding(size_type path, Point const &p) const;
+    Curve const &_curveAt(size_type path, size_type i, CurveIterator const &cache) const;
+    Curve *_duplicateCurve(size_type path, size_type i) const;
+
+    std::vector<PathRecord> _paths;
+    std::vector<size_type> _segments; // (index << 3) | kind
+    std::vector<Point> _lines;        // 2 points per segment
+    std::vector<Point> _quads;        // 3 points per segment
+    std::vector<Point> _cubics;       // 4 points per segment
+    std::vector<EllipticalArc> _arcs;
+    boost::ptr_vector<Curve> _others;
+};
+
+/** @brief Store paths to a PackedPathVector.
+ * Follows the same conventions as PathBuilder.
+ * @ingroup Paths */
+class PackedPathBuilder : public PathSink {
+public:
+    /// Create a builder that outputs to an internal packed vector.
+    PackedPathBuilder() : _out(&_storage), _in_path(false) {}
+    /// Create a builder that appends to the given packed vector.
+    explicit PackedPathBuilder(PackedPathVector &out) : _out(&out), _in_path(false) {}
+
+    void moveTo(Point const &p);
+    void lineTo(Point const &p);
+    void quadTo(Point const &c, Point const &p);
+    void curveTo(Point const &c0, Point const &c1, Point const &p);
+    void arcTo(Coord rx, Coord ry, Coord angle, bool large_arc, bool sweep, Point const &p);
+    void closePath();
+    void flush();
+    bool backspace();
+
+    /// Retrieve the stored paths.
+    PackedPathVector const &peek() const { return *_out; }
+    /// Clear the stored paths.
+    void clear() { _out->clear(); _in_path = false; }
+
+private:
+    // not copyable, since _out can point to _storage
+    PackedPathBuilder(PackedPathBuilder const &);
+    PackedPathBuilder &operator=(PackedPathBuilder const &);
+
+    void _implicitMoveTo() {
+        if (!_in_path) moveTo(_start_p);
+    }
+
+    PackedPathVector _storage;
+    PackedPathVector *_out;
+    Point _start_p;
+    bool _in_path;
+};
+
+} // end namespace Geom
+
+#endif // LIB2GEOM_SEEN_PACKED_PATHVECTOR_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
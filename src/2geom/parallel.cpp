@@ -0,0 +1,223 @@
+/** @file
+ * @brief Running independent work items on multiple threads
+ *//*
+ * Copyright 2016 authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/parallel.h>
+
+#ifdef CPP11
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+namespace Geom {
+
+namespace {
+
+unsigned requested_threads = 1;
+
+#ifdef CPP11
+
+// set in worker threads and while the calling thread processes items
+thread_local bool inside_task = false;
+
+/* Worker threads are started on first use and kept around until exit.
+ * Each call to run() publishes a new job by incrementing the generation counter.
+ * Items are claimed in chunks from an atomic counter by the workers
+ * and by the calling thread. */
+class WorkerPool {
+public:
+    static WorkerPool &get() {
+        static WorkerPool pool;
+        return pool;
+    }
+
+    void run(ParallelTask &task, std::size_t n, unsigned threads) {
+        std::lock_guard<std::mutex> run_lock(_run_mutex);
+        unsigned helpers = threads - 1;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            while (_threads.size() < helpers) {
+                _threads.push_back(std::thread(&WorkerPool::_worker, this, _threads.size()));
+            }
+            _task = &task;
+            _size = n;
+            // several chunks per thread give some load balancing
+            _chunk = std::max<std::size_t>(1, n / (8 * threads));
+            _next = 0;
+            _helpers = helpers;
+            _busy = helpers;
+            _error = std::exception_ptr();
+            ++_generation;
+        }
+        _wake.notify_all();
+
+        inside_task = true;
+        _work();
+        inside_task = false;
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this] { return _busy == 0; });
+        _task = nullptr;
+        if (_error) {
+            std::rethrow_exception(_error);
+        }
+    }
+
+private:
+    WorkerPool()
+        : _task(nullptr)
+        , _size(0)
+        , _chunk(1)
+        , _next(0)
+        , _generation(0)
+        , _helpers(0)
+        , _busy(0)
+        , _quit(false)
+    {}
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _quit = true;
+        }
+        _wake.notify_all();
+        for (std::size_t i = 0; i < _threads.size(); ++i) {
+            _threads[i].join();
+        }
+    }
+
+    void _worker(std::size_t id) {
+        inside_task = true;
+        unsigned long seen = 0;
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            _wake.wait(lock, [&] { return _quit || _generation != seen; });
+            if (_quit) return;
+            seen = _generation;
+            // the thread count may have been lowered since this thread was started
+            if (id >= _helpers) continue;
+
+            lock.unlock();
+            _work();
+            lock.lock();
+            if (--_busy == 0) {
+                _done.notify_all();
+            }
+        }
+    }
+
+    void _work() {
+        while (true) {
+            std::size_t begin = _next.fetch_add(_chunk);
+            if (begin >= _size) return;
+            std::size_t end = std::min(begin + _chunk, _size);
+            try {
+                for (std::size_t i = begin; i < end; ++i) {
+                    _task->run(i);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_error) {
+                    _error = std::current_exception();
+                }
+                // skip all remaining items
+                _next = _size;
+                return;
+            }
+        }
+    }
+
+    std::mutex _run_mutex;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+    std::vector<std::thread> _threads;
+
+    ParallelTask *_task;
+    std::size_t _size;
+    std::size_t _chunk;
+    std::atomic<std::size_t> _next;
+    unsigned long _generation;
+    unsigned _helpers;
+    unsigned _busy;
+    bool _quit;
+    std::exception_ptr _error;
+};
+
+#endif // CPP11
+
+} // end anonymous namespace
+
+void set_thread_count(unsigned n)
+{
+    requested_threads = n;
+}
+
+unsigned thread_count()
+{
+#ifdef CPP11
+    if (requested_threads == 0) {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+    return requested_threads;
+#else
+    return 1;
+#endif
+}
+
+void parallel_run(ParallelTask &task, std::size_t n)
+{
+#ifdef CPP11
+    unsigned threads = std::min<std::size_t>(thread_count(), n);
+    if (threads > 1 && !inside_task) {
+        WorkerPool::get().run(task, n, threads);
+        return;
+    }
+#endif
+    for (std::size_t i = 0; i < n; ++i) {
+        task.run(i);
+    }
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,81 @@
+/** @file
+ * @brief Running independent work items on multiple threads
+ *//*
+ * Copyright 2016 authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#ifndef LIB2GEOM_SEEN_PARALLEL_H
+#define LIB2GEOM_SEEN_PARALLEL_H
+
+#include <cstddef>
+
+namespace Geom {
+
+/** @brief Set the number of threads used by parallelized algorithms.
+ * The default is 1, which means that all computations are done on the calling thread.
+ * Passing 0 selects the number of hardware threads. Worker threads are only available
+ * when the library is built with C++11 support; otherwise this setting has no effect.
+ * @ingroup Utilities */
+void set_thread_count(unsigned n);
+
+/** @brief Get the number of threads used by parallelized algorithms.
+ * @ingroup Utilities */
+unsigned thread_count();
+
+/** @brief Work that can be split into independent items.
+ * @ingroup Utilities */
+class ParallelTask {
+public:
+    virtual ~ParallelTask() {}
+    /** @brief Process a single item.
+     * This can be called concurrently for different items, so it must not modify
+     * any data shared with other items. Results should be stored in slots indexed
+     * by the item number, which also keeps the output independent of scheduling. */
+    virtual void run(std::size_t i) = 0;
+};
+
+/** @brief Call task.run(i) for each i in [0, n).
+ * Items are distributed among the worker threads and the calling thread.
+ * The function returns when all items are processed. If any item throws,
+ * the remaining items are skipped and the first exception is rethrown.
+ * Nested calls from within a task are run serially.
+ * @ingroup Utilities */
+void parallel_run(ParallelTask &task, std::size_t n);
+
+} // end namespace Geom
+
+#endif // LIB2GEOM_SEEN_PARALLEL_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
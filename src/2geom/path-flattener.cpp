@@ -0,0 +1,169 @@
+/** @file
+ * @brief Conversion of curves to polylines within a tolerance
+ *//*
+ * Copyright 2016 authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <2geom/bezier-curve.h>
+#include <2geom/elliptical-arc.h>
+#include <2geom/path.h>
+#include <2geom/path-flattener.h>
+#include <2geom/pathvector.h>
+
+namespace Geom {
+
+namespace {
+
+// upper limit on the number of line segments a single curve is flattened into
+unsigned const MAX_SEGMENTS = 1 << 16;
+
+// largest norm of the second differences of the control points
+Coord max_second_difference(BezierCurve const &b)
+{
+    Coord result = 0;
+    for (unsigned i = 0; i + 2 <= b.order(); ++i) {
+        result = std::max(result, L2(b[i] - 2 * b[i+1] + b[i+2]));
+    }
+    return result;
+}
+
+unsigned arc_segment_count(EllipticalArc const &arc, Coord tolerance)
+{
+    // Uniform angle steps map to uniform steps on the unit circle, where the sagitta
+    // of a chord spanning the angle a is 1 - cos(a/2). The affine map to the ellipse
+    // scales distances by at most the larger ray.
+    Coord r = std::max(arc.ray(X), arc.ray(Y));
+    Coord step = tolerance < r ? 2 * std::acos(1 - tolerance / r) : M_PI / 2;
+    Coord n = std::ceil(arc.angularExtent() / step);
+    if (!(n < MAX_SEGMENTS)) return MAX_SEGMENTS;
+    return std::max(unsigned(n), 1u);
+}
+
+} // end anonymous namespace
+
+/* For a curve with continuous second derivative bounded by M, the chord between
+ * times differing by h stays within M h^2 / 8 of the curve. */
+unsigned PathFlattener::_count(Coord max_second_derivative) const
+{
+    Coord n = std::ceil(std::sqrt(max_second_derivative / (8 * _tolerance)));
+    if (!(n < MAX_SEGMENTS)) return MAX_SEGMENTS;
+    return std::max(unsigned(n), 1u);
+}
+
+unsigned PathFlattener::segmentCount(Curve const &c) const
+{
+    if (BezierCurve const *b = dynamic_cast<BezierCurve const *>(&c)) {
+        unsigned d = b->order();
+        if (d <= 1) return 1;
+        return _count(d * (d - 1) * max_second_difference(*b));
+    }
+    if (EllipticalArc const *arc = dynamic_cast<EllipticalArc const *>(&c)) {
+        if (arc->isChord()) return 1;
+        return arc_segment_count(*arc, _tolerance);
+    }
+    if (c.isLineSegment()) return 1;
+
+    OptRect dd = bounds_fast(derivative(derivative(c.toSBasis())));
+    if (!dd) return 1;
+    Coord mx = std::max(std::fabs((*dd)[X].min()), std::fabs((*dd)[X].max()));
+    Coord my = std::max(std::fabs((*dd)[Y].min()), std::fabs((*dd)[Y].max()));
+    return _count(hypot(mx, my));
+}
+
+void PathFlattener::flatten(Curve const &c, std::vector<Point> &out) const
+{
+    unsigned n = segmentCount(c);
+    std::size_t first = out.size();
+    out.resize(first + n);
+    Point *dest = &out[first];
+
+    if (n > 1) {
+        BezierCurve const *b = dynamic_cast<BezierCurve const *>(&c);
+        EllipticalArc const *arc = b ? NULL : dynamic_cast<EllipticalArc const *>(&c);
+        Coord step = 1.0 / n;
+
+        if (b && b->order() <= 3) {
+            // evaluate in the power basis: p0 + p1 t + p2 t^2 + p3 t^3
+            Point p0 = (*b)[0], p1, p2, p3;
+            if (b->order() == 2) {
+                p1 = 2 * ((*b)[1] - (*b)[0]);
+                p2 = (*b)[0] - 2 * (*b)[1] + (*b)[2];
+            } else {
+                p1 = 3 * ((*b)[1] - (*b)[0]);
+                p2 = 3 * ((*b)[0] - 2 * (*b)[1] + (*b)[2]);
+                p3 = (*b)[3] - (*b)[0] + 3 * ((*b)[1] - (*b)[2]);
+            }
+            for (unsigned i = 1; i < n; ++i) {
+                Coord t = i * step;
+                dest[i-1] = ((p3 * t + p2) * t + p1) * t + p0;
+            }
+        } else if (arc) {
+            Affine m = arc->unitCircleTransform();
+            Coord a0 = arc->initialAngle(), sweep = arc->sweepAngle();
+            for (unsigned i = 1; i < n; ++i) {
+                dest[i-1] = Point::polar(a0 + sweep * (i * step)) * m;
+            }
+        } else {
+            for (unsigned i = 1; i < n; ++i) {
+                dest[i-1] = c.pointAt(i * step);
+            }
+        }
+    }
+    dest[n-1] = c.finalPoint();
+}
+
+void PathFlattener::flatten(Path const &path, std::vector<Point> &out) const
+{
+    out.push_back(path.initialPoint());
+    for (Path::const_iterator i = path.begin(); i != path.end_default(); ++i) {
+        flatten(*i, out);
+    }
+}
+
+void PathFlattener::flatten(PathVector const &pv, std::vector<Point> &out,
+                            std::vector<std::size_t> &ends) const
+{
+    for (PathVector::const_iterator i = pv.begin(); i != pv.end(); ++i) {
+        flatten(*i, out);
+        ends.push_back(out.size());
+    }
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,110 @@
+/** @file
+ * @brief Conversion of curves to polylines within a tolerance
+ *//*
+ * Copyright 2016 authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#ifndef LIB2GEOM_SEEN_PATH_FLATTENER_H
+#define LIB2GEOM_SEEN_PATH_FLATTENER_H
+
+#include <vector>
+#include <2geom/forward.h>
+#include <2geom/point.h>
+
+namespace Geom {
+
+/** @brief Approximate curves with polylines.
+ *
+ * The flattener replaces each curve with a polyline whose distance from the curve
+ * does not exceed the tolerance. The number of segments is computed up front from a bound
+ * on the second derivative of the curve, and the curve is then sampled at uniform time steps.
+ * For Bezier curves this is Wang's formula, which bounds the second derivative using
+ * the second differences of the control points; elliptical arcs are sampled at uniform
+ * angles. Other curves are bounded through their S-basis representation.
+ *
+ * The points are appended to a vector supplied by the caller. Clearing the vector and
+ * reusing it for the next call avoids any memory allocation once it has grown large enough:
+ * @code
+   PathFlattener flattener(0.25);
+   std::vector<Point> points;
+   for (...) {
+       points.clear();
+       flattener.flatten(path, points);
+       // use points
+   }
+   @endcode
+ *
+ * @ingroup Paths */
+class PathFlattener {
+public:
+    /** @brief Create a flattener.
+     * @param tolerance Maximum distance between a curve and its polyline */
+    explicit PathFlattener(Coord tolerance = 0.1)
+        : _tolerance(tolerance)
+    {}
+
+    Coord tolerance() const { return _tolerance; }
+    void setTolerance(Coord tolerance) { _tolerance = tolerance; }
+
+    /// Number of line segments used to approximate the curve.
+    unsigned segmentCount(Curve const &c) const;
+
+    /** @brief Append the polyline approximating a curve.
+     * The initial point of the curve is not appended, so that consecutive curves
+     * of a path can be flattened into the same vector. The last appended point
+     * is always the final point of the curve. */
+    void flatten(Curve const &c, std::vector<Point> &out) const;
+    /** @brief Append the polyline approximating a path.
+     * The initial point of the path is appended first. For closed paths,
+     * the closing segment is included, so the last point equals the first one. */
+    void flatten(Path const &path, std::vector<Point> &out) const;
+    /** @brief Append polylines approximating all paths of a path vector.
+     * @param pv Paths to flatten
+     * @param out Vector receiving the points of all paths
+     * @param ends Vector receiving, for each path, the index in @a out
+     *             one past its last point */
+    void flatten(PathVector const &pv, std::vector<Point> &out,
+                 std::vector<std::size_t> &ends) const;
+
+private:
+    unsigned _count(Coord max_second_derivative) const;
+    Coord _tolerance;
+};
+
+} // end namespace Geom
+
+#endif // LIB2GEOM_SEEN_PATH_FLATTENER_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
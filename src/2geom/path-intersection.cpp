@@ -1,6 +1,9 @@
 #include <2geom/path-intersection.h>
 
+#include <2geom/monotone-decomposition.h>
 #include <2geom/ord.h>
+#include <2geom/predicates.h>
+#include <algorithm>
 
 //for path_direction:
 #include <2geom/sbasis-geometric.h>
@@ -81,7 +84,8 @@ linear_intersect(Point const &A0, Point const &A1, Point const &B0, Point const
     Point Ad = A1 - A0,
           Bd = B1 - B0,
            d = B0 - A0;
-    det = cross(Ad, Bd);
+    // the sign of the determinant is exact, so it reliably gives the crossing direction
+    det = cross_difference(A0, A1, B0, B1);
 
     double det_rel = det; // Calculate the determinant of the normalized vectors
     if (both_lines_non_zero) {
@@ -103,7 +107,17 @@ linear_intersect(Point const &A0, Point const &A1, Point const &B0, Point const
     double detinv = 1.0 / det;
     tA = cross(d, Bd) * detinv;
     tB = cross(d, Ad) * detinv;
-    return (tA >= 0.) && (tA <= 1.) && (tB >= 0.) && (tB <= 1.);
+    if (!both_lines_non_zero) {
+        return (tA >= 0.) && (tA <= 1.) && (tB >= 0.) && (tB <= 1.);
+    }
+
+    /* Decide with exact predicates whether the segments intersect. The rounded times
+     * can be slightly outside of the unit interval when the intersection is at an
+     * endpoint, in which case it would be missed and the curves subdivided further. */
+    if (!segments_intersect(A0, A1, B0, B1)) return false;
+    tA = std::min(std::max(tA, 0.), 1.);
+    tB = std::min(std::max(tB, 0.), 1.);
+    return true;
 }
 
 
@@ -406,14 +420,19 @@ std::vector<double> offset_doubles(std::vector<double> const &x, double offs) {
 /**
  * Finds all the monotonic splits for a path.  Only includes the split between
  * curves if they switch derivative directions at that point.
+ * The splits of the curves are taken from the cached monotone decomposition.
  */
 std::vector<double> path_mono_splits(Path const &p) {
     std::vector<double> ret;
     if(p.empty()) return ret;
     
+    MonotoneDecomposition const &md = p.monotoneDecomposition();
+    std::vector<double> cspl;
     bool pdx=2, pdy=2;  //Previous derivative direction
     for(unsigned i = 0; i < p.size(); i++) {
-        std::vector<double> spl = offset_doubles(curve_mono_splits(p[i]), i);
+        cspl.clear();
+        md.splitTimes(i, cspl);
+        std::vector<double> spl = offset_doubles(cspl, i);
         bool dx = p[i].initialPoint()[X] > (spl.empty()? p[i].finalPoint()[X] :
                                                          p.valueAt(spl.front(), X));
         bool dy = p[i].initialPoint()[Y] > (spl.empty()? p[i].finalPoint()[Y] :
@@ -549,18 +568,22 @@ CrossingSet crossings_among(PathVector const &p) {
 */
 
 
-Crossings curve_self_crossings(Curve const &a) {
+/** Finds the self crossings of a curve, given its monotonic pieces. */
+static Crossings curve_self_crossings(Curve const &a, MonotoneDecomposition::const_iterator first,
+                                      MonotoneDecomposition::const_iterator last) {
     Crossings res;
-    std::vector<double> spl;
-    spl.push_back(0);
-    append(spl, curve_mono_splits(a));
-    spl.push_back(1);
-    for(unsigned i = 1; i < spl.size(); i++)
-        for(unsigned j = i+1; j < spl.size(); j++)
-            pair_intersect(a, spl[i-1], spl[i], a, spl[j-1], spl[j], res);
+    for(MonotoneDecomposition::const_iterator i = first; i != last; ++i)
+        for(MonotoneDecomposition::const_iterator j = i + 1; j != last; ++j)
+            pair_intersect(a, i->t0, i->t1, a, j->t0, j->t1, res);
     return res;
 }
 
+Crossings curve_self_crossings(Curve const &a) {
+    MonotoneDecomposition md;
+    md.addCurve(a);
+    return curve_self_crossings(a, md.begin(0), md.end(0));
+}
+
 /*
 void mono_curve_intersect(Curve const & A, double Al, double Ah, 
                           Curve const & B, double Bl, double Bh,
@@ -658,31 +681,18 @@ Crossings path_self_crossings(Path const &p) {
 }
 */
 
+/** Finds the self crossings of a path. They are computed by Path::intersectSelf(),
+ * so the points where the path joins consecutive curves are not reported. */
 Crossings self_crossings(Path const &p) {
     Crossings ret;
-    std::vector<std::vector<unsigned> > cull = sweep_bounds(bounds(p));
-    for(unsigned i = 0; i < cull.size(); i++) {
-        Crossings res = curve_self_crossings(p[i]);
-        offset_crossings(res, i, i);
-        append(ret, res);
-        for(unsigned jx = 0; jx < cull[i].size(); jx++) {
-            unsigned j = cull[i][jx];
-            res.clear();
-            pair_intersect(p[i], 0, 1, p[j], 0, 1, res);
-            
-            //if(fabs(int(i)-j) == 1 || fabs(int(i)-j) == p.size()-1) {
-                Crossings res2;
-                for(unsigned k = 0; k < res.size(); k++) {
-                    if(res[k].ta != 0 && res[k].ta != 1 && res[k].tb != 0 && res[k].tb != 1) {
-                        res2.push_back(res[k]);
-                    }
-                }
-                res = res2;
-            //}
-            offset_crossings(res, i, j);
-            append(ret, res);
-        }
+    std::vector<PathIntersection> xs = p.intersectSelf();
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        PathTime const &ta = xs[i].first, &tb = xs[i].second;
+        Point da = p[ta.curve_index].unitTangentAt(ta.t);
+        Point db = p[tb.curve_index].unitTangentAt(tb.t);
+        ret.push_back(Crossing(ta.curve_index + ta.t, tb.curve_index + tb.t, cross(da, db) > 0));
     }
+    sort_crossings(ret, 0);
     return ret;
 }
 
@@ -38,16 +38,118 @@
 #include <2geom/circle.h>
 #include <2geom/ellipse.h>
 #include <2geom/convex-hull.h>
+#include <2geom/monotone-decomposition.h>
+#include <2geom/monotone-sweep.h>
 #include <2geom/svg-path-writer.h>
 #include <2geom/sweeper.h>
+#include <2geom/winding-batch.h>
 #include <algorithm>
 #include <limits>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 using std::swap;
 using namespace Geom::PathInternal;
 
 namespace Geom {
 
+namespace PathInternal {
+
+/* The cached value is written only by the thread which moved the state from CACHE_EMPTY
+ * to CACHE_WRITING, and read only after observing CACHE_READY, which is stored with
+ * release semantics once the value is written. */
+
+BoundsCache &BoundsCache::operator=(BoundsCache const &other)
+{
+    OptRect bounds;
+    if (other.get(bounds)) {
+        store(bounds);
+    } else {
+        clear();
+    }
+    return *this;
+}
+
+bool BoundsCache::get(OptRect &bounds) const
+{
+#ifdef _MSC_VER
+    // volatile accesses have acquire and release semantics in MSVC
+    long state = *static_cast<long const volatile *>(&_state);
+#else
+    long state = __atomic_load_n(&_state, __ATOMIC_ACQUIRE);
+#endif
+    if (state != CACHE_READY) return false;
+    bounds = _bounds;
+    return true;
+}
+
+void BoundsCache::set(OptRect const &bounds) const
+{
+    // if another thread is already storing the bounds, it will store the same value
+#ifdef _MSC_VER
+    bool claimed = _InterlockedCompareExchange(&_state, CACHE_WRITING, CACHE_EMPTY)
+        == CACHE_EMPTY;
+#else
+    long expected = CACHE_EMPTY;
+    bool claimed = __atomic_compare_exchange_n(&_state, &expected, long(CACHE_WRITING), false,
+                                               __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+#endif
+    if (claimed) {
+        _bounds = bounds;
+        _publish();
+    }
+}
+
+void BoundsCache::store(OptRect const &bounds)
+{
+    _bounds = bounds;
+    _publish();
+}
+
+void BoundsCache::_publish() const
+{
+#ifdef _MSC_VER
+    *static_cast<long volatile *>(&_state) = CACHE_READY;
+#else
+    __atomic_store_n(&_state, long(CACHE_READY), __ATOMIC_RELEASE);
+#endif
+}
+
+MonotoneDecomposition const *DecompositionCache::get() const
+{
+#ifdef _MSC_VER
+    return *static_cast<MonotoneDecomposition * const volatile *>(&_value);
+#else
+    return __atomic_load_n(&_value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+MonotoneDecomposition const *DecompositionCache::set(MonotoneDecomposition *d) const
+{
+#ifdef _MSC_VER
+    MonotoneDecomposition *current = static_cast<MonotoneDecomposition *>(
+        _InterlockedCompareExchangePointer(reinterpret_cast<void * volatile *>(&_value), d, NULL));
+    bool stored = current == NULL;
+#else
+    MonotoneDecomposition *current = NULL;
+    bool stored = __atomic_compare_exchange_n(&_value, &current, d, false,
+                                              __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+    if (stored) return d;
+    // another thread has computed the same decomposition
+    delete d;
+    return current;
+}
+
+void DecompositionCache::clear()
+{
+    delete _value;
+    _value = NULL;
+}
+
+} // namespace PathInternal
+
 // this represents an empty interval
 PathInterval::PathInterval()
     : _from(0, 0.0)
@@ -310,6 +412,9 @@ void Path::close(bool c)
         // replace it with the closing segment
         Sequence::iterator last = _data->curves.end() - 2;
         if (last->isLineSegment() && last->finalPoint() == initialPoint()) {
+            // the data may be shared with other paths, which must not change
+            _unshare();
+            last = _data->curves.end() - 2;
             _closing_seg->setInitial(last->initialPoint());
             _data->curves.erase(last);
         }
@@ -335,8 +440,8 @@ OptRect Path::boundsFast() const
         return bounds;
     }
     // if the path is not empty, we look for cached bounds
-    if (_data->fast_bounds) {
-        return _data->fast_bounds;
+    if (_data->fast_bounds.get(bounds)) {
+        return bounds;
     }
 
     bounds = front().boundsFast();
@@ -348,15 +453,63 @@ OptRect Path::boundsFast() const
             bounds.unionWith(iter->boundsFast());
         }
     }
-    _data->fast_bounds = bounds;
+    _data->fast_bounds.set(bounds);
+    return bounds;
+}
+
+/* Compute the cached fast bounds after a transform, if that can be done without looking
+ * at the curves. The fast bounds of Bezier curves are the bounding boxes of their control
+ * points; transforms which do not rotate or shear map them to the bounding boxes
+ * of the transformed control points, which are exactly the bounds that would be
+ * computed after the transform. */
+OptRect Path::_transformedBoundsFast(Affine const &m) const
+{
+    OptRect bounds;
+    if (m[1] != 0 || m[2] != 0) return bounds;
+    if (!_data->fast_bounds.get(bounds)) return bounds;
+    for (std::size_t i = 0; i < _data->curves.size(); ++i) {
+        if (!_data->curves[i].isBezier()) return OptRect();
+    }
+    if (bounds) {
+        *bounds *= m;
+    }
+    return bounds;
+}
+
+/* Compute the cached exact bounds after a transform. Transforms which do not rotate
+ * or shear map the extreme points of any curve to the extreme points of the transformed
+ * curve, so this works for all curve types. The result can differ from recomputed bounds
+ * only by rounding errors in the positions of the extrema. */
+OptRect Path::_transformedBoundsExact(Affine const &m) const
+{
+    OptRect bounds;
+    if (m[1] != 0 || m[2] != 0) return bounds;
+    if (_data->exact_bounds.get(bounds) && bounds) {
+        *bounds *= m;
+    }
     return bounds;
 }
 
+void Path::_storeBounds(OptRect const &fast, OptRect const &exact)
+{
+    // the data was unshared, so no other thread can be accessing the caches;
+    // the bounds of non-empty paths are never empty, so empty values are not cached
+    if (fast) {
+        _data->fast_bounds.store(fast);
+    }
+    if (exact) {
+        _data->exact_bounds.store(exact);
+    }
+}
+
 OptRect Path::boundsExact() const
 {
     OptRect bounds;
     if (empty())
         return bounds;
+    if (_data->exact_bounds.get(bounds)) {
+        return bounds;
+    }
     bounds = front().boundsExact();
     const_iterator iter = begin();
     // the closing path segment can be ignored, because it will always lie within the bbox of the rest of the path
@@ -365,9 +518,19 @@ OptRect Path::boundsExact() const
             bounds.unionWith(iter->boundsExact());
         }
     }
+    _data->exact_bounds.set(bounds);
     return bounds;
 }
 
+MonotoneDecomposition const &Path::monotoneDecomposition() const
+{
+    MonotoneDecomposition const *d = _data->monotone.get();
+    if (!d) {
+        d = _data->monotone.set(new MonotoneDecomposition(*this));
+    }
+    return *d;
+}
+
 Piecewise<D2<SBasis> > Path::toPwSb() const
 {
     Piecewise<D2<SBasis> > ret;
@@ -409,6 +572,9 @@ bool Path::operator==(Path const &other) const
 void Path::start(Point const &p) {
     if (_data->curves.size() > 1) {
         clear();
+    } else {
+        // the closing segment may be shared with copies of the path
+        _unshare();
     }
     _closing_seg->setInitial(p);
     _closing_seg->setFinal(p);
@@ -467,10 +633,22 @@ std::vector<PathTime> Path::roots(Coord v, Dim2 d) const
 // The class below implements sweepline optimization for curve intersection in paths.
 // Instead of O(N^2), this takes O(N + X), where X is the number of overlaps
 // between the bounding boxes of curves.
+//
+// Besides finding all intersections, it can stop as soon as any intersection is found,
+// or only look for the intersections with the smallest curve index on the first path.
+// In the latter mode, pairs whose curve on the first path comes after the best curve
+// found so far are skipped, and the sweep ends once all curves of the first path up to
+// the best one have been swept past, since no pairs involving them remain.
 
 struct CurveIntersectionSweepSet
 {
 public:
+    enum Mode {
+        FIND_ALL,
+        FIND_ANY,
+        FIND_FIRST
+    };
+
     struct CurveRecord {
         boost::intrusive::list_member_hook<> _hook;
         Curve const *curve;
@@ -489,13 +667,21 @@ public:
     typedef std::vector<CurveRecord>::const_iterator ItemIterator;
 
     CurveIntersectionSweepSet(std::vector<PathIntersection> &result,
-                              Path const &a, Path const &b, Coord precision)
+                              Path const &a, Path const &b, Coord precision,
+                              Mode mode = FIND_ALL)
         : _result(result)
         , _precision(precision)
         , _sweep_dir(X)
+        , _mode(mode)
+        , _done(false)
+        , _best(a.size())
+        , _pending(0)
     {
         std::size_t asz = a.size(), bsz = b.size();
         _records.reserve(asz + bsz);
+        if (mode == FIND_FIRST) {
+            _swept.resize(asz, false);
+        }
 
         for (std::size_t i = 0; i < asz; ++i) {
             _records.push_back(CurveRecord(&a[i], i, 0));
@@ -523,20 +709,42 @@ public:
 
         for (ActiveCurveList::iterator i = _active[ow].begin(); i != _active[ow].end(); ++i) {
             if (!ii->bounds.intersects(i->bounds)) continue;
-            std::vector<CurveIntersection> cx = ii->curve->intersect(*i->curve, _precision);
-            for (std::size_t k = 0; k < cx.size(); ++k) {
-                PathTime tw(ii->index, cx[k].first), tow(i->index, cx[k].second);
+            std::size_t aindex = w == 0 ? ii->index : i->index;
+            if (aindex > _best) continue;
+            // the scratch vector keeps its capacity, so most pairs do not allocate
+            _cx.clear();
+            ii->curve->intersect(*i->curve, _cx, _precision);
+            if (_cx.empty()) continue;
+
+            for (std::size_t k = 0; k < _cx.size(); ++k) {
+                PathTime tw(ii->index, _cx[k].first), tow(i->index, _cx[k].second);
                 _result.push_back(PathIntersection(
                                       w == 0 ? tw : tow,
                                       w == 0 ? tow : tw,
-                                      cx[k].point()));
+                                      _cx[k].point()));
+            }
+            if (_mode == FIND_ANY) {
+                _done = true;
+                return;
+            }
+            if (_mode == FIND_FIRST) {
+                _best = aindex;
             }
         }
     }
     void removeActiveItem(ItemIterator ii) {
         ActiveCurveList &acl = _active[ii->which];
         acl.erase(acl.iterator_to(*ii));
+
+        if (_mode == FIND_FIRST && ii->which == 0) {
+            _swept[ii->index] = true;
+            while (_pending < _swept.size() && _swept[_pending]) {
+                ++_pending;
+            }
+            _done = _pending > _best;
+        }
     }
+    bool done() const { return _done; }
 
 private:
     typedef boost::intrusive::list
@@ -550,28 +758,169 @@ private:
 
     std::vector<CurveRecord> _records;
     std::vector<PathIntersection> &_result;
+    std::vector<CurveIntersection> _cx;
     ActiveCurveList _active[2];
     Coord _precision;
     Dim2 _sweep_dir;
+    Mode _mode;
+    bool _done;
+    std::size_t _best; ///< Smallest index of a curve of the first path with an intersection
+    std::size_t _pending; ///< Smallest index of a curve of the first path not swept past yet
+    std::vector<bool> _swept;
+};
+
+// Intersects the pairs of monotonic pieces found by MonotoneSweep, skipping the points
+// where the path joins consecutive pieces.
+class SelfIntersectionHandler
+    : public MonotoneSweep::PairHandler
+{
+public:
+    SelfIntersectionHandler(MonotoneSweep const &sweep, std::vector<PathIntersection> &result,
+                            Coord precision)
+        : _sweep(sweep)
+        , _result(result)
+        , _portions(sweep.pieces().size(), static_cast<Curve *>(NULL))
+        , _precision(precision)
+    {}
+    ~SelfIntersectionHandler() {
+        for (std::size_t i = 0; i < _portions.size(); ++i) {
+            delete _portions[i];
+        }
+    }
+
+    void intersect(MonotoneSweep::Piece const &a, MonotoneSweep::Piece const &b,
+                   std::vector<Coord> &xs)
+    {
+        _cx.clear();
+        _portion(a).intersect(_portion(b), _cx, _precision);
+
+        for (std::size_t i = 0; i < _cx.size(); ++i) {
+            Point p = _cx[i].point();
+            PathTime ta(a.curve_index, lerp(_cx[i].first, a.t0, a.t1));
+            PathTime tb(b.curve_index, lerp(_cx[i].second, b.t0, b.t1));
+            if (_sweep.atJoint(a, ta.t, b, tb.t, p)) continue;
+            _result.push_back(PathIntersection(ta, tb, p));
+            xs.push_back(p[X]);
+        }
+    }
+
+private:
+    Curve const &_portion(MonotoneSweep::Piece const &p) {
+        if (p.t0 == 0 && p.t1 == 1) return *p.curve;
+        Curve *&c = _portions[p.index];
+        if (!c) {
+            c = p.curve->portion(p.t0, p.t1);
+        }
+        return *c;
+    }
+
+    MonotoneSweep const &_sweep;
+    std::vector<PathIntersection> &_result;
+    std::vector<Curve *> _portions;
+    std::vector<CurveIntersection> _cx;
+    Coord _precision;
 };
 
 std::vector<PathIntersection> Path::intersect(Path const &other, Coord precision) const
 {
     std::vector<PathIntersection> result;
+    intersect(other, result, precision);
+    return result;
+}
 
-    CurveIntersectionSweepSet cisset(result, *this, other, precision);
+void Path::intersect(Path const &other, std::vector<PathIntersection> &out, Coord precision) const
+{
+    std::size_t start = out.size();
+
+    CurveIntersectionSweepSet cisset(out, *this, other, precision);
     Sweeper<CurveIntersectionSweepSet> sweeper(cisset);
     sweeper.process();
 
     // preprocessing to remove duplicate intersections at endpoints
     std::size_t asz = size(), bsz = other.size();
+    for (std::size_t i = start; i < out.size(); ++i) {
+        out[i].first.normalizeForward(asz);
+        out[i].second.normalizeForward(bsz);
+    }
+    std::sort(out.begin() + start, out.end());
+    out.erase(std::unique(out.begin() + start, out.end()), out.end());
+}
+
+bool Path::intersects(Path const &other, Coord precision) const
+{
+    OptRect bounds = boundsFast(), obounds = other.boundsFast();
+    if (!bounds || !obounds || !bounds->intersects(*obounds)) return false;
+
+    std::vector<PathIntersection> xs;
+    CurveIntersectionSweepSet cisset(xs, *this, other, precision,
+                                     CurveIntersectionSweepSet::FIND_ANY);
+    Sweeper<CurveIntersectionSweepSet> sweeper(cisset);
+    sweeper.processUntilDone();
+    return !xs.empty();
+}
+
+boost::optional<PathIntersection> Path::firstIntersection(Path const &other, Coord precision) const
+{
+    boost::optional<PathIntersection> result;
+    OptRect bounds = boundsFast(), obounds = other.boundsFast();
+    if (!bounds || !obounds || !bounds->intersects(*obounds)) return result;
+
+    std::vector<PathIntersection> xs;
+    CurveIntersectionSweepSet cisset(xs, *this, other, precision,
+                                     CurveIntersectionSweepSet::FIND_FIRST);
+    Sweeper<CurveIntersectionSweepSet> sweeper(cisset);
+    sweeper.processUntilDone();
+    if (xs.empty()) return result;
+
+    // normalize the times in the same way as intersect()
+    std::size_t asz = size(), bsz = other.size();
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i].first.normalizeForward(asz);
+        xs[i].second.normalizeForward(bsz);
+    }
+    result = *std::min_element(xs.begin(), xs.end());
+    return result;
+}
+
+std::vector<PathIntersection> Path::intersectSelf(Coord precision) const
+{
+    std::vector<PathIntersection> result;
+    MonotoneSweep sweep(*this, precision);
+    SelfIntersectionHandler handler(sweep, result, precision);
+    sweep.process(handler);
+
+    std::size_t sz = size_default();
     for (std::size_t i = 0; i < result.size(); ++i) {
-        result[i].first.normalizeForward(asz);
-        result[i].second.normalizeForward(bsz);
+        PathIntersection &x = result[i];
+        // the final point of an open path has no next curve
+        if (_closed || x.first.curve_index + 1 < sz) x.first.normalizeForward(sz);
+        if (_closed || x.second.curve_index + 1 < sz) x.second.normalizeForward(sz);
+        if (x.second < x.first) {
+            std::swap(x.first, x.second);
+        }
     }
     std::sort(result.begin(), result.end());
-    result.erase(std::unique(result.begin(), result.end()), result.end());
 
+    // an intersection at the junction of two pieces is found with both of them
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        PathIntersection const &x = result[i];
+        bool duplicate = false;
+        for (std::size_t j = kept; j > 0; --j) {
+            PathIntersection const &y = result[j - 1];
+            if (x.first.asFlatTime() - y.first.asFlatTime() > EPSILON) break;
+            if (std::fabs(x.second.asFlatTime() - y.second.asFlatTime()) <= EPSILON
+                && are_near(x.point(), y.point(), precision))
+            {
+                duplicate = true;
+                break;
+            }
+        }
+        if (!duplicate) {
+            result[kept++] = x;
+        }
+    }
+    result.erase(result.begin() + kept, result.end());
     return result;
 }
 
@@ -581,8 +930,9 @@ int Path::winding(Point const &p) const {
     /* To handle all the edge cases, we consider the maximum Y edge of the bounding box
      * as not included in box. This way paths that contain linear horizontal
      * segments will be treated correctly. */
-    for (const_iterator i = begin(); i != end_closed(); ++i) {
-        Rect bounds = i->boundsFast();
+    for (size_type ci = 0; ci < size_closed(); ++ci) {
+        Curve const &c = _data->curves[ci];
+        Rect bounds = c.boundsFast();
 
         if (bounds.height() == 0) continue;
         if (p[X] > bounds.right() || !bounds[Y].lowerContains(p[Y])) {
@@ -594,8 +944,8 @@ int Path::winding(Point const &p) const {
             /* Ray intersects the curve's bbox, but the point is outside it.
              * The winding contribution is exactly the same as that
              * of a linear segment with the same initial and final points. */
-            Point ip = i->initialPoint();
-            Point fp = i->finalPoint();
+            Point ip = c.initialPoint();
+            Point fp = c.finalPoint();
             Rect eqbox(ip, fp);
 
             if (eqbox[Y].lowerContains(p[Y])) {
@@ -612,12 +962,58 @@ int Path::winding(Point const &p) const {
             }
         } else {
             // point is inside bbox
-            wind += i->winding(p);
+            wind += _windingInBounds(ci, p);
         }
     }
     return wind;
 }
 
+/* Winding contribution of a curve whose bounding box contains the point. The monotonic
+ * pieces which the ray might cross often all lie on one side of the point, in which
+ * case the contribution is known without solving for the crossings. The pieces are
+ * tested with a small margin, since their bounds are only as accurate as the split
+ * times; anything closer falls back to Curve::winding(). */
+int Path::_windingInBounds(size_type index, Point const &p) const
+{
+    Curve const &c = _data->curves[index];
+    // line segments are solved directly
+    if (c.isLineSegment()) {
+        return c.winding(p);
+    }
+
+    MonotoneDecomposition const &md = monotoneDecomposition();
+    bool left = false, right = false;
+    for (MonotoneDecomposition::const_iterator i = md.begin(index); i != md.end(index); ++i) {
+        Rect bounds = i->bounds();
+        Coord margin = EPSILON * (1 + bounds.maxExtent());
+        if (p[Y] < bounds.top() - margin || p[Y] > bounds.bottom() + margin) continue;
+        if (p[X] < bounds.left() - margin) {
+            right = true;
+        } else if (p[X] > bounds.right() + margin) {
+            left = true;
+        } else {
+            return c.winding(p);
+        }
+    }
+    if (left && right) {
+        return c.winding(p);
+    }
+    if (!right) {
+        // no piece near the ray lies to the right of the point
+        return 0;
+    }
+    // the ray crosses the whole curve, like the line between its endpoints
+    Point ip = c.initialPoint();
+    Point fp = c.finalPoint();
+    if (!Interval(ip[Y], fp[Y]).lowerContains(p[Y])) return 0;
+    return ip[Y] < fp[Y] ? 1 : -1;
+}
+
+void Path::winding(std::vector<Point> const &points, std::vector<int> &result) const
+{
+    BatchWinding(*this).winding(points, result);
+}
+
 PathVector Path::removeLineOverlap(PathVector const& other) const {
     PathVector result;
     std::vector<PathTime> intersections;
@@ -850,9 +1246,13 @@ PathTime Path::nearestTime(Point const &p, Coord *dist) const
         return ret;
     }
 
+    // a single query is cheaper than the decomposition, so it is only used when cached
+    MonotoneDecomposition const *md = _data->monotone.get();
     for (size_type i = 0; i < size_default(); ++i) {
         Curve const &c = at(i);
         if (distance(p, c.boundsFast()) >= mindist) continue;
+        // the pieces are tighter than the fast bounds
+        if (md && md->distanceBound(i, p) >= mindist) continue;
 
         Coord t = c.nearestTime(p);
         Coord d = distance(c.pointAt(t), p);
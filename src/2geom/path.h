@@ -39,6 +39,7 @@
 #include <algorithm>
 #include <iostream>
 #include <boost/operators.hpp>
+#include <boost/optional.hpp>
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <boost/shared_ptr.hpp>
 #include <2geom/intersection.h>
@@ -55,9 +56,77 @@ namespace PathInternal {
 
 typedef boost::ptr_vector<Curve> Sequence;
 
+/* Bounding box computed lazily by const methods. The value is published through a state
+ * word, which is accessed atomically in path.cpp, so the cache can be filled by several
+ * threads at once. Non-const methods must only be called when no other thread
+ * is accessing the cache. */
+class BoundsCache {
+public:
+    BoundsCache() : _state(CACHE_EMPTY) {}
+    BoundsCache(BoundsCache const &other) : _state(CACHE_EMPTY) { *this = other; }
+    BoundsCache &operator=(BoundsCache const &other);
+
+    /// Retrieve the cached value. Returns false if it has not been computed yet.
+    bool get(OptRect &bounds) const;
+    /// Store a computed value, unless another thread has already stored one.
+    void set(OptRect const &bounds) const;
+    /// Replace the cached value.
+    void store(OptRect const &bounds);
+    /// Discard the cached value.
+    void clear() { _state = CACHE_EMPTY; }
+
+private:
+    enum State {
+        CACHE_EMPTY,
+        CACHE_WRITING,
+        CACHE_READY
+    };
+    void _publish() const;
+
+    mutable OptRect _bounds; ///< Valid only when _state is CACHE_READY
+    mutable long _state;
+};
+
+/* Monotone decomposition computed lazily by const methods. The first published
+ * decomposition wins; the pointer is accessed atomically in path.cpp. As with BoundsCache,
+ * non-const methods must only be called when no other thread is accessing the cache. */
+class DecompositionCache {
+public:
+    DecompositionCache() : _value(NULL) {}
+    ~DecompositionCache() { clear(); }
+
+    /// Retrieve the cached value. Returns NULL if it has not been computed yet.
+    MonotoneDecomposition const *get() const;
+    /** Store a computed value and return the cached one. If another thread has already
+     * stored a value, the passed one is deleted. Takes ownership of @a d. */
+    MonotoneDecomposition const *set(MonotoneDecomposition *d) const;
+    /// Discard the cached value.
+    void clear();
+
+private:
+    DecompositionCache(DecompositionCache const &); // not implemented
+    DecompositionCache &operator=(DecompositionCache const &); // not implemented
+
+    mutable MonotoneDecomposition *_value;
+};
+
+/* Curve data shared between copies of a path. Paths sharing the same data can be used
+ * from several threads at once, as long as none of them is modified; the reference count
+ * of boost::shared_ptr is atomic, and a modified path always unshares its data first. */
 struct PathData {
     Sequence curves;
-    OptRect fast_bounds;
+    BoundsCache fast_bounds;
+    BoundsCache exact_bounds;
+    DecompositionCache monotone;
+
+    PathData() {}
+    // cached values are not copied, because the data is copied only before a modification
+    PathData(PathData const &other)
+        : curves(other.curves)
+    {}
+
+private:
+    PathData &operator=(PathData const &); // not implemented
 };
 
 template <typename P>
@@ -316,6 +385,13 @@ struct ShapeTraits<Path> {
  * Therefore you can return Path and PathVector from functions without worrying
  * about temporary copies.
  *
+ * Distinct Path objects can be used from different threads without locking, even when
+ * they share data, in the same way as standard containers: any number of threads can
+ * call const methods at the same time, and a path that is being modified must not be
+ * accessed by other threads. Copies of a path may be modified concurrently with const
+ * access to the original, because the modified copy unshares its data first. Values
+ * cached by const methods, such as the result of boundsFast(), are published atomically.
+ *
  * Note that this class cannot represent arbitrary shapes, which may contain holes.
  * To do that, use PathVector, which is more generic.
  *
@@ -496,22 +572,35 @@ public:
 
     /** @brief Get a tight-fitting bounding box.
      * This will return the smallest possible axis-aligned rectangle containing
-     * all the curves in the path. */
+     * all the curves in the path. The result is cached until the path is modified. */
     OptRect boundsExact() const;
 
+    /** @brief Get the split of the curves into pieces monotonic in both coordinates.
+     * The decomposition covers the curves up to size_closed(), even if the path is open,
+     * so its curve indices are the same as those of the path. It is computed on first use and cached
+     * until the path is modified; copies of the path share the cached value. The returned
+     * reference is valid until the path is modified or destroyed. */
+    MonotoneDecomposition const &monotoneDecomposition() const;
+
     Piecewise<D2<SBasis> > toPwSb() const;
 
     /// Test paths for exact equality.
     bool operator==(Path const &other) const;
 
-    /// Apply a transform to each curve.
+    /** @brief Apply a transform to each curve.
+     * If the transform does not rotate or shear, such as Translate, Scale and Zoom,
+     * the cached results of boundsFast() and boundsExact() are transformed along with
+     * the curves instead of being discarded. */
     template <typename T>
     Path &operator*=(T const &tr) {
         BOOST_CONCEPT_ASSERT((TransformConcept<T>));
+        OptRect fast = _transformedBoundsFast(tr);
+        OptRect exact = _transformedBoundsExact(tr);
         _unshare();
         for (std::size_t i = 0; i < _data->curves.size(); ++i) {
             _data->curves[i] *= tr;
         }
+        _storeBounds(fast, exact);
         return *this;
     }
 
@@ -561,6 +650,29 @@ public:
 
     /// Compute intersections with another path.
     std::vector<PathIntersection> intersect(Path const &other, Coord precision = EPSILON) const;
+    /** @brief Append intersections with another path to a vector.
+     * The appended intersections are the same, and in the same order, as those returned
+     * by intersect(Path const &, Coord). Existing elements of @a out are kept, so the vector
+     * can be reused for many queries without reallocation. */
+    void intersect(Path const &other, std::vector<PathIntersection> &out,
+                   Coord precision = EPSILON) const;
+    /** @brief Check whether this path intersects another path.
+     * Equivalent to <code>!intersect(other, precision).empty()</code>, but stops
+     * as soon as the first pair of intersecting curves is found. */
+    bool intersects(Path const &other, Coord precision = EPSILON) const;
+    /** @brief Find the intersection with the smallest time value on this path.
+     * Returns the first element of intersect(other, precision), or nothing when the paths
+     * do not intersect. Curve pairs which cannot contain an earlier intersection than
+     * the ones already found are not intersected, and the search stops as soon as
+     * the answer is known. */
+    boost::optional<PathIntersection> firstIntersection(Path const &other,
+                                                        Coord precision = EPSILON) const;
+    /** @brief Compute the intersections of the path with itself.
+     * Each intersection is reported once, with <code>first < second</code>. The points
+     * where consecutive curves join, including the initial point of a closed path,
+     * are not reported. The monotonic pieces of the curves are swept with MonotoneSweep,
+     * so only pieces which become neighbours in the sweep are intersected. */
+    std::vector<PathIntersection> intersectSelf(Coord precision = EPSILON) const;
 
     /** @brief Determine the winding number at the specified point.
      * 
@@ -574,6 +686,14 @@ public:
      * considered to be inside the path. */
     int winding(Point const &p) const;
 
+    /** @brief Determine the winding numbers of many points.
+     * This is much faster than calling winding() for each point, because the path
+     * is prepared only once. Use BatchWinding directly to reuse the preparation
+     * for several calls.
+     * @param points Points to classify
+     * @param result Vector which will be filled with the winding numbers of the points */
+    void winding(std::vector<Point> const &points, std::vector<int> &result) const;
+
     PathVector removeLineOverlap(PathVector const& other) const;
 
     std::vector<Coord> allNearestTimes(Point const &p, Coord from, Coord to) const;
@@ -839,9 +959,16 @@ private:
             _data.reset(new PathData(*_data));
             _closing_seg = static_cast<ClosingSegment*>(&_data->curves.back());
         }
-        _data->fast_bounds = OptRect();
+        // the data is not shared at this point, so no other thread can access the cache
+        _data->fast_bounds.clear();
+        _data->exact_bounds.clear();
+        _data->monotone.clear();
     }
     PathTime _factorTime(Coord t) const;
+    int _windingInBounds(size_type index, Point const &p) const;
+    OptRect _transformedBoundsFast(Affine const &m) const;
+    OptRect _transformedBoundsExact(Affine const &m) const;
+    void _storeBounds(OptRect const &fast, OptRect const &exact);
 
     void stitch(Sequence::iterator first_replaced, Sequence::iterator last_replaced, Sequence &sequence);
     void do_update(Sequence::iterator first, Sequence::iterator last, Sequence &source);
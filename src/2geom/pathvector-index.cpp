@@ -0,0 +1,344 @@
+/** @file
+ * @brief Bounding volume hierarchy for repeated queries on a path vector
+ *//*
+ * Copyright 2016 authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/pathvector-index.h>
+#include <algorithm>
+
+namespace Geom {
+
+namespace {
+
+// The tree is balanced, so this is enough for any number of items that fits in memory.
+unsigned const MAX_DEPTH = 64;
+
+/* Winding contribution of a single curve. This is the body of the loop
+ * in Path::winding(), so that the sum over all curves of a path vector
+ * is the same as PathVector::winding(). */
+int curve_winding(Curve const &c, Rect bounds, Point const &p)
+{
+    if (bounds.height() == 0) return 0;
+    if (p[X] > bounds.right() || !bounds[Y].lowerContains(p[Y])) {
+        return 0;
+    }
+    if (p[X] < bounds.left()) {
+        Point ip = c.initialPoint();
+        Point fp = c.finalPoint();
+        Rect eqbox(ip, fp);
+        if (eqbox[Y].lowerContains(p[Y])) {
+            return ip[Y] < fp[Y] ? 1 : -1;
+        }
+        return 0;
+    }
+    return c.winding(p);
+}
+
+template <typename T>
+struct CentroidLess {
+    CentroidLess(Dim2 d) : dim(d) {}
+    bool operator()(T const &a, T const &b) const {
+        return a.bounds[dim].middle() < b.bounds[dim].middle();
+    }
+    Dim2 dim;
+};
+
+} // end anonymous namespace
+
+PathVectorIndex::PathVectorIndex(PathVector const &pv, unsigned leaf_size)
+    : _pv(pv)
+{
+    if (leaf_size == 0) leaf_size = 1;
+
+    for (size_type i = 0; i < _pv.size(); ++i) {
+        Path const &path = _pv[i];
+        size_type begin = _items.size();
+        Item item;
+        item.path_index = i;
+        item.naked_moveto = false;
+        item.open_closing = false;
+
+        if (path.empty()) {
+            item.bounds = Rect(path.initialPoint(), path.initialPoint());
+            item.curve_index = 0;
+            item.naked_moveto = true;
+            _items.push_back(item);
+        } else {
+            // winding uses the closing segment even for open paths
+            for (size_type j = 0; j < path.size_closed(); ++j) {
+                item.bounds = path[j].boundsFast();
+                item.curve_index = j;
+                item.open_closing = j >= path.size_default();
+                _items.push_back(item);
+            }
+        }
+
+        PathEntry entry;
+        entry.root = _nodes.size();
+        _nodes.push_back(Node());
+        _build(_items, _nodes, entry.root, begin, _items.size(), leaf_size);
+        entry.bounds = _nodes[entry.root].bounds;
+        _paths.push_back(entry);
+    }
+
+    if (_paths.empty()) return;
+    _path_nodes.push_back(Node());
+    _build(_paths, _path_nodes, 0, 0, _paths.size(), leaf_size);
+}
+
+template <typename T>
+void PathVectorIndex::_build(std::vector<T> &items, std::vector<Node> &nodes,
+                             size_type node, size_type begin, size_type end, unsigned leaf_size)
+{
+    Rect bounds = items[begin].bounds;
+    Rect centroids(bounds.midpoint(), bounds.midpoint());
+    for (size_type i = begin + 1; i < end; ++i) {
+        bounds.unionWith(items[i].bounds);
+        centroids.expandTo(items[i].bounds.midpoint());
+    }
+    nodes[node].bounds = bounds;
+
+    if (end - begin <= leaf_size) {
+        nodes[node].first = begin;
+        nodes[node].count = end - begin;
+        return;
+    }
+
+    // split at the median centroid along the longer dimension
+    Dim2 d = centroids.width() >= centroids.height() ? X : Y;
+    size_type mid = begin + (end - begin) / 2;
+    std::nth_element(items.begin() + begin, items.begin() + mid, items.begin() + end,
+                     CentroidLess<T>(d));
+
+    size_type child = nodes.size();
+    nodes[node].first = child;
+    nodes[node].count = 0;
+    nodes.push_back(Node());
+    nodes.push_back(Node());
+    _build(items, nodes, child, begin, mid, leaf_size);
+    _build(items, nodes, child + 1, mid, end, leaf_size);
+}
+
+OptRect PathVectorIndex::bounds() const
+{
+    if (_path_nodes.empty()) return OptRect();
+    return _path_nodes[0].bounds;
+}
+
+int PathVectorIndex::winding(Point const &p) const
+{
+    if (_path_nodes.empty()) return 0;
+
+    int wind = 0;
+    size_type stack[MAX_DEPTH];
+    unsigned top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        Node const &node = _path_nodes[stack[--top]];
+        // paths whose bounding boxes do not contain the point have zero winding
+        if (!node.bounds.contains(p)) continue;
+        if (node.count == 0) {
+            stack[top++] = node.first;
+            stack[top++] = node.first + 1;
+            continue;
+        }
+        for (size_type i = node.first; i < node.first + node.count; ++i) {
+            if (_paths[i].bounds.contains(p)) {
+                _pathWinding(_paths[i], p, wind);
+            }
+        }
+    }
+    return wind;
+}
+
+void PathVectorIndex::_pathWinding(PathEntry const &path, Point const &p, int &wind) const
+{
+    size_type stack[MAX_DEPTH];
+    unsigned top = 0;
+    stack[top++] = path.root;
+
+    while (top > 0) {
+        Node const &node = _nodes[stack[--top]];
+        // only curves whose boxes intersect the ray towards +X can contribute
+        if (p[X] > node.bounds.right() || !node.bounds[Y].contains(p[Y])) continue;
+        if (node.count == 0) {
+            stack[top++] = node.first;
+            stack[top++] = node.first + 1;
+            continue;
+        }
+        for (size_type i = node.first; i < node.first + node.count; ++i) {
+            Item const &item = _items[i];
+            if (item.naked_moveto) continue;
+            wind += curve_winding(_curve(item), item.bounds, p);
+        }
+    }
+}
+
+boost::optional<PathVectorTime> PathVectorIndex::nearestTime(Point const &p, Coord *dist) const
+{
+    boost::optional<PathVectorTime> retval;
+    Coord mindist = infinity();
+
+    /* Both levels are searched depth-first, nearer child first. Nodes at exactly
+     * the best distance are still visited, so that ties resolve like in PathVector. */
+    size_type path_stack[MAX_DEPTH];
+    unsigned path_top = 0;
+    if (!_path_nodes.empty()) {
+        path_stack[path_top++] = 0;
+    }
+
+    while (path_top > 0) {
+        Node const &pnode = _path_nodes[path_stack[--path_top]];
+        if (distance(p, pnode.bounds) > mindist) continue;
+        if (pnode.count == 0) {
+            size_type a = pnode.first, b = pnode.first + 1;
+            if (distanceSq(p, _path_nodes[a].bounds) < distanceSq(p, _path_nodes[b].bounds)) {
+                std::swap(a, b);
+            }
+            path_stack[path_top++] = a;
+            path_stack[path_top++] = b;
+            continue;
+        }
+
+        for (size_type pi = pnode.first; pi < pnode.first + pnode.count; ++pi) {
+            size_type stack[MAX_DEPTH];
+            unsigned top = 0;
+            stack[top++] = _paths[pi].root;
+
+            while (top > 0) {
+                Node const &node = _nodes[stack[--top]];
+                if (distance(p, node.bounds) > mindist) continue;
+                if (node.count == 0) {
+                    size_type a = node.first, b = node.first + 1;
+                    if (distanceSq(p, _nodes[a].bounds) < distanceSq(p, _nodes[b].bounds)) {
+                        std::swap(a, b);
+                    }
+                    stack[top++] = a;
+                    stack[top++] = b;
+                    continue;
+                }
+
+                for (size_type i = node.first; i < node.first + node.count; ++i) {
+                    Item const &item = _items[i];
+                    if (item.open_closing) continue;
+                    if (distance(p, item.bounds) > mindist) continue;
+
+                    Coord t = 0, d;
+                    if (item.naked_moveto) {
+                        d = distance(item.bounds.min(), p);
+                    } else {
+                        Curve const &c = _curve(item);
+                        t = c.nearestTime(p);
+                        d = distance(c.pointAt(t), p);
+                    }
+                    // among equally distant curves, pick the first one
+                    if (d < mindist || (d == mindist && retval
+                        && CurveRef(item.path_index, item.curve_index)
+                           < CurveRef(retval->path_index, retval->curve_index)))
+                    {
+                        mindist = d;
+                        retval = PathVectorTime(item.path_index, item.curve_index, t);
+                    }
+                }
+            }
+        }
+    }
+
+    if (dist) {
+        *dist = mindist;
+    }
+    return retval;
+}
+
+std::vector<PathVectorIndex::CurveRef> PathVectorIndex::overlappingCurves(Rect const &r) const
+{
+    std::vector<CurveRef> result;
+    size_type path_stack[MAX_DEPTH];
+    unsigned path_top = 0;
+    if (!_path_nodes.empty()) {
+        path_stack[path_top++] = 0;
+    }
+
+    while (path_top > 0) {
+        Node const &pnode = _path_nodes[path_stack[--path_top]];
+        if (!pnode.bounds.intersects(r)) continue;
+        if (pnode.count == 0) {
+            path_stack[path_top++] = pnode.first;
+            path_stack[path_top++] = pnode.first + 1;
+            continue;
+        }
+
+        for (size_type pi = pnode.first; pi < pnode.first + pnode.count; ++pi) {
+            size_type stack[MAX_DEPTH];
+            unsigned top = 0;
+            stack[top++] = _paths[pi].root;
+
+            while (top > 0) {
+                Node const &node = _nodes[stack[--top]];
+                if (!node.bounds.intersects(r)) continue;
+                if (node.count == 0) {
+                    stack[top++] = node.first;
+                    stack[top++] = node.first + 1;
+                    continue;
+                }
+                for (size_type i = node.first; i < node.first + node.count; ++i) {
+                    Item const &item = _items[i];
+                    if (item.naked_moveto || item.open_closing || !item.bounds.intersects(r)) continue;
+                    result.push_back(CurveRef(item.path_index, item.curve_index));
+                }
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<PathVectorIndex::size_type> PathVectorIndex::overlappingPaths(Rect const &r) const
+{
+    std::vector<CurveRef> curves = overlappingCurves(r);
+    std::vector<size_type> result;
+    for (size_type i = 0; i < curves.size(); ++i) {
+        if (result.empty() || result.back() != curves[i].path_index) {
+            result.push_back(curves[i].path_index);
+        }
+    }
+    return result;
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,153 @@
+/** @file
+ * @brief Bounding volume hierarchy for repeated queries on a path vector
+ *//*
+ * Copyright 2016 authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#ifndef LIB2GEOM_SEEN_PATHVECTOR_INDEX_H
+#define LIB2GEOM_SEEN_PATHVECTOR_INDEX_H
+
+#include <vector>
+#include <boost/optional.hpp>
+#include <2geom/forward.h>
+#include <2geom/pathvector.h>
+#include <2geom/rect.h>
+
+namespace Geom {
+
+/** @brief Spatial index for repeated queries on a static path vector.
+ *
+ * PathVector answers winding and nearest point queries by looking at every curve.
+ * When many queries are run against the same shape, it is worth building
+ * a bounding volume hierarchy over its curves once; each query then only
+ * visits the curves whose bounding boxes are relevant to it.
+ *
+ * The index stores a copy of the path vector, which is cheap thanks to
+ * copy-on-write path data. Results are the same as the ones returned
+ * by the corresponding PathVector methods.
+ *
+ * @ingroup Paths */
+class PathVectorIndex {
+public:
+    typedef PathVector::size_type size_type;
+
+    /// Identifies a curve in the indexed path vector.
+    struct CurveRef {
+        size_type path_index;
+        size_type curve_index;
+
+        CurveRef() : path_index(0), curve_index(0) {}
+        CurveRef(size_type p, size_type c) : path_index(p), curve_index(c) {}
+        bool operator==(CurveRef const &other) const {
+            return path_index == other.path_index && curve_index == other.curve_index;
+        }
+        bool operator<(CurveRef const &other) const {
+            return path_index < other.path_index
+                || (path_index == other.path_index && curve_index < other.curve_index);
+        }
+    };
+
+    /** @brief Build the index.
+     * @param pv Path vector to index
+     * @param leaf_size Maximum number of curves stored in a leaf node */
+    explicit PathVectorIndex(PathVector const &pv, unsigned leaf_size = 4);
+
+    /// Get the indexed path vector.
+    PathVector const &pathvector() const { return _pv; }
+    /// Number of indexed curves, including closing segments.
+    size_type size() const { return _items.size(); }
+    OptRect bounds() const;
+
+    /// Determine the winding number at the specified point, like PathVector::winding().
+    int winding(Point const &p) const;
+
+    /// Check whether the point is inside the shape.
+    bool contains(Point const &p, FillRule rule = FILL_NONZERO) const {
+        int w = winding(p);
+        return rule == FILL_NONZERO ? w != 0 : w % 2 != 0;
+    }
+
+    /// Find the nearest point on the paths, like PathVector::nearestTime().
+    boost::optional<PathVectorTime> nearestTime(Point const &p, Coord *dist = NULL) const;
+
+    /** @brief Find curves whose bounding boxes intersect the given rectangle.
+     * Closing segments are included when the path is closed; empty paths are never reported.
+     * The result is sorted by path and curve index. */
+    std::vector<CurveRef> overlappingCurves(Rect const &r) const;
+
+    /** @brief Find paths which have at least one curve overlapping the given rectangle.
+     * The result is sorted. */
+    std::vector<size_type> overlappingPaths(Rect const &r) const;
+
+private:
+    struct Item {
+        Rect bounds;
+        size_type path_index;
+        size_type curve_index;
+        bool naked_moveto; ///< Empty path, represented by its initial point
+        bool open_closing; ///< Closing segment of an open path; only used for winding
+    };
+    struct PathEntry {
+        Rect bounds;
+        size_type root; ///< Root of the tree over the curves of this path
+    };
+    struct Node {
+        Rect bounds;
+        size_type first; ///< First child index for inner nodes, first item for leaves
+        size_type count; ///< Number of items in a leaf, zero for inner nodes
+    };
+
+    template <typename T>
+    static void _build(std::vector<T> &items, std::vector<Node> &nodes,
+                       size_type node, size_type begin, size_type end, unsigned leaf_size);
+    void _pathWinding(PathEntry const &path, Point const &p, int &wind) const;
+    Curve const &_curve(Item const &item) const {
+        return _pv[item.path_index][item.curve_index];
+    }
+
+    PathVector _pv;
+    /* The index has two levels, so that winding queries can skip entire paths
+     * whose bounding boxes do not contain the point, like PathVector::winding() does. */
+    std::vector<Item> _items; ///< Curves, grouped by path
+    std::vector<Node> _nodes; ///< Trees over the curves of each path
+    std::vector<PathEntry> _paths;
+    std::vector<Node> _path_nodes; ///< Tree over the paths
+};
+
+} // end namespace Geom
+
+#endif // LIB2GEOM_SEEN_PATHVECTOR_INDEX_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
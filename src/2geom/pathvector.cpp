@@ -32,10 +32,12 @@
  */
 
 #include <2geom/affine.h>
+#include <2geom/parallel.h>
 #include <2geom/path.h>
 #include <2geom/pathvector.h>
 #include <2geom/svg-path-writer.h>
 #include <2geom/sweeper.h>
+#include <2geom/winding-batch.h>
 
 namespace Geom {
 
@@ -139,6 +141,14 @@ void PathVector::snapEnds(Coord precision)
 // should probably be merged
 class PathIntersectionSweepSet {
 public:
+    /* In FIND_ALL mode, the candidate pairs are collected and intersected afterwards.
+     * In FIND_ANY mode, each candidate pair is checked as soon as it is found,
+     * and the sweep is done after the first one that intersects. */
+    enum Mode {
+        FIND_ALL,
+        FIND_ANY
+    };
+
     struct PathRecord {
         boost::intrusive::list_member_hook<> _hook;
         Path const *path;
@@ -155,15 +165,21 @@ public:
     typedef std::vector<PathRecord>::iterator ItemIterator;
 
     PathIntersectionSweepSet(std::vector<PVIntersection> &result,
-                             PathVector const &a, PathVector const &b, Coord precision)
+                             PathVector const &a, PathVector const &b, Coord precision,
+                             Mode mode = FIND_ALL)
         : _result(result)
         , _precision(precision)
+        , _mode(mode)
+        , _done(false)
     {
+        // empty paths have no bounds and cannot intersect anything
         _records.reserve(a.size() + b.size());
         for (std::size_t i = 0; i < a.size(); ++i) {
+            if (a[i].empty()) continue;
             _records.push_back(PathRecord(a[i], i, 0));
         }
         for (std::size_t i = 0; i < b.size(); ++i) {
+            if (b[i].empty()) continue;
             _records.push_back(PathRecord(b[i], i, 1));
         }
     }
@@ -181,13 +197,19 @@ public:
 
         for (ActivePathList::iterator i = _active[ow].begin(); i != _active[ow].end(); ++i) {
             if (!ii->path->boundsFast().intersects(i->path->boundsFast())) continue;
-            std::vector<PathIntersection> px = ii->path->intersect(*i->path, _precision);
-            for (std::size_t k = 0; k < px.size(); ++k) {
-                PathVectorTime tw(ii->index, px[k].first), tow(i->index, px[k].second);
-                _result.push_back(PVIntersection(
-                    w == 0 ? tw : tow,
-                    w == 0 ? tow : tw,
-                    px[k].point()));
+            if (_mode == FIND_ANY) {
+                if (ii->path->intersects(*i->path, _precision)) {
+                    _done = true;
+                    return;
+                }
+                continue;
+            }
+            // store the path from the first vector first, so that the result for each pair
+            // does not depend on the order of the sweep
+            if (w == 0) {
+                _pairs.push_back(std::make_pair(&*ii, &*i));
+            } else {
+                _pairs.push_back(std::make_pair(&*i, &*ii));
             }
         }
         _active[w].push_back(*ii);
@@ -198,7 +220,87 @@ public:
         apl.erase(apl.iterator_to(*ii));
     }
 
+    bool done() const { return _done; }
+
+    /* Intersect the candidate pairs found by the sweep. This is done as a separate
+     * step, so that the pairs can be processed in parallel. The results are
+     * concatenated in the order in which the pairs were found, which makes
+     * the output independent of the thread count. */
+    void intersectPairs() {
+        if (thread_count() == 1) {
+            // a single scratch vector is enough when the pairs are processed in order
+            std::vector<PathIntersection> px;
+            for (std::size_t i = 0; i < _pairs.size(); ++i) {
+                px.clear();
+                _pairs[i].first->path->intersect(*_pairs[i].second->path, px, _precision);
+                _appendPair(i, px);
+            }
+            return;
+        }
+
+        std::vector<std::vector<PathIntersection> > px(_pairs.size());
+        PairIntersector task(_pairs, px, _precision);
+        parallel_run(task, _pairs.size());
+
+        for (std::size_t i = 0; i < _pairs.size(); ++i) {
+            _appendPair(i, px[i]);
+        }
+    }
+
+    /* Find the intersection with the smallest time on the first path vector. The pairs
+     * are visited in the order of paths in the first path vector, so once an intersection
+     * is found, only the remaining pairs with the same path need to be checked. */
+    boost::optional<PVIntersection> firstPairIntersection() {
+        std::stable_sort(_pairs.begin(), _pairs.end(), FirstPathLess());
+
+        boost::optional<PVIntersection> result;
+        for (std::size_t i = 0; i < _pairs.size(); ++i) {
+            std::size_t ai = _pairs[i].first->index, bi = _pairs[i].second->index;
+            if (result && ai > result->first.path_index) break;
+            boost::optional<PathIntersection> x =
+                _pairs[i].first->path->firstIntersection(*_pairs[i].second->path, _precision);
+            if (!x) continue;
+            PVIntersection px(PathVectorTime(ai, x->first), PathVectorTime(bi, x->second),
+                              x->point());
+            if (!result || px < *result) {
+                result = px;
+            }
+        }
+        return result;
+    }
+
 private:
+    struct FirstPathLess {
+        bool operator()(std::pair<PathRecord const *, PathRecord const *> const &a,
+                        std::pair<PathRecord const *, PathRecord const *> const &b) const {
+            return a.first->index < b.first->index;
+        }
+    };
+
+    void _appendPair(std::size_t i, std::vector<PathIntersection> const &px) {
+        std::size_t ai = _pairs[i].first->index, bi = _pairs[i].second->index;
+        for (std::size_t k = 0; k < px.size(); ++k) {
+            _result.push_back(PVIntersection(PathVectorTime(ai, px[k].first),
+                                             PathVectorTime(bi, px[k].second),
+                                             px[k].point()));
+        }
+    }
+
+    typedef std::vector<std::pair<PathRecord const *, PathRecord const *> > PairList;
+
+    struct PairIntersector : public ParallelTask {
+        PairIntersector(PairList const &pairs, std::vector<std::vector<PathIntersection> > &out,
+                        Coord precision)
+            : _pairs(pairs), _out(out), _precision(precision)
+        {}
+        void run(std::size_t i) {
+            _pairs[i].first->path->intersect(*_pairs[i].second->path, _out[i], _precision);
+        }
+        PairList const &_pairs;
+        std::vector<std::vector<PathIntersection> > &_out;
+        Coord _precision;
+    };
+
     typedef boost::intrusive::list
         < PathRecord
         , boost::intrusive::member_hook
@@ -211,20 +313,50 @@ private:
     std::vector<PVIntersection> &_result;
     std::vector<PathRecord> _records;
     ActivePathList _active[2];
+    PairList _pairs;
     Coord _precision;
+    Mode _mode;
+    bool _done;
 };
 
 std::vector<PVIntersection> PathVector::intersect(PathVector const &other, Coord precision) const
 {
     std::vector<PVIntersection> result;
+    intersect(other, result, precision);
+    return result;
+}
+
+void PathVector::intersect(PathVector const &other, std::vector<PVIntersection> &out,
+                           Coord precision) const
+{
+    std::size_t start = out.size();
 
-    PathIntersectionSweepSet pisset(result, *this, other, precision);
+    PathIntersectionSweepSet pisset(out, *this, other, precision);
     Sweeper<PathIntersectionSweepSet> sweeper(pisset);
     sweeper.process();
+    pisset.intersectPairs();
 
-    std::sort(result.begin(), result.end());
+    std::sort(out.begin() + start, out.end());
+}
 
-    return result;
+bool PathVector::intersects(PathVector const &other, Coord precision) const
+{
+    std::vector<PVIntersection> unused;
+    PathIntersectionSweepSet pisset(unused, *this, other, precision,
+                                    PathIntersectionSweepSet::FIND_ANY);
+    Sweeper<PathIntersectionSweepSet> sweeper(pisset);
+    sweeper.processUntilDone();
+    return pisset.done();
+}
+
+boost::optional<PVIntersection> PathVector::firstIntersection(PathVector const &other,
+                                                              Coord precision) const
+{
+    std::vector<PVIntersection> unused;
+    PathIntersectionSweepSet pisset(unused, *this, other, precision);
+    Sweeper<PathIntersectionSweepSet> sweeper(pisset);
+    sweeper.process();
+    return pisset.firstPairIntersection();
 }
 
 int PathVector::winding(Point const &p) const
@@ -237,6 +369,11 @@ int PathVector::winding(Point const &p) const
     return wind;
 }
 
+void PathVector::winding(std::vector<Point> const &points, std::vector<int> &result) const
+{
+    BatchWinding(*this).winding(points, result);
+}
+
 PathVector PathVector::removeLineOverlap(PathVector const& other) const {
     PathVector result;
     for (const_iterator ii = begin(); ii != end(); ++ii) {
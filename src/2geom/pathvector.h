@@ -97,6 +97,13 @@ struct ShapeTraits<PathVector> {
     typedef PathVectorIntersection IntersectionType;
 };
 
+/** @brief Rule for deciding whether a point is inside a shape based on its winding number.
+ * @ingroup Paths */
+enum FillRule {
+    FILL_NONZERO, ///< Inside when the winding number is not zero
+    FILL_EVENODD  ///< Inside when the winding number is odd
+};
+
 /** @brief Sequence of subpaths.
  *
  * This class corresponds to the SVG notion of a path:
@@ -244,7 +251,12 @@ public:
         return at(pos.path_index).at(pos.curve_index).valueAt(pos.t, d);
     }
 
+    /** @brief Get the approximate bounding box.
+     * This combines the bounds cached in the paths, so repeated calls do not need
+     * to examine the curves of unmodified paths. */
     OptRect boundsFast() const;
+    /** @brief Get a tight-fitting bounding box.
+     * Like boundsFast(), this combines the bounds cached in the paths. */
     OptRect boundsExact() const;
 
     template <typename T>
@@ -264,10 +276,28 @@ public:
     void snapEnds(Coord precision = EPSILON);
 
     std::vector<PVIntersection> intersect(PathVector const &other, Coord precision = EPSILON) const;
+    /** @brief Append intersections with another path vector to a vector.
+     * Existing elements of @a out are kept. Reusing the same vector for many queries
+     * avoids reallocating it every time. */
+    void intersect(PathVector const &other, std::vector<PVIntersection> &out,
+                   Coord precision = EPSILON) const;
+    /** @brief Check whether any path intersects a path of the other path vector.
+     * Equivalent to <code>!intersect(other, precision).empty()</code>, but stops
+     * as soon as an intersection is found. */
+    bool intersects(PathVector const &other, Coord precision = EPSILON) const;
+    /** @brief Find the intersection with the smallest time value on this path vector.
+     * Returns the first element of intersect(other, precision), or nothing when
+     * the path vectors do not intersect. Paths after the one containing the first
+     * intersection are not intersected at all. */
+    boost::optional<PVIntersection> firstIntersection(PathVector const &other,
+                                                      Coord precision = EPSILON) const;
 
     /** @brief Determine the winding number at the specified point.
      * This is simply the sum of winding numbers for constituent paths. */
     int winding(Point const &p) const;
+    /** @brief Determine the winding numbers of many points.
+     * @see Path::winding(std::vector<Point> const &, std::vector<int> &) const */
+    void winding(std::vector<Point> const &points, std::vector<int> &result) const;
 
     /**
      * @brief Remove parts of the path which are covered by a given PathVector (other)
@@ -0,0 +1,623 @@
+/** @file
+ * @brief Boolean operations on polygons - implementation
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <queue>
+#include <set>
+#include <boost/intrusive/set.hpp>
+#include <2geom/arena.h>
+#include <2geom/path.h>
+#include <2geom/polygon-intersection-graph.h>
+#include <2geom/predicates.h>
+
+namespace Geom {
+
+namespace {
+
+// Lexicographic order of points, which is the order in which the sweep line visits them.
+inline bool lex_less(Point const &a, Point const &b)
+{
+    return a[X] < b[X] || (a[X] == b[X] && a[Y] < b[Y]);
+}
+
+/* A segment of the input. Segments are divided at intersections during the sweep,
+ * but all predicates use the original segment, since the rounded intersection points
+ * are not exactly on it. This way an input vertex which lies on an edge is always
+ * recognized as such, no matter how many times the edge was divided. */
+struct InputSegment {
+    Point from, to; ///< Endpoints in lexicographic order
+    std::size_t index;
+
+    // Positive if q lies above the segment, negative if below, zero if on its line.
+    double side(Point const &q) const { return orient2d(from, to, q); }
+};
+
+/* Endpoint of a segment. The event at the lexicographically smaller endpoint is the left
+ * event; it represents the segment in the sweep status and stores its attributes. */
+struct SweepEvent {
+    boost::intrusive::set_member_hook
+        < boost::intrusive::link_mode<boost::intrusive::normal_link> > hook;
+    Point p;
+    SweepEvent *other; ///< Event at the other endpoint
+    InputSegment const *input; ///< Segment from which this one was divided
+    unsigned char boundary;
+    unsigned char below;
+    bool left;
+    bool dead; ///< The segment has been merged into another one
+};
+
+/* Whether the segments are in the given order when they are collinear. This order must
+ * not change when they are divided, because the area below a segment is determined
+ * from the segment below it when it is inserted. */
+inline bool collinear_less(SweepEvent const *a, SweepEvent const *b)
+{
+    return a->input->index < b->input->index;
+}
+
+/* Position of the point of the event e relative to the input segment of the event s.
+ * Points created by division are not exactly on their input segments, so they are
+ * considered to lie on s whenever the input segments are collinear. */
+double side(SweepEvent const *s, SweepEvent const *e)
+{
+    double o = s->input->side(e->p);
+    if (o != 0 && e->p != e->input->from && e->p != e->input->to &&
+        s->input->side(e->input->from) == 0 && s->input->side(e->input->to) == 0)
+    {
+        return 0;
+    }
+    return o;
+}
+
+/* Whether the segment a is below the segment b, where both events are at the same point.
+ * The predicate is always evaluated for the segment with the lower index, so that
+ * the order is consistent even if the other endpoints are not exactly on the inputs. */
+inline bool below_at_common_point(SweepEvent const *a, SweepEvent const *b)
+{
+    if (collinear_less(a, b)) {
+        return side(a, b->other) >= 0;
+    } else {
+        return side(b, a->other) < 0;
+    }
+}
+
+// Whether the event a should be processed before the event b.
+bool event_before(SweepEvent const *a, SweepEvent const *b)
+{
+    if (a->p[X] != b->p[X]) return a->p[X] < b->p[X];
+    if (a->p[Y] != b->p[Y]) return a->p[Y] < b->p[Y];
+    // at the same point, segments are removed before new ones are inserted
+    if (a->left != b->left) return !a->left;
+    // otherwise the lower segment goes first
+    return below_at_common_point(a, b);
+}
+
+struct EventAfter {
+    bool operator()(SweepEvent const *a, SweepEvent const *b) const {
+        return event_before(b, a);
+    }
+};
+
+// Order of the segments crossing the sweep line, from bottom to top.
+struct SegmentLess {
+    bool operator()(SweepEvent const &a, SweepEvent const &b) const;
+};
+
+bool SegmentLess::operator()(SweepEvent const &a, SweepEvent const &b) const
+{
+    if (&a == &b) return false;
+    if (a.p == b.p) {
+        // with a common left endpoint, the right endpoints determine the order
+        return below_at_common_point(&a, &b);
+    }
+    // compare the segment inserted later with the one inserted earlier,
+    // first using its left endpoint and then, if it lies on the other segment, the right one
+    if (event_before(&a, &b)) {
+        double o = side(&a, &b);
+        if (o == 0) o = side(&a, b.other);
+        if (o != 0) return o > 0;
+    } else {
+        double o = side(&b, &a);
+        if (o == 0) o = side(&b, a.other);
+        if (o != 0) return o < 0;
+    }
+    return collinear_less(&a, &b);
+}
+
+struct LexLess {
+    bool operator()(Point const &a, Point const &b) const { return lex_less(a, b); }
+};
+
+enum SegmentIntersection {
+    DISJOINT,
+    TOUCHING,   ///< the segments intersect at an endpoint of one of them, stored in ip0
+    OVERLAPPING,///< the collinear segments overlap between ip0 and ip1
+    CROSSING    ///< the segments cross at the rounded point ip0
+};
+
+// Compute the intersection of the segments represented by the left events a and b.
+SegmentIntersection intersect_segments(SweepEvent const *a, SweepEvent const *b,
+                                       Point &ip0, Point &ip1)
+{
+    Point const &p0 = a->p, &p1 = a->other->p, &q0 = b->p, &q1 = b->other->p;
+    if (p1[X] < q0[X] || q1[X] < p0[X] ||
+        std::max(p0[Y], p1[Y]) < std::min(q0[Y], q1[Y]) ||
+        std::max(q0[Y], q1[Y]) < std::min(p0[Y], p1[Y]))
+    {
+        return DISJOINT;
+    }
+
+    double o0 = side(a, b);
+    double o1 = side(a, b->other);
+    if ((o0 > 0 && o1 > 0) || (o0 < 0 && o1 < 0)) return DISJOINT;
+    double o2 = side(b, a);
+    double o3 = side(b, a->other);
+    if ((o2 > 0 && o3 > 0) || (o2 < 0 && o3 < 0)) return DISJOINT;
+
+    if (o0 == 0 && o1 == 0) {
+        // collinear segments
+        ip0 = lex_less(p0, q0) ? q0 : p0;
+        ip1 = lex_less(p1, q1) ? p1 : q1;
+        if (lex_less(ip1, ip0)) return DISJOINT;
+        return ip0 == ip1 ? TOUCHING : OVERLAPPING;
+    }
+    // segments which are not collinear can only meet at their common endpoint
+    if (p0 == q0 || p0 == q1) { ip0 = p0; return TOUCHING; }
+    if (p1 == q0 || p1 == q1) { ip0 = p1; return TOUCHING; }
+    // an endpoint lies on the other segment, so it is the exact intersection
+    if (o0 == 0) { ip0 = q0; return TOUCHING; }
+    if (o1 == 0) { ip0 = q1; return TOUCHING; }
+    if (o2 == 0) { ip0 = p0; return TOUCHING; }
+    if (o3 == 0) { ip0 = p1; return TOUCHING; }
+
+    // proper crossing; keep the rounded point within the bounding boxes of both segments
+    Point const &l0 = a->input->from, &m0 = b->input->from;
+    Point dl = a->input->to - l0, dm = b->input->to - m0, d = m0 - l0;
+    Coord t = (d[X] * dm[Y] - d[Y] * dm[X]) / (dl[X] * dm[Y] - dl[Y] * dm[X]);
+    ip0 = l0 + t * dl;
+    for (unsigned i = 0; i < 2; ++i) {
+        Dim2 dim = static_cast<Dim2>(i);
+        Coord lo = std::max(std::min(p0[dim], p1[dim]), std::min(q0[dim], q1[dim]));
+        Coord hi = std::min(std::max(p0[dim], p1[dim]), std::max(q0[dim], q1[dim]));
+        ip0[dim] = std::min(std::max(ip0[dim], lo), hi);
+    }
+
+    return CROSSING;
+}
+
+typedef boost::intrusive::set
+    < SweepEvent
+    , boost::intrusive::member_hook
+        < SweepEvent
+        , boost::intrusive::set_member_hook
+            < boost::intrusive::link_mode<boost::intrusive::normal_link> >
+        , &SweepEvent::hook
+        >
+    , boost::intrusive::compare<SegmentLess>
+    > SweepStatus;
+
+struct EndLess {
+    bool operator()(std::pair<Point, std::size_t> const &a,
+                    std::pair<Point, std::size_t> const &b) const {
+        if (a.first != b.first) return lex_less(a.first, b.first);
+        return a.second < b.second;
+    }
+};
+
+} // anonymous namespace
+
+/* Plane sweep over the edges of both operands, following the algorithm of Martínez,
+ * Rueda and Feito. The edges are divided at their intersections and overlapping edges
+ * are merged. When an edge is inserted into the sweep status, the operands containing
+ * the area below it are determined from the edge below it. */
+class PolygonIntersectionGraph::Sweep
+{
+public:
+    // all containers allocate from the arena, which is released after the sweep
+    Sweep(MonotonicArena *arena, std::size_t nsegs)
+        : _inputs(arena)
+        , _events(arena)
+        , _sorted(arena)
+        , _queue(EventAfter(), EventVector(arena))
+        , _crossings(LexLess(), arena)
+        , _inserted(arena)
+    {
+        _sorted.reserve(2 * nsegs);
+    }
+
+    void addSegment(Point const &a, Point const &b, unsigned char boundary) {
+        if (a == b) return;
+        _inputs.push_back(InputSegment());
+        InputSegment &input = _inputs.back();
+        input.from = lex_less(a, b) ? a : b;
+        input.to = lex_less(a, b) ? b : a;
+        input.index = _inputs.size() - 1;
+
+        SweepEvent *l = _newEvent(input.from, true, NULL, &input, boundary);
+        SweepEvent *r = _newEvent(input.to, false, l, &input, boundary);
+        l->other = r;
+        _sorted.push_back(l);
+        _sorted.push_back(r);
+    }
+
+    // Run the sweep and append the resulting edges to out.
+    void run(std::vector<Edge> &out) {
+        // the initial events are sorted up front; only the events created
+        // by dividing segments go through the priority queue
+        std::sort(_sorted.begin(), _sorted.end(), event_before);
+        std::size_t next_sorted = 0;
+
+        while (next_sorted < _sorted.size() || !_queue.empty()) {
+            SweepEvent *se;
+            if (!_queue.empty() && (next_sorted == _sorted.size() ||
+                                    event_before(_queue.top(), _sorted[next_sorted])))
+            {
+                se = _queue.top();
+                _queue.pop();
+            } else {
+                se = _sorted[next_sorted++];
+            }
+            if (se->dead) continue;
+
+            if (se->p != _point) {
+                _point = se->p;
+                _inserted.clear();
+            }
+            _rewind = false;
+
+            if (se->left) {
+                SweepStatus::iterator pos = _status.insert(*se).first;
+                SweepStatus::iterator it = pos;
+                SweepEvent *prev = it == _status.begin() ? NULL : &*--it;
+                it = pos;
+                ++it;
+                SweepEvent *next = it == _status.end() ? NULL : &*it;
+
+                // the area below the segment is the area above the previous one
+                se->below = prev ? prev->below ^ prev->boundary : 0;
+
+                if (next && _possibleIntersection(se, next) == OVERLAP) {
+                    _merge(se, next);
+                } else if (prev && _possibleIntersection(prev, se) == OVERLAP) {
+                    _merge(prev, se);
+                }
+                _inserted.push_back(se);
+            } else {
+                SweepEvent *le = se->other;
+                SweepStatus::iterator pos = _status.iterator_to(*le);
+                SweepStatus::iterator it = pos;
+                SweepEvent *prev = it == _status.begin() ? NULL : &*--it;
+                it = pos;
+                ++it;
+                SweepEvent *next = it == _status.end() ? NULL : &*it;
+                _status.erase(pos);
+
+                if (le->boundary) {
+                    out.push_back(Edge(le->p, se->p, le->boundary, le->below));
+                }
+                if (prev && next && _possibleIntersection(prev, next) == OVERLAP) {
+                    _merge(prev, next);
+                }
+            }
+
+            if (_rewind) {
+                /* A segment was divided at the current point, so its right event should
+                 * have been processed before the segments starting here were inserted.
+                 * Insert them again once the new events are processed. */
+                for (std::size_t i = 0; i < _inserted.size(); ++i) {
+                    if (_inserted[i]->dead) continue;
+                    _status.erase(_status.iterator_to(*_inserted[i]));
+                    _queue.push(_inserted[i]);
+                }
+                _inserted.clear();
+            }
+        }
+    }
+
+private:
+    enum IntersectionKind {
+        NONE,
+        SPLIT,   ///< at least one segment was divided
+        OVERLAP  ///< the segments are now equal
+    };
+
+    SweepEvent *_newEvent(Point const &p, bool left, SweepEvent *other,
+                          InputSegment const *input, unsigned char boundary)
+    {
+        _events.push_back(SweepEvent());
+        SweepEvent *e = &_events.back();
+        e->p = p;
+        e->other = other;
+        e->input = input;
+        e->boundary = boundary;
+        e->below = 0;
+        e->left = left;
+        e->dead = false;
+        return e;
+    }
+
+    // Divide the segment with the left event le at the point p.
+    void _divideSegment(SweepEvent *le, Point const &p) {
+        SweepEvent *re = le->other;
+        SweepEvent *r = _newEvent(p, false, le, le->input, le->boundary);
+        SweepEvent *l = _newEvent(p, true, re, le->input, le->boundary);
+        re->other = l;
+        le->other = r;
+        _queue.push(l);
+        _queue.push(r);
+        if (p == _point) _rewind = true;
+    }
+
+    // Divide the segment at p, unless p is not strictly between its endpoints.
+    bool _divideAt(SweepEvent *le, Point const &p) {
+        if (!lex_less(le->p, p) || !lex_less(p, le->other->p)) return false;
+        _divideSegment(le, p);
+        return true;
+    }
+
+    /* Merge two equal segments which are adjacent in the sweep status. The lower one
+     * is kept, so that the area below it remains correct; the area above it does not
+     * change, since it takes over the boundary of the upper one. */
+    void _merge(SweepEvent *lower, SweepEvent *upper) {
+        lower->boundary ^= upper->boundary;
+        _status.erase(_status.iterator_to(*upper));
+        upper->dead = true;
+        upper->other->dead = true;
+    }
+
+    /* Where three or more segments cross at a point which is not representable,
+     * each pair can yield a slightly different rounded point. Reuse a nearby crossing
+     * or endpoint instead, so that all of them meet at one vertex. */
+    Point _snapCrossing(Point const &ip, SweepEvent const *le1, SweepEvent const *le2) {
+        Point const *ends[4] = { &le1->p, &le1->other->p, &le2->p, &le2->other->p };
+        Coord tolerance = 0;
+        for (unsigned i = 0; i < 4; ++i) {
+            tolerance = std::max(tolerance, std::max(std::fabs((*ends[i])[X]),
+                                                     std::fabs((*ends[i])[Y])));
+        }
+        tolerance *= 1e-12;
+
+        Point result = ip;
+        bool snapped = false;
+        for (unsigned i = 0; i < 4 && !snapped; ++i) {
+            if (are_near(*ends[i], ip, tolerance)) {
+                result = *ends[i];
+                snapped = true;
+            }
+        }
+        Coord const inf = std::numeric_limits<Coord>::infinity();
+        CrossingSet::iterator it =
+            _crossings.lower_bound(Point(ip[X] - tolerance, -inf));
+        for (; !snapped && it != _crossings.end() && (*it)[X] <= ip[X] + tolerance; ++it) {
+            if (are_near(*it, ip, tolerance)) {
+                result = *it;
+                snapped = true;
+            }
+        }
+
+        // a rounded intersection point must not be behind the sweep line
+        if (lex_less(result, _point)) result = _point;
+        _crossings.insert(result);
+        return result;
+    }
+
+    // Check the segments adjacent in the sweep status, where le1 is below le2.
+    IntersectionKind _possibleIntersection(SweepEvent *le1, SweepEvent *le2) {
+        Point ip0, ip1;
+        SegmentIntersection kind = intersect_segments(le1, le2, ip0, ip1);
+        if (kind == DISJOINT) return NONE;
+        if (kind == CROSSING) {
+            ip0 = _snapCrossing(ip0, le1, le2);
+        }
+        if (kind != OVERLAPPING) {
+            bool s1 = _divideAt(le1, ip0);
+            bool s2 = _divideAt(le2, ip0);
+            return s1 || s2 ? SPLIT : NONE;
+        }
+
+        // the segments overlap
+        if (le1->p == le2->p) {
+            if (le1->other->p != le2->other->p) {
+                // divide the longer segment at the end of the shorter one
+                if (lex_less(le1->other->p, le2->other->p)) {
+                    _divideSegment(le2, le1->other->p);
+                } else {
+                    _divideSegment(le1, le2->other->p);
+                }
+            }
+            return OVERLAP;
+        }
+
+        // divide both segments so that the overlapping portions become equal;
+        // they will be merged when the second of them is inserted
+        SweepEvent *first = le1, *second = le2;
+        if (event_before(le2, le1)) std::swap(first, second);
+        SweepEvent *first_end = first->other, *second_end = second->other;
+        if (first_end->p == second_end->p) {
+            _divideSegment(first, second->p);
+        } else if (lex_less(first_end->p, second_end->p)) {
+            _divideSegment(first, second->p);
+            _divideSegment(second, first_end->p);
+        } else {
+            // the first segment contains the second one
+            _divideSegment(first, second->p);
+            _divideSegment(first_end->other, second_end->p);
+        }
+        return SPLIT;
+    }
+
+    typedef std::vector<SweepEvent *, ArenaAllocator<SweepEvent *> > EventVector;
+    typedef std::set<Point, LexLess, ArenaAllocator<Point> > CrossingSet;
+
+    std::deque<InputSegment, ArenaAllocator<InputSegment> > _inputs;
+    std::deque<SweepEvent, ArenaAllocator<SweepEvent> > _events;
+    EventVector _sorted;
+    std::priority_queue<SweepEvent *, EventVector, EventAfter> _queue;
+    SweepStatus _status;
+    CrossingSet _crossings; ///< Points at which segments were divided
+    Point _point; ///< Point of the current event
+    EventVector _inserted; ///< Segments inserted at the current point
+    bool _rewind;
+};
+
+PolygonIntersectionGraph::PolygonIntersectionGraph(PathVector const &a, PathVector const &b,
+                                                   MonotonicArena *arena)
+{
+    PathVector const *operands[2] = { &a, &b };
+    // the sweep data is only needed during construction
+    MonotonicArena local_arena;
+    std::size_t nsegs = a.curveCount() + b.curveCount();
+    Sweep sweep(arena ? arena : &local_arena, nsegs + a.size() + b.size());
+    for (unsigned w = 0; w < 2; ++w) {
+        PathVector const &pv = *operands[w];
+        for (std::size_t i = 0; i < pv.size(); ++i) {
+            Path const &path = pv[i];
+            for (std::size_t j = 0; j < path.size_open(); ++j) {
+                sweep.addSegment(path[j].initialPoint(), path[j].finalPoint(), 1 << w);
+            }
+            // open paths are treated as closed
+            Point last = path.size_open() ? path.back_open().finalPoint() : path.initialPoint();
+            sweep.addSegment(last, path.initialPoint(), 1 << w);
+        }
+    }
+    _edges.reserve(nsegs);
+    sweep.run(_edges);
+}
+
+/* The operation is given as a truth table: bit (in_a | in_b << 1) of the table
+ * states whether an area with the given membership belongs to the result. */
+PathVector PolygonIntersectionGraph::_getResult(unsigned table) const
+{
+    // select the edges which separate an area in the result from one outside of it
+    std::vector<std::size_t> selected;
+    for (std::size_t i = 0; i < _edges.size(); ++i) {
+        unsigned below = _edges[i].below;
+        unsigned above = below ^ _edges[i].boundary;
+        if (((table >> below) & 1) != ((table >> above) & 1)) {
+            selected.push_back(i);
+        }
+    }
+
+    // identify the vertices: sort the endpoints and group equal ones
+    std::vector<std::pair<Point, std::size_t> > ends;
+    ends.reserve(2 * selected.size());
+    for (std::size_t i = 0; i < selected.size(); ++i) {
+        ends.push_back(std::make_pair(_edges[selected[i]].from, 2 * i));
+        ends.push_back(std::make_pair(_edges[selected[i]].to, 2 * i + 1));
+    }
+    std::sort(ends.begin(), ends.end(), EndLess());
+
+    std::vector<std::size_t> vertex(ends.size()); // vertex of each edge end
+    std::vector<std::size_t> vstart; // index of the first end at each vertex
+    for (std::size_t i = 0; i < ends.size(); ++i) {
+        if (i == 0 || ends[i].first != ends[i - 1].first) {
+            vstart.push_back(i);
+        }
+        vertex[ends[i].second] = vstart.size() - 1;
+    }
+    vstart.push_back(ends.size());
+
+    // every vertex has an even number of edges, so walking along unused edges
+    // always leads back to the starting vertex
+    std::vector<bool> used(selected.size(), false);
+    std::vector<std::size_t> cursor(vstart.begin(), vstart.end() - 1);
+    PathVector result;
+    for (std::size_t i = 0; i < selected.size(); ++i) {
+        if (used[i]) continue;
+        used[i] = true;
+        std::size_t start = vertex[2 * i];
+        std::size_t v = vertex[2 * i + 1];
+        Path path(ends[vstart[start]].first);
+        while (v != start) {
+            path.appendNew<LineSegment>(ends[vstart[v]].first);
+            std::size_t &c = cursor[v];
+            while (c < vstart[v + 1] && used[ends[c].second / 2]) {
+                ++c;
+            }
+            if (c == vstart[v + 1]) break;
+            std::size_t e = ends[c].second / 2;
+            used[e] = true;
+            v = vertex[2 * e] == v ? vertex[2 * e + 1] : vertex[2 * e];
+        }
+        path.close();
+        result.push_back(path);
+    }
+    return result;
+}
+
+PathVector PolygonIntersectionGraph::getUnion() const
+{
+    return _getResult(0xe);
+}
+
+PathVector PolygonIntersectionGraph::getIntersection() const
+{
+    return _getResult(0x8);
+}
+
+PathVector PolygonIntersectionGraph::getAminusB() const
+{
+    return _getResult(0x2);
+}
+
+PathVector PolygonIntersectionGraph::getBminusA() const
+{
+    return _getResult(0x4);
+}
+
+PathVector PolygonIntersectionGraph::getXOR() const
+{
+    return _getResult(0x6);
+}
+
+bool PolygonIntersectionGraph::isPolygonal(PathVector const &pv)
+{
+    for (std::size_t i = 0; i < pv.size(); ++i) {
+        for (std::size_t j = 0; j < pv[i].size_open(); ++j) {
+            if (!pv[i][j].isLineSegment()) return false;
+        }
+    }
+    return true;
+}
+
+} // namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
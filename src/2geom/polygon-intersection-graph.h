@@ -0,0 +1,111 @@
+/** @file
+ * @brief Boolean operations on polygons
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+
+#ifndef LIB2GEOM_SEEN_POLYGON_INTERSECTION_GRAPH_H
+#define LIB2GEOM_SEEN_POLYGON_INTERSECTION_GRAPH_H
+
+#include <vector>
+#include <2geom/forward.h>
+#include <2geom/pathvector.h>
+#include <2geom/point.h>
+
+namespace Geom {
+
+/** @brief Boolean operations on path vectors consisting only of line segments.
+ *
+ * This is a much faster counterpart of PathIntersectionGraph for polygons. The edges
+ * of both operands are processed in a single plane sweep in the style of the algorithm
+ * by Martínez, Rueda and Feito: the edges are split at all their intersections,
+ * overlapping portions are merged, and the sweep determines whether the areas on both
+ * sides of each edge are inside the operands. All decisions are made with an exact
+ * orientation predicate against the original edges, so touching and collinear edges,
+ * shared vertices and coincident operands are handled correctly. Only the coordinates
+ * of intersections between edges which cross are rounded; crossings of several edges
+ * at the same point are joined into a single vertex.
+ *
+ * As with PathIntersectionGraph, both operands are interpreted using the even-odd fill
+ * rule and open paths are treated as if they were closed. The results consist of closed
+ * paths made of line segments.
+ *
+ * @ingroup Paths */
+class PolygonIntersectionGraph
+{
+public:
+    /** @brief Compute the arrangement of the edges of both operands.
+     * @param arena Memory for the temporary data of the sweep. If null, a local arena
+     *              is used; a caller performing many operations can pass the same
+     *              arena each time and reset it in between to avoid heap allocations. */
+    PolygonIntersectionGraph(PathVector const &a, PathVector const &b,
+                             MonotonicArena *arena = NULL);
+
+    PathVector getUnion() const;
+    PathVector getIntersection() const;
+    PathVector getAminusB() const;
+    PathVector getBminusA() const;
+    PathVector getXOR() const;
+
+    /// Returns the number of edges in the arrangement of both operands.
+    std::size_t size() const { return _edges.size(); }
+
+    /// Check whether all segments of a path vector are line segments.
+    static bool isPolygonal(PathVector const &pv);
+
+private:
+    /* An edge of the arrangement, stored with its lexicographically smaller endpoint
+     * first. Bit 0 of the flags refers to the first operand, bit 1 to the second. */
+    struct Edge {
+        Point from, to;
+        unsigned char boundary; ///< Operands for which the edge is a boundary
+        unsigned char below;    ///< Operands which contain the area just below the edge
+
+        Edge(Point const &f, Point const &t, unsigned char b, unsigned char bl)
+            : from(f), to(t), boundary(b), below(bl)
+        {}
+    };
+    class Sweep;
+
+    PathVector _getResult(unsigned table) const;
+
+    std::vector<Edge> _edges;
+};
+
+} // namespace Geom
+
+#endif // LIB2GEOM_SEEN_POLYGON_INTERSECTION_GRAPH_H
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
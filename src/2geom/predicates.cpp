@@ -0,0 +1,253 @@
+/** @file
+ * @brief Robust geometric predicates
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <2geom/predicates.h>
+
+namespace Geom {
+
+namespace {
+
+/* Error-free transformations: the result of each operation is represented exactly
+ * as the sum of the rounded result x and the rounding error y. */
+
+inline void two_sum(double a, double b, double &x, double &y)
+{
+    x = a + b;
+    double bv = x - a;
+    double av = x - bv;
+    y = (a - av) + (b - bv);
+}
+
+inline void two_diff(double a, double b, double &x, double &y)
+{
+    x = a - b;
+    double bv = a - x;
+    double av = x + bv;
+    y = (a - av) + (bv - b);
+}
+
+inline void split(double a, double &hi, double &lo)
+{
+    double c = 134217729.0 * a; // 2^27 + 1
+    double big = c - a;
+    hi = c - big;
+    lo = a - hi;
+}
+
+inline void two_product(double a, double b, double &x, double &y)
+{
+    x = a * b;
+    double ahi, alo, bhi, blo;
+    split(a, ahi, alo);
+    split(b, bhi, blo);
+    y = alo * blo - (((x - ahi * bhi) - alo * bhi) - ahi * blo);
+}
+
+/* An expansion is a sum of nonoverlapping floating point values, ordered by increasing
+ * magnitude. Zero components are removed, except when the value of the sum is zero,
+ * so the last component always has the sign of the sum. */
+typedef std::vector<double> Expansion;
+
+// Add b to the expansion e of length n, writing the result to h. Returns its length.
+int grow_expansion(int n, double const *e, double b, double *h)
+{
+    double q = b;
+    int hn = 0;
+    for (int i = 0; i < n; ++i) {
+        double sum, err;
+        two_sum(q, e[i], sum, err);
+        if (err != 0) h[hn++] = err;
+        q = sum;
+    }
+    if (q != 0 || hn == 0) h[hn++] = q;
+    return hn;
+}
+
+Expansion difference(double a, double b)
+{
+    double x, y;
+    two_diff(a, b, x, y);
+    Expansion result;
+    if (y != 0) result.push_back(y);
+    result.push_back(x);
+    return result;
+}
+
+Expansion operator+(Expansion const &e, Expansion const &f)
+{
+    Expansion h(e), tmp(e.size() + f.size());
+    for (std::size_t i = 0; i < f.size(); ++i) {
+        tmp.resize(h.size() + 1);
+        tmp.resize(grow_expansion(h.size(), &h[0], f[i], &tmp[0]));
+        h.swap(tmp);
+    }
+    return h;
+}
+
+Expansion operator*(Expansion const &e, double b)
+{
+    Expansion h;
+    h.reserve(2 * e.size());
+    double q, err;
+    two_product(e[0], b, q, err);
+    if (err != 0) h.push_back(err);
+    for (std::size_t i = 1; i < e.size(); ++i) {
+        double hi, lo, sum;
+        two_product(e[i], b, hi, lo);
+        two_sum(q, lo, sum, err);
+        if (err != 0) h.push_back(err);
+        two_sum(hi, sum, q, err);
+        if (err != 0) h.push_back(err);
+    }
+    if (q != 0 || h.empty()) h.push_back(q);
+    return h;
+}
+
+Expansion operator*(Expansion const &e, Expansion const &f)
+{
+    Expansion h = e * f[0];
+    for (std::size_t i = 1; i < f.size(); ++i) {
+        h = h + e * f[i];
+    }
+    return h;
+}
+
+Expansion operator-(Expansion const &e)
+{
+    Expansion h(e);
+    for (std::size_t i = 0; i < h.size(); ++i) {
+        h[i] = -h[i];
+    }
+    return h;
+}
+
+} // anonymous namespace
+
+namespace detail {
+
+Coord cross_difference_exact(Point const &a0, Point const &a1, Point const &b0, Point const &b1)
+{
+    double ax[2], ay[2], bx[2], by[2];
+    two_diff(a1[X], a0[X], ax[0], ax[1]);
+    two_diff(a1[Y], a0[Y], ay[0], ay[1]);
+    two_diff(b1[X], b0[X], bx[0], bx[1]);
+    two_diff(b1[Y], b0[Y], by[0], by[1]);
+
+    // The 16 partial products are added one by one; the result has at most 17 terms.
+    // The differences are often exact, so many of the products are zero and skipped.
+    double buf[2][17];
+    int n = 0, cur = 0;
+    for (unsigned i = 0; i < 2; ++i) {
+        for (unsigned j = 0; j < 2; ++j) {
+            double t[4];
+            two_product(ax[i], by[j], t[0], t[1]);
+            two_product(-ay[i], bx[j], t[2], t[3]);
+            for (unsigned k = 0; k < 4; ++k) {
+                if (t[k] == 0) continue;
+                n = grow_expansion(n, buf[cur], t[k], buf[1 - cur]);
+                cur = 1 - cur;
+            }
+        }
+    }
+    return n == 0 ? 0 : buf[cur][n - 1];
+}
+
+} // namespace detail
+
+bool segments_intersect(Point const &a0, Point const &a1, Point const &b0, Point const &b1)
+{
+    Coord o0 = orient2d(b0, b1, a0), o1 = orient2d(b0, b1, a1);
+    if ((o0 > 0 && o1 > 0) || (o0 < 0 && o1 < 0)) return false;
+    Coord o2 = orient2d(a0, a1, b0), o3 = orient2d(a0, a1, b1);
+    if ((o2 > 0 && o3 > 0) || (o2 < 0 && o3 < 0)) return false;
+    if (o0 == 0 && o1 == 0 && o2 == 0 && o3 == 0) {
+        // collinear segments intersect when their projections on both axes do
+        for (unsigned i = 0; i < 2; ++i) {
+            Dim2 d = static_cast<Dim2>(i);
+            if (std::max(a0[d], a1[d]) < std::min(b0[d], b1[d]) ||
+                std::max(b0[d], b1[d]) < std::min(a0[d], a1[d]))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+Coord incircle(Point const &a, Point const &b, Point const &c, Point const &d)
+{
+    Coord adx = a[X] - d[X], ady = a[Y] - d[Y];
+    Coord bdx = b[X] - d[X], bdy = b[Y] - d[Y];
+    Coord cdx = c[X] - d[X], cdy = c[Y] - d[Y];
+
+    Coord bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+    Coord cdxady = cdx * ady, adxcdy = adx * cdy;
+    Coord adxbdy = adx * bdy, bdxady = bdx * ady;
+    Coord alift = adx * adx + ady * ady;
+    Coord blift = bdx * bdx + bdy * bdy;
+    Coord clift = cdx * cdx + cdy * cdy;
+
+    Coord det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy)
+              + clift * (adxbdy - bdxady);
+    Coord permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy)) * alift
+                    + (std::fabs(cdxady) + std::fabs(adxcdy)) * blift
+                    + (std::fabs(adxbdy) + std::fabs(bdxady)) * clift;
+    // (10 + 96 eps) eps, where eps = 2^-53
+    Coord errbound = 1.1102230246251577e-15 * permanent;
+    if (det > errbound || -det > errbound) return det;
+
+    // evaluate the same expression exactly
+    Expansion eadx = difference(a[X], d[X]), eady = difference(a[Y], d[Y]);
+    Expansion ebdx = difference(b[X], d[X]), ebdy = difference(b[Y], d[Y]);
+    Expansion ecdx = difference(c[X], d[X]), ecdy = difference(c[Y], d[Y]);
+    Expansion ealift = eadx * eadx + eady * eady;
+    Expansion eblift = ebdx * ebdx + ebdy * ebdy;
+    Expansion eclift = ecdx * ecdx + ecdy * ecdy;
+    Expansion result = ealift * (ebdx * ecdy + -(ecdx * ebdy))
+                     + eblift * (ecdx * eady + -(eadx * ecdy))
+                     + eclift * (eadx * ebdy + -(ebdx * eady));
+    return result.back();
+}
+
+} // namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
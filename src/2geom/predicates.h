@@ -0,0 +1,105 @@
+/** @file
+ * @brief Robust geometric predicates
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+
+#ifndef LIB2GEOM_SEEN_PREDICATES_H
+#define LIB2GEOM_SEEN_PREDICATES_H
+
+#include <cmath>
+#include <2geom/point.h>
+
+namespace Geom {
+
+/* The predicates use the adaptive scheme from J. R. Shewchuk, "Adaptive Precision
+ * Floating-Point Arithmetic and Fast Robust Geometric Predicates". The determinant
+ * is first evaluated in ordinary floating point together with a bound on its rounding
+ * error; only when the result is smaller than the bound, it is recomputed exactly.
+ * The sign of the returned value is always correct, while its magnitude is only
+ * an approximation of the determinant. */
+
+namespace detail {
+Coord cross_difference_exact(Point const &a0, Point const &a1, Point const &b0, Point const &b1);
+} // namespace detail
+
+/** @brief Exact sign of the cross product of two vectors given by their endpoints.
+ * Computes \f$(a_1 - a_0) \times (b_1 - b_0)\f$ without rounding the differences first.
+ * The result is zero exactly when the directions are parallel.
+ * @relates Point */
+inline Coord cross_difference(Point const &a0, Point const &a1, Point const &b0, Point const &b1)
+{
+    Coord left = (a1[X] - a0[X]) * (b1[Y] - b0[Y]);
+    Coord right = (a1[Y] - a0[Y]) * (b1[X] - b0[X]);
+    Coord det = left - right;
+
+    // When the products have opposite signs or one of them is zero, no cancellation occurs
+    // and the test below always succeeds. Avoiding separate branches for these cases
+    // matters, because their outcome is unpredictable for arbitrary input.
+    // (3 + 16 eps) eps, where eps = 2^-53
+    Coord const errbound = 3.3306690738754716e-16 * (std::fabs(left) + std::fabs(right));
+    if (std::fabs(det) >= errbound) return det;
+    return detail::cross_difference_exact(a0, a1, b0, b1);
+}
+
+/** @brief Orientation of three points.
+ * Returns a positive value if the points a, b, c make a counter-clockwise turn in
+ * a coordinate system where the Y axis points up, a negative value for a clockwise turn
+ * and zero if they are collinear. The value is the same as cross(b - a, c - a),
+ * except that its sign is exact.
+ * @relates Point */
+inline Coord orient2d(Point const &a, Point const &b, Point const &c) {
+    return cross_difference(a, b, a, c);
+}
+
+/** @brief Exact test whether two line segments intersect.
+ * Returns true if the closed segments from a0 to a1 and from b0 to b1 have at least
+ * one common point, including when they only touch at an endpoint or overlap.
+ * @relates Point */
+bool segments_intersect(Point const &a0, Point const &a1, Point const &b0, Point const &b1);
+
+/** @brief Position of a point relative to the circle through three other points.
+ * If a, b, c make a counter-clockwise turn, returns a positive value when d lies
+ * inside the circle passing through them, a negative value when it lies outside
+ * and zero when the four points are cocircular. The sign is reversed when
+ * the turn is clockwise.
+ * @relates Point */
+Coord incircle(Point const &a, Point const &b, Point const &c, Point const &d);
+
+} // namespace Geom
+
+#endif // LIB2GEOM_SEEN_PREDICATES_H
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,601 @@
+/** @file
+ * @brief R-tree spatial index
+ *//*
+ * Authors:
+ *   Evangelos Katsikaros (original insert-only implementation)
+ *
+ * Copyright 2009-2016 authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#ifndef LIB2GEOM_SEEN_RTREE_H
+#define LIB2GEOM_SEEN_RTREE_H
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <utility>
+#include <vector>
+#include <2geom/parallel.h>
+#include <2geom/rect.h>
+
+namespace Geom {
+
+/** @brief Dynamic spatial index of values with rectangular bounds.
+ *
+ * The tree can be filled one value at a time with insert(), or all at once
+ * with bulkLoad(), which uses the Sort-Tile-Recursive algorithm and produces
+ * much better trees in less time. Values can be removed with remove().
+ *
+ * Nodes are stored in contiguous arrays rather than allocated separately:
+ * the bounding boxes of the children of a node occupy consecutive memory,
+ * so a node can be scanned without chasing pointers.
+ *
+ * Queries do not modify the tree, so they can be run from several threads
+ * at the same time. The batch methods do this using parallel_run().
+ *
+ * @tparam T Value type; it must be copyable and equality comparable
+ * @ingroup Utilities */
+template <typename T>
+class RTree {
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+    /** @brief Create an empty tree.
+     * @param max_entries Maximum number of children of a node, at least 2
+     * @param min_entries Minimum number of children of a non-root node.
+     *   Zero selects 40% of the maximum; larger values are clamped to half of it. */
+    explicit RTree(unsigned max_entries = 16, unsigned min_entries = 0)
+        : _max(std::max(max_entries, 2u))
+        , _min(min_entries)
+        , _root(0)
+        , _size(0)
+    {
+        if (_min == 0) _min = std::max(1u, _max * 2 / 5);
+        _min = std::min(_min, (_max + 1) / 2);
+    }
+
+    /** @brief Replace the contents of the tree with the given values.
+     * @param first Iterator to a sequence of std::pair<Rect, T>
+     * @param last End of the sequence */
+    template <typename Iter>
+    void bulkLoad(Iter first, Iter last) {
+        clear();
+        std::vector<Entry> entries;
+        for (; first != last; ++first) {
+            entries.push_back(Entry(first->first, _addValue(first->second)));
+        }
+        if (entries.empty()) return;
+        _size = entries.size();
+
+        for (unsigned level = 0; ; ++level) {
+            std::vector<Entry> parents;
+            _pack(entries, level, parents);
+            if (parents.size() == 1) {
+                _root = parents[0].ref;
+                break;
+            }
+            entries.swap(parents);
+        }
+    }
+
+    /// Add a value with the given bounding box.
+    void insert(Rect const &r, T const &value) {
+        _insertEntry(Entry(r, _addValue(value)));
+        ++_size;
+    }
+
+    /** @brief Remove a value.
+     * Removes one value equal to @a value that was inserted with the bounding box @a r.
+     * @return True if a value was removed */
+    bool remove(Rect const &r, T const &value) {
+        if (_size == 0) return false;
+        std::vector<Entry> orphans;
+        if (!_remove(_root, r, value, orphans)) return false;
+        --_size;
+
+        // shorten the tree when the root has only one child
+        while (_nodes[_root].level > 0 && _nodes[_root].count <= 1) {
+            if (_nodes[_root].count == 0) {
+                _nodes[_root].level = 0;
+                break;
+            }
+            size_type child = _refs[_slot(_root, 0)];
+            _freeNode(_root);
+            _root = child;
+        }
+        // entries of underfull nodes are inserted again
+        for (size_type i = 0; i < orphans.size(); ++i) {
+            _insertEntry(orphans[i]);
+        }
+        return true;
+    }
+
+    /// Remove all values.
+    void clear() {
+        _nodes.clear();
+        _boxes.clear();
+        _refs.clear();
+        _free_nodes.clear();
+        _values.clear();
+        _free_values.clear();
+        _root = 0;
+        _size = 0;
+    }
+
+    /// Number of values in the tree.
+    size_type size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    /// Number of levels of nodes; zero for an empty tree.
+    unsigned height() const { return _size == 0 ? 0 : _nodes[_root].level + 1; }
+    unsigned maxEntries() const { return _max; }
+    unsigned minEntries() const { return _min; }
+
+    /// Bounding box of all values in the tree.
+    OptRect bounds() const {
+        if (_size == 0) return OptRect();
+        return _nodeBounds(_root);
+    }
+
+    /** @brief Find values whose bounding boxes intersect the given rectangle.
+     * The values are written to the output iterator in no particular order. */
+    template <typename OutputIterator>
+    OutputIterator query(Rect const &r, OutputIterator out) const {
+        if (_size == 0) return out;
+        std::vector<size_type> stack;
+        stack.push_back(_root);
+        while (!stack.empty()) {
+            size_type node = stack.back();
+            stack.pop_back();
+            bool leaf = _nodes[node].level == 0;
+            size_type begin = _slot(node, 0), end = begin + _nodes[node].count;
+            for (size_type s = begin; s < end; ++s) {
+                if (!_boxes[s].intersects(r)) continue;
+                if (leaf) {
+                    *out++ = _values[_refs[s]];
+                } else {
+                    stack.push_back(_refs[s]);
+                }
+            }
+        }
+        return out;
+    }
+
+    /// Find values whose bounding boxes intersect the given rectangle.
+    std::vector<T> query(Rect const &r) const {
+        std::vector<T> result;
+        query(r, std::back_inserter(result));
+        return result;
+    }
+
+    /** @brief Run many range queries.
+     * @return Vector with the results of query() for each rectangle */
+    std::vector<std::vector<T> > batchQuery(std::vector<Rect> const &rects) const {
+        std::vector<std::vector<T> > result(rects.size());
+        QueryTask task(*this, rects, result);
+        parallel_run(task, rects.size());
+        return result;
+    }
+
+    /** @brief Find the values nearest to a point.
+     * Distance is measured from the point to the bounding boxes of values.
+     * @return At most @a k values, ordered by increasing distance */
+    std::vector<T> nearest(Point const &p, size_type k) const {
+        std::vector<T> result;
+        if (_size == 0 || k == 0) return result;
+
+        std::priority_queue<QueueItem> queue;
+        queue.push(QueueItem(0, _root, false));
+        while (!queue.empty() && result.size() < k) {
+            QueueItem item = queue.top();
+            queue.pop();
+            if (item.is_value) {
+                result.push_back(_values[item.ref]);
+                continue;
+            }
+            bool leaf = _nodes[item.ref].level == 0;
+            size_type begin = _slot(item.ref, 0), end = begin + _nodes[item.ref].count;
+            for (size_type s = begin; s < end; ++s) {
+                queue.push(QueueItem(distanceSq(p, _boxes[s]), _refs[s], leaf));
+            }
+        }
+        return result;
+    }
+
+    /** @brief Run many nearest neighbor queries.
+     * @return Vector with the results of nearest() for each point */
+    std::vector<std::vector<T> > batchNearest(std::vector<Point> const &points, size_type k) const {
+        std::vector<std::vector<T> > result(points.size());
+        NearestTask task(*this, points, k, result);
+        parallel_run(task, points.size());
+        return result;
+    }
+
+    /** @brief Call a function for each node of the tree.
+     * The function is called with the bounding box of the node and its depth,
+     * which is zero for the root. This is mainly useful for visualization. */
+    template <typename Visitor>
+    void visitNodes(Visitor &v) const {
+        if (_size == 0) return;
+        _visitNodes(_root, 0, v);
+    }
+
+private:
+    struct Node {
+        unsigned count;
+        unsigned level; ///< Zero for leaves
+    };
+    // child node index in inner nodes, value index in leaves
+    struct Entry {
+        Entry(Rect const &b, size_type r) : bounds(b), ref(r) {}
+        Rect bounds;
+        size_type ref;
+    };
+    struct EntryLess {
+        EntryLess(Dim2 d) : dim(d) {}
+        bool operator()(Entry const &a, Entry const &b) const {
+            if (a.bounds[dim].min() != b.bounds[dim].min()) {
+                return a.bounds[dim].min() < b.bounds[dim].min();
+            }
+            return a.bounds[dim].max() < b.bounds[dim].max();
+        }
+        Dim2 dim;
+    };
+    struct CenterLess {
+        CenterLess(Dim2 d) : dim(d) {}
+        bool operator()(Entry const &a, Entry const &b) const {
+            return a.bounds[dim].middle() < b.bounds[dim].middle();
+        }
+        Dim2 dim;
+    };
+    struct QueueItem {
+        QueueItem(Coord d, size_type r, bool v) : dist(d), ref(r), is_value(v) {}
+        // std::priority_queue returns the largest item, so this is reversed
+        bool operator<(QueueItem const &other) const {
+            if (dist != other.dist) return dist > other.dist;
+            if (is_value != other.is_value) return !is_value;
+            return ref > other.ref;
+        }
+        Coord dist;
+        size_type ref;
+        bool is_value;
+    };
+    class QueryTask : public ParallelTask {
+    public:
+        QueryTask(RTree const &t, std::vector<Rect> const &r, std::vector<std::vector<T> > &o)
+            : tree(t), rects(r), out(o) {}
+        void run(std::size_t i) {
+            tree.query(rects[i], std::back_inserter(out[i]));
+        }
+        RTree const &tree;
+        std::vector<Rect> const &rects;
+        std::vector<std::vector<T> > &out;
+    };
+    class NearestTask : public ParallelTask {
+    public:
+        NearestTask(RTree const &t, std::vector<Point> const &p, size_type n,
+                    std::vector<std::vector<T> > &o)
+            : tree(t), points(p), k(n), out(o) {}
+        void run(std::size_t i) {
+            out[i] = tree.nearest(points[i], k);
+        }
+        RTree const &tree;
+        std::vector<Point> const &points;
+        size_type k;
+        std::vector<std::vector<T> > &out;
+    };
+
+    size_type _slot(size_type node, unsigned i) const { return node * _max + i; }
+
+    size_type _allocNode(unsigned level) {
+        size_type node;
+        if (!_free_nodes.empty()) {
+            node = _free_nodes.back();
+            _free_nodes.pop_back();
+        } else {
+            node = _nodes.size();
+            _nodes.push_back(Node());
+            _boxes.resize(_boxes.size() + _max, Rect());
+            _refs.resize(_refs.size() + _max, 0);
+        }
+        _nodes[node].count = 0;
+        _nodes[node].level = level;
+        return node;
+    }
+    void _freeNode(size_type node) {
+        _nodes[node].count = 0;
+        _free_nodes.push_back(node);
+    }
+    size_type _addValue(T const &value) {
+        if (!_free_values.empty()) {
+            size_type i = _free_values.back();
+            _free_values.pop_back();
+            _values[i] = value;
+            return i;
+        }
+        _values.push_back(value);
+        return _values.size() - 1;
+    }
+
+    Rect _nodeBounds(size_type node) const {
+        size_type begin = _slot(node, 0), end = begin + _nodes[node].count;
+        Rect result = _boxes[begin];
+        for (size_type s = begin + 1; s < end; ++s) {
+            result.unionWith(_boxes[s]);
+        }
+        return result;
+    }
+    void _append(size_type node, Entry const &e) {
+        size_type s = _slot(node, _nodes[node].count++);
+        _boxes[s] = e.bounds;
+        _refs[s] = e.ref;
+    }
+    void _erase(size_type node, unsigned i) {
+        unsigned last = --_nodes[node].count;
+        _boxes[_slot(node, i)] = _boxes[_slot(node, last)];
+        _refs[_slot(node, i)] = _refs[_slot(node, last)];
+    }
+
+    /* Pack entries into nodes of the given level using Sort-Tile-Recursive:
+     * sort by X, cut into vertical slices, sort each slice by Y and cut it into nodes.
+     * Nodes within a slice get nearly equal numbers of entries. */
+    void _pack(std::vector<Entry> &entries, unsigned level, std::vector<Entry> &parents) {
+        size_type n = entries.size();
+        size_type leaves = (n + _max - 1) / _max;
+        size_type slices = static_cast<size_type>(std::ceil(std::sqrt(static_cast<double>(leaves))));
+        size_type slice_size = slices * _max;
+
+        std::sort(entries.begin(), entries.end(), CenterLess(X));
+        for (size_type begin = 0; begin < n; begin += slice_size) {
+            size_type end = std::min(begin + slice_size, n);
+            std::sort(entries.begin() + begin, entries.begin() + end, CenterLess(Y));
+
+            size_type count = end - begin;
+            size_type nodes = (count + _max - 1) / _max;
+            size_type pos = begin;
+            for (size_type j = 0; j < nodes; ++j) {
+                size_type next = begin + count * (j + 1) / nodes;
+                size_type node = _allocNode(level);
+                for (; pos < next; ++pos) {
+                    _append(node, entries[pos]);
+                }
+                parents.push_back(Entry(_nodeBounds(node), node));
+            }
+        }
+    }
+
+    void _insertEntry(Entry const &e) {
+        if (_nodes.size() == _free_nodes.size()) {
+            _root = _allocNode(0);
+        }
+        size_type sibling;
+        if (_insert(_root, e, sibling)) {
+            // the root was split, so the tree grows by one level
+            size_type old_root = _root;
+            _root = _allocNode(_nodes[old_root].level + 1);
+            _append(_root, Entry(_nodeBounds(old_root), old_root));
+            _append(_root, Entry(_nodeBounds(sibling), sibling));
+        }
+    }
+
+    // Returns true if the node was split; the new node is stored in sibling.
+    bool _insert(size_type node, Entry const &e, size_type &sibling) {
+        if (_nodes[node].level == 0) {
+            return _addEntry(node, e, sibling);
+        }
+        unsigned i = _chooseSubtree(node, e.bounds);
+        size_type child = _refs[_slot(node, i)];
+        size_type split;
+        if (_insert(child, e, split)) {
+            _boxes[_slot(node, i)] = _nodeBounds(child);
+            return _addEntry(node, Entry(_nodeBounds(split), split), sibling);
+        }
+        _boxes[_slot(node, i)].unionWith(e.bounds);
+        return false;
+    }
+
+    // Pick the child whose bounding box needs the least enlargement.
+    unsigned _chooseSubtree(size_type node, Rect const &r) const {
+        unsigned best = 0;
+        Coord best_enlargement = 0, best_area = 0;
+        for (unsigned i = 0; i < _nodes[node].count; ++i) {
+            Rect const &b = _boxes[_slot(node, i)];
+            Rect u = b;
+            u.unionWith(r);
+            Coord area = b.area();
+            Coord enlargement = u.area() - area;
+            if (i == 0 || enlargement < best_enlargement
+                || (enlargement == best_enlargement && area < best_area))
+            {
+                best = i;
+                best_enlargement = enlargement;
+                best_area = area;
+            }
+        }
+        return best;
+    }
+
+    bool _addEntry(size_type node, Entry const &e, size_type &sibling) {
+        if (_nodes[node].count < _max) {
+            _append(node, e);
+            return false;
+        }
+        std::vector<Entry> entries;
+        entries.reserve(_max + 1);
+        for (unsigned i = 0; i < _max; ++i) {
+            entries.push_back(Entry(_boxes[_slot(node, i)], _refs[_slot(node, i)]));
+        }
+        entries.push_back(e);
+        sibling = _allocNode(_nodes[node].level);
+        _split(entries, node, sibling);
+        return true;
+    }
+
+    /* R*-tree split: choose the axis with the smallest total perimeter of the candidate
+     * distributions, then the distribution on that axis with the least overlap. */
+    void _split(std::vector<Entry> &entries, size_type node, size_type sibling) {
+        size_type n = entries.size();
+        std::vector<Rect> head(n), tail(n);
+
+        Dim2 axis = X;
+        Coord best_margin = 0;
+        for (unsigned d = 0; d < 2; ++d) {
+            std::sort(entries.begin(), entries.end(), EntryLess(Dim2(d)));
+            _prefixBounds(entries, head, tail);
+            Coord margin = 0;
+            for (size_type k = _min; k <= n - _min; ++k) {
+                margin += head[k - 1].width() + head[k - 1].height()
+                        + tail[k].width() + tail[k].height();
+            }
+            if (d == 0 || margin < best_margin) {
+                axis = Dim2(d);
+                best_margin = margin;
+            }
+        }
+
+        std::sort(entries.begin(), entries.end(), EntryLess(axis));
+        _prefixBounds(entries, head, tail);
+        size_type split = _min;
+        Coord best_overlap = 0, best_area = 0;
+        for (size_type k = _min; k <= n - _min; ++k) {
+            OptRect common = head[k - 1] & tail[k];
+            Coord overlap = common ? common->area() : 0;
+            Coord area = head[k - 1].area() + tail[k].area();
+            if (k == _min || overlap < best_overlap
+                || (overlap == best_overlap && area < best_area))
+            {
+                split = k;
+                best_overlap = overlap;
+                best_area = area;
+            }
+        }
+
+        _nodes[node].count = 0;
+        for (size_type i = 0; i < split; ++i) {
+            _append(node, entries[i]);
+        }
+        for (size_type i = split; i < n; ++i) {
+            _append(sibling, entries[i]);
+        }
+    }
+
+    // head[i] bounds entries [0, i], tail[i] bounds entries [i, n)
+    static void _prefixBounds(std::vector<Entry> const &entries,
+                              std::vector<Rect> &head, std::vector<Rect> &tail)
+    {
+        size_type n = entries.size();
+        head[0] = entries[0].bounds;
+        for (size_type i = 1; i < n; ++i) {
+            head[i] = head[i - 1];
+            head[i].unionWith(entries[i].bounds);
+        }
+        tail[n - 1] = entries[n - 1].bounds;
+        for (size_type i = n - 1; i > 0; --i) {
+            tail[i - 1] = tail[i];
+            tail[i - 1].unionWith(entries[i - 1].bounds);
+        }
+    }
+
+    bool _remove(size_type node, Rect const &r, T const &value, std::vector<Entry> &orphans) {
+        if (_nodes[node].level == 0) {
+            for (unsigned i = 0; i < _nodes[node].count; ++i) {
+                size_type s = _slot(node, i);
+                if (_boxes[s] == r && _values[_refs[s]] == value) {
+                    _free_values.push_back(_refs[s]);
+                    _erase(node, i);
+                    return true;
+                }
+            }
+            return false;
+        }
+        for (unsigned i = 0; i < _nodes[node].count; ++i) {
+            size_type s = _slot(node, i);
+            if (!_boxes[s].contains(r)) continue;
+            size_type child = _refs[s];
+            if (!_remove(child, r, value, orphans)) continue;
+
+            if (_nodes[child].count < _min) {
+                _collect(child, orphans);
+                _erase(node, i);
+            } else {
+                _boxes[s] = _nodeBounds(child);
+            }
+            return true;
+        }
+        return false;
+    }
+
+    // Gather all values stored in a subtree and free its nodes.
+    void _collect(size_type node, std::vector<Entry> &out) {
+        for (unsigned i = 0; i < _nodes[node].count; ++i) {
+            size_type s = _slot(node, i);
+            if (_nodes[node].level == 0) {
+                out.push_back(Entry(_boxes[s], _refs[s]));
+            } else {
+                _collect(_refs[s], out);
+            }
+        }
+        _freeNode(node);
+    }
+
+    template <typename Visitor>
+    void _visitNodes(size_type node, unsigned depth, Visitor &v) const {
+        if (_nodes[node].count == 0) return;
+        v(_nodeBounds(node), depth);
+        if (_nodes[node].level == 0) return;
+        for (unsigned i = 0; i < _nodes[node].count; ++i) {
+            _visitNodes(_refs[_slot(node, i)], depth + 1, v);
+        }
+    }
+
+    unsigned _max;
+    unsigned _min;
+    size_type _root;
+    size_type _size;
+    std::vector<Node> _nodes;
+    std::vector<Rect> _boxes; ///< Bounding boxes of children, _max slots per node
+    std::vector<size_type> _refs; ///< Child node or value indices, _max slots per node
+    std::vector<size_type> _free_nodes;
+    std::vector<T> _values;
+    std::vector<size_type> _free_values;
+};
+
+} // end namespace Geom
+
+#endif // LIB2GEOM_SEEN_RTREE_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -37,6 +37,7 @@
 #include <iterator>
 #include <stdexcept>
 #include <vector>
+#include <cstddef>
 #include <cstdio>
 #include <2geom/exception.h>
 #include <2geom/point.h>
@@ -50,7 +51,11 @@ namespace Geom {
  * This class provides an interface to an SVG path data parser written in Ragel.
  * It supports parsing the path data either at once or block-by-block.
  * Use the parse() functions to parse complete data and the feed() and finish()
- * functions to parse partial data.
+ * functions to parse partial data. Blocks can be split at any byte, including
+ * the middle of a number, and they need not be null-terminated, so the parser
+ * can work directly on memory-mapped files or buffers received in chunks.
+ * The input is not copied, except for numbers that span block boundaries,
+ * and segments are passed to the sink without creating intermediate curves.
  *
  * The parser will call the appropriate methods on the PathSink supplied
  * at construction. To store the path in memory as a PathVector, pass
@@ -76,7 +81,7 @@ public:
      * process the last block of partial data.
      * @param str String to parse
      * @param len Length of string or -1 if null-terminated */
-    void parse(char const *str, int len = -1);
+    void parse(char const *str, std::ptrdiff_t len = -1);
     /** @brief Parse an STL string. */
     void parse(std::string const &s);
 
@@ -87,7 +92,7 @@ public:
      * with the last block of data.
      * @param str String to parse
      * @param len Length of string or -1 if null-terminated */
-    void feed(char const *str, int len = -1);
+    void feed(char const *str, std::ptrdiff_t len = -1);
     /** @brief Parse a part of path data stored in an STL string. */
     void feed(std::string const &s);
 
@@ -118,7 +123,21 @@ private:
     std::vector<Coord> _params;
     PathSink &_sink;
     Coord _z_snap_threshold;
-    Curve *_curve;
+
+    // The last segment is passed to the sink only when the next command is parsed,
+    // because a following 'z' may need to adjust its final point.
+    enum SegmentType {
+        SEGMENT_NONE,
+        SEGMENT_LINE,
+        SEGMENT_QUAD,
+        SEGMENT_CUBIC,
+        SEGMENT_ARC
+    };
+    SegmentType _segment;
+    Point _segment_controls[2];
+    Point _segment_final;
+    Coord _arc_rx, _arc_ry, _arc_angle;
+    bool _arc_large, _arc_sweep;
 
     int cs;
     std::string _number_part;
@@ -135,7 +154,7 @@ private:
     void _arcTo(double rx, double ry, double angle,
                 bool large_arc, bool sweep, Point const &p);
     void _closePath();
-    void _pushCurve(Curve *c);
+    void _flushSegment();
 
     void _parse(char const *str, char const *strend, bool finish);
 };
@@ -151,6 +170,11 @@ inline void parse_svg_path(std::string const &str, PathSink &sink) {
 /** Feed SVG path data from a C stream to the specified sink
  * @ingroup Paths */
 void parse_svg_path_file(FILE *fi, PathSink &sink);
+/** @brief Feed SVG path data from a file to the specified sink
+ * Regular files are memory-mapped where supported and parsed without copying.
+ * @throw std::runtime_error if the file cannot be opened
+ * @ingroup Paths */
+void parse_svg_path_file(char const *filename, PathSink &sink);
 
 /** @brief Create path vector from SVG path data stored in a C string
  * @ingroup Paths */
@@ -163,6 +187,22 @@ inline PathVector parse_svg_path(char const *str) {
     return ret;
 }
 
+/** @brief Create path vector from SVG path data, parsing subpaths concurrently.
+ * The data is split before absolute moveto commands into ranges, which are parsed
+ * in parallel using the threads set with set_thread_count(). The result is identical
+ * to that of parse_svg_path(). Data without absolute movetos or shorter than
+ * a few dozen kilobytes is parsed serially.
+ * @param str String to parse
+ * @param len Length of string or -1 if null-terminated
+ * @throw SVGPathParseError if the data is invalid
+ * @ingroup Paths */
+PathVector parse_svg_path_parallel(char const *str, std::ptrdiff_t len = -1);
+/** @brief Create path vector from SVG path data, parsing subpaths concurrently.
+ * @ingroup Paths */
+inline PathVector parse_svg_path_parallel(std::string const &str) {
+    return parse_svg_path_parallel(str.data(), str.size());
+}
+
 /** @brief Create path vector from a C stream with SVG path data
  * @ingroup Paths */
 inline PathVector read_svgd_f(FILE * fi) {
@@ -177,11 +217,12 @@ inline PathVector read_svgd_f(FILE * fi) {
 /** @brief Create path vector from SVG path data stored in a file
  * @ingroup Paths */
 inline PathVector read_svgd(char const *filename) {
-    FILE* fi = fopen(filename, "r");
-    if(fi == NULL) throw(std::runtime_error("Error opening file"));
-    PathVector out = read_svgd_f(fi);
-    fclose(fi);
-    return out;
+    PathVector ret;
+    SubpathInserter iter(ret);
+    PathIteratorSink<SubpathInserter> generator(iter);
+
+    parse_svg_path_file(filename, generator);
+    return ret;
 }
 
 } // end namespace Geom
@@ -30,14 +30,24 @@
  *
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <cmath>
+#include <cstring>
 #include <vector>
-#include <glib.h>
 
+#include "config.h"
 #include <2geom/point.h>
 #include <2geom/svg-path-parser.h>
 #include <2geom/angle.h>
+#include <2geom/parallel.h>
+
+#ifdef HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace Geom {
 
@@ -50,14 +60,13 @@ SVGPathParser::SVGPathParser(PathSink &sink)
     : _absolute(false)
     , _sink(sink)
     , _z_snap_threshold(0)
-    , _curve(NULL)
+    , _segment(SEGMENT_NONE)
 {
     reset();
 }
 
 SVGPathParser::~SVGPathParser()
 {
-    delete _curve;
 }
 
 void SVGPathParser::reset() {
@@ -65,15 +74,14 @@ void SVGPathParser::reset() {
     _current = _initial = Point(0, 0);
     _quad_tangent = _cubic_tangent = Point(0, 0);
     _params.clear();
-    delete _curve;
-    _curve = NULL;
+    _segment = SEGMENT_NONE;
 
     %%{
         write init;
     }%%
 }
 
-void SVGPathParser::parse(char const *str, int len)
+void SVGPathParser::parse(char const *str, std::ptrdiff_t len)
 {
     if (len < 0) {
         len = std::strlen(str);
@@ -86,7 +94,7 @@ void SVGPathParser::parse(std::string const &s)
     _parse(s.c_str(), s.c_str() + s.size(), true);
 }
 
-void SVGPathParser::feed(char const *str, int len)
+void SVGPathParser::feed(char const *str, std::ptrdiff_t len)
 {
     if (len < 0) {
         len = std::strlen(str);
@@ -140,27 +148,36 @@ Point SVGPathParser::_pop_point()
 
 void SVGPathParser::_moveTo(Point const &p)
 {
-    _pushCurve(NULL); // flush
+    _flushSegment();
     _sink.moveTo(p);
     _quad_tangent = _cubic_tangent = _current = _initial = p;
 }
 
 void SVGPathParser::_lineTo(Point const &p)
 {
-    _pushCurve(new LineSegment(_current, p));
+    _flushSegment();
+    _segment = SEGMENT_LINE;
+    _segment_final = p;
     _quad_tangent = _cubic_tangent = _current = p;
 }
 
 void SVGPathParser::_curveTo(Point const &c0, Point const &c1, Point const &p)
 {
-    _pushCurve(new CubicBezier(_current, c0, c1, p));
+    _flushSegment();
+    _segment = SEGMENT_CUBIC;
+    _segment_controls[0] = c0;
+    _segment_controls[1] = c1;
+    _segment_final = p;
     _quad_tangent = _current = p;
     _cubic_tangent = p + ( p - c1 );
 }
 
 void SVGPathParser::_quadTo(Point const &c, Point const &p)
 {
-    _pushCurve(new QuadraticBezier(_current, c, p));
+    _flushSegment();
+    _segment = SEGMENT_QUAD;
+    _segment_controls[0] = c;
+    _segment_final = p;
     _cubic_tangent = _current = p;
     _quad_tangent = p + ( p - c );
 }
@@ -172,30 +189,49 @@ void SVGPathParser::_arcTo(Coord rx, Coord ry, Coord angle,
         return; // ignore invalid (ambiguous) arc segments where start and end point are the same (per SVG spec)
     }
 
-    _pushCurve(new EllipticalArc(_current, rx, ry, angle, large_arc, sweep, p));
+    _flushSegment();
+    _segment = SEGMENT_ARC;
+    _arc_rx = rx;
+    _arc_ry = ry;
+    _arc_angle = angle;
+    _arc_large = large_arc;
+    _arc_sweep = sweep;
+    _segment_final = p;
     _quad_tangent = _cubic_tangent = _current = p;
 }
 
 void SVGPathParser::_closePath()
 {
-    if (_curve && (!_absolute || !_moveto_was_absolute) &&
+    if (_segment != SEGMENT_NONE && (!_absolute || !_moveto_was_absolute) &&
         are_near(_initial, _current, _z_snap_threshold))
     {
-        _curve->setFinal(_initial);
+        _segment_final = _initial;
     }
 
-    _pushCurve(NULL); // flush
+    _flushSegment();
     _sink.closePath();
     _quad_tangent = _cubic_tangent = _current = _initial;
 }
 
-void SVGPathParser::_pushCurve(Curve *c)
+void SVGPathParser::_flushSegment()
 {
-    if (_curve) {
-        _sink.feed(*_curve, false);
-        delete _curve;
+    switch (_segment) {
+    case SEGMENT_LINE:
+        _sink.lineTo(_segment_final);
+        break;
+    case SEGMENT_QUAD:
+        _sink.quadTo(_segment_controls[0], _segment_final);
+        break;
+    case SEGMENT_CUBIC:
+        _sink.curveTo(_segment_controls[0], _segment_controls[1], _segment_final);
+        break;
+    case SEGMENT_ARC:
+        _sink.arcTo(_arc_rx, _arc_ry, _arc_angle, _arc_large, _arc_sweep, _segment_final);
+        break;
+    default:
+        break;
     }
-    _curve = c;
+    _segment = SEGMENT_NONE;
 }
 
 void SVGPathParser::_parse(char const *str, char const *strend, bool finish)
@@ -212,12 +248,13 @@ void SVGPathParser::_parse(char const *str, char const *strend, bool finish)
 
         action push_number {
             if (start) {
-                std::string buf(start, p);
-                _push(g_ascii_strtod(buf.c_str(), NULL));
+                _push(parse_coord(start, p));
                 start = NULL;
             } else {
-                std::string buf(str, p);
-                _push(g_ascii_strtod((_number_part + buf).c_str(), NULL));
+                // the number started in a previous block
+                _number_part.append(str, p);
+                _push(parse_coord(_number_part.data(),
+                                  _number_part.data() + _number_part.size()));
                 _number_part.clear();
             }
         }
@@ -439,11 +476,14 @@ void SVGPathParser::_parse(char const *str, char const *strend, bool finish)
             throw SVGPathParseError();
         }
     } else if (start != NULL) {
-        _number_part = std::string(start, pe);
+        _number_part.assign(start, pe);
+    } else if (!_number_part.empty()) {
+        // the whole block is a part of a number that started in a previous block
+        _number_part.append(str, pe);
     }
 
     if (finish) {
-        _pushCurve(NULL);
+        _flushSegment();
         _sink.flush();
         reset();
     }
@@ -457,22 +497,122 @@ void parse_svg_path(char const *str, PathSink &sink)
 
 void parse_svg_path_file(FILE *fi, PathSink &sink)
 {
-    static const size_t BUFFER_SIZE = 4096;
-    char buffer[BUFFER_SIZE];
+    static const size_t BUFFER_SIZE = 65536;
+    std::vector<char> buffer(BUFFER_SIZE);
     size_t bytes_read;
     SVGPathParser parser(sink);
 
     while (true) {
-        bytes_read = fread(buffer, 1, BUFFER_SIZE, fi);
+        bytes_read = fread(&buffer[0], 1, BUFFER_SIZE, fi);
         if (bytes_read < BUFFER_SIZE) {
-            parser.parse(buffer, bytes_read);
+            parser.parse(&buffer[0], bytes_read);
             break;
         } else {
-            parser.feed(buffer, bytes_read);
+            parser.feed(&buffer[0], bytes_read);
         }
     }
 }
 
+void parse_svg_path_file(char const *filename, PathSink &sink)
+{
+#ifdef HAVE_MMAP
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error("Error opening file");
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        std::size_t size = st.st_size;
+        void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data != MAP_FAILED) {
+            posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+            try {
+                SVGPathParser parser(sink);
+                parser.parse(static_cast<char const *>(data), size);
+            } catch (...) {
+                munmap(data, size);
+                throw;
+            }
+            munmap(data, size);
+            return;
+        }
+    } else {
+        close(fd);
+    }
+    // fall back to reading through stdio, e.g. for pipes or empty files
+#endif
+    FILE *fi = fopen(filename, "r");
+    if (fi == NULL) {
+        throw std::runtime_error("Error opening file");
+    }
+    try {
+        parse_svg_path_file(fi, sink);
+    } catch (...) {
+        fclose(fi);
+        throw;
+    }
+    fclose(fi);
+}
+
+namespace {
+
+// Parses ranges of path data which start with an absolute moveto into separate path vectors.
+class SubpathRangeParser : public ParallelTask {
+public:
+    SubpathRangeParser(char const *str, std::vector<std::size_t> const &bounds,
+                       std::vector<PathVector> &out)
+        : _str(str), _bounds(bounds), _out(out)
+    {}
+    void run(std::size_t i) {
+        SubpathInserter iter(_out[i]);
+        PathIteratorSink<SubpathInserter> generator(iter);
+        SVGPathParser parser(generator);
+        parser.parse(_str + _bounds[i], _bounds[i + 1] - _bounds[i]);
+    }
+private:
+    char const *_str;
+    std::vector<std::size_t> const &_bounds;
+    std::vector<PathVector> &_out;
+};
+
+} // end anonymous namespace
+
+PathVector parse_svg_path_parallel(char const *str, std::ptrdiff_t len)
+{
+    if (len < 0) {
+        len = std::strlen(str);
+    }
+
+    // Ranges smaller than this are not worth a separate task.
+    std::size_t const MIN_RANGE_SIZE = 64 * 1024;
+    std::size_t const size = len;
+    std::size_t const ranges = std::min<std::size_t>(4 * thread_count(), size / MIN_RANGE_SIZE);
+
+    // Split before absolute moveto commands. They do not depend on the preceding data,
+    // and 'M' cannot appear in path data in any other role. Relative movetos are not
+    // used, since they depend on the current point.
+    std::vector<std::size_t> bounds(1, 0);
+    for (std::size_t i = 1; i < ranges; ++i) {
+        std::size_t pos = std::max(i * size / ranges, bounds.back() + 1);
+        if (pos >= size) break;
+        void const *m = std::memchr(str + pos, 'M', size - pos);
+        if (m == NULL) break;
+        bounds.push_back(static_cast<char const *>(m) - str);
+    }
+    bounds.push_back(size);
+
+    std::vector<PathVector> parts(bounds.size() - 1);
+    SubpathRangeParser task(str, bounds, parts);
+    parallel_run(task, parts.size());
+
+    PathVector ret;
+    for (std::size_t i = 0; i < parts.size(); ++i) {
+        ret.insert(ret.end(), parts[i].begin(), parts[i].end());
+    }
+    return ret;
+}
+
 } // namespace Geom
 
 /*
@@ -30,8 +30,8 @@
  * the specific language governing rights and limitations.
  */
 
+#include <algorithm>
 #include <cmath>
-#include <iomanip>
 #include <2geom/coord.h>
 #include <2geom/svg-path-writer.h>
 #include <glib.h>
@@ -43,16 +43,26 @@ static inline bool is_digit(char c) {
 }
 
 SVGPathWriter::SVGPathWriter()
-    : _epsilon(0)
+    : _out(&_s)
+    , _start(0)
+    , _number(32)
+    , _epsilon(0)
     , _precision(-1)
     , _optimize(false)
     , _use_shorthands(true)
     , _command(0)
-{
-    // always use C locale for number formatting
-    _ns.imbue(std::locale::classic());
-    _ns.unsetf(std::ios::floatfield);
-}
+{}
+
+SVGPathWriter::SVGPathWriter(std::string &out)
+    : _out(&out)
+    , _start(out.size())
+    , _number(32)
+    , _epsilon(0)
+    , _precision(-1)
+    , _optimize(false)
+    , _use_shorthands(true)
+    , _command(0)
+{}
 
 void SVGPathWriter::moveTo(Point const &p)
 {
@@ -166,9 +176,9 @@ void SVGPathWriter::closePath()
 {
     flush();
     if (_optimize) {
-        _s << "z";
+        _out->push_back('z');
     } else {
-        _s << " z";
+        _out->append(" z");
     }
     _current = _quad_tangent = _cubic_tangent = _subpath_start;
 }
@@ -177,21 +187,18 @@ void SVGPathWriter::flush()
 {
     if (_command == 0 || _current_pars.empty()) return;
 
-    if (_optimize) {
-        _s << _command;
-    } else {
-        if (_s.tellp() != 0) {
-            _s << ' ';
-        }
-        _s << _command;
+    if (!_optimize && _out->size() != _start) {
+        _out->push_back(' ');
     }
+    _out->push_back(_command);
 
     char lastchar = _command;
     bool contained_dot = false;
+    char *cs = &_number[0];
 
     for (unsigned i = 0; i < _current_pars.size(); ++i) {
         // TODO: optimize the use of absolute / relative coords
-        std::string cs = _formatCoord(_current_pars[i]);
+        char *cs_end = _formatCoord(_current_pars[i], cs);
 
         // Separator handling logic.
         // Floating point values can end with a digit or dot
@@ -201,24 +208,23 @@ void SVGPathWriter::flush()
         // * digit-dot (only if the previous number didn't contain a dot)
         // * dot-digit
         if (_optimize) {
-            // C++11: change to front()
             char firstchar = cs[0];
             if (is_digit(lastchar)) {
                 if (is_digit(firstchar)) {
-                    _s << " ";
+                    _out->push_back(' ');
                 } else if (firstchar == '.' && !contained_dot) {
-                    _s << " ";
+                    _out->push_back(' ');
                 }
             } else if (lastchar == '.' && is_digit(firstchar)) {
-                _s << " ";
+                _out->push_back(' ');
             }
-            _s << cs;
+            _out->append(cs, cs_end);
 
-            // C++11: change to back()
-            lastchar = cs[cs.length()-1];
-            contained_dot = cs.find('.') != std::string::npos;
+            lastchar = cs_end[-1];
+            contained_dot = std::find(cs, cs_end, '.') != cs_end;
         } else {
-            _s << " " << cs;
+            _out->push_back(' ');
+            _out->append(cs, cs_end);
         }
     }
     _current_pars.clear();
@@ -227,10 +233,7 @@ void SVGPathWriter::flush()
 
 void SVGPathWriter::clear()
 {
-    _s.clear();
-    _s.str("");
-    _ns.clear();
-    _ns.str("");
+    _out->erase(_start);
     _command = 0;
     _current_pars.clear();
     _current = Point(0,0);
@@ -244,7 +247,7 @@ void SVGPathWriter::setPrecision(int prec)
         _epsilon = 0;
     } else {
         _epsilon = std::pow(10., -prec);
-        _ns << std::setprecision(_precision);
+        _number.resize(std::max(32, prec + 32));
     }
 }
 
@@ -256,18 +259,12 @@ void SVGPathWriter::_setCommand(char cmd)
     _command = cmd;
 }
 
-std::string SVGPathWriter::_formatCoord(Coord par)
+char *SVGPathWriter::_formatCoord(Coord par, char *buf)
 {
-    std::string ret;
     if (_precision < 0) {
-        ret = format_coord_shortest(par);
-    } else {
-        _ns << par;
-        ret = _ns.str();
-        _ns.clear();
-        _ns.str("");
+        return format_coord_shortest(par, buf);
     }
-    return ret;
+    return format_coord_precision(par, _precision, buf);
 }
 
 
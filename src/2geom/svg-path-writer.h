@@ -35,11 +35,17 @@
 
 #include <2geom/path-sink.h>
 #include <sstream>
+#include <string>
+#include <vector>
 
 namespace Geom {
 
 /** @brief Serialize paths to SVG path data strings.
  * You can access the generated string by calling the str() method.
+ * Alternatively, the writer can append the path data to a string supplied
+ * by the caller, which avoids copying when serializing large amounts of data.
+ * Coordinates are formatted directly into the output string, without
+ * per-coordinate allocations or iostreams.
  * @ingroup Paths
  */
 class SVGPathWriter
@@ -47,6 +53,9 @@ class SVGPathWriter
 {
 public:
     SVGPathWriter();
+    /** @brief Create a writer which appends path data to the given string.
+     * The string must outlive the writer. Its existing content is not modified. */
+    explicit SVGPathWriter(std::string &out);
     ~SVGPathWriter() {}
 
     void moveTo(Point const &p);
@@ -86,13 +95,20 @@ public:
     void setUseShorthands(bool use) { _use_shorthands = use; }
 
     /// Retrieve the generated path data string.
-    std::string str() const { return _s.str(); }
+    std::string str() const { return _out->substr(_start); }
 
 private:
+    // not copyable, since _out can point to _s
+    SVGPathWriter(SVGPathWriter const &);
+    SVGPathWriter &operator=(SVGPathWriter const &);
+
     void _setCommand(char cmd);
-    std::string _formatCoord(Coord par);
+    char *_formatCoord(Coord par, char *buf);
 
-    std::ostringstream _s, _ns;
+    std::string _s;
+    std::string *_out; ///< Output string, either _s or one supplied by the caller
+    std::size_t _start; ///< Length of the output string before anything was written
+    std::vector<char> _number; ///< Buffer for formatting a single coordinate
     std::vector<Coord> _current_pars;
     Point _subpath_start;
     Point _current;
@@ -37,6 +37,7 @@
 #include <algorithm>
 #include <vector>
 #include <boost/intrusive/list.hpp>
+#include <boost/type_traits/integral_constant.hpp>
 #include <boost/range/algorithm/heap_algorithm.hpp>
 
 namespace Geom {
@@ -56,6 +57,8 @@ public:
 
     void addActiveItem(ItemIterator /*ii*/) {}
     void removeActiveItem(ItemIterator /*ii*/) {}
+    /// Optional; return true to stop Sweeper::processUntilDone() before all events are processed.
+    bool done() const { return false; }
 
 private:
     std::vector<Item> const &_items;
@@ -75,6 +78,8 @@ private:
  *   compute the bounding interval of the referenced item in the direction of sweep.
  * - void addActiveItem(iterator i) - add an item to the active list.
  * - void removeActiveItem(iterator i) - remove an item from the active list.
+ * - bool done() - optional; only needed by processUntilDone(), which stops
+ *   the sweep once it returns true.
  *
  * Create the object, then instantiate this template with the above class
  * as the template parameter, pass it the constructed object of the class,
@@ -108,6 +113,19 @@ public:
      * addActiveItem and removeActiveItem on the SweepSet passed at construction
      * according to the order of the boundaries of each item. */
     void process() {
+        _process(boost::false_type());
+    }
+
+    /** @brief Process events until the SweepSet is done.
+     * Same as process(), except that the sweep stops early once the done() method
+     * of the SweepSet returns true. */
+    void processUntilDone() {
+        _process(boost::true_type());
+    }
+
+private:
+    template <typename CheckDone>
+    void _process(CheckDone check_done) {
         if (_set.items().empty()) return;
 
         Iter last = _set.items().end();
@@ -125,7 +143,7 @@ public:
         Event next_entry = _get_next(_entry_events);
         Event next_exit = _get_next(_exit_events);
 
-        while (next_entry || next_exit) {
+        while ((next_entry || next_exit) && !_done(check_done)) {
             assert(next_exit);
 
             if (!next_entry || next_exit > next_entry) {
@@ -140,7 +158,10 @@ public:
         }
     }
 
-private:
+    // only the overload which is used gets instantiated, so done() is not required by process()
+    bool _done(boost::false_type) const { return false; }
+    bool _done(boost::true_type) const { return _set.done(); }
+
     struct Event
         : boost::totally_ordered<Event>
     {
@@ -0,0 +1,395 @@
+/** @file
+ * @brief Winding number computation for many points at once
+ *//*
+ * Copyright 2016 authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/winding-batch.h>
+#include <2geom/bezier-curve.h>
+#include <2geom/predicates.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace Geom {
+
+namespace {
+
+// number of points processed together; the coordinates of a block stay in L1 cache
+std::size_t const BLOCK_SIZE = 256;
+
+// evaluate a cubic polynomial given by its power basis coefficients
+inline Coord horner(Coord const *c, Coord t)
+{
+    return ((c[3] * t + c[2]) * t + c[1]) * t + c[0];
+}
+
+} // end anonymous namespace
+
+BatchWinding::BatchWinding(PathVector const &pv)
+{
+    for (PathVector::const_iterator i = pv.begin(); i != pv.end(); ++i) {
+        addPath(*i);
+    }
+}
+
+void BatchWinding::addPath(Path const &path)
+{
+    // the copy shares curve data with the original, and keeps it alive for the pieces
+    _paths.push_back(path);
+    Path const &p = _paths.back();
+    MonotoneDecomposition const &md = p.monotoneDecomposition();
+    for (std::size_t i = 0; i < p.size_closed(); ++i) {
+        _addCurve(p[i], md.begin(i), md.end(i));
+    }
+}
+
+void BatchWinding::clear()
+{
+    _pieces.clear();
+    _paths.clear();
+}
+
+void BatchWinding::_addCurve(Curve const &c, MonotoneDecomposition::const_iterator first,
+                             MonotoneDecomposition::const_iterator last)
+{
+    Piece piece;
+    // only quadratic and cubic Beziers fill in the polynomial below
+    std::fill(piece.cx, piece.cx + 4, 0.0);
+    std::fill(piece.cy, piece.cy + 4, 0.0);
+    piece.degree = 0;
+
+    // this includes generic Bezier curves of order 1, which are not LineSegments
+    if (c.isLineSegment()) {
+        Point ip = c.initialPoint(), fp = c.finalPoint();
+        // horizontal lines never contribute to the winding number
+        if (ip[Y] == fp[Y]) return;
+        piece.top = std::min(ip[Y], fp[Y]);
+        piece.bottom = std::max(ip[Y], fp[Y]);
+        piece.left = std::min(ip[X], fp[X]);
+        piece.right = std::max(ip[X], fp[X]);
+        piece.x0 = ip[X];
+        piece.y0 = ip[Y];
+        piece.dxdy = (fp[X] - ip[X]) / (fp[Y] - ip[Y]);
+        piece.x1 = fp[X];
+        piece.y1 = fp[Y];
+        // each of the operations giving the crossing has a relative error of at most
+        // half an ulp, and the terms of the sum are bounded by |x0| and right - left
+        piece.xerr = 8 * std::numeric_limits<Coord>::epsilon()
+                   * (std::fabs(ip[X]) + piece.right - piece.left);
+        piece.t0 = 0;
+        piece.t1 = 1;
+        piece.curve = NULL;
+        piece.dir = ip[Y] < fp[Y] ? 1 : -1;
+        _pieces.push_back(piece);
+        return;
+    }
+
+    BezierCurve const *bezier = dynamic_cast<BezierCurve const *>(&c);
+    // quadratic and cubic Beziers are evaluated directly rather than through valueAt()
+    if (bezier && (bezier->order() == 2 || bezier->order() == 3)) {
+        Point p0 = bezier->controlPoint(0), p1 = bezier->controlPoint(1);
+        Point p2 = bezier->controlPoint(2), p3;
+        Point coeffs[4];
+        coeffs[0] = p0;
+        if (bezier->order() == 2) {
+            coeffs[1] = 2 * (p1 - p0);
+            coeffs[2] = p0 - 2 * p1 + p2;
+            coeffs[3] = Point(0, 0);
+        } else {
+            p3 = bezier->controlPoint(3);
+            coeffs[1] = 3 * (p1 - p0);
+            coeffs[2] = 3 * (p0 - 2 * p1 + p2);
+            coeffs[3] = p3 - p0 + 3 * (p1 - p2);
+        }
+        for (unsigned i = 0; i < 4; ++i) {
+            piece.cx[i] = coeffs[i][X];
+            piece.cy[i] = coeffs[i][Y];
+        }
+        piece.degree = bezier->order();
+    }
+
+    /* Merge the pieces of the monotone decomposition which have the same direction
+     * in Y, so that the curve is split only at the extrema of its Y coordinate. Both
+     * coordinates are monotonic on the decomposed pieces, so the X range of a merged
+     * piece is spanned by their endpoints; it is widened by a small margin, because
+     * the split times are only approximate. */
+    while (first != last) {
+        Point p0 = first->p0, p1 = first->p1;
+        Interval xrange(p0[X], p1[X]);
+        piece.t0 = first->t0;
+        for (++first; first != last; ++first) {
+            if (first->p1[Y] != p1[Y] && (first->p1[Y] > p1[Y]) != (p1[Y] > p0[Y])) break;
+            xrange.expandTo(first->p1[X]);
+            p1 = first->p1;
+        }
+        piece.t1 = (first - 1)->t1;
+        if (p0[Y] == p1[Y]) continue;
+
+        xrange.expandBy(EPSILON * (1 + xrange.extent()));
+        piece.top = std::min(p0[Y], p1[Y]);
+        piece.bottom = std::max(p0[Y], p1[Y]);
+        piece.left = xrange.min();
+        piece.right = xrange.max();
+        piece.x0 = piece.y0 = piece.dxdy = 0;
+        piece.x1 = piece.y1 = piece.xerr = 0;
+        piece.curve = &c;
+        piece.dir = p0[Y] < p1[Y] ? 1 : -1;
+        _pieces.push_back(piece);
+    }
+}
+
+/* Contribution of a piece for a point within its bounding box. The piece is monotonic in Y,
+ * so it crosses the point's Y coordinate exactly once. Line segments compare the crossing
+ * with the point, and use orient2d() when the rounded comparison cannot decide.
+ * Polynomial pieces find the crossing with Newton's method, falling back to bisection
+ * when a step leaves the bracket; other curves use bisection. */
+int BatchWinding::_exactWinding(Piece const &piece, Coord x, Coord y)
+{
+    if (!piece.curve) {
+        Coord xcross = piece.x0 + (y - piece.y0) * piece.dxdy;
+        if (std::fabs(xcross - x) > piece.xerr) {
+            return xcross > x ? piece.dir : 0;
+        }
+        return _lineWinding(piece, x, y);
+    }
+
+    Coord a = piece.t0, b = piece.t1;
+    bool increasing = piece.dir > 0;
+    Coord t;
+
+    if (piece.degree != 0) {
+        Coord const *cy = piece.cy;
+        Coord ya = horner(cy, a), yb = horner(cy, b);
+        t = a + (b - a) * (y - ya) / (yb - ya);
+        if (!(t > a && t < b)) {
+            t = (a + b) / 2;
+        }
+        for (unsigned iter = 0; iter < 100; ++iter) {
+            Coord f = horner(cy, t) - y;
+            if (f == 0) break;
+            if ((f < 0) == increasing) {
+                a = t;
+            } else {
+                b = t;
+            }
+            Coord df = (3 * cy[3] * t + 2 * cy[2]) * t + cy[1];
+            Coord next = t - f / df;
+            if (!(next > a && next < b)) {
+                next = (a + b) / 2;
+            }
+            if (next == t || b - a <= EPSILON * EPSILON) break;
+            t = next;
+        }
+        return horner(piece.cx, t) > x ? piece.dir : 0;
+    }
+
+    while (true) {
+        Coord mid = (a + b) / 2;
+        if (mid <= a || mid >= b) break;
+        if ((piece.curve->valueAt(mid, Y) < y) == increasing) {
+            a = mid;
+        } else {
+            b = mid;
+        }
+    }
+    t = a;
+    return piece.curve->valueAt(t, X) > x ? piece.dir : 0;
+}
+
+// same as BezierCurveN<1>::winding()
+int BatchWinding::_lineWinding(Piece const &piece, Coord x, Coord y)
+{
+    Point ip(piece.x0, piece.y0), fp(piece.x1, piece.y1), p(x, y);
+    if (piece.dir > 0) {
+        return orient2d(ip, fp, p) > 0 ? 1 : 0;
+    }
+    return orient2d(fp, ip, p) > 0 ? -1 : 0;
+}
+
+int BatchWinding::_pieceWinding(Piece const &piece, Coord x, Coord y)
+{
+    if (y < piece.top || y >= piece.bottom || x > piece.right) return 0;
+    // the ray crosses the piece exactly once when the point is to its left
+    if (x < piece.left) return piece.dir;
+    return _exactWinding(piece, x, y);
+}
+
+int BatchWinding::winding(Point const &p) const
+{
+    int wind = 0;
+    for (std::size_t i = 0; i < _pieces.size(); ++i) {
+        wind += _pieceWinding(_pieces[i], p[X], p[Y]);
+    }
+    return wind;
+}
+
+/* Add the contributions of one piece to the winding numbers of a block of points.
+ * The vector loops evaluate the same conditions as _pieceWinding() for several points
+ * at once. Winding numbers are accumulated as doubles, so that they can stay in
+ * floating point registers; they are small integers, so this is exact. */
+void BatchWinding::_windBlock(Piece const &piece, Coord const *xs, Coord const *ys,
+                              Coord *wind, std::size_t n)
+{
+    std::size_t i = 0;
+
+#if defined(__AVX__)
+    __m256d top = _mm256_set1_pd(piece.top), bottom = _mm256_set1_pd(piece.bottom);
+    __m256d left = _mm256_set1_pd(piece.left), right = _mm256_set1_pd(piece.right);
+    __m256d x0 = _mm256_set1_pd(piece.x0), y0 = _mm256_set1_pd(piece.y0);
+    __m256d dxdy = _mm256_set1_pd(piece.dxdy), dir = _mm256_set1_pd(piece.dir);
+    __m256d xerr = _mm256_set1_pd(piece.xerr), nxerr = _mm256_set1_pd(-piece.xerr);
+
+    for (; i + 4 <= n; i += 4) {
+        __m256d x = _mm256_loadu_pd(xs + i), y = _mm256_loadu_pd(ys + i);
+        __m256d active = _mm256_and_pd(
+            _mm256_and_pd(_mm256_cmp_pd(y, top, _CMP_GE_OQ), _mm256_cmp_pd(y, bottom, _CMP_LT_OQ)),
+            _mm256_cmp_pd(x, right, _CMP_LE_OQ));
+        if (_mm256_movemask_pd(active) == 0) continue;
+
+        __m256d leftof = _mm256_cmp_pd(x, left, _CMP_LT_OQ);
+        __m256d hit = _mm256_and_pd(active, leftof);
+        __m256d inside = _mm256_andnot_pd(leftof, active);
+        if (piece.curve) {
+            int mask = _mm256_movemask_pd(inside);
+            for (int k = 0; k < 4; ++k) {
+                if (mask & (1 << k)) {
+                    wind[i + k] += _exactWinding(piece, xs[i + k], ys[i + k]);
+                }
+            }
+        } else {
+            __m256d xcross = _mm256_add_pd(x0, _mm256_mul_pd(_mm256_sub_pd(y, y0), dxdy));
+            __m256d diff = _mm256_sub_pd(xcross, x);
+            __m256d near = _mm256_and_pd(_mm256_cmp_pd(diff, xerr, _CMP_LE_OQ),
+                                         _mm256_cmp_pd(diff, nxerr, _CMP_GE_OQ));
+            hit = _mm256_or_pd(hit, _mm256_and_pd(inside, _mm256_cmp_pd(diff, xerr, _CMP_GT_OQ)));
+            int mask = _mm256_movemask_pd(_mm256_and_pd(inside, near));
+            for (int k = 0; k < 4; ++k) {
+                if (mask & (1 << k)) {
+                    wind[i + k] += _lineWinding(piece, xs[i + k], ys[i + k]);
+                }
+            }
+        }
+        __m256d w = _mm256_loadu_pd(wind + i);
+        _mm256_storeu_pd(wind + i, _mm256_add_pd(w, _mm256_and_pd(hit, dir)));
+    }
+#elif defined(__SSE2__)
+    __m128d top = _mm_set1_pd(piece.top), bottom = _mm_set1_pd(piece.bottom);
+    __m128d left = _mm_set1_pd(piece.left), right = _mm_set1_pd(piece.right);
+    __m128d x0 = _mm_set1_pd(piece.x0), y0 = _mm_set1_pd(piece.y0);
+    __m128d dxdy = _mm_set1_pd(piece.dxdy), dir = _mm_set1_pd(piece.dir);
+    __m128d xerr = _mm_set1_pd(piece.xerr), nxerr = _mm_set1_pd(-piece.xerr);
+
+    for (; i + 2 <= n; i += 2) {
+        __m128d x = _mm_loadu_pd(xs + i), y = _mm_loadu_pd(ys + i);
+        __m128d active = _mm_and_pd(_mm_and_pd(_mm_cmpge_pd(y, top), _mm_cmplt_pd(y, bottom)),
+                                    _mm_cmple_pd(x, right));
+        if (_mm_movemask_pd(active) == 0) continue;
+
+        __m128d leftof = _mm_cmplt_pd(x, left);
+        __m128d hit = _mm_and_pd(active, leftof);
+        __m128d inside = _mm_andnot_pd(leftof, active);
+        if (piece.curve) {
+            int mask = _mm_movemask_pd(inside);
+            for (int k = 0; k < 2; ++k) {
+                if (mask & (1 << k)) {
+                    wind[i + k] += _exactWinding(piece, xs[i + k], ys[i + k]);
+                }
+            }
+        } else {
+            __m128d xcross = _mm_add_pd(x0, _mm_mul_pd(_mm_sub_pd(y, y0), dxdy));
+            __m128d diff = _mm_sub_pd(xcross, x);
+            __m128d near = _mm_and_pd(_mm_cmple_pd(diff, xerr), _mm_cmpge_pd(diff, nxerr));
+            hit = _mm_or_pd(hit, _mm_and_pd(inside, _mm_cmpgt_pd(diff, xerr)));
+            int mask = _mm_movemask_pd(_mm_and_pd(inside, near));
+            for (int k = 0; k < 2; ++k) {
+                if (mask & (1 << k)) {
+                    wind[i + k] += _lineWinding(piece, xs[i + k], ys[i + k]);
+                }
+            }
+        }
+        __m128d w = _mm_loadu_pd(wind + i);
+        _mm_storeu_pd(wind + i, _mm_add_pd(w, _mm_and_pd(hit, dir)));
+    }
+#endif
+
+    // remaining points, or all of them when no vector instructions are available
+    for (; i < n; ++i) {
+        wind[i] += _pieceWinding(piece, xs[i], ys[i]);
+    }
+}
+
+void BatchWinding::winding(std::vector<Point> const &points, std::vector<int> &result) const
+{
+    result.assign(points.size(), 0);
+    if (_pieces.empty()) return;
+
+    Coord xs[BLOCK_SIZE], ys[BLOCK_SIZE], wind[BLOCK_SIZE];
+
+    for (std::size_t begin = 0; begin < points.size(); begin += BLOCK_SIZE) {
+        std::size_t n = std::min(BLOCK_SIZE, points.size() - begin);
+        Coord minx = points[begin][X], miny = points[begin][Y], maxy = miny;
+        for (std::size_t i = 0; i < n; ++i) {
+            Point const &p = points[begin + i];
+            xs[i] = p[X];
+            ys[i] = p[Y];
+            wind[i] = 0;
+            minx = std::min(minx, p[X]);
+            miny = std::min(miny, p[Y]);
+            maxy = std::max(maxy, p[Y]);
+        }
+
+        for (std::size_t j = 0; j < _pieces.size(); ++j) {
+            Piece const &piece = _pieces[j];
+            // skip pieces which cannot affect any point in this block
+            if (piece.bottom <= miny || piece.top > maxy || piece.right < minx) continue;
+            _windBlock(piece, xs, ys, wind, n);
+        }
+
+        for (std::size_t i = 0; i < n; ++i) {
+            result[begin + i] = static_cast<int>(wind[i]);
+        }
+    }
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,112 @@
+/** @file
+ * @brief Winding number computation for many points at once
+ *//*
+ * Copyright 2016 authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#ifndef LIB2GEOM_SEEN_WINDING_BATCH_H
+#define LIB2GEOM_SEEN_WINDING_BATCH_H
+
+#include <vector>
+#include <2geom/forward.h>
+#include <2geom/monotone-decomposition.h>
+#include <2geom/pathvector.h>
+
+namespace Geom {
+
+/** @brief Shape prepared for computing winding numbers of many points.
+ *
+ * The paths are split once into pieces that are monotonic in the Y direction.
+ * A horizontal ray crosses each such piece at most once, and only points within
+ * the bounding box of a curved piece need a numerical solution; all other cases,
+ * including line segments, reduce to a few comparisons. Points are processed
+ * in blocks, using SSE2 or AVX instructions when the library is compiled
+ * for a CPU that supports them.
+ *
+ * The results are the same as those of Path::winding() and PathVector::winding(),
+ * except possibly for points which lie exactly on the path.
+ *
+ * @ingroup Paths */
+class BatchWinding {
+public:
+    BatchWinding() {}
+    explicit BatchWinding(Path const &path) { addPath(path); }
+    explicit BatchWinding(PathVector const &pv);
+
+    /// Add a path to the shape. Open paths are treated as if they were closed.
+    void addPath(Path const &path);
+    void clear();
+
+    /// Number of monotonic pieces the shape was split into.
+    std::size_t size() const { return _pieces.size(); }
+
+    /// Compute the winding number of a single point.
+    int winding(Point const &p) const;
+    /** @brief Compute winding numbers of many points.
+     * @param points Points to classify
+     * @param result Vector which will be filled with the winding numbers of the points */
+    void winding(std::vector<Point> const &points, std::vector<int> &result) const;
+
+private:
+    struct Piece {
+        Coord top, bottom; ///< Range of Y coordinates, excluding the bottom one
+        Coord left, right; ///< Range of X coordinates, possibly larger than the actual one
+        Coord x0, y0, dxdy; ///< Initial point and inverse slope of line segments
+        Coord x1, y1; ///< Final point of line segments
+        Coord xerr; ///< Error bound of the X coordinate of a line crossing computed from dxdy
+        Coord t0, t1; ///< Time interval of curved pieces
+        Coord cx[4], cy[4]; ///< Power basis coefficients of Bezier curves up to cubic
+        unsigned degree; ///< Degree of the polynomial in cx and cy; 0 for other curves
+        Curve const *curve; ///< NULL for line segments
+        int dir; ///< +1 if Y increases along the piece, -1 if it decreases
+    };
+
+    void _addCurve(Curve const &c, MonotoneDecomposition::const_iterator first,
+                   MonotoneDecomposition::const_iterator last);
+    static int _exactWinding(Piece const &piece, Coord x, Coord y);
+    static int _lineWinding(Piece const &piece, Coord x, Coord y);
+    static int _pieceWinding(Piece const &piece, Coord x, Coord y);
+    static void _windBlock(Piece const &piece, Coord const *xs, Coord const *ys,
+                           Coord *wind, std::size_t n);
+
+    std::vector<Piece> _pieces;
+    PathVector _paths; ///< Copies of the added paths, which own the curves referenced by pieces
+};
+
+} // end namespace Geom
+
+#endif // LIB2GEOM_SEEN_WINDING_BATCH_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,169 @@
+/**
+ * \file
+ * \brief Memory allocations and speed of Bezier operations
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+#include <2geom/basic-intersection.h>
+#include <2geom/bezier-curve.h>
+#include <2geom/nearest-time.h>
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+#include <glib.h>
+
+using namespace Geom;
+
+// count every call to the global allocation function
+static unsigned long allocations = 0;
+
+void *operator new(std::size_t size)
+{
+    ++allocations;
+    void *p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) throw()
+{
+    std::free(p);
+}
+
+#if __cplusplus >= 201402L
+void operator delete(void *p, std::size_t) throw()
+{
+    std::free(p);
+}
+#endif
+
+static Point random_point()
+{
+    return Point(g_random_double_range(0, 100), g_random_double_range(0, 100));
+}
+
+static double ms(std::clock_t start, std::clock_t stop)
+{
+    return (stop - start) * (1000. / CLOCKS_PER_SEC);
+}
+
+class Measurement {
+public:
+    Measurement(char const *name, unsigned count)
+        : _name(name), _count(count), _allocations(allocations), _start(std::clock())
+    {}
+    ~Measurement() {
+        std::clock_t stop = std::clock();
+        std::cout << _name << ": " << ms(_start, stop) << " ms, "
+                  << double(allocations - _allocations) / _count << " allocations per call"
+                  << std::endl;
+    }
+private:
+    char const *_name;
+    unsigned _count;
+    unsigned long _allocations;
+    std::clock_t _start;
+};
+
+int main(int argc, char **argv)
+{
+    unsigned count = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+    // for reproducibility.
+    g_random_set_seed(1234);
+    std::vector<CubicBezier> curves;
+    std::vector<Point> points;
+    for (unsigned i = 0; i < count; ++i) {
+        curves.push_back(CubicBezier(random_point(), random_point(), random_point(), random_point()));
+        points.push_back(random_point());
+    }
+
+    Coord sink = 0;
+    {
+        Measurement m("portion(D2<Bezier>)", count);
+        for (unsigned i = 0; i < count; ++i) {
+            D2<Bezier> p = portion(curves[i].fragment(), 0.25, 0.75);
+            sink += p[X][1];
+        }
+    }
+    {
+        Measurement m("derivative(D2<Bezier>)", count);
+        for (unsigned i = 0; i < count; ++i) {
+            D2<Bezier> d = derivative(curves[i].fragment());
+            sink += d[Y][0];
+        }
+    }
+    {
+        Measurement m("Bezier::subdivide", count);
+        for (unsigned i = 0; i < count; ++i) {
+            std::pair<Bezier, Bezier> halves = curves[i].fragment()[X].subdivide(0.5);
+            sink += halves.first[2] + halves.second[1];
+        }
+    }
+    {
+        Measurement m("nearest_time(Point, D2<Bezier>)", count);
+        for (unsigned i = 0; i < count; ++i) {
+            sink += nearest_time(points[i], curves[i].fragment());
+        }
+    }
+    {
+        Measurement m("CubicBezier::intersect", count);
+        for (unsigned i = 0; i + 1 < count; ++i) {
+            sink += curves[i].intersect(curves[i+1]).size();
+        }
+    }
+    {
+        std::vector<std::vector<Point> > cps;
+        for (unsigned i = 0; i < count; ++i) {
+            cps.push_back(curves[i].controlPoints());
+        }
+        std::vector<std::pair<Coord, Coord> > xs;
+        Measurement m("find_intersections_bezier_clipping", count);
+        for (unsigned i = 0; i + 1 < count; ++i) {
+            xs.clear();
+            find_intersections_bezier_clipping(xs, cps[i], cps[i+1]);
+            sink += xs.size();
+        }
+    }
+
+    // prevent the compiler from optimizing out the computations
+    if (sink == 42) {
+        std::cout << std::endl;
+    }
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,184 @@
+/**
+ * \file
+ * \brief Performance test for the fixed-degree specializations of BezierCurveN
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/bezier-curve.h>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <ctime>
+#include <glib.h>
+
+using namespace Geom;
+
+static Point random_point()
+{
+    return Point(g_random_double_range(0, 100), g_random_double_range(0, 100));
+}
+
+static double ns_per_call(std::clock_t start, std::clock_t stop, unsigned count)
+{
+    return (stop - start) * (1e9 / CLOCKS_PER_SEC) / count;
+}
+
+// Compares the specialized methods with the generic ones of BezierCurve, which are
+// called through a qualified name to bypass virtual dispatch.
+template <typename CurveType>
+class Benchmark {
+public:
+    Benchmark(std::vector<CurveType> const &curves, std::vector<Point> const &points)
+        : _curves(curves), _points(points), _sink(0)
+    {}
+
+    void run(char const *name) {
+        std::cout << name << std::endl;
+        std::clock_t s0, s1, g0, g1;
+        unsigned n = _curves.size();
+
+        s0 = std::clock();
+        for (unsigned i = 0; i < n; ++i) _sink += _curves[i].pointAt(0.3)[X];
+        s1 = std::clock();
+        g0 = std::clock();
+        for (unsigned i = 0; i < n; ++i) _sink += _curves[i].BezierCurve::pointAt(0.3)[X];
+        g1 = std::clock();
+        _report("pointAt", ns_per_call(g0, g1, n), ns_per_call(s0, s1, n));
+
+        s0 = std::clock();
+        for (unsigned i = 0; i < n; ++i) _sink += _curves[i].pointAndDerivatives(0.3, 2)[1][Y];
+        s1 = std::clock();
+        g0 = std::clock();
+        for (unsigned i = 0; i < n; ++i) {
+            _sink += _curves[i].BezierCurve::pointAndDerivatives(0.3, 2)[1][Y];
+        }
+        g1 = std::clock();
+        _report("pointAndDerivatives", ns_per_call(g0, g1, n), ns_per_call(s0, s1, n));
+
+        s0 = std::clock();
+        for (unsigned i = 0; i < n; ++i) _sink += _curves[i].boundsExact().width();
+        s1 = std::clock();
+        g0 = std::clock();
+        for (unsigned i = 0; i < n; ++i) _sink += _curves[i].BezierCurve::boundsExact().width();
+        g1 = std::clock();
+        _report("boundsExact", ns_per_call(g0, g1, n), ns_per_call(s0, s1, n));
+
+        s0 = std::clock();
+        for (unsigned i = 0; i < n; ++i) _sink += _curves[i].roots(50, X).size();
+        s1 = std::clock();
+        g0 = std::clock();
+        for (unsigned i = 0; i < n; ++i) _sink += _curves[i].BezierCurve::roots(50, X).size();
+        g1 = std::clock();
+        _report("roots", ns_per_call(g0, g1, n), ns_per_call(s0, s1, n));
+
+        s0 = std::clock();
+        for (unsigned i = 0; i < n; ++i) _sink += _curves[i].nearestTime(_points[i]);
+        s1 = std::clock();
+        g0 = std::clock();
+        for (unsigned i = 0; i < n; ++i) _sink += _curves[i].BezierCurve::nearestTime(_points[i]);
+        g1 = std::clock();
+        _report("nearestTime", ns_per_call(g0, g1, n), ns_per_call(s0, s1, n));
+
+        s0 = std::clock();
+        for (unsigned i = 0; i < n; ++i) {
+            Curve *c = _curves[i].portion(0.25, 0.75);
+            _sink += c->initialPoint()[X];
+            delete c;
+        }
+        s1 = std::clock();
+        g0 = std::clock();
+        for (unsigned i = 0; i < n; ++i) {
+            Curve *c = _curves[i].BezierCurve::portion(0.25, 0.75);
+            _sink += c->initialPoint()[X];
+            delete c;
+        }
+        g1 = std::clock();
+        _report("portion", ns_per_call(g0, g1, n), ns_per_call(s0, s1, n));
+    }
+
+    Coord sink() const { return _sink; }
+
+private:
+    void _report(char const *op, double generic, double specialized) {
+        std::cout << "  " << std::setw(20) << std::left << op << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(10) << generic << " ns"
+                  << std::setw(10) << specialized << " ns"
+                  << std::setw(8) << generic / specialized << "x" << std::endl;
+    }
+
+    std::vector<CurveType> const &_curves;
+    std::vector<Point> const &_points;
+    Coord _sink;
+};
+
+int main(int argc, char **argv)
+{
+    unsigned count = argc > 1 ? std::atoi(argv[1]) : 100000;
+
+    // for reproducibility.
+    g_random_set_seed(1234);
+    std::vector<LineSegment> lines;
+    std::vector<QuadraticBezier> quads;
+    std::vector<CubicBezier> cubics;
+    std::vector<Point> points;
+    for (unsigned i = 0; i < count; ++i) {
+        lines.push_back(LineSegment(random_point(), random_point()));
+        quads.push_back(QuadraticBezier(random_point(), random_point(), random_point()));
+        cubics.push_back(CubicBezier(random_point(), random_point(), random_point(), random_point()));
+        points.push_back(random_point());
+    }
+
+    std::cout << count << " curves of each degree; time per call: generic, specialized, speedup"
+              << std::endl;
+    Coord sink = 0;
+    Benchmark<LineSegment> bl(lines, points);
+    bl.run("LineSegment");
+    sink += bl.sink();
+    Benchmark<QuadraticBezier> bq(quads, points);
+    bq.run("QuadraticBezier");
+    sink += bq.sink();
+    Benchmark<CubicBezier> bc(cubics, points);
+    bc.run("CubicBezier");
+    sink += bc.sink();
+
+    // prevent the compiler from optimizing out the computations
+    if (sink == 42) {
+        std::cout << std::endl;
+    }
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
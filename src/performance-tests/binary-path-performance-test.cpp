@@ -0,0 +1,196 @@
+/**
+ * \file
+ * \brief Performance test comparing the binary path format with SVG path data
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/binary-path.h>
+#include <2geom/packed-pathvector.h>
+#include <2geom/path.h>
+#include <2geom/pathvector.h>
+#include <2geom/svg-path-parser.h>
+#include <2geom/svg-path-writer.h>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <glib.h>
+
+using namespace Geom;
+
+static Coord random_coord(Coord size)
+{
+    // drawing programs usually round coordinates to a few decimal places
+    return std::floor(g_random_double_range(0, size) * 1000 + 0.5) / 1000;
+}
+
+static Point random_point(Coord size)
+{
+    return Point(random_coord(size), random_coord(size));
+}
+
+static PathVector random_paths(unsigned npaths, unsigned nsegs)
+{
+    Coord const size = 1000;
+    PathVector pv;
+    for (unsigned i = 0; i < npaths; ++i) {
+        Path path(random_point(size));
+        for (unsigned j = 0; j < nsegs; ++j) {
+            switch (g_random_int_range(0, 3)) {
+            case 0:
+                path.appendNew<LineSegment>(random_point(size));
+                break;
+            case 1:
+                path.appendNew<QuadraticBezier>(random_point(size), random_point(size));
+                break;
+            default:
+                path.appendNew<CubicBezier>(random_point(size), random_point(size),
+                                            random_point(size));
+                break;
+            }
+        }
+        path.close();
+        pv.push_back(path);
+    }
+    return pv;
+}
+
+static double ms(std::clock_t start, std::clock_t stop)
+{
+    return (stop - start) * (1000. / CLOCKS_PER_SEC);
+}
+
+// Sink which only counts the commands, to measure decoding without building paths.
+class CountingSink : public PathSink {
+public:
+    CountingSink() : count(0) {}
+    void moveTo(Point const &) { ++count; }
+    void lineTo(Point const &) { ++count; }
+    void curveTo(Point const &, Point const &, Point const &) { ++count; }
+    void quadTo(Point const &, Point const &) { ++count; }
+    void arcTo(Coord, Coord, Coord, bool, bool, Point const &) { ++count; }
+    void closePath() { ++count; }
+    void flush() {}
+    std::size_t count;
+};
+
+static void report(char const *name, std::size_t size, double write_ms, double read_ms,
+                   double packed_ms, double count_ms, unsigned reps)
+{
+    std::cout << name << ": " << size / 1024 << " KiB, write " << write_ms / reps
+              << " ms, read " << read_ms / reps << " ms, read packed "
+              << packed_ms / reps << " ms, decode only " << count_ms / reps << " ms" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned reps = argc > 1 ? std::atoi(argv[1]) : 5;
+
+    // for reproducibility.
+    g_random_set_seed(1234);
+    PathVector pv = random_paths(1000, 100);
+
+    // SVG path data
+    std::string svg;
+    std::clock_t start = std::clock();
+    for (unsigned i = 0; i < reps; ++i) {
+        svg = write_svg_path(pv);
+    }
+    double write_ms = ms(start, std::clock());
+
+    start = std::clock();
+    for (unsigned i = 0; i < reps; ++i) {
+        PathVector result = parse_svg_path(svg.c_str());
+    }
+    double read_ms = ms(start, std::clock());
+
+    start = std::clock();
+    for (unsigned i = 0; i < reps; ++i) {
+        PackedPathBuilder builder;
+        parse_svg_path(svg.c_str(), builder);
+    }
+    double packed_ms = ms(start, std::clock());
+
+    start = std::clock();
+    for (unsigned i = 0; i < reps; ++i) {
+        CountingSink sink;
+        parse_svg_path(svg.c_str(), sink);
+    }
+    double count_ms = ms(start, std::clock());
+    report("SVG path data", svg.size(), write_ms, read_ms, packed_ms, count_ms, reps);
+
+    char const *names[3] = { "Binary, float64", "Binary, float32", "Binary, quantized to 0.001" };
+    BinaryPathEncoding encodings[3] = {
+        BINARY_PATH_FLOAT64, BINARY_PATH_FLOAT32, BINARY_PATH_QUANTIZED
+    };
+    for (unsigned e = 0; e < 3; ++e) {
+        std::string data;
+        start = std::clock();
+        for (unsigned i = 0; i < reps; ++i) {
+            data = write_binary_path(pv, encodings[e], 0.001);
+        }
+        write_ms = ms(start, std::clock());
+
+        start = std::clock();
+        for (unsigned i = 0; i < reps; ++i) {
+            PathVector result = read_binary_path(data);
+        }
+        read_ms = ms(start, std::clock());
+
+        start = std::clock();
+        for (unsigned i = 0; i < reps; ++i) {
+            PackedPathVector packed;
+            read_binary_path(data.data(), data.size(), packed);
+        }
+        packed_ms = ms(start, std::clock());
+
+        start = std::clock();
+        for (unsigned i = 0; i < reps; ++i) {
+            CountingSink sink;
+            read_binary_path(data.data(), data.size(), sink);
+        }
+        count_ms = ms(start, std::clock());
+        report(names[e], data.size(), write_ms, read_ms, packed_ms, count_ms, reps);
+
+        if (encodings[e] == BINARY_PATH_FLOAT64 && read_binary_path(data) != pv) {
+            std::cout << "Decoded paths do not match the input!" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,189 @@
+/**
+ * \file
+ * \brief Memory allocations and speed of Boolean operations
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/arena.h>
+#include <2geom/intersection-graph.h>
+#include <2geom/path-flattener.h>
+#include <2geom/polygon-intersection-graph.h>
+#include <2geom/svg-path-parser.h>
+#include <iostream>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include <glib.h>
+
+using namespace Geom;
+
+// count every call to the global allocation function
+static unsigned long allocations = 0;
+
+void *operator new(std::size_t size)
+{
+    ++allocations;
+    void *p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) throw()
+{
+    std::free(p);
+}
+
+#if __cplusplus >= 201402L
+void operator delete(void *p, std::size_t) throw()
+{
+    std::free(p);
+}
+#endif
+
+class Measurement {
+public:
+    Measurement(char const *name, unsigned count)
+        : _name(name), _count(count), _allocations(allocations), _start(g_get_monotonic_time())
+    {}
+    ~Measurement() {
+        gint64 stop = g_get_monotonic_time();
+        std::cout << _name << ": " << (stop - _start) / 1000. << " ms, "
+                  << double(allocations - _allocations) / _count << " allocations per operation"
+                  << std::endl;
+    }
+private:
+    char const *_name;
+    unsigned _count;
+    unsigned long _allocations;
+    gint64 _start;
+};
+
+// polygonal approximation of the paths, for PolygonIntersectionGraph
+static PathVector flatten(PathVector const &pv)
+{
+    PathFlattener flattener(0.1);
+    PathVector result;
+    for (std::size_t i = 0; i < pv.size(); ++i) {
+        std::vector<Point> pts;
+        flattener.flatten(pv[i], pts);
+        Path p(pts.front());
+        for (std::size_t j = 1; j < pts.size(); ++j) {
+            p.appendNew<LineSegment>(pts[j]);
+        }
+        p.close(pv[i].closed());
+        result.push_back(p);
+    }
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 4) {
+        std::cout << "Usage: " << argv[0] << " ops a.svgd b.svgd" << std::endl;
+        std::exit(1);
+    }
+
+    PathVector a = read_svgd(argv[2]);
+    PathVector b = read_svgd(argv[3]);
+    unsigned const ops = atoi(argv[1]);
+
+    OptRect abox = a.boundsExact();
+    OptRect bbox = b.boundsExact();
+    if (!abox || !bbox) {
+        std::cout << "The input contains an empty path" << std::endl;
+        std::exit(1);
+    }
+    a *= Translate(-abox->corner(0));
+    b *= Translate(-bbox->corner(0));
+
+    // the same random placements of the second operand are used for all measurements
+    g_random_set_seed(1234);
+    std::vector<PathVector> bs;
+    for (unsigned i = 0; i < ops; ++i) {
+        Point delta;
+        delta[X] = g_random_double_range(-bbox->width(), abox->width());
+        delta[Y] = g_random_double_range(-bbox->height(), abox->height());
+        bs.push_back(b * Translate(delta));
+    }
+
+    PathVector pa = flatten(a);
+    std::vector<PathVector> pbs;
+    for (unsigned i = 0; i < ops; ++i) {
+        pbs.push_back(flatten(bs[i]));
+    }
+
+    std::size_t sink = 0;
+    {
+        Measurement m("PathIntersectionGraph", ops);
+        for (unsigned i = 0; i < ops; ++i) {
+            PathIntersectionGraph pig(a, bs[i]);
+            sink += pig.getIntersection().size();
+        }
+    }
+    {
+        MonotonicArena arena;
+        Measurement m("PathIntersectionGraph, reused arena", ops);
+        for (unsigned i = 0; i < ops; ++i) {
+            arena.reset();
+            PathIntersectionGraph pig(a, bs[i], EPSILON, &arena);
+            sink += pig.getIntersection().size();
+        }
+    }
+    {
+        Measurement m("PolygonIntersectionGraph", ops);
+        for (unsigned i = 0; i < ops; ++i) {
+            PolygonIntersectionGraph pig(pa, pbs[i]);
+            sink += pig.getIntersection().size();
+        }
+    }
+    {
+        MonotonicArena arena;
+        Measurement m("PolygonIntersectionGraph, reused arena", ops);
+        for (unsigned i = 0; i < ops; ++i) {
+            arena.reset();
+            PolygonIntersectionGraph pig(pa, pbs[i], &arena);
+            sink += pig.getIntersection().size();
+        }
+    }
+
+    // prevent the compiler from optimizing out the computations
+    if (sink == 42) {
+        std::cout << std::endl;
+    }
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
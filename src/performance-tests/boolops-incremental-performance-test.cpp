@@ -0,0 +1,102 @@
+/**
+ * \file
+ * \brief Performance test for incremental updates of boolean operations
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/intersection-graph.h>
+#include <2geom/pathvector.h>
+#include <2geom/svg-path-parser.h>
+#include <cstdlib>
+#include <iostream>
+#include <glib.h>
+
+using namespace Geom;
+
+/* Simulate an editor which recomputes the union of two large operands while the user
+ * drags one of the paths: each step moves the path a little and computes the union,
+ * either with a new graph or by updating the previous one. */
+int main(int argc, char **argv)
+{
+    unsigned grid = argc > 1 ? std::atoi(argv[1]) : 60;
+    unsigned steps = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    Path blob = parse_svg_path("M 2,-3 L 3,-2 1,2 3,4 4,2 6,3 2,11 0,10 2,5 1,4 -1,6 -2,5 Z")[0];
+    Path rect = parse_svg_path("M 0,0 L 5,0 5,8 0,8 Z")[0];
+    PathVector a, b;
+    for (unsigned i = 0; i < grid; ++i) {
+        for (unsigned j = 0; j < grid; ++j) {
+            a.push_back(blob * Translate(12 * i, 16 * j));
+            b.push_back(rect * Rotate(0.1 * (j % 10) + 0.05) * Translate(12 * i + 0.37, 16 * j + 0.61));
+        }
+    }
+    std::size_t const dragged = a.size() / 2;
+    Path const start = a[dragged];
+    std::cout << a.size() << " + " << b.size() << " paths, " << steps << " steps" << std::endl;
+
+    gint64 t0 = g_get_monotonic_time();
+    PathVector full_result;
+    for (unsigned k = 1; k <= steps; ++k) {
+        a[dragged] = start * Translate(0.7 * k, 0.3 * k);
+        PathIntersectionGraph pig(a, b);
+        full_result = pig.getUnion();
+    }
+    gint64 t1 = g_get_monotonic_time();
+
+    a[dragged] = start;
+    PathIntersectionGraph pig(a, b);
+    gint64 t2 = g_get_monotonic_time();
+    PathVector result;
+    for (unsigned k = 1; k <= steps; ++k) {
+        pig.replacePath(0, dragged, start * Translate(0.7 * k, 0.3 * k));
+        result = pig.getUnion();
+    }
+    gint64 t3 = g_get_monotonic_time();
+
+    double full_ms = (t1 - t0) / 1000. / steps;
+    double incr_ms = (t3 - t2) / 1000. / steps;
+    std::cout << "New graph for each step: " << full_ms << " ms per step\n"
+              << "Incremental update:      " << incr_ms << " ms per step, speedup "
+              << full_ms / incr_ms << std::endl;
+
+    if (result != full_result) {
+        std::cout << "Results differ!" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -32,24 +32,62 @@
  */
 
 #include <2geom/intersection-graph.h>
+#include <2geom/parallel.h>
 #include <2geom/svg-path-parser.h>
+#include <algorithm>
 #include <iostream>
 #include <glib.h>
 
 using namespace Geom;
 
+struct BoolopsResult {
+    long num_intersections;
+    long num_outcv;
+    double seconds;
+};
+
+static BoolopsResult run_boolops(PathVector const &a, PathVector const &b,
+                                 Rect const &abox, Rect const &bbox, unsigned ops)
+{
+    BoolopsResult r;
+    r.num_intersections = 0;
+    r.num_outcv = 0;
+
+    // for reproducibility.
+    g_random_set_seed(1234);
+
+    // use wall clock time, since CPU time adds up over all threads
+    gint64 start = g_get_monotonic_time();
+    for (unsigned i = 0; i < ops; ++i) {
+        Point delta;
+        delta[X] = g_random_double_range(-bbox.width(), abox.width());
+        delta[Y] = g_random_double_range(-bbox.height(), abox.height());
+
+        PathVector bt = b * Translate(delta);
+
+        PathIntersectionGraph pig(a, bt);
+        PathVector x = pig.getIntersection();
+        r.num_intersections += pig.intersectionPoints().size();
+        r.num_outcv += x.curveCount();
+    }
+    r.seconds = (g_get_monotonic_time() - start) / 1e6;
+    return r;
+}
+
 int main(int argc, char **argv)
 {
-    if (argc != 4) {
-        std::cout << "Wrong number of arguments";
+    if (argc != 4 && argc != 5) {
+        std::cout << "Usage: " << argv[0] << " ops a.svgd b.svgd [max_threads]" << std::endl;
+        std::exit(1);
     }
 
     PathVector a = read_svgd(argv[2]);
     PathVector b = read_svgd(argv[3]);
     unsigned const ops = atoi(argv[1]);
+    unsigned const max_threads = argc == 5 ? atoi(argv[4]) : 1;
 
     OptRect abox = a.boundsExact();
-    OptRect bbox = a.boundsExact();
+    OptRect bbox = b.boundsExact();
     if (!abox) {
         std::cout << argv[1] << " contains an empty path" << std::endl;
         std::exit(1);
@@ -62,29 +100,30 @@ int main(int argc, char **argv)
     a *= Translate(-abox->corner(0));
     b *= Translate(-bbox->corner(0));
 
-    long num_intersections = 0;
-    long num_outcv = 0;
-
-    // for reproducibility.
-    g_random_set_seed(1234);
-
-    for (unsigned i = 0; i < ops; ++i) {
-        Point delta;
-        delta[X] = g_random_double_range(-bbox->width(), abox->width());
-        delta[Y] = g_random_double_range(-bbox->height(), abox->height());
-
-        PathVector bt = b * Translate(delta);
-
-        PathIntersectionGraph pig(a, bt);
-        PathVector x = pig.getIntersection();
-        num_intersections += pig.intersectionPoints().size();
-        num_outcv += x.curveCount();
+    // run with 1, 2, 4, ... threads; the output must not depend on the thread count
+    BoolopsResult serial = BoolopsResult();
+    for (unsigned threads = 1; threads <= std::max(max_threads, 1u); threads *= 2) {
+        set_thread_count(threads);
+        if (thread_count() != threads) {
+            std::cout << "Worker threads are not available in this build" << std::endl;
+            break;
+        }
+        BoolopsResult r = run_boolops(a, b, *abox, *bbox, ops);
+        if (threads == 1) {
+            serial = r;
+            std::cout << "Completed " << ops << " operations.\n"
+                      << "Total intersections: " << r.num_intersections << "\n"
+                      << "Total output curves: " << r.num_outcv << std::endl;
+        } else if (r.num_intersections != serial.num_intersections
+                   || r.num_outcv != serial.num_outcv)
+        {
+            std::cout << "Results with " << threads << " threads differ!" << std::endl;
+            return 1;
+        }
+        std::cout << threads << " thread(s): " << r.seconds * 1000 << " ms, speedup "
+                  << serial.seconds / r.seconds << std::endl;
     }
 
-    std::cout << "Completed " << ops << " operations.\n"
-              << "Total intersections: " << num_intersections << "\n"
-              << "Total output curves: " << num_outcv << std::endl;
-
     return 0;
 }
 
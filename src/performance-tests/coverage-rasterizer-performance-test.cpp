@@ -0,0 +1,158 @@
+/**
+ * \file
+ * \brief Performance test for CoverageRasterizer
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+#include <2geom/coverage-rasterizer.h>
+#include <2geom/path.h>
+#ifdef HAVE_CAIRO
+#include <cairo.h>
+#include <2geom/cairo-path-sink.h>
+#endif
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <glib.h>
+
+using namespace Geom;
+
+static Point random_point(Coord size)
+{
+    return Point(g_random_double_range(0, size), g_random_double_range(0, size));
+}
+
+// Generate small closed paths made of random lines, quadratics and cubics.
+static PathVector random_shapes(unsigned count, Coord size, Coord shape_size)
+{
+    PathVector pv;
+    for (unsigned i = 0; i < count; ++i) {
+        Point corner = random_point(size - shape_size);
+        Path path(corner + random_point(shape_size));
+        for (unsigned j = 0; j < 6; ++j) {
+            switch (g_random_int_range(0, 3)) {
+            case 0:
+                path.appendNew<LineSegment>(corner + random_point(shape_size));
+                break;
+            case 1:
+                path.appendNew<QuadraticBezier>(corner + random_point(shape_size),
+                                                corner + random_point(shape_size));
+                break;
+            default:
+                path.appendNew<CubicBezier>(corner + random_point(shape_size),
+                                            corner + random_point(shape_size),
+                                            corner + random_point(shape_size));
+                break;
+            }
+        }
+        path.close();
+        pv.push_back(path);
+    }
+    return pv;
+}
+
+static double ms(std::clock_t start, std::clock_t stop)
+{
+    return (stop - start) * (1000. / CLOCKS_PER_SEC);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned count = argc > 1 ? std::atoi(argv[1]) : 1000;
+    int side = argc > 2 ? std::atoi(argv[2]) : 1024;
+    unsigned repeats = 10;
+
+    // for reproducibility.
+    g_random_set_seed(1234);
+    PathVector shapes = random_shapes(count, side, side / 8.);
+    IntRect area(0, 0, side, side);
+    std::cout << count << " shapes, " << side << "x" << side << " pixels" << std::endl;
+
+    std::vector<unsigned char> mask(side * side);
+    CoverageRasterizer rasterizer(area);
+    std::clock_t start = std::clock();
+    for (unsigned i = 0; i < repeats; ++i) {
+        rasterizer.reset();
+        rasterizer.feed(shapes);
+        rasterizer.render(&mask[0], side);
+    }
+    std::clock_t stop = std::clock();
+    std::cout << "CoverageRasterizer: " << ms(start, stop) / repeats << " ms" << std::endl;
+
+    std::vector<float> fmask(side * side);
+    start = std::clock();
+    for (unsigned i = 0; i < repeats; ++i) {
+        rasterizer.render(&fmask[0], side, FILL_EVENODD);
+    }
+    stop = std::clock();
+    std::cout << "CoverageRasterizer::render(float *), even-odd: "
+              << ms(start, stop) / repeats << " ms" << std::endl;
+
+#ifdef HAVE_CAIRO
+    cairo_surface_t *surface = cairo_image_surface_create(CAIRO_FORMAT_A8, side, side);
+    cairo_t *cr = cairo_create(surface);
+    start = std::clock();
+    for (unsigned i = 0; i < repeats; ++i) {
+        cairo_set_operator(cr, CAIRO_OPERATOR_CLEAR);
+        cairo_paint(cr);
+        cairo_set_operator(cr, CAIRO_OPERATOR_OVER);
+        CairoPathSink sink(cr);
+        sink.feed(shapes);
+        cairo_set_fill_rule(cr, CAIRO_FILL_RULE_WINDING);
+        cairo_fill(cr);
+    }
+    cairo_surface_flush(surface);
+    stop = std::clock();
+    std::cout << "Cairo: " << ms(start, stop) / repeats << " ms" << std::endl;
+
+    // mean absolute difference of the coverage values
+    unsigned char const *data = cairo_image_surface_get_data(surface);
+    int cairo_stride = cairo_image_surface_get_stride(surface);
+    double difference = 0;
+    for (int y = 0; y < side; ++y) {
+        for (int x = 0; x < side; ++x) {
+            difference += std::abs(int(data[y * cairo_stride + x]) - int(mask[y * side + x]));
+        }
+    }
+    std::cout << "Mean difference from Cairo: " << difference / (side * side) << std::endl;
+    cairo_destroy(cr);
+    cairo_surface_destroy(surface);
+#endif
+
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
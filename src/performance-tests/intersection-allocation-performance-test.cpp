@@ -0,0 +1,170 @@
+/**
+ * \file
+ * \brief Memory allocations and speed of path intersection
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/pathvector.h>
+#include <2geom/path.h>
+#include <iostream>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include <glib.h>
+
+using namespace Geom;
+
+// count every call to the global allocation function
+static unsigned long allocations = 0;
+
+void *operator new(std::size_t size)
+{
+    ++allocations;
+    void *p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) throw()
+{
+    std::free(p);
+}
+
+#if __cplusplus >= 201402L
+void operator delete(void *p, std::size_t) throw()
+{
+    std::free(p);
+}
+#endif
+
+class Measurement {
+public:
+    Measurement(char const *name, unsigned count)
+        : _name(name), _count(count), _allocations(allocations), _start(g_get_monotonic_time())
+    {}
+    ~Measurement() {
+        gint64 stop = g_get_monotonic_time();
+        std::cout << _name << ": " << (stop - _start) / 1000. << " ms, "
+                  << double(allocations - _allocations) / _count << " allocations per query"
+                  << std::endl;
+    }
+private:
+    char const *_name;
+    unsigned _count;
+    unsigned long _allocations;
+    gint64 _start;
+};
+
+static Point random_point(Point const &center, Coord r)
+{
+    return center + Point(g_random_double_range(-r, r), g_random_double_range(-r, r));
+}
+
+// a small closed path made of line segments and cubic Beziers
+static Path random_path(Coord size)
+{
+    Point center(g_random_double_range(0, size), g_random_double_range(0, size));
+    Path path(random_point(center, 5));
+    for (unsigned i = 0; i < 8; ++i) {
+        if (i % 2) {
+            path.appendNew<LineSegment>(random_point(center, 5));
+        } else {
+            path.appendNew<CubicBezier>(random_point(center, 5), random_point(center, 5),
+                                        random_point(center, 5));
+        }
+    }
+    path.close();
+    return path;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned const npaths = argc > 1 ? std::atoi(argv[1]) : 500;
+    unsigned const reps = 10;
+
+    // for reproducibility.
+    g_random_set_seed(1234);
+    // the density of paths does not depend on their number
+    Coord size = 10 * std::sqrt(double(npaths));
+    PathVector a, b;
+    for (unsigned i = 0; i < npaths; ++i) {
+        a.push_back(random_path(size));
+        b.push_back(random_path(size));
+    }
+
+    std::size_t sink = 0;
+    {
+        Measurement m("PathVector::intersect", reps);
+        for (unsigned i = 0; i < reps; ++i) {
+            std::vector<PVIntersection> xs = a.intersect(b);
+            sink += xs.size();
+        }
+    }
+    {
+        std::vector<PVIntersection> xs;
+        Measurement m("PathVector::intersect, reused vector", reps);
+        for (unsigned i = 0; i < reps; ++i) {
+            xs.clear();
+            a.intersect(b, xs);
+            sink += xs.size();
+        }
+    }
+
+    // intersect each path with the next one, most of which overlap
+    for (unsigned i = 0; i < npaths; ++i) {
+        b[i] = a[i] * Translate(2, 1);
+    }
+    {
+        Measurement m("Path::intersect", npaths);
+        for (unsigned i = 0; i < npaths; ++i) {
+            std::vector<PathIntersection> xs = a[i].intersect(b[i]);
+            sink += xs.size();
+        }
+    }
+    {
+        std::vector<PathIntersection> xs;
+        Measurement m("Path::intersect, reused vector", npaths);
+        for (unsigned i = 0; i < npaths; ++i) {
+            xs.clear();
+            a[i].intersect(b[i], xs);
+            sink += xs.size();
+        }
+    }
+    std::cout << "Total intersections: " << sink << std::endl;
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,158 @@
+/**
+ * \file
+ * \brief Speed of intersection queries which stop early
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/pathvector.h>
+#include <2geom/path.h>
+#include <2geom/transforms.h>
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <glib.h>
+
+using namespace Geom;
+
+class Timer {
+public:
+    Timer(char const *name) : _name(name), _start(g_get_monotonic_time()) {}
+    ~Timer() {
+        gint64 stop = g_get_monotonic_time();
+        std::cout << _name << ": " << (stop - _start) / 1000. << " ms" << std::endl;
+    }
+private:
+    char const *_name;
+    gint64 _start;
+};
+
+// a closed wavy ring made of cubic Beziers, similar to an outline of a glyph or a shape
+static Path wavy_ring(Point const &center, Coord radius, unsigned segments)
+{
+    Path path;
+    for (unsigned i = 0; i <= segments; ++i) {
+        Coord angle = 2 * M_PI * i / segments;
+        Coord r = radius * (1 + 0.1 * g_random_double_range(-1, 1));
+        Point p = center + r * Point::polar(angle);
+        if (i == 0) {
+            path.start(p);
+            continue;
+        }
+        Point t = Point::polar(angle).cw() * radius * 0.3;
+        if (i == segments) {
+            p = path.initialPoint();
+        }
+        path.appendNew<CubicBezier>(path.finalPoint() + t, p - t, p);
+    }
+    path.close();
+    return path;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned const npairs = argc > 1 ? std::atoi(argv[1]) : 500;
+    unsigned const segments = 64;
+
+    // for reproducibility.
+    g_random_set_seed(1234);
+
+    // overlapping rings cross many times; a ring inside a larger one
+    // has overlapping bounding boxes but no intersections
+    std::vector<Path> a, crossing, nested;
+    for (unsigned i = 0; i < npairs; ++i) {
+        Point center(g_random_double_range(0, 1000), g_random_double_range(0, 1000));
+        a.push_back(wavy_ring(center, 50, segments));
+        crossing.push_back(wavy_ring(center + Point(30, 10), 50, segments));
+        nested.push_back(wavy_ring(center, 30, segments));
+    }
+
+    std::vector<Path> const *others[2] = { &crossing, &nested };
+    char const *names[2] = { "crossing", "nested" };
+    std::size_t sink = 0;
+    for (unsigned k = 0; k < 2; ++k) {
+        std::vector<Path> const &b = *others[k];
+        std::cout << npairs << " " << names[k] << " pairs:" << std::endl;
+        {
+            Timer t("  !Path::intersect().empty()");
+            for (unsigned i = 0; i < npairs; ++i) {
+                sink += !a[i].intersect(b[i]).empty();
+            }
+        }
+        {
+            Timer t("  Path::intersects()");
+            for (unsigned i = 0; i < npairs; ++i) {
+                sink += a[i].intersects(b[i]);
+            }
+        }
+        {
+            Timer t("  Path::intersect().front()");
+            for (unsigned i = 0; i < npairs; ++i) {
+                std::vector<PathIntersection> xs = a[i].intersect(b[i]);
+                if (!xs.empty()) sink += xs.front().first.curve_index;
+            }
+        }
+        {
+            Timer t("  Path::firstIntersection()");
+            for (unsigned i = 0; i < npairs; ++i) {
+                boost::optional<PathIntersection> x = a[i].firstIntersection(b[i]);
+                if (x) sink += x->first.curve_index;
+            }
+        }
+    }
+
+    PathVector pva, pvb;
+    for (unsigned i = 0; i < npairs; ++i) {
+        pva.push_back(a[i]);
+        pvb.push_back(crossing[i]);
+    }
+    std::cout << "PathVector with " << npairs << " paths:" << std::endl;
+    {
+        Timer t("  !PathVector::intersect().empty()");
+        sink += !pva.intersect(pvb).empty();
+    }
+    {
+        Timer t("  PathVector::intersects()");
+        sink += pva.intersects(pvb);
+    }
+    {
+        Timer t("  PathVector::firstIntersection()");
+        sink += bool(pva.firstIntersection(pvb));
+    }
+    std::cout << "Checksum: " << sink << std::endl;
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,156 @@
+/**
+ * \file
+ * \brief Queries reusing the cached monotone decomposition of paths
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/monotone-decomposition.h>
+#include <2geom/path.h>
+#include <2geom/path-intersection.h>
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <glib.h>
+
+using namespace Geom;
+
+class Timer {
+public:
+    Timer(char const *name, unsigned count)
+        : _name(name), _count(count), _start(g_get_monotonic_time()) {}
+    ~Timer() {
+        gint64 stop = g_get_monotonic_time();
+        std::cout << _name << ": " << double(stop - _start) / _count << " us per query"
+                  << std::endl;
+    }
+private:
+    char const *_name;
+    unsigned _count;
+    gint64 _start;
+};
+
+static Point random_point(Point const &center, Coord r)
+{
+    return center + Point(g_random_double_range(-r, r), g_random_double_range(-r, r));
+}
+
+// a long closed scribble made of cubic Beziers
+static Path random_path(unsigned nsegs)
+{
+    Path path(Point(0, 0));
+    for (unsigned i = 0; i < nsegs; ++i) {
+        Point last = path.finalPoint();
+        path.appendNew<CubicBezier>(random_point(last, 20), random_point(last, 20),
+                                    random_point(last, 20));
+    }
+    path.close();
+    return path;
+}
+
+// a copy of the path which does not share the cached values
+static Path fresh_copy(Path const &path)
+{
+    return Path(path.begin(), path.end_open(), path.closed());
+}
+
+int main(int argc, char **argv)
+{
+    unsigned const nsegs = argc > 1 ? std::atoi(argv[1]) : 1000;
+    unsigned const queries = 1000;
+
+    // for reproducibility.
+    g_random_set_seed(1234);
+    Path path = random_path(nsegs);
+    OptRect bounds = path.boundsFast();
+    std::vector<Point> points;
+    for (unsigned i = 0; i < queries; ++i) {
+        points.push_back(Point(g_random_double_range((*bounds)[X].min(), (*bounds)[X].max()),
+                               g_random_double_range((*bounds)[Y].min(), (*bounds)[Y].max())));
+    }
+    std::cout << nsegs << " cubic Beziers, "
+              << path.monotoneDecomposition().pieceCount() << " monotonic pieces" << std::endl;
+
+    long sink = 0;
+    {
+        Timer t("MonotoneDecomposition construction", 10);
+        for (unsigned i = 0; i < 10; ++i) {
+            MonotoneDecomposition md(path);
+            sink += md.pieceCount();
+        }
+    }
+    {
+        Timer t("Path::winding, fresh path", 10);
+        for (unsigned i = 0; i < 10; ++i) {
+            sink += fresh_copy(path).winding(points[i]);
+        }
+    }
+    {
+        Timer t("Path::winding, unchanged path", queries);
+        for (unsigned i = 0; i < queries; ++i) {
+            sink += path.winding(points[i]);
+        }
+    }
+    {
+        Timer t("Path::nearestTime, fresh path", 10);
+        for (unsigned i = 0; i < 10; ++i) {
+            sink += fresh_copy(path).nearestTime(points[i]).curve_index;
+        }
+    }
+    {
+        Timer t("Path::nearestTime, unchanged path", queries);
+        for (unsigned i = 0; i < queries; ++i) {
+            sink += path.nearestTime(points[i]).curve_index;
+        }
+    }
+
+    Path small = random_path(nsegs / 10);
+    {
+        Timer t("self_crossings, fresh path", 3);
+        for (unsigned i = 0; i < 3; ++i) {
+            sink += self_crossings(fresh_copy(small)).size();
+        }
+    }
+    {
+        Timer t("self_crossings, unchanged path", 3);
+        for (unsigned i = 0; i < 3; ++i) {
+            sink += self_crossings(small).size();
+        }
+    }
+    std::cout << "Checksum: " << sink << std::endl;
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
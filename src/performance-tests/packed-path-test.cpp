@@ -0,0 +1,166 @@
+/**
+ * \file
+ * \brief Performance test comparing PathVector with PackedPathVector
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/packed-pathvector.h>
+#include <2geom/pathvector.h>
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <glib.h>
+
+using namespace Geom;
+
+static Point random_point(Point const &origin, Coord size)
+{
+    return origin + Point(g_random_double_range(0, size), g_random_double_range(0, size));
+}
+
+// Generate a grid of closed paths made of random lines, quadratics and cubics.
+static PathVector random_paths(unsigned npaths, unsigned nsegs)
+{
+    PathVector result;
+    for (unsigned i = 0; i < npaths; ++i) {
+        Point origin(100 * (i % 100), 100 * (i / 100));
+        Path path(random_point(origin, 100));
+        for (unsigned j = 0; j < nsegs; ++j) {
+            switch (g_random_int_range(0, 3)) {
+            case 0:
+                path.appendNew<LineSegment>(random_point(origin, 100));
+                break;
+            case 1:
+                path.appendNew<QuadraticBezier>(random_point(origin, 100),
+                                                random_point(origin, 100));
+                break;
+            default:
+                path.appendNew<CubicBezier>(random_point(origin, 100),
+                                            random_point(origin, 100),
+                                            random_point(origin, 100));
+                break;
+            }
+        }
+        path.close();
+        result.push_back(path);
+    }
+    return result;
+}
+
+static double ms(std::clock_t start, std::clock_t stop)
+{
+    return (stop - start) * (1000. / CLOCKS_PER_SEC);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned npaths = argc > 1 ? std::atoi(argv[1]) : 2000;
+    unsigned nsegs = argc > 2 ? std::atoi(argv[2]) : 100;
+    unsigned const num_points = 2000;
+    unsigned const num_repeats = 10;
+
+    // for reproducibility.
+    g_random_set_seed(1234);
+    PathVector pv = random_paths(npaths, nsegs);
+
+    std::clock_t start = std::clock();
+    PackedPathVector packed(pv);
+    std::clock_t stop = std::clock();
+    std::cout << "Packing " << npaths << " paths with " << nsegs << " segments each: "
+              << ms(start, stop) << " ms" << std::endl;
+
+    OptRect bounds = pv.boundsFast();
+    std::vector<Point> points;
+    for (unsigned i = 0; i < num_points; ++i) {
+        points.push_back(Point(g_random_double_range(bounds->left(), bounds->right()),
+                               g_random_double_range(bounds->top(), bounds->bottom())));
+    }
+
+    long check_pv = 0, check_packed = 0;
+
+    start = std::clock();
+    for (unsigned i = 0; i < num_points; ++i) {
+        check_pv += pv.winding(points[i]);
+    }
+    stop = std::clock();
+    std::cout << "PathVector winding (" << num_points << "x): " << ms(start, stop) << " ms" << std::endl;
+
+    start = std::clock();
+    for (unsigned i = 0; i < num_points; ++i) {
+        check_packed += packed.winding(points[i]);
+    }
+    stop = std::clock();
+    std::cout << "PackedPathVector winding (" << num_points << "x): " << ms(start, stop) << " ms" << std::endl;
+
+    if (check_pv != check_packed) {
+        std::cout << "Winding results differ!" << std::endl;
+        return 1;
+    }
+
+    start = std::clock();
+    for (unsigned i = 0; i < num_repeats; ++i) {
+        pv.boundsExact();
+    }
+    stop = std::clock();
+    std::cout << "PathVector boundsExact (" << num_repeats << "x): " << ms(start, stop) << " ms" << std::endl;
+
+    start = std::clock();
+    for (unsigned i = 0; i < num_repeats; ++i) {
+        packed.boundsExact();
+    }
+    stop = std::clock();
+    std::cout << "PackedPathVector boundsExact (" << num_repeats << "x): " << ms(start, stop) << " ms" << std::endl;
+
+    start = std::clock();
+    for (unsigned i = 0; i < num_repeats; ++i) {
+        pv *= Affine(Rotate(0.01));
+        pv.boundsFast();
+    }
+    stop = std::clock();
+    std::cout << "PathVector *= Affine + boundsFast (" << num_repeats << "x): " << ms(start, stop) << " ms" << std::endl;
+
+    start = std::clock();
+    for (unsigned i = 0; i < num_repeats; ++i) {
+        packed *= Affine(Rotate(0.01));
+        packed.boundsFast();
+    }
+    stop = std::clock();
+    std::cout << "PackedPathVector *= Affine + boundsFast (" << num_repeats << "x): " << ms(start, stop) << " ms" << std::endl;
+
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
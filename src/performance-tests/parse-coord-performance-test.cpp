@@ -0,0 +1,179 @@
+/**
+ * \file
+ * \brief Performance test for parsing numbers in SVG path data
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/coord.h>
+#include <2geom/svg-path-parser.h>
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <ctime>
+#include <stdint.h>
+#include <glib.h>
+
+using namespace Geom;
+
+// Sink which stores the coordinates of all points in the order of parsing.
+class CoordinateSink : public PathSink {
+public:
+    CoordinateSink(std::vector<Coord> &out) : _out(out) {}
+    virtual void moveTo(Point const &p) { _add(p); }
+    virtual void lineTo(Point const &p) { _add(p); }
+    virtual void curveTo(Point const &, Point const &, Point const &) {}
+    virtual void quadTo(Point const &, Point const &) {}
+    virtual void arcTo(Coord, Coord, Coord, bool, bool, Point const &) {}
+    virtual void closePath() {}
+    virtual void flush() {}
+private:
+    void _add(Point const &p) {
+        _out.push_back(p[X]);
+        _out.push_back(p[Y]);
+    }
+    std::vector<Coord> &_out;
+};
+
+static double random_bits_double()
+{
+    union {
+        uint64_t u;
+        double d;
+    };
+    do {
+        u = uint64_t(g_random_int()) | (uint64_t(g_random_int()) << 32);
+    } while (!std::isfinite(d));
+    return d;
+}
+
+/* Append a random number to the corpus. Most numbers look like the output
+ * of drawing programs; the rest exercise the slow path. */
+static void append_number(std::string &corpus)
+{
+    char buf[64];
+    int kind = g_random_int_range(0, 100);
+    if (kind < 60) {
+        // coordinates with a few decimal places
+        std::sprintf(buf, "%.*f", g_random_int_range(0, 7), g_random_double_range(-2000, 2000));
+        corpus += buf;
+    } else if (kind < 70) {
+        std::sprintf(buf, "%d", g_random_int_range(-10000, 10000));
+        corpus += buf;
+    } else if (kind < 80) {
+        std::sprintf(buf, "%.*e", g_random_int_range(0, 10), g_random_double_range(-1, 1)
+                     * std::pow(10.0, g_random_int_range(-40, 40)));
+        corpus += buf;
+    } else if (kind < 95) {
+        // shortest representation of a coordinate, usually 16-17 digits
+        corpus += format_coord_shortest(g_random_double_range(-2000, 2000));
+    } else {
+        corpus += format_coord_shortest(random_bits_double());
+    }
+}
+
+static double ms(std::clock_t start, std::clock_t stop)
+{
+    return (stop - start) * (1000. / CLOCKS_PER_SEC);
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t count = argc > 1 ? std::atoi(argv[1]) : 2000000;
+    count += count % 2; // the corpus is a list of points
+
+    // for reproducibility.
+    g_random_set_seed(1234);
+
+    std::string corpus = "M";
+    std::vector<std::size_t> offsets;
+    offsets.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        corpus += ' ';
+        offsets.push_back(corpus.size());
+        append_number(corpus);
+    }
+    double const mb = corpus.size() / (1024. * 1024.);
+    std::cout << count << " numbers, " << mb << " MB of path data" << std::endl;
+
+    // Reference values, converted by the C library as the parser originally did.
+    std::vector<Coord> reference(count);
+    std::clock_t start = std::clock();
+    for (std::size_t i = 0; i < count; ++i) {
+        reference[i] = g_ascii_strtod(corpus.c_str() + offsets[i], NULL);
+    }
+    std::clock_t stop = std::clock();
+    std::cout << "g_ascii_strtod: " << ms(start, stop) << " ms" << std::endl;
+
+    std::vector<Coord> direct(count);
+    start = std::clock();
+    for (std::size_t i = 0; i < count; ++i) {
+        char const *begin = corpus.c_str() + offsets[i];
+        char const *end = begin + std::strcspn(begin, " ");
+        direct[i] = parse_coord(begin, end);
+    }
+    stop = std::clock();
+    std::cout << "parse_coord: " << ms(start, stop) << " ms" << std::endl;
+
+    std::vector<Coord> parsed;
+    parsed.reserve(count);
+    CoordinateSink sink(parsed);
+    start = std::clock();
+    parse_svg_path(corpus.c_str(), sink);
+    stop = std::clock();
+    double t = ms(start, stop);
+    std::cout << "SVGPathParser: " << t << " ms, " << mb / (t / 1000.) << " MB/s" << std::endl;
+
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        bool ok = i < parsed.size()
+            && std::memcmp(&parsed[i], &reference[i], sizeof(Coord)) == 0
+            && std::memcmp(&direct[i], &reference[i], sizeof(Coord)) == 0;
+        if (!ok) {
+            if (mismatches < 10) {
+                std::size_t len = std::strcspn(corpus.c_str() + offsets[i], " ");
+                std::cout << "Mismatch: " << corpus.substr(offsets[i], len) << std::endl;
+            }
+            ++mismatches;
+        }
+    }
+    std::cout << "Values different from g_ascii_strtod: " << mismatches << std::endl;
+
+    return mismatches == 0 ? 0 : 1;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -13,8 +13,12 @@
 
 
 #include <iostream>
+#include <cstdio>
 #include <ctime>
+#include <string>
+#include <glib.h>
 
+#include "2geom/parallel.h"
 #include "2geom/svg-path-parser.h"
 #include "2geom/pathvector.h"
 #include "2geom/path.h"
@@ -69,6 +73,27 @@ static char const *path_str =
     "539.47487,449.23188 571.22455,441.66601 603.32025,433.29795 631.13918,426.50743 658.9581,419.7169 "
     "688.21455,391.64677 702.85715,390.39104";
 
+// Sink which only counts the segments, to measure the parser alone.
+class CountingSink : public PathSink {
+public:
+    CountingSink() : segments(0) {}
+    virtual void moveTo(Point const &) { ++segments; }
+    virtual void lineTo(Point const &) { ++segments; }
+    virtual void curveTo(Point const &, Point const &, Point const &) { ++segments; }
+    virtual void quadTo(Point const &, Point const &) { ++segments; }
+    virtual void arcTo(Coord, Coord, Coord, bool, bool, Point const &) { ++segments; }
+    virtual void closePath() {}
+    virtual void flush() {}
+    unsigned long segments;
+};
+
+static void report_throughput(char const *name, std::size_t bytes, std::clock_t start, std::clock_t stop)
+{
+    double seconds = double(stop - start) / CLOCKS_PER_SEC;
+    std::cout << name << ": " << seconds * 1000 << " ms, "
+              << bytes / seconds / (1024 * 1024) << " MB/s" << std::endl;
+}
+
 int main()
 {
     for (int rep = 0; rep < 3; rep++) {
@@ -81,6 +106,82 @@ int main()
         std::cout << "Parse SVG-d (" << num_repeats << "x): " << (stop - start) * (1000. / CLOCKS_PER_SEC) << " ms "
                   << std::endl;
     }
+
+    // throughput on a larger input, one path per line like in svgd files
+    std::string data;
+    while (data.size() < 32 * 1024 * 1024) {
+        data += path_str;
+        data += '\n';
+    }
+    std::cout << "Throughput on " << data.size() / (1024 * 1024) << " MB of path data" << std::endl;
+
+    CountingSink counter;
+    std::clock_t start = std::clock();
+    SVGPathParser parser(counter);
+    parser.parse(data.data(), data.size());
+    std::clock_t stop = std::clock();
+    report_throughput("SVGPathParser::parse, counting sink", data.size(), start, stop);
+
+    start = std::clock();
+    std::size_t const block = 65536;
+    for (std::size_t i = 0; i < data.size(); i += block) {
+        parser.feed(data.data() + i, std::min(block, data.size() - i));
+    }
+    parser.finish();
+    stop = std::clock();
+    report_throughput("SVGPathParser::feed, 64 KiB blocks, counting sink", data.size(), start, stop);
+
+    start = std::clock();
+    PathVector pv = parse_svg_path(data.c_str());
+    stop = std::clock();
+    report_throughput("parse_svg_path into PathVector", data.size(), start, stop);
+
+    // parallel parsing with 1, 2, 4, ... threads; use wall clock time,
+    // since CPU time adds up over all threads
+    set_thread_count(0);
+    unsigned const max_threads = thread_count();
+    double serial_seconds = 0;
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        set_thread_count(threads);
+        gint64 wall_start = g_get_monotonic_time();
+        PathVector ppv = parse_svg_path_parallel(data);
+        double seconds = (g_get_monotonic_time() - wall_start) / 1e6;
+        if (threads == 1) {
+            serial_seconds = seconds;
+        }
+        if (ppv != pv) {
+            std::cout << "Results with " << threads << " threads differ!" << std::endl;
+            return 1;
+        }
+        std::cout << "parse_svg_path_parallel, " << threads << " thread(s): " << seconds * 1000
+                  << " ms, " << data.size() / seconds / (1024 * 1024) << " MB/s, speedup "
+                  << serial_seconds / seconds << std::endl;
+    }
+    if (max_threads == 1) {
+        std::cout << "Only one thread is available in this build or on this machine" << std::endl;
+    }
+    set_thread_count(1);
+
+    char const *filename = "parse-svg-test.svgd";
+    FILE *f = std::fopen(filename, "w");
+    if (f) {
+        std::fwrite(data.data(), 1, data.size(), f);
+        std::fclose(f);
+
+        f = std::fopen(filename, "r");
+        start = std::clock();
+        parse_svg_path_file(f, counter);
+        stop = std::clock();
+        std::fclose(f);
+        report_throughput("parse_svg_path_file(FILE *), counting sink", data.size(), start, stop);
+
+        start = std::clock();
+        parse_svg_path_file(filename, counter);
+        stop = std::clock();
+        report_throughput("parse_svg_path_file(filename), counting sink", data.size(), start, stop);
+        std::remove(filename);
+    }
+    return counter.segments == 42;
 }
 
 
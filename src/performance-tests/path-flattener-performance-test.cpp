@@ -0,0 +1,159 @@
+/**
+ * \file
+ * \brief Performance test for PathFlattener
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+#include <2geom/elliptical-arc.h>
+#include <2geom/path-flattener.h>
+#include <2geom/path.h>
+#include <2geom/pathvector.h>
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <glib.h>
+
+using namespace Geom;
+
+static Point random_point(Coord size)
+{
+    return Point(g_random_double_range(0, size), g_random_double_range(0, size));
+}
+
+// Generate closed paths made of random lines, quadratics, cubics and elliptical arcs.
+static PathVector random_paths(unsigned count, unsigned nsegs, Coord size)
+{
+    PathVector pv;
+    for (unsigned i = 0; i < count; ++i) {
+        Path path(random_point(size));
+        for (unsigned j = 0; j < nsegs; ++j) {
+            switch (g_random_int_range(0, 4)) {
+            case 0:
+                path.appendNew<LineSegment>(random_point(size));
+                break;
+            case 1:
+                path.appendNew<QuadraticBezier>(random_point(size), random_point(size));
+                break;
+            case 2:
+                path.appendNew<CubicBezier>(random_point(size), random_point(size),
+                                            random_point(size));
+                break;
+            default:
+                path.appendNew<EllipticalArc>(g_random_double_range(1, size),
+                                              g_random_double_range(1, size),
+                                              g_random_double_range(0, M_PI),
+                                              g_random_int_range(0, 2), g_random_int_range(0, 2),
+                                              random_point(size));
+                break;
+            }
+        }
+        path.close();
+        pv.push_back(path);
+    }
+    return pv;
+}
+
+/* The usual ad hoc approach: split the curve in half with Curve::portion()
+ * until a few sample points are close enough to the chord. */
+static void flatten_portion(Curve const &c, Coord tolerance, std::vector<Point> &out,
+                            unsigned depth = 0)
+{
+    LineSegment chord(c.initialPoint(), c.finalPoint());
+    bool flat = true;
+    for (unsigned i = 1; i < 4 && flat; ++i) {
+        Point p = c.pointAt(i / 4.);
+        flat = distance(p, chord.pointAt(chord.nearestTime(p))) <= tolerance;
+    }
+    if (flat || depth >= 20) {
+        out.push_back(c.finalPoint());
+        return;
+    }
+    Curve *first = c.portion(0, 0.5);
+    Curve *second = c.portion(0.5, 1);
+    flatten_portion(*first, tolerance, out, depth + 1);
+    flatten_portion(*second, tolerance, out, depth + 1);
+    delete first;
+    delete second;
+}
+
+static double ms(std::clock_t start, std::clock_t stop)
+{
+    return (stop - start) * (1000. / CLOCKS_PER_SEC);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned count = argc > 1 ? std::atoi(argv[1]) : 1000;
+    Coord tolerance = argc > 2 ? std::atof(argv[2]) : 0.1;
+    unsigned repeats = 10;
+
+    // for reproducibility.
+    g_random_set_seed(1234);
+    PathVector paths = random_paths(count, 20, 1000);
+    std::cout << paths.size() << " paths, " << paths.curveCount() << " curves, tolerance "
+              << tolerance << std::endl;
+
+    PathFlattener flattener(tolerance);
+    std::vector<Point> points;
+    std::vector<std::size_t> ends;
+    std::clock_t start = std::clock();
+    for (unsigned r = 0; r < repeats; ++r) {
+        points.clear();
+        ends.clear();
+        flattener.flatten(paths, points, ends);
+    }
+    std::clock_t stop = std::clock();
+    std::cout << "PathFlattener: " << ms(start, stop) / repeats << " ms, "
+              << points.size() << " points" << std::endl;
+
+    std::vector<Point> portion_points;
+    start = std::clock();
+    for (unsigned r = 0; r < repeats; ++r) {
+        portion_points.clear();
+        for (std::size_t i = 0; i < paths.size(); ++i) {
+            portion_points.push_back(paths[i].initialPoint());
+            for (std::size_t j = 0; j < paths[i].size_default(); ++j) {
+                flatten_portion(paths[i][j], tolerance, portion_points);
+            }
+        }
+    }
+    stop = std::clock();
+    std::cout << "Curve::portion subdivision: " << ms(start, stop) / repeats << " ms, "
+              << portion_points.size() << " points" << std::endl;
+
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,152 @@
+/**
+ * \file
+ * \brief Performance test for Boolean operations on polygons
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/intersection-graph.h>
+#include <2geom/pathvector.h>
+#include <2geom/polygon-intersection-graph.h>
+#include <2geom/svg-path-parser.h>
+#include <2geom/transforms.h>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <glib.h>
+
+using namespace Geom;
+
+// A closed polygon approximating a circle with a noisy radius, like a flattened freehand shape.
+static Path noisy_circle(Point const &center, Coord radius, unsigned nverts)
+{
+    Path path(center + Point(radius, 0));
+    for (unsigned i = 1; i < nverts; ++i) {
+        Coord r = radius * g_random_double_range(0.95, 1.05);
+        path.appendNew<LineSegment>(center + Point::polar(2 * M_PI * i / nverts, r));
+    }
+    path.close();
+    return path;
+}
+
+// Count random points at which the union is classified incorrectly.
+static unsigned count_errors(PathVector const &a, PathVector const &b, PathVector const &result)
+{
+    Rect bounds = *(a.boundsFast() | b.boundsFast());
+    unsigned errors = 0;
+    for (unsigned i = 0; i < 1000; ++i) {
+        Point p(g_random_double_range(bounds[X].min(), bounds[X].max()),
+                g_random_double_range(bounds[Y].min(), bounds[Y].max()));
+        bool expected = a.winding(p) % 2 || b.winding(p) % 2;
+        if (bool(result.winding(p) % 2) != expected) ++errors;
+    }
+    return errors;
+}
+
+static bool run(char const *name, PathVector const &a, PathVector const &b, unsigned reps)
+{
+    std::size_t nsegs = a.curveCount() + b.curveCount();
+    std::cout << name << ", " << nsegs << " segments:" << std::endl;
+
+    gint64 t0 = g_get_monotonic_time();
+    PathVector curve_result;
+    for (unsigned i = 0; i < reps; ++i) {
+        PathIntersectionGraph pig(a, b);
+        curve_result = pig.getUnion();
+    }
+    gint64 t1 = g_get_monotonic_time();
+    PathVector polygon_result;
+    for (unsigned i = 0; i < reps; ++i) {
+        PolygonIntersectionGraph pig(a, b);
+        polygon_result = pig.getUnion();
+    }
+    gint64 t2 = g_get_monotonic_time();
+
+    double curve_ms = (t1 - t0) / 1000. / reps;
+    double polygon_ms = (t2 - t1) / 1000. / reps;
+    std::cout << "  PathIntersectionGraph:    " << curve_ms << " ms\n"
+              << "  PolygonIntersectionGraph: " << polygon_ms << " ms, speedup "
+              << curve_ms / polygon_ms << std::endl;
+
+    // PathIntersectionGraph does not support edges shared between the operands
+    unsigned curve_errors = count_errors(a, b, curve_result);
+    if (curve_errors) {
+        std::cout << "  PathIntersectionGraph result is wrong at " << curve_errors
+                  << " of 1000 points" << std::endl;
+    }
+    if (count_errors(a, b, polygon_result)) {
+        std::cout << "PolygonIntersectionGraph result is wrong!" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned reps = argc > 1 ? std::atoi(argv[1]) : 5;
+    g_random_set_seed(1234);
+
+    // many small shapes
+    Path blob = parse_svg_path("M 2,-3 L 3,-2 1,2 3,4 4,2 6,3 2,11 0,10 2,5 1,4 -1,6 -2,5 Z")[0];
+    Path rect = parse_svg_path("M 0,0 L 5,0 5,8 0,8 Z")[0];
+    PathVector a, b;
+    for (unsigned i = 0; i < 30; ++i) {
+        for (unsigned j = 0; j < 30; ++j) {
+            a.push_back(blob * Translate(12 * i, 16 * j));
+            b.push_back(rect * Rotate(0.1 * (j % 10) + 0.05) * Translate(12 * i + 0.37, 16 * j + 0.61));
+        }
+    }
+    if (!run("Grid of small polygons", a, b, reps)) return 1;
+
+    // few shapes with many vertices
+    PathVector c, d;
+    c.push_back(noisy_circle(Point(0, 0), 100, 5000));
+    d.push_back(noisy_circle(Point(60, 20), 100, 5000));
+    if (!run("Two large polygons", c, d, reps)) return 1;
+
+    // shapes sharing edges and vertices
+    PathVector e, f;
+    for (unsigned i = 0; i < 40; ++i) {
+        for (unsigned j = 0; j < 40; ++j) {
+            Path square = rect * Translate(5 * i, 8 * j);
+            ((i + j) % 2 ? e : f).push_back(square);
+        }
+    }
+    e.push_back(noisy_circle(Point(100, 160), 80, 2000));
+    if (!run("Checkerboard", e, f, reps)) return 1;
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,162 @@
+/**
+ * \file
+ * \brief Performance test for the robust geometric predicates
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/convex-hull.h>
+#include <2geom/predicates.h>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <glib.h>
+
+using namespace Geom;
+
+static int sgn(Coord x)
+{
+    return (x > 0) - (x < 0);
+}
+
+// Compare orient2d with the plain floating point determinant on the given triples.
+static void time_orient2d(char const *name, std::vector<Point> const &pts, unsigned reps)
+{
+    std::size_t n = pts.size() / 3;
+    int naive_sum = 0, exact_sum = 0;
+    unsigned disagree = 0;
+
+    gint64 t0 = g_get_monotonic_time();
+    for (unsigned r = 0; r < reps; ++r) {
+        for (std::size_t i = 0; i < n; ++i) {
+            Point const &a = pts[3*i], &b = pts[3*i+1], &c = pts[3*i+2];
+            naive_sum += sgn(cross(b - a, c - a));
+        }
+    }
+    gint64 t1 = g_get_monotonic_time();
+    for (unsigned r = 0; r < reps; ++r) {
+        for (std::size_t i = 0; i < n; ++i) {
+            exact_sum += sgn(orient2d(pts[3*i], pts[3*i+1], pts[3*i+2]));
+        }
+    }
+    gint64 t2 = g_get_monotonic_time();
+    for (std::size_t i = 0; i < n; ++i) {
+        Point const &a = pts[3*i], &b = pts[3*i+1], &c = pts[3*i+2];
+        if (sgn(cross(b - a, c - a)) != sgn(orient2d(a, b, c))) ++disagree;
+    }
+
+    double calls = double(n) * reps;
+    std::cout << name << ":\n"
+              << "  cross(b - a, c - a): " << (t1 - t0) * 1000. / calls << " ns/call\n"
+              << "  orient2d:            " << (t2 - t1) * 1000. / calls << " ns/call\n"
+              << "  wrong signs of the plain determinant: " << disagree << " of " << n
+              << " (checksums " << naive_sum << ", " << exact_sum << ")" << std::endl;
+}
+
+static void time_hull(char const *name, std::vector<Point> const &pts, unsigned reps)
+{
+    std::size_t size = 0;
+    gint64 t0 = g_get_monotonic_time();
+    for (unsigned r = 0; r < reps; ++r) {
+        ConvexHull hull(pts);
+        size += hull.size();
+    }
+    gint64 t1 = g_get_monotonic_time();
+    std::cout << "ConvexHull, " << name << " (" << pts.size() << " points): "
+              << (t1 - t0) / 1000. / reps << " ms, " << size / reps << " vertices" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned reps = argc > 1 ? std::atoi(argv[1]) : 10;
+    g_random_set_seed(1234);
+    unsigned const n = 1000000;
+
+    // random triples; the fast path of the adaptive test decides all of them
+    std::vector<Point> random_pts;
+    for (unsigned i = 0; i < 3 * n; ++i) {
+        random_pts.push_back(Point(g_random_double_range(0, 1), g_random_double_range(0, 1)));
+    }
+    time_orient2d("Random points", random_pts, reps);
+
+    // triples within a few units in the last place of a line, which need the exact fallback
+    std::vector<Point> collinear_pts;
+    Coord const ulp = std::ldexp(1.0, -53);
+    for (unsigned i = 0; i < n; ++i) {
+        collinear_pts.push_back(Point(0.5 + g_random_int_range(0, 64) * ulp,
+                                      0.5 + g_random_int_range(0, 64) * ulp));
+        collinear_pts.push_back(Point(12, 12));
+        collinear_pts.push_back(Point(24, 24));
+    }
+    time_orient2d("Nearly collinear points", collinear_pts, reps);
+
+    // incircle on random points and on points close to a circle
+    std::vector<Point> near_circle;
+    for (unsigned i = 0; i < n; ++i) {
+        near_circle.push_back(Point(3 + (g_random_int_range(0, 64) - 32) * 4 * ulp, 4));
+    }
+    Coord sum = 0;
+    gint64 t0 = g_get_monotonic_time();
+    for (unsigned r = 0; r < reps; ++r) {
+        for (unsigned i = 0; i + 3 < 3 * n; i += 4) {
+            sum += sgn(incircle(random_pts[i], random_pts[i+1], random_pts[i+2], random_pts[i+3]));
+        }
+    }
+    gint64 t1 = g_get_monotonic_time();
+    Point a(5, 0), b(0, 5), c(-5, 0);
+    for (unsigned r = 0; r < reps; ++r) {
+        for (unsigned i = 0; i < n; ++i) {
+            sum += sgn(incircle(a, b, c, near_circle[i]));
+        }
+    }
+    gint64 t2 = g_get_monotonic_time();
+    std::cout << "incircle:\n"
+              << "  random points:          " << (t1 - t0) * 1000. / (reps * (3. * n / 4))
+              << " ns/call\n"
+              << "  points near the circle: " << (t2 - t1) * 1000. / (reps * double(n))
+              << " ns/call (checksum " << sum << ")" << std::endl;
+
+    time_hull("random points", random_pts, reps);
+    std::vector<Point> circle_pts;
+    for (unsigned i = 0; i < n; ++i) {
+        circle_pts.push_back(Point::polar(2 * M_PI * i / n, 100));
+    }
+    time_hull("points on a circle", circle_pts, reps);
+    time_hull("nearly collinear points", collinear_pts, reps);
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,209 @@
+/**
+ * \file
+ * \brief Performance test for RTree, optionally compared with libspatialindex
+ *//*
+ * Copyright 2010  Evangelos Katsikaros <vkatsikaros at yahoo dot gr>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/rtree.h>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+#include <glib.h>
+
+#ifdef HAVE_LIBSPATIALINDEX
+#include <SpatialIndex.h>
+#endif
+
+using namespace Geom;
+
+static double ms(std::clock_t start, std::clock_t stop)
+{
+    return (stop - start) * (1000. / CLOCKS_PER_SEC);
+}
+
+#ifdef HAVE_LIBSPATIALINDEX
+// Counts the results of libspatialindex queries.
+class CountVisitor : public SpatialIndex::IVisitor {
+public:
+    CountVisitor() : count(0) {}
+    void visitNode(const SpatialIndex::INode &) {}
+    void visitData(const SpatialIndex::IData &) { ++count; }
+    void visitData(std::vector<const SpatialIndex::IData*> &v) { count += v.size(); }
+    std::size_t count;
+};
+
+static SpatialIndex::Region to_region(Rect const &r)
+{
+    double plow[2], phigh[2];
+    plow[0] = r.left();
+    plow[1] = r.top();
+    phigh[0] = r.right();
+    phigh[1] = r.bottom();
+    return SpatialIndex::Region(plow, phigh, 2);
+}
+#endif
+
+int main(int argc, char **argv)
+{
+    /* Rectangles of size 10x10 are placed every 20 units in the area (-limit, -limit),
+     * (limit, limit). Queries are random rectangles of size up to 200x200. */
+    int limit = argc > 1 ? std::atoi(argv[1]) : 2000;
+    unsigned const num_queries = 10000;
+    unsigned const num_nearest = 10000;
+
+    std::vector<std::pair<Rect, unsigned> > items;
+    for (int x = -limit; x <= limit; x += 20) {
+        for (int y = -limit; y <= limit; y += 20) {
+            items.push_back(std::make_pair(Rect(x, y, x + 10, y + 10), (unsigned) items.size()));
+        }
+    }
+    std::cout << "Number of rectangles: " << items.size() << std::endl;
+
+    // for reproducibility.
+    g_random_set_seed(1234);
+    std::vector<Rect> queries;
+    std::vector<Point> points;
+    for (unsigned i = 0; i < num_queries; ++i) {
+        Point a(g_random_double_range(-limit, limit), g_random_double_range(-limit, limit));
+        queries.push_back(Rect(a, a + Point(g_random_double_range(0, 200),
+                                            g_random_double_range(0, 200))));
+        points.push_back(a);
+    }
+
+    std::size_t check_list = 0;
+    std::clock_t start = std::clock();
+    for (unsigned i = 0; i < num_queries; ++i) {
+        for (unsigned j = 0; j < items.size(); ++j) {
+            if (queries[i].intersects(items[j].first)) ++check_list;
+        }
+    }
+    std::clock_t stop = std::clock();
+    std::cout << "Full scan (" << num_queries << " queries, " << check_list << " results): "
+              << ms(start, stop) << " ms" << std::endl;
+
+    RTree<unsigned> inserted;
+    start = std::clock();
+    for (unsigned i = 0; i < items.size(); ++i) {
+        inserted.insert(items[i].first, items[i].second);
+    }
+    stop = std::clock();
+    std::cout << "RTree insert: " << ms(start, stop) << " ms, height " << inserted.height() << std::endl;
+
+    RTree<unsigned> loaded;
+    start = std::clock();
+    loaded.bulkLoad(items.begin(), items.end());
+    stop = std::clock();
+    std::cout << "RTree bulk load: " << ms(start, stop) << " ms, height " << loaded.height() << std::endl;
+
+    RTree<unsigned> *trees[2] = { &inserted, &loaded };
+    char const *names[2] = { "inserted", "bulk loaded" };
+    for (unsigned t = 0; t < 2; ++t) {
+        std::vector<unsigned> result;
+        std::size_t check_tree = 0;
+        start = std::clock();
+        for (unsigned i = 0; i < num_queries; ++i) {
+            result.clear();
+            trees[t]->query(queries[i], std::back_inserter(result));
+            check_tree += result.size();
+        }
+        stop = std::clock();
+        std::cout << "RTree " << names[t] << " query: " << ms(start, stop) << " ms" << std::endl;
+        if (check_tree != check_list) {
+            std::cout << "Query results differ!" << std::endl;
+            return 1;
+        }
+
+        start = std::clock();
+        for (unsigned i = 0; i < num_nearest; ++i) {
+            trees[t]->nearest(points[i], 10);
+        }
+        stop = std::clock();
+        std::cout << "RTree " << names[t] << " 10 nearest (" << num_nearest << "x): "
+                  << ms(start, stop) << " ms" << std::endl;
+    }
+
+    start = std::clock();
+    for (unsigned i = 0; i < items.size(); i += 2) {
+        loaded.remove(items[i].first, items[i].second);
+    }
+    stop = std::clock();
+    std::cout << "RTree remove half: " << ms(start, stop) << " ms" << std::endl;
+
+#ifdef HAVE_LIBSPATIALINDEX
+    SpatialIndex::IStorageManager *storage =
+        SpatialIndex::StorageManager::createNewMemoryStorageManager();
+    SpatialIndex::id_type index_id;
+    // fillFactor, indexCapacity, leafCapacity, dimensionality, variant, indexIdentifier
+    SpatialIndex::ISpatialIndex *sitree = SpatialIndex::RTree::createNewRTree(
+        *storage, 0.7, 16, 16, 2, SpatialIndex::RTree::RV_RSTAR, index_id);
+
+    start = std::clock();
+    for (unsigned i = 0; i < items.size(); ++i) {
+        sitree->insertData(0, 0, to_region(items[i].first), items[i].second);
+    }
+    stop = std::clock();
+    std::cout << "libspatialindex insert: " << ms(start, stop) << " ms" << std::endl;
+
+    CountVisitor counter;
+    start = std::clock();
+    for (unsigned i = 0; i < num_queries; ++i) {
+        sitree->intersectsWithQuery(to_region(queries[i]), counter);
+    }
+    stop = std::clock();
+    std::cout << "libspatialindex query: " << ms(start, stop) << " ms" << std::endl;
+    if (counter.count != check_list) {
+        std::cout << "libspatialindex query results differ!" << std::endl;
+    }
+
+    start = std::clock();
+    for (unsigned i = 0; i < num_nearest; ++i) {
+        CountVisitor v;
+        double p[2] = { points[i][X], points[i][Y] };
+        sitree->nearestNeighborQuery(10, SpatialIndex::Point(p, 2), v);
+    }
+    stop = std::clock();
+    std::cout << "libspatialindex 10 nearest (" << num_nearest << "x): "
+              << ms(start, stop) << " ms" << std::endl;
+
+    delete sitree;
+    delete storage;
+#endif
+
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
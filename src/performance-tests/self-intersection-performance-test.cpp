@@ -0,0 +1,170 @@
+/**
+ * \file
+ * \brief Self-intersection of long freehand paths
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/path.h>
+#include <2geom/path-intersection.h>
+#include <2geom/sweep-bounds.h>
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <glib.h>
+
+using namespace Geom;
+
+class Timer {
+public:
+    Timer(char const *name, unsigned count)
+        : _name(name), _count(count), _start(g_get_monotonic_time()) {}
+    ~Timer() {
+        gint64 stop = g_get_monotonic_time();
+        std::cout << _name << ": " << double(stop - _start) / _count / 1000 << " ms" << std::endl;
+    }
+private:
+    char const *_name;
+    unsigned _count;
+    gint64 _start;
+};
+
+/* A scribble like the ones drawn with the pencil tool in spiro or B-spline mode:
+ * a long, smooth path of short cubic Beziers, which wanders within a box and crosses
+ * itself many times. */
+static Path pencil_path(unsigned nsegs, Coord size)
+{
+    Coord const step = 4;
+    Point pos(size / 2, size / 2);
+    Point c2 = pos; // second control point of the last curve, for smooth joins
+    Coord heading = 0;
+    Path path(pos);
+    for (unsigned i = 0; i < nsegs; ++i) {
+        heading += g_random_double_range(-0.6, 0.6);
+        Point dir = Point::polar(heading);
+        Point next = pos + step * dir;
+        // turn back at the edges of the box
+        if (next[X] < 0 || next[X] > size || next[Y] < 0 || next[Y] > size) {
+            heading += M_PI;
+            dir = -dir;
+            next = pos + step * dir;
+        }
+        Point c1 = path.empty() ? pos + step / 3 * dir : 2 * pos - c2;
+        c2 = next - step / 3 * dir;
+        path.appendNew<CubicBezier>(c1, c2, next);
+        pos = next;
+    }
+    return path;
+}
+
+/* Shading drawn as a single zigzag stroke: long diagonal curves going back and forth,
+ * each slightly displaced from the previous one. Every curve overlaps the bounding boxes
+ * of hundreds of others, but it only crosses a few of its neighbours. */
+static Path hatching_path(unsigned nsegs, Coord size)
+{
+    unsigned const per_stroke = 4;
+    Coord const gap = 2 * size / nsegs;
+    Point pos(0, 0);
+    Path path(pos);
+    for (unsigned i = 0; i < nsegs; ++i) {
+        bool forward = i / per_stroke % 2 == 0;
+        unsigned k = i % per_stroke + 1;
+        Coord x0 = (i / per_stroke / 2) * gap;
+        Point next = forward
+            ? Point(x0 + size * k / per_stroke, size * k / per_stroke)
+            : Point(x0 + size - (size - gap) * k / per_stroke, size * (per_stroke - k) / per_stroke);
+        Point jitter(0, g_random_double_range(-gap, gap));
+        path.appendNew<CubicBezier>(lerp(1. / 3, pos, next) + jitter,
+                                    lerp(2. / 3, pos, next) - jitter, next);
+        pos = next;
+    }
+    return path;
+}
+
+// intersect all curve pairs with overlapping bounding boxes
+static std::size_t bbox_culled_intersections(Path const &path)
+{
+    std::size_t count = 0;
+    std::vector<std::vector<unsigned> > cull = sweep_bounds(bounds(path));
+    for (std::size_t i = 0; i < cull.size(); ++i) {
+        for (std::size_t j = 0; j < cull[i].size(); ++j) {
+            std::vector<CurveIntersection> xs = path[i].intersect(path[cull[i][j]]);
+            count += xs.size();
+        }
+    }
+    return count;
+}
+
+static void run(char const *name, Path const &path)
+{
+    path.monotoneDecomposition();
+    std::cout << path.size() << " cubic Beziers, " << name << ":" << std::endl;
+
+    std::size_t self = 0, crossings = 0;
+    // the reference takes minutes for the longest hatching
+    if (path.size() <= 4000) {
+        std::size_t culled = 0;
+        {
+            Timer t("  bounding box culling and Curve::intersect", 1);
+            culled = bbox_culled_intersections(path);
+        }
+        std::cout << "  " << culled << " intersections including joints" << std::endl;
+    }
+    {
+        Timer t("  Path::intersectSelf", 1);
+        self = path.intersectSelf().size();
+    }
+    {
+        Timer t("  self_crossings", 1);
+        crossings = self_crossings(path).size();
+    }
+    std::cout << "  " << self << " self-intersections, " << crossings << " self crossings"
+              << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned const max_segs = argc > 1 ? std::atoi(argv[1]) : 16000;
+
+    // for reproducibility.
+    g_random_set_seed(1234);
+    for (unsigned nsegs = 1000; nsegs <= max_segs; nsegs *= 4) {
+        run("scribble", pencil_path(nsegs, 400));
+        run("hatching", hatching_path(nsegs, 400));
+    }
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
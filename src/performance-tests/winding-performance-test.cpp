@@ -0,0 +1,136 @@
+/**
+ * \file
+ * \brief Performance test for batch winding number computation
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/path.h>
+#include <2geom/winding-batch.h>
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <glib.h>
+
+using namespace Geom;
+
+static Point random_point(Coord size)
+{
+    return Point(g_random_double_range(0, size), g_random_double_range(0, size));
+}
+
+// Generate a self-intersecting closed path made of random lines, quadratics and cubics.
+static Path random_path(unsigned nsegs, Coord size)
+{
+    Path path(random_point(size));
+    for (unsigned j = 0; j < nsegs; ++j) {
+        switch (g_random_int_range(0, 3)) {
+        case 0:
+            path.appendNew<LineSegment>(random_point(size));
+            break;
+        case 1:
+            path.appendNew<QuadraticBezier>(random_point(size), random_point(size));
+            break;
+        default:
+            path.appendNew<CubicBezier>(random_point(size), random_point(size), random_point(size));
+            break;
+        }
+    }
+    path.close();
+    return path;
+}
+
+static double ms(std::clock_t start, std::clock_t stop)
+{
+    return (stop - start) * (1000. / CLOCKS_PER_SEC);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned nsegs = argc > 1 ? std::atoi(argv[1]) : 100;
+    unsigned side = argc > 2 ? std::atoi(argv[2]) : 1000;
+    Coord const size = 1000;
+
+    // for reproducibility.
+    g_random_set_seed(1234);
+    Path path = random_path(nsegs, size);
+
+    // pixel centers of a raster covering the path
+    std::vector<Point> points;
+    points.reserve(side * side);
+    for (unsigned y = 0; y < side; ++y) {
+        for (unsigned x = 0; x < side; ++x) {
+            points.push_back(Point((x + 0.5) * size / side, (y + 0.5) * size / side));
+        }
+    }
+    std::cout << nsegs << " segments, " << points.size() << " points" << std::endl;
+
+    std::vector<int> single(points.size());
+    std::clock_t start = std::clock();
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        single[i] = path.winding(points[i]);
+    }
+    std::clock_t stop = std::clock();
+    std::cout << "Path::winding(Point): " << ms(start, stop) << " ms" << std::endl;
+
+    std::vector<int> batch;
+    start = std::clock();
+    path.winding(points, batch);
+    stop = std::clock();
+    std::cout << "Path::winding(std::vector<Point>): " << ms(start, stop) << " ms" << std::endl;
+
+    start = std::clock();
+    BatchWinding prepared(path);
+    stop = std::clock();
+    std::cout << "BatchWinding preparation (" << prepared.size() << " pieces): "
+              << ms(start, stop) << " ms" << std::endl;
+
+    std::vector<int> reused;
+    start = std::clock();
+    prepared.winding(points, reused);
+    stop = std::clock();
+    std::cout << "BatchWinding::winding: " << ms(start, stop) << " ms" << std::endl;
+
+    // points exactly on the path may be classified differently
+    std::size_t differences = 0;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        if (single[i] != batch[i] || batch[i] != reused[i]) ++differences;
+    }
+    std::cout << "Points with different results: " << differences << std::endl;
+
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,176 @@
+/**
+ * \file
+ * \brief Performance test for writing SVG path data
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/path.h>
+#include <2geom/pathvector.h>
+#include <2geom/svg-path-parser.h>
+#include <2geom/svg-path-writer.h>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <glib.h>
+
+using namespace Geom;
+
+static Coord random_coord(Coord size, bool rounded)
+{
+    Coord x = g_random_double_range(0, size);
+    // drawing programs usually round coordinates to a few decimal places
+    return rounded ? std::floor(x * 1000 + 0.5) / 1000 : x;
+}
+
+static Point random_point(Coord size, bool rounded)
+{
+    return Point(random_coord(size, rounded), random_coord(size, rounded));
+}
+
+static PathVector random_paths(unsigned npaths, unsigned nsegs, bool rounded)
+{
+    Coord const size = 1000;
+    PathVector pv;
+    for (unsigned i = 0; i < npaths; ++i) {
+        Path path(random_point(size, rounded));
+        for (unsigned j = 0; j < nsegs; ++j) {
+            switch (g_random_int_range(0, 3)) {
+            case 0:
+                path.appendNew<LineSegment>(random_point(size, rounded));
+                break;
+            case 1:
+                path.appendNew<QuadraticBezier>(random_point(size, rounded),
+                                                random_point(size, rounded));
+                break;
+            default:
+                path.appendNew<CubicBezier>(random_point(size, rounded),
+                                            random_point(size, rounded),
+                                            random_point(size, rounded));
+                break;
+            }
+        }
+        path.close();
+        pv.push_back(path);
+    }
+    return pv;
+}
+
+static void report_throughput(char const *name, std::size_t bytes, std::clock_t start,
+                              std::clock_t stop)
+{
+    double seconds = double(stop - start) / CLOCKS_PER_SEC;
+    std::cout << "  " << name << ": " << seconds * 1000 << " ms, "
+              << bytes / seconds / (1024 * 1024) << " MB/s" << std::endl;
+}
+
+static bool run(PathVector const &pv, unsigned reps)
+{
+    std::string data;
+    std::clock_t start = std::clock();
+    std::size_t bytes = 0;
+    for (unsigned i = 0; i < reps; ++i) {
+        data = write_svg_path(pv);
+        bytes += data.size();
+    }
+    std::clock_t stop = std::clock();
+    report_throughput("write_svg_path, shortest", bytes, start, stop);
+
+    // the shortest representation must preserve the values exactly;
+    // elliptical arcs are not used, since their parameters are recomputed on parsing
+    if (parse_svg_path(data.c_str()) != pv) {
+        std::cout << "Written path data does not match the input!" << std::endl;
+        return false;
+    }
+
+    start = std::clock();
+    bytes = 0;
+    for (unsigned i = 0; i < reps; ++i) {
+        bytes += write_svg_path(pv, -1, true).size();
+    }
+    stop = std::clock();
+    report_throughput("write_svg_path, shortest, optimized", bytes, start, stop);
+
+    start = std::clock();
+    bytes = 0;
+    for (unsigned i = 0; i < reps; ++i) {
+        bytes += write_svg_path(pv, 6).size();
+    }
+    stop = std::clock();
+    report_throughput("write_svg_path, precision 6", bytes, start, stop);
+
+    // append to a reused string, as when exporting a whole document
+    std::string out;
+    start = std::clock();
+    bytes = 0;
+    for (unsigned i = 0; i < reps; ++i) {
+        out.clear();
+        SVGPathWriter writer(out);
+        writer.feed(pv);
+        bytes += out.size();
+    }
+    stop = std::clock();
+    report_throughput("SVGPathWriter with output string, shortest", bytes, start, stop);
+
+    start = std::clock();
+    bytes = 0;
+    for (unsigned i = 0; i < reps; ++i) {
+        out.clear();
+        SVGPathWriter writer(out);
+        writer.setPrecision(6);
+        writer.feed(pv);
+        bytes += out.size();
+    }
+    stop = std::clock();
+    report_throughput("SVGPathWriter with output string, precision 6", bytes, start, stop);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned reps = argc > 1 ? std::atoi(argv[1]) : 10;
+
+    // for reproducibility.
+    g_random_set_seed(1234);
+
+    std::cout << "Coordinates rounded to 3 decimal places:" << std::endl;
+    if (!run(random_paths(1000, 100, true), reps)) return 1;
+    std::cout << "Coordinates with full precision:" << std::endl;
+    if (!run(random_paths(1000, 100, false), reps)) return 1;
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
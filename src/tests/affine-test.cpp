@@ -34,6 +34,7 @@
 #include <gtest/gtest.h>
 #include <2geom/affine.h>
 #include <2geom/transforms.h>
+#include <vector>
 
 namespace Geom {
 
@@ -415,6 +416,37 @@ TEST(AffineTest, Multiplication) {
     EXPECT_EQ(a3 * a2 * a1, t1);
 }
 
+TEST(AffineTest, TransformPoints) {
+    Affine ms[4] = {
+        Translate(10.5, -3.25),
+        Scale(-2, 0.3) * Translate(1, 2),
+        Scale(3),
+        Rotate(0.7) * Scale(1.5, 0.25) * Translate(-100, 0.125)
+    };
+    // odd number of points to exercise the scalar remainder of the vector loops
+    std::vector<Point> pts;
+    for (unsigned i = 0; i < 15; ++i) {
+        pts.push_back(Point(i * 1.75 - 7, 100.0 / (i + 1)));
+    }
+
+    for (unsigned k = 0; k < 4; ++k) {
+        std::vector<Point> result = pts;
+        transform_points(&result[0], result.size(), ms[k]);
+        std::vector<Coord> xs, ys;
+        for (unsigned i = 0; i < pts.size(); ++i) {
+            xs.push_back(pts[i][X]);
+            ys.push_back(pts[i][Y]);
+        }
+        transform_coords(&xs[0], &ys[0], xs.size(), ms[k]);
+
+        for (unsigned i = 0; i < pts.size(); ++i) {
+            Point expected = pts[i] * ms[k];
+            EXPECT_EQ(result[i], expected);
+            EXPECT_EQ(Point(xs[i], ys[i]), expected);
+        }
+    }
+}
+
 } // end namespace Geom
 
 /*
@@ -0,0 +1,167 @@
+/** @file
+ * @brief Unit tests for MonotonicArena.
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include "testing.h"
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include <2geom/arena.h>
+#include <2geom/point.h>
+
+using namespace Geom;
+
+static bool is_aligned(void *p)
+{
+    return reinterpret_cast<std::size_t>(p) % MonotonicArena::ALIGNMENT == 0;
+}
+
+TEST(ArenaTest, Allocation) {
+    MonotonicArena arena(256);
+    char *prev = NULL;
+    for (unsigned i = 1; i < 200; ++i) {
+        char *p = static_cast<char *>(arena.allocate(i % 37 + 1));
+        EXPECT_TRUE(is_aligned(p));
+        // the memory must be writable and distinct from earlier allocations
+        std::fill(p, p + i % 37 + 1, char(i));
+        if (prev) {
+            EXPECT_EQ(*prev, char(i - 1));
+        }
+        prev = p;
+    }
+    EXPECT_GE(arena.bytesReserved(), arena.bytesUsed());
+
+    // allocations larger than the block size
+    void *big = arena.allocate(100000);
+    EXPECT_TRUE(is_aligned(big));
+    std::fill(static_cast<char *>(big), static_cast<char *>(big) + 100000, 1);
+    EXPECT_GE(arena.bytesReserved(), 100000u);
+
+    arena.release();
+    EXPECT_EQ(arena.bytesUsed(), 0u);
+    EXPECT_EQ(arena.bytesReserved(), 0u);
+}
+
+TEST(ArenaTest, ResetReusesMemory) {
+    MonotonicArena arena(1024);
+    for (unsigned i = 0; i < 1000; ++i) {
+        arena.allocate(48);
+    }
+    std::size_t reserved = arena.bytesReserved();
+    EXPECT_GT(reserved, 0u);
+
+    for (unsigned k = 0; k < 5; ++k) {
+        arena.reset();
+        EXPECT_EQ(arena.bytesUsed(), 0u);
+        for (unsigned i = 0; i < 1000; ++i) {
+            arena.allocate(48);
+        }
+        EXPECT_EQ(arena.bytesReserved(), reserved);
+    }
+}
+
+TEST(ArenaTest, InitialBuffer) {
+    char buffer[1000];
+    MonotonicArena arena(buffer, sizeof(buffer));
+    char *p = static_cast<char *>(arena.allocate(100));
+    EXPECT_TRUE(p >= buffer && p + 100 <= buffer + sizeof(buffer));
+    EXPECT_EQ(arena.bytesReserved(), 0u);
+
+    // the buffer is used up before the heap
+    for (unsigned i = 0; i < 20; ++i) {
+        arena.allocate(100);
+    }
+    EXPECT_GT(arena.bytesReserved(), 0u);
+
+    arena.reset();
+    p = static_cast<char *>(arena.allocate(100));
+    EXPECT_TRUE(p >= buffer && p + 100 <= buffer + sizeof(buffer));
+}
+
+TEST(ArenaTest, Containers) {
+    MonotonicArena arena;
+    std::vector<Point, ArenaAllocator<Point> > pts(&arena);
+    std::set<int, std::less<int>, ArenaAllocator<int> > ints(std::less<int>(), &arena);
+    for (int i = 0; i < 1000; ++i) {
+        pts.push_back(Point(i, -i));
+        ints.insert((i * 7919) % 1000);
+    }
+    EXPECT_EQ(pts.size(), 1000u);
+    EXPECT_EQ(pts[500], Point(500, -500));
+    EXPECT_EQ(ints.size(), 1000u);
+    EXPECT_EQ(*ints.begin(), 0);
+    EXPECT_EQ(*ints.rbegin(), 999);
+    EXPECT_GE(arena.bytesUsed(), 1000 * sizeof(Point));
+
+    // without an arena, the global heap is used
+    std::vector<Point, ArenaAllocator<Point> > heap_pts;
+    heap_pts.assign(pts.begin(), pts.end());
+    EXPECT_TRUE(heap_pts.get_allocator().arena() == NULL);
+    EXPECT_TRUE(std::equal(pts.begin(), pts.end(), heap_pts.begin()));
+
+    ArenaAllocator<int> a(&arena);
+    ArenaAllocator<Point> b(a), c;
+    EXPECT_TRUE(a == b);
+    EXPECT_TRUE(b != c);
+}
+
+namespace {
+struct Counted {
+    Counted() { ++count; }
+    Counted(int, int) { ++count; }
+    ~Counted() { --count; }
+    static int count;
+};
+int Counted::count = 0;
+}
+
+TEST(ArenaTest, Objects) {
+    MonotonicArena arena;
+    MonotonicArena *arenas[2] = { &arena, NULL };
+    for (unsigned i = 0; i < 2; ++i) {
+        Counted *x = arena_new<Counted>(arenas[i]);
+        Counted *y = arena_new<Counted>(arenas[i], 1, 2);
+        EXPECT_EQ(Counted::count, 2);
+        arena_delete(arenas[i], x);
+        arena_delete(arenas[i], y);
+        EXPECT_EQ(Counted::count, 0);
+    }
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -224,6 +224,43 @@ TEST_F(BezierTest, Mutation) {
     }
 }
 
+TEST_F(BezierTest, Storage) {
+    // copying and assigning between polynomials stored inline and on the heap
+    Bezier small(1, 2, 3, 4);
+    Bezier big(Bezier::Order(12));
+    for (unsigned i = 0; i < big.size(); ++i) {
+        big[i] = i;
+    }
+
+    Bezier a(small);
+    a = big;
+    EXPECT_EQ(12u, a.order());
+    for (unsigned i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(i, a[i]);
+    }
+    a = small;
+    EXPECT_EQ(3u, a.order());
+    EXPECT_EQ(4, a[3]);
+
+    Bezier b(big);
+    b[0] = -1;
+    EXPECT_EQ(0, big[0]);
+    b = b;
+    EXPECT_EQ(-1, b[0]);
+
+    // arithmetic across the inline size limit
+    Bezier sum = small + big;
+    EXPECT_EQ(12u, sum.order());
+    EXPECT_FLOAT_EQ(sum.valueAt(0.3), small.valueAt(0.3) + big.valueAt(0.3));
+    Bezier prod = small * small * small;
+    EXPECT_EQ(9u, prod.order());
+    Coord v = small.valueAt(0.7);
+    EXPECT_FLOAT_EQ(prod.valueAt(0.7), v * v * v);
+
+    Bezier pb = portion(big, 0.2, 0.6);
+    EXPECT_FLOAT_EQ(pb.valueAt(0.5), big.valueAt(0.4));
+}
+
 TEST_F(BezierTest, MultiDerivative) {
     vector<double> vnd = wiggle.valueAndDerivatives(0.5, 5);
     expect_array((const double[]){0,0,12,72,0,0}, vnd);
@@ -501,6 +538,84 @@ TEST_F(BezierTest, Intersection) {
     #endif
 }
 
+// Compare the fixed-degree specializations of BezierCurveN with the generic implementation
+// in BezierCurve, which is called through a qualified name to bypass virtual dispatch.
+template <unsigned N>
+void check_specialized_curve(BezierCurveN<N> const &c)
+{
+    for (unsigned i = 0; i <= 16; ++i) {
+        Coord t = i / 16.;
+        EXPECT_TRUE(are_near(c.pointAt(t), c.BezierCurve::pointAt(t), 1e-12));
+        EXPECT_NEAR(c.valueAt(t, Y), c.BezierCurve::valueAt(t, Y), 1e-12);
+        std::vector<Point> pd = c.pointAndDerivatives(t, 4);
+        std::vector<Point> gpd = c.BezierCurve::pointAndDerivatives(t, 4);
+        ASSERT_EQ(pd.size(), gpd.size());
+        for (unsigned k = 0; k < pd.size(); ++k) {
+            EXPECT_TRUE(are_near(pd[k], gpd[k], 1e-10));
+        }
+    }
+    EXPECT_EQ(c.pointAt(0), c.initialPoint());
+    EXPECT_EQ(c.pointAt(1), c.finalPoint());
+
+    Rect bounds = c.boundsExact(), gbounds = c.BezierCurve::boundsExact();
+    EXPECT_TRUE(are_near(bounds.min(), gbounds.min(), 1e-10));
+    EXPECT_TRUE(are_near(bounds.max(), gbounds.max(), 1e-10));
+
+    Coord v = c.pointAt(0.3)[X];
+    std::vector<Coord> rs = c.roots(v, X), grs = c.BezierCurve::roots(v, X);
+    ASSERT_EQ(rs.size(), grs.size());
+    for (unsigned k = 0; k < rs.size(); ++k) {
+        EXPECT_NEAR(rs[k], grs[k], 1e-9);
+        EXPECT_NEAR(c.valueAt(rs[k], X), v, 1e-9);
+    }
+
+    for (unsigned i = 0; i < 10; ++i) {
+        Point p(g_random_double_range(-2, 12), g_random_double_range(-2, 12));
+        Coord t = c.nearestTime(p), gt = c.BezierCurve::nearestTime(p);
+        // the nearest point may not be unique, so compare the distances
+        EXPECT_NEAR(distance(c.pointAt(t), p), distance(c.pointAt(gt), p), 1e-9);
+        Coord pt = c.nearestTime(p, 0.75, 0.25);
+        EXPECT_GE(pt, 0.25);
+        EXPECT_LE(pt, 0.75);
+        EXPECT_LE(distance(c.pointAt(pt), p), distance(c.pointAt(0.5), p));
+    }
+
+    Coord f = g_random_double_range(0, 1), t = g_random_double_range(0, 1);
+    Curve *portion = c.portion(f, t);
+    Curve *gportion = c.BezierCurve::portion(f, t);
+    EXPECT_TRUE(dynamic_cast<BezierCurveN<N> *>(portion) != NULL);
+    EXPECT_TRUE(are_near(portion->initialPoint(), c.pointAt(f), 1e-12));
+    EXPECT_TRUE(are_near(portion->finalPoint(), c.pointAt(t), 1e-12));
+    for (unsigned i = 0; i <= 8; ++i) {
+        EXPECT_TRUE(are_near(portion->pointAt(i / 8.), gportion->pointAt(i / 8.), 1e-10));
+    }
+    delete portion;
+    delete gportion;
+}
+
+static Point random_point()
+{
+    return Point(g_random_double_range(0, 10), g_random_double_range(0, 10));
+}
+
+TEST_F(BezierTest, FixedDegreeSpecializations) {
+    g_random_set_seed(4321);
+    for (unsigned i = 0; i < 100; ++i) {
+        check_specialized_curve(LineSegment(random_point(), random_point()));
+        check_specialized_curve(QuadraticBezier(random_point(), random_point(), random_point()));
+        check_specialized_curve(CubicBezier(random_point(), random_point(),
+                                            random_point(), random_point()));
+    }
+
+    // degenerate cases: constant coordinates and coincident control points
+    check_specialized_curve(QuadraticBezier(Point(1, 1), Point(1, 5), Point(1, 1)));
+    check_specialized_curve(CubicBezier(Point(0, 0), Point(0, 0), Point(3, 3), Point(3, 3)));
+    CubicBezier flat(Point(0, 2), Point(1, 2), Point(2, 2), Point(3, 2));
+    EXPECT_TRUE(flat.roots(2, Y).empty());
+    EXPECT_TRUE(flat.BezierCurve::roots(2, Y).empty());
+    EXPECT_EQ(flat.boundsExact(), Rect(0, 2, 3, 2));
+}
+
 /*
   Local Variables:
   mode:c++
@@ -0,0 +1,202 @@
+/** @file
+ * @brief Unit tests for the binary path format.
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include "testing.h"
+#include <cstdio>
+
+#include <2geom/binary-path.h>
+#include <2geom/exception.h>
+#include <2geom/packed-pathvector.h>
+#include <2geom/pathvector.h>
+#include <2geom/svg-path-parser.h>
+
+using namespace Geom;
+
+class BinaryPathTest : public ::testing::Test {
+protected:
+    BinaryPathTest() {
+        shapes = parse_svg_path(
+            "M 0,0 L 10,0 10,10 0,10 z "
+            "M 2.5,2.25 Q 8.125,2 8,8 L 2,8 z "
+            "M 0.1,0.2 C 0.3,0.4 -1e-7,123456.789 -3.5,7 "
+            "M 0,0 a 5,10 45 0 1 10,10 a 5,10 45 1 0 -10,-10 z "
+            "M 100,100 z L 110,110 M 5,5");
+    }
+
+    // check that the paths have the same structure and the points differ by at most eps
+    void expect_near(PathVector const &a, PathVector const &b, Coord eps) {
+        ASSERT_EQ(a.size(), b.size());
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            ASSERT_EQ(a[i].size_closed(), b[i].size_closed());
+            EXPECT_EQ(a[i].closed(), b[i].closed());
+            for (std::size_t j = 0; j < a[i].size_closed(); ++j) {
+                EXPECT_TRUE(are_near(a[i][j].initialPoint(), b[i][j].initialPoint(), eps));
+                EXPECT_TRUE(are_near(a[i][j].finalPoint(), b[i][j].finalPoint(), eps));
+                EXPECT_TRUE(are_near(a[i][j].pointAt(0.5), b[i][j].pointAt(0.5), eps));
+            }
+        }
+    }
+
+    PathVector shapes;
+};
+
+TEST_F(BinaryPathTest, Float64Exact) {
+    std::string data = write_binary_path(shapes);
+    PathVector result = read_binary_path(data);
+    EXPECT_EQ(result, shapes);
+
+    // a segment after closepath starts at the initial point of the closed path
+    ASSERT_EQ(result.size(), 7u);
+    EXPECT_EQ(result[5].initialPoint(), Point(100, 100));
+    EXPECT_TRUE(result[6].empty());
+
+    EXPECT_EQ(write_binary_path(result), data);
+}
+
+TEST_F(BinaryPathTest, Float32) {
+    std::string data = write_binary_path(shapes, BINARY_PATH_FLOAT32);
+    EXPECT_LT(data.size(), write_binary_path(shapes).size());
+    expect_near(read_binary_path(data), shapes, 1e-2);
+
+    // values representable in single precision are preserved
+    PathVector simple = parse_svg_path("M 0,0 L 10,0.5 Q 1,2 3,4.25 z");
+    EXPECT_EQ(read_binary_path(write_binary_path(simple, BINARY_PATH_FLOAT32)), simple);
+}
+
+TEST_F(BinaryPathTest, Quantized) {
+    std::string data = write_binary_path(shapes, BINARY_PATH_QUANTIZED, 0.01);
+    EXPECT_LT(data.size(), write_binary_path(shapes, BINARY_PATH_FLOAT32).size());
+    expect_near(read_binary_path(data), shapes, 0.01);
+
+    // the quantized points are consistent, so the paths stay continuous
+    PathVector result = read_binary_path(data);
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        for (std::size_t j = 1; j < result[i].size_default(); ++j) {
+            EXPECT_EQ(result[i][j - 1].finalPoint(), result[i][j].initialPoint());
+        }
+    }
+
+    EXPECT_THROW(BinaryPathWriter(BINARY_PATH_QUANTIZED, 0), RangeError);
+    EXPECT_THROW(write_binary_path(parse_svg_path("M 1e300,0 L 1,1"),
+                                   BINARY_PATH_QUANTIZED, 1), RangeError);
+}
+
+TEST_F(BinaryPathTest, Packed) {
+    BinaryPathEncoding encodings[3] = {
+        BINARY_PATH_FLOAT64, BINARY_PATH_FLOAT32, BINARY_PATH_QUANTIZED
+    };
+    for (unsigned i = 0; i < 3; ++i) {
+        std::string data = write_binary_path(shapes, encodings[i], 0.125);
+        PackedPathVector packed;
+        read_binary_path(data.data(), data.size(), packed);
+        EXPECT_EQ(packed.toPathVector(), read_binary_path(data));
+    }
+
+    // data is appended to the existing paths
+    std::string data = write_binary_path(shapes);
+    PackedPathVector packed(shapes);
+    read_binary_path(data.data(), data.size(), packed);
+    EXPECT_EQ(packed.size(), 2 * shapes.size());
+}
+
+TEST_F(BinaryPathTest, OutputString) {
+    std::string out = "prefix";
+    BinaryPathWriter writer(out);
+    writer.feed(shapes);
+    EXPECT_EQ(out.substr(0, 6), "prefix");
+    EXPECT_EQ(out.substr(6), write_binary_path(shapes));
+    EXPECT_EQ(writer.str(), write_binary_path(shapes));
+
+    writer.clear();
+    EXPECT_EQ(read_binary_path(out.substr(6)), PathVector());
+    EXPECT_EQ(out.substr(0, 6), "prefix");
+}
+
+TEST_F(BinaryPathTest, InvalidData) {
+    std::string data = write_binary_path(shapes);
+    EXPECT_THROW(read_binary_path(data.substr(0, 7)), BinaryPathFormatError);
+    EXPECT_THROW(read_binary_path(data.substr(0, data.size() - 1)), BinaryPathFormatError);
+
+    std::string bad = data;
+    bad[0] = 'X';
+    EXPECT_THROW(read_binary_path(bad), BinaryPathFormatError);
+    bad = data;
+    bad[4] = 2; // unknown version
+    EXPECT_THROW(read_binary_path(bad), BinaryPathFormatError);
+    bad = data;
+    bad[5] = 3; // unknown encoding
+    EXPECT_THROW(read_binary_path(bad), BinaryPathFormatError);
+    bad = data;
+    bad[8] = 1; // segment without a moveto
+    EXPECT_THROW(read_binary_path(bad), BinaryPathFormatError);
+    bad = data;
+    bad[8] = 7; // unknown command
+    EXPECT_THROW(read_binary_path(bad), BinaryPathFormatError);
+
+    // truncated varint
+    data = write_binary_path(shapes, BINARY_PATH_QUANTIZED, 1e-6);
+    EXPECT_THROW(read_binary_path(data.substr(0, 18)), BinaryPathFormatError);
+}
+
+TEST_F(BinaryPathTest, Files) {
+    char const *filename = "binary-path-test.bin";
+    PathVector many;
+    for (unsigned i = 0; i < 1000; ++i) {
+        many.insert(many.end(), shapes.begin(), shapes.end());
+    }
+    std::string data = write_binary_path(many);
+    FILE *f = std::fopen(filename, "wb");
+    ASSERT_TRUE(f != NULL);
+    std::fwrite(data.data(), 1, data.size(), f);
+    std::fclose(f);
+
+    PackedPathVector packed;
+    read_binary_path_file(filename, packed);
+    EXPECT_EQ(packed.toPathVector(), many);
+
+    // empty files do not contain the header
+    f = std::fopen(filename, "wb");
+    std::fclose(f);
+    EXPECT_THROW(read_binary_path_file(filename, packed), BinaryPathFormatError);
+
+    std::remove(filename);
+    EXPECT_THROW(read_binary_path_file(filename, packed), std::runtime_error);
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -36,6 +36,7 @@
 #include <iostream>
 
 #include <2geom/convex-hull.h>
+#include <2geom/predicates.h>
 #include <vector>
 #include <iterator>
 
@@ -258,6 +259,31 @@ TEST_F(ConvexHullTest, PointContainment) {
     EXPECT_TRUE(square.interiorContains(half));*/
 }
 
+TEST_F(ConvexHullTest, NearlyCollinearPoints) {
+    // points within a few units in the last place of a line, which are easily
+    // classified inconsistently by inexact orientation tests
+    std::vector<Point> pts;
+    Coord const ulp = std::ldexp(1.0, -53);
+    for (int i = 0; i < 12; ++i) {
+        for (int j = 0; j < 12; ++j) {
+            pts.push_back(Point(0.5 + i * ulp, 0.5 + j * ulp));
+        }
+    }
+    pts.push_back(Point(12, 12));
+    pts.push_back(Point(24, 24));
+    ConvexHull hull(pts);
+
+    // all turns of the boundary must have the same direction
+    ASSERT_GE(hull.size(), 3u);
+    for (std::size_t i = 0; i < hull.size(); ++i) {
+        Point a = hull[i], b = hull[(i + 1) % hull.size()], c = hull[(i + 2) % hull.size()];
+        EXPECT_GT(orient2d(a, b, c), 0) << "at vertex " << i;
+    }
+    for (std::size_t i = 0; i < pts.size(); ++i) {
+        EXPECT_TRUE(hull.contains(pts[i]));
+    }
+}
+
 TEST_F(ConvexHullTest, ExtremePoints) {
     Point zero(0,0);
     EXPECT_EQ(0., point.top());
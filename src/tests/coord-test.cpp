@@ -34,6 +34,9 @@
 #include <gtest/gtest.h>
 #include <2geom/coord.h>
 #include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <stdint.h>
 #include <glib.h>
 #include <iostream>
@@ -76,6 +79,98 @@ TEST(CoordTest, StringRoundtripNice) {
     }
 }
 
+TEST(CoordTest, ParseRange) {
+    char const *literals[] = {
+        "0", "-0", "+0", "1", "-1", "0.5", ".5", "-.5", "5.", "1e3", "1E-3", "1.5e+2",
+        "123.456", "0.1", "0.3", "-273.15", "9007199254740992", "9007199254740993",
+        "1234567890123456789", "12345678901234567890", "0.000000000000000000000001",
+        "1e22", "1e23", "3e30", "1e-22", "1e-23", "4.9406564584124654e-324", "1e400",
+        "1.7976931348623157e308", "2.2250738585072011e-308", "00000000000000000000000001.5",
+        "0.10000000000000000555111512312578270211815834045410156250000000001"
+    };
+    for (unsigned i = 0; i < sizeof(literals) / sizeof(literals[0]); ++i) {
+        std::string s = literals[i];
+        // surround the literal with other characters to check that they are not read
+        std::string padded = "99" + s + "99";
+        double x = parse_coord(padded.data() + 2, padded.data() + 2 + s.size());
+        double expected = g_ascii_strtod(s.c_str(), NULL);
+        EXPECT_EQ(0, std::memcmp(&x, &expected, sizeof(double))) << s;
+    }
+
+    std::string junk = "1.2.3";
+    EXPECT_TRUE(std::isnan(parse_coord(junk.data(), junk.data() + junk.size())));
+}
+
+TEST(CoordTest, ParseRangeRandom) {
+    union {
+        uint64_t u;
+        double d;
+    };
+    char buf[64];
+    for (unsigned i = 0; i < 100000; ++i) {
+        u = uint64_t(g_random_int()) | (uint64_t(g_random_int()) << 32);
+        if (!std::isfinite(d)) continue;
+
+        // short decimal literals, which are handled by the fast path
+        int len = std::sprintf(buf, "%.*f", int(i % 8), std::fmod(d, 1e6));
+        double x = parse_coord(buf, buf + len);
+        double expected = g_ascii_strtod(buf, NULL);
+        EXPECT_EQ(0, std::memcmp(&x, &expected, sizeof(double))) << buf;
+
+        std::string str = format_coord_shortest(d);
+        x = parse_coord(str.data(), str.data() + str.size());
+        EXPECT_EQ(d, x) << str;
+    }
+}
+
+TEST(CoordTest, FormatPrecision) {
+    char buf[64], expected[64];
+    double const special[] = {
+        0, -0.0, 0.5, 1.5, 2.5, 0.125, 0.375, 1e-5, 1e-4, 123456, 999999.5, 9.9999999,
+        1e21, 1e-300, 4.9406564584124654e-324, 1.7976931348623157e308, -1e10
+    };
+    for (int prec = 0; prec <= 17; ++prec) {
+        for (unsigned i = 0; i < sizeof(special) / sizeof(special[0]); ++i) {
+            char *end = format_coord_precision(special[i], prec, buf);
+            std::sprintf(expected, "%.*g", prec, special[i]);
+            EXPECT_EQ(std::string(buf, end), expected);
+        }
+    }
+
+    union {
+        uint64_t u;
+        double d;
+    };
+    for (unsigned i = 0; i < 100000; ++i) {
+        u = uint64_t(g_random_int()) | (uint64_t(g_random_int()) << 32);
+        if (!std::isfinite(d)) continue;
+        int prec = i % 18;
+        // values of typical magnitude, as well as arbitrary ones
+        double x = i % 2 ? d : std::fmod(d, 1e4);
+
+        char *end = format_coord_precision(x, prec, buf);
+        std::sprintf(expected, "%.*g", prec, x);
+        EXPECT_EQ(std::string(buf, end), expected);
+
+        end = format_coord_shortest(d, buf);
+        *end = 0;
+        double back = g_ascii_strtod(buf, NULL);
+        EXPECT_EQ(0, std::memcmp(&back, &d, sizeof(double))) << buf;
+    }
+
+    struct { double x; char const *str; } const shortest[] = {
+        { 0, "0" }, { -0.0, "-0" }, { 0.5, ".5" }, { 0.1, ".1" }, { 1.5, "1.5" },
+        { 1e-4, ".0001" }, { 1e-5, "1e-5" }, { -2.5e-7, "-25e-8" }, { 123456, "123456" },
+        { 999999.5, "999999.5" }, { 1e21, "1e21" }, { -1e10, "-1e10" },
+        { 4.9406564584124654e-324, "5e-324" },
+        { 1.7976931348623157e308, "17976931348623157e292" }
+    };
+    for (unsigned i = 0; i < sizeof(shortest) / sizeof(shortest[0]); ++i) {
+        char *end = format_coord_shortest(shortest[i].x, buf);
+        EXPECT_EQ(std::string(buf, end), shortest[i].str);
+    }
+}
+
 } // end namespace Geom
 
 /*
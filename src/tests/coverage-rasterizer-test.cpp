@@ -0,0 +1,258 @@
+/** @file
+ * @brief Unit tests for CoverageRasterizer.
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include "testing.h"
+#include <cmath>
+#include <vector>
+
+#include <2geom/circle.h>
+#include <2geom/coverage-rasterizer.h>
+#include <2geom/path.h>
+#include <2geom/svg-path-parser.h>
+
+using namespace Geom;
+
+static std::vector<float> rasterize(PathVector const &pv, IntRect const &area,
+                                    FillRule rule = FILL_NONZERO, Coord tolerance = 0.1)
+{
+    CoverageRasterizer r(area, tolerance);
+    r.feed(pv);
+    std::vector<float> result(area.width() * area.height());
+    r.render(&result[0], area.width(), rule);
+    return result;
+}
+
+static PathVector rect_path(Coord x0, Coord y0, Coord x1, Coord y1)
+{
+    return PathVector(Path(Rect(x0, y0, x1, y1)));
+}
+
+static float total(std::vector<float> const &cov)
+{
+    float sum = 0;
+    for (std::size_t i = 0; i < cov.size(); ++i) {
+        sum += cov[i];
+    }
+    return sum;
+}
+
+TEST(CoverageRasterizerTest, PixelAlignedRect)
+{
+    IntRect area(0, 0, 10, 10);
+    std::vector<float> cov = rasterize(rect_path(2, 3, 7, 8), area);
+    for (int y = 0; y < 10; ++y) {
+        for (int x = 0; x < 10; ++x) {
+            bool inside = x >= 2 && x < 7 && y >= 3 && y < 8;
+            EXPECT_FLOAT_EQ(cov[y * 10 + x], inside ? 1 : 0);
+        }
+    }
+}
+
+TEST(CoverageRasterizerTest, PartialCoverage)
+{
+    IntRect area(0, 0, 10, 10);
+    std::vector<float> cov = rasterize(rect_path(2.5, 2.25, 5.5, 4.75), area);
+    EXPECT_NEAR(cov[2 * 10 + 2], 0.5 * 0.75, 1e-6);
+    EXPECT_NEAR(cov[2 * 10 + 3], 0.75, 1e-6);
+    EXPECT_NEAR(cov[3 * 10 + 2], 0.5, 1e-6);
+    EXPECT_NEAR(cov[3 * 10 + 4], 1, 1e-6);
+    EXPECT_NEAR(cov[4 * 10 + 5], 0.5 * 0.75, 1e-6);
+    EXPECT_NEAR(cov[4 * 10 + 6], 0, 1e-6);
+    EXPECT_NEAR(total(cov), 3 * 2.5, 1e-5);
+
+    // a slanted edge crossing several pixels in one scanline
+    PathVector tri = parse_svg_path("M 0,0 L 10,1 L 0,1 z");
+    cov = rasterize(tri, area);
+    EXPECT_NEAR(total(cov), 5, 1e-5);
+    for (int x = 0; x < 10; ++x) {
+        EXPECT_NEAR(cov[x], 1 - (x + 0.5) / 10, 1e-5);
+    }
+}
+
+TEST(CoverageRasterizerTest, Orientation)
+{
+    IntRect area(0, 0, 20, 20);
+    PathVector pv = parse_svg_path("M 2,2 Q 15,2 15,15 L 2,15 z");
+    std::vector<float> a = rasterize(pv, area);
+    std::vector<float> b = rasterize(pv.reversed(), area);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        EXPECT_NEAR(a[i], b[i], 1e-6);
+    }
+}
+
+TEST(CoverageRasterizerTest, CurveArea)
+{
+    IntRect area(0, 0, 64, 64);
+    PathVector circle = PathVector(Path(Circle(32, 32, 20)));
+    std::vector<float> cov = rasterize(circle, area, FILL_NONZERO, 0.01);
+    // the flattened circle is inscribed, so it loses about 2/3 of tolerance times perimeter
+    EXPECT_NEAR(total(cov), M_PI * 400, 1);
+    EXPECT_FLOAT_EQ(cov[32 * 64 + 32], 1);
+    EXPECT_FLOAT_EQ(cov[0], 0);
+
+    // the same circle as cubic Beziers
+    PathVector cubic = parse_svg_path(
+        "M 52,32 C 52,43.0457 43.0457,52 32,52 C 20.9543,52 12,43.0457 12,32 "
+        "C 12,20.9543 20.9543,12 32,12 C 43.0457,12 52,20.9543 52,32 z");
+    std::vector<float> cov2 = rasterize(cubic, area, FILL_NONZERO, 0.01);
+    EXPECT_NEAR(total(cov2), M_PI * 400, 1);
+    for (std::size_t i = 0; i < cov.size(); ++i) {
+        EXPECT_NEAR(cov[i], cov2[i], 0.02);
+    }
+
+    // coarser tolerance
+    std::vector<float> cov3 = rasterize(circle, area);
+    EXPECT_NEAR(total(cov3), M_PI * 400, 0.1 * 2 * M_PI * 20);
+    EXPECT_LT(total(cov3), total(cov));
+}
+
+TEST(CoverageRasterizerTest, FillRules)
+{
+    IntRect area(0, 0, 10, 10);
+    PathVector pv = rect_path(0, 0, 10, 10);
+    pv.push_back(Path(Rect(3, 3, 7, 7)));
+
+    std::vector<float> nonzero = rasterize(pv, area, FILL_NONZERO);
+    std::vector<float> evenodd = rasterize(pv, area, FILL_EVENODD);
+    EXPECT_FLOAT_EQ(nonzero[5 * 10 + 5], 1);
+    EXPECT_FLOAT_EQ(evenodd[5 * 10 + 5], 0);
+    EXPECT_FLOAT_EQ(nonzero[1 * 10 + 1], 1);
+    EXPECT_FLOAT_EQ(evenodd[1 * 10 + 1], 1);
+
+    // a hole with opposite orientation is empty under both rules
+    pv.back() = pv.back().reversed();
+    nonzero = rasterize(pv, area, FILL_NONZERO);
+    EXPECT_FLOAT_EQ(nonzero[5 * 10 + 5], 0);
+    EXPECT_FLOAT_EQ(total(nonzero), 100 - 16);
+}
+
+TEST(CoverageRasterizerTest, Clipping)
+{
+    // shape extending past the left, top and bottom edges of the area
+    IntRect area(0, 0, 10, 10);
+    std::vector<float> cov = rasterize(rect_path(-10, -10, 5.5, 25), area);
+    for (int y = 0; y < 10; ++y) {
+        for (int x = 0; x < 10; ++x) {
+            EXPECT_FLOAT_EQ(cov[y * 10 + x], x < 5 ? 1 : x == 5 ? 0.5 : 0);
+        }
+    }
+
+    // slanted edges crossing the left and right edges
+    PathVector tri = parse_svg_path("M -10,0 L 20,10 L -10,10 z");
+    cov = rasterize(tri, area);
+    // below the line y = (x + 10) / 3 within the square
+    EXPECT_NEAR(total(cov), 50, 1e-3);
+
+    // area not at the origin
+    IntRect offset(100, 200, 110, 210);
+    cov = rasterize(rect_path(102, 203, 104, 204), offset);
+    EXPECT_FLOAT_EQ(cov[3 * 10 + 2], 1);
+    EXPECT_FLOAT_EQ(total(cov), 2);
+
+    // nothing inside
+    cov = rasterize(rect_path(20, 0, 30, 10), area);
+    EXPECT_FLOAT_EQ(total(cov), 0);
+}
+
+TEST(CoverageRasterizerTest, MatchesWinding)
+{
+    IntRect area(0, 0, 40, 40);
+    PathVector pv = parse_svg_path(
+        "M 2,2 Q 38,2 38,30 L 20,38 C 10,20 10,20 2,38 z "
+        "M 24,14 A 5,4 30 1 1 24,15 z");
+
+    for (unsigned r = 0; r < 2; ++r) {
+        FillRule rule = r == 0 ? FILL_NONZERO : FILL_EVENODD;
+        std::vector<float> cov = rasterize(pv, area, rule);
+        for (int y = 0; y < 40; ++y) {
+            for (int x = 0; x < 40; ++x) {
+                float c = cov[y * 40 + x];
+                int w = pv.winding(Point(x + 0.5, y + 0.5));
+                bool inside = rule == FILL_NONZERO ? w != 0 : w % 2 != 0;
+                if (c > 0.999) {
+                    EXPECT_TRUE(inside) << x << ", " << y;
+                }
+                if (c < 0.001) {
+                    EXPECT_FALSE(inside) << x << ", " << y;
+                }
+            }
+        }
+    }
+}
+
+TEST(CoverageRasterizerTest, ByteOutput)
+{
+    IntRect area(0, 0, 16, 16);
+    PathVector pv = PathVector(Path(Circle(8, 8, 6.3)));
+    CoverageRasterizer r(area);
+    r.feed(pv);
+    std::vector<float> f(16 * 16);
+    std::vector<unsigned char> b(20 * 16);
+    r.render(&f[0], 16);
+    r.render(&b[0], 20);
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            EXPECT_EQ(b[y * 20 + x], (unsigned char) std::floor(f[y * 16 + x] * 255 + 0.5));
+        }
+    }
+
+    r.reset();
+    r.render(&b[0], 20);
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            EXPECT_EQ(b[y * 20 + x], 0);
+        }
+    }
+}
+
+TEST(CoverageRasterizerTest, OpenPaths)
+{
+    // open subpaths are filled as if they were closed
+    IntRect area(0, 0, 10, 10);
+    PathVector open = parse_svg_path("M 1,1 L 9,1 L 9,9 L 1,9");
+    PathVector closed = parse_svg_path("M 1,1 L 9,1 L 9,9 L 1,9 z");
+    std::vector<float> a = rasterize(open, area);
+    std::vector<float> b = rasterize(closed, area);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        EXPECT_FLOAT_EQ(a[i], b[i]);
+    }
+    EXPECT_FLOAT_EQ(total(a), 64);
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
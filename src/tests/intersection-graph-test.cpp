@@ -33,8 +33,14 @@
 
 #include "testing.h"
 #include <iostream>
+#if __cplusplus >= 201103L
+#include <atomic>
+#include <thread>
+#endif
 
+#include <2geom/exception.h>
 #include <2geom/intersection-graph.h>
+#include <2geom/parallel.h>
 #include <2geom/pathvector.h>
 #include <2geom/svg-path-parser.h>
 #include <2geom/svg-path-writer.h>
@@ -212,6 +218,180 @@ TEST_F(IntersectionGraphTest, RhombusInSquare) {
     checkRandomPoints(square, rhombus, s2, B_MINUS_A);
 }
 
+#if __cplusplus >= 201103L
+// The curve solvers are reached from worker threads, so they must not keep any shared state.
+TEST_F(IntersectionGraphTest, ThreadCountIndependence) {
+    Path blob = string_to_path("M 0,0 C 4,-3 9,2 10,6 C 11,10 3,12 0,9 C -3,6 -4,3 0,0 Z");
+    PathVector a, b;
+    for (unsigned i = 0; i < 10; ++i) {
+        for (unsigned j = 0; j < 10; ++j) {
+            a.push_back(blob * Translate(12 * i, 16 * j));
+            b.push_back(blob * Rotate(0.1 * j + 0.05) * Translate(12 * i + 3.37, 16 * j + 2.61));
+        }
+    }
+
+    PathIntersectionGraph serial(a, b);
+    PathVector su = serial.getUnion();
+    checkRandomPoints(a, b, su, UNION);
+
+    // uses worker threads when the library is built with them
+    set_thread_count(4);
+    PathIntersectionGraph threaded(a, b);
+    set_thread_count(1);
+
+    EXPECT_EQ(threaded.intersectionPoints(), serial.intersectionPoints());
+    EXPECT_EQ(threaded.getUnion(), su);
+    EXPECT_EQ(threaded.getIntersection(), serial.getIntersection());
+
+    /* Intersect Bezier curves from several threads at once, in any build. Nearly
+     * coincident curves need many clipping steps, which used to be counted in a static
+     * variable shared by the threads. */
+    PathVector c;
+    for (unsigned i = 0; i < 10; ++i) {
+        for (unsigned j = 0; j < 10; ++j) {
+            c.push_back(blob * Rotate(1e-3 * (j + 1)) * Translate(12 * i + 1e-3 * i, 16 * j));
+        }
+    }
+    std::vector<PVIntersection> expected = a.intersect(c);
+    ASSERT_FALSE(expected.empty());
+    std::atomic<bool> start(false);
+    std::atomic<unsigned> failures(0);
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < 8; ++t) {
+        threads.push_back(std::thread([&]() {
+            while (!start.load()) {}
+            for (unsigned k = 0; k < 10; ++k) {
+                std::vector<PVIntersection> xs = a.intersect(c);
+                if (xs.size() != expected.size()) {
+                    ++failures;
+                    continue;
+                }
+                for (std::size_t i = 0; i < xs.size(); ++i) {
+                    if (xs[i].point() != expected[i].point()) ++failures;
+                }
+            }
+        }));
+    }
+    start = true;
+    for (unsigned t = 0; t < threads.size(); ++t) {
+        threads[t].join();
+    }
+    EXPECT_EQ(failures.load(), 0u);
+}
+#endif
+
+// compare an updated graph with one constructed from scratch
+static void expect_same_graph(PathIntersectionGraph &graph, PathVector const &a,
+                              PathVector const &b)
+{
+    PathIntersectionGraph full(a, b);
+    EXPECT_EQ(graph.valid(), full.valid());
+    EXPECT_EQ(graph.size(), full.size());
+    EXPECT_EQ(graph.intersectionPoints(), full.intersectionPoints());
+    EXPECT_EQ(graph.windingPoints(), full.windingPoints());
+    EXPECT_EQ(graph.getUnion(), full.getUnion());
+    EXPECT_EQ(graph.getIntersection(), full.getIntersection());
+    EXPECT_EQ(graph.getAminusB(), full.getAminusB());
+    EXPECT_EQ(graph.getBminusA(), full.getBminusA());
+    EXPECT_EQ(graph.getXOR(), full.getXOR());
+}
+
+TEST_F(IntersectionGraphTest, ReplacePaths) {
+    PathVector a, b;
+    for (unsigned i = 0; i < 6; ++i) {
+        for (unsigned j = 0; j < 6; ++j) {
+            a.push_back(bigh * Translate(12 * i, 16 * j));
+            b.push_back(rectangle * Rotate(0.1 * j + 0.05) * Translate(12 * i + 0.37, 16 * j + 0.61));
+        }
+    }
+    // paths without intersections, inside and outside of the other operand
+    a.push_back(smallrect * Translate(100, 0));
+    b.push_back(smallrect * Scale(0.1) * Translate(12.5, 17));
+
+    PathIntersectionGraph graph(a, b);
+    expect_same_graph(graph, a, b);
+
+    // move a path of A to a different place in the grid
+    a[7] *= Translate(12, 0.5);
+    graph.replacePath(0, 7, a[7]);
+    expect_same_graph(graph, a, b);
+
+    // move several paths of B, so that they cover other paths
+    std::vector<std::size_t> indices;
+    PathVector moved;
+    indices.push_back(3);
+    indices.push_back(20);
+    indices.push_back(36);
+    for (std::size_t k = 0; k < indices.size(); ++k) {
+        b[indices[k]] = bigrect * Translate(12 * k + 0.25, 16 * k + 0.25);
+        moved.push_back(b[indices[k]]);
+    }
+    graph.replacePaths(1, indices, moved);
+    expect_same_graph(graph, a, b);
+    checkRandomPoints(a, b, graph.getUnion(), UNION);
+    checkRandomPoints(a, b, graph.getAminusB(), A_MINUS_B);
+
+    // the path without intersections moves inside the other operand and back
+    a[36] = smallrect * Translate(15, 20);
+    graph.replacePath(0, 36, a[36]);
+    expect_same_graph(graph, a, b);
+    a[36] = smallrect * Translate(100, 0);
+    graph.replacePath(0, 36, a[36]);
+    expect_same_graph(graph, a, b);
+
+    // empty paths
+    a[0] = Path(Point(5, 5));
+    graph.replacePath(0, 0, a[0]);
+    expect_same_graph(graph, a, b);
+    a[0] = bigh;
+    graph.replacePath(0, 0, a[0]);
+    expect_same_graph(graph, a, b);
+    checkRandomPoints(a, b, graph.getIntersection(), INTERSECTION);
+
+    EXPECT_THROW(graph.replacePath(0, a.size(), bigh), RangeError);
+    EXPECT_THROW(graph.replacePath(2, 0, bigh), RangeError);
+    indices.assign(2, 1);
+    moved.resize(1);
+    EXPECT_THROW(graph.replacePaths(1, indices, moved), RangeError);
+    moved.push_back(bigh);
+    EXPECT_THROW(graph.replacePaths(1, indices, moved), RangeError);
+}
+
+TEST_F(IntersectionGraphTest, ExternalArena) {
+    PathVector a, b;
+    for (unsigned i = 0; i < 4; ++i) {
+        a.push_back(bigh * Translate(12 * i, 0));
+        b.push_back(rectangle * Rotate(0.1 * i + 0.05) * Translate(12 * i + 0.37, 0.61));
+    }
+    PathIntersectionGraph reference(a, b);
+
+    // the arena is reset between operations, so that its memory is reused
+    MonotonicArena arena;
+    std::size_t reserved = 0;
+    for (unsigned k = 0; k < 3; ++k) {
+        arena.reset();
+        {
+            PathIntersectionGraph graph(a, b, EPSILON, &arena);
+            EXPECT_EQ(graph.size(), reference.size());
+            EXPECT_EQ(graph.getUnion(), reference.getUnion());
+            EXPECT_EQ(graph.getIntersection(), reference.getIntersection());
+            // polygonal operands are handled by PolygonIntersectionGraph here
+            checkRandomPoints(a, b, boolean_operation(a, b, BOOLEAN_XOR, EPSILON, &arena), XOR);
+        }
+        EXPECT_GT(arena.bytesUsed(), 0u);
+        if (k > 0) {
+            EXPECT_EQ(arena.bytesReserved(), reserved);
+        }
+        reserved = arena.bytesReserved();
+    }
+
+    // rebuilding the graph allocates from the same arena
+    PathIntersectionGraph graph(a, b, EPSILON, &arena);
+    a[1] *= Translate(0.5, 1);
+    graph.replacePath(0, 1, a[1]);
+    expect_same_graph(graph, a, b);
+}
+
 // this test is disabled, since we cannot handle overlapping segments for now.
 #if 0
 TEST_F(IntersectionGraphTest, EqualUnionAndIntersection) {
@@ -181,3 +181,23 @@ TEST(LineTest, Intersection) {
     EXPECT_TRUE(a.intersect(lsb).empty());
     EXPECT_TRUE(b.intersect(lsa).empty());
 }
+
+TEST(LineTest, TouchingSegments) {
+    // segments sharing an endpoint, where the crossing time computed in floating point
+    // lies slightly outside of the unit interval
+    Point a0(0.5701775185624964, 0.6031515303082539);
+    Point a1(0.17159538584369952, 0.26510648255474234);
+    Point b0(0.4719851093701949, 0.09146155141827722);
+    LineSegment lsa(a0, a1), lsb(b0, a1);
+
+    std::vector<CurveIntersection> r = lsa.intersect(lsb);
+    ASSERT_EQ(r.size(), 1u);
+    EXPECT_EQ(r[0].first, 1);
+    EXPECT_EQ(r[0].second, 1);
+    EXPECT_TRUE(are_near(r[0].point(), a1, 1e-15));
+
+    OptCrossing c = intersection(lsa, lsb);
+    ASSERT_TRUE(c);
+    EXPECT_EQ(c->ta, 1);
+    EXPECT_EQ(c->tb, 1);
+}
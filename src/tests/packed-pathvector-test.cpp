@@ -0,0 +1,205 @@
+/** @file
+ * @brief Unit tests for PackedPathVector.
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include "testing.h"
+#include <iostream>
+
+#include <2geom/packed-pathvector.h>
+#include <2geom/pathvector.h>
+#include <2geom/svg-path-parser.h>
+#include <glib.h>
+
+using namespace std;
+using namespace Geom;
+
+class PackedPathVectorTest : public ::testing::Test {
+protected:
+    PackedPathVectorTest() {
+        shapes = parse_svg_path(
+            "M 0,0 L 10,0 10,10 0,10 z "
+            "M 2,2 Q 8,2 8,8 L 2,8 z "
+            "m 262.6037,35.824151 c 0,0 -92.64892,-187.405851 30,-149.999981 104.06976,31.739531 170,109.9999815 170,109.9999815 l -10,-59.9999905 c 0,0 40,79.99999 -40,79.99999 -80,0 -70,-129.999981 -70,-129.999981 l 50,0 C 435.13571,-131.5667 652.76275,126.44872 505.74322,108.05672 358.73876,89.666591 292.6037,-14.175849 292.6037,15.824151 c 0,30 -30,20 -30,20 z "
+            "M 0,0 a 5,10 45 0 1 10,10 a 5,10 45 0 1 -10,-10 z "
+            "M 100,100 H 120 V 130 C 90,140 80,110 100,100");
+        // a path with a higher-order Bezier, stored out of line
+        Path quartic(Point(50, 50));
+        std::vector<Point> pts;
+        pts.push_back(Point(50, 50));
+        pts.push_back(Point(80, 20));
+        pts.push_back(Point(110, 90));
+        pts.push_back(Point(60, 120));
+        pts.push_back(Point(40, 70));
+        quartic.append(BezierCurve::create(pts));
+        quartic.close();
+        shapes.push_back(quartic);
+        // an empty path
+        shapes.push_back(Path(Point(3, 4)));
+    }
+
+    void checkWinding(PathVector const &pv, PackedPathVector const &packed) {
+        OptRect bounds = pv.boundsFast();
+        ASSERT_TRUE(bounds);
+        g_random_set_seed(3456);
+        for (unsigned i = 0; i < 2000; ++i) {
+            Point p;
+            p[X] = g_random_double_range(bounds->left() - 5, bounds->right() + 5);
+            p[Y] = g_random_double_range(bounds->top() - 5, bounds->bottom() + 5);
+            EXPECT_EQ(pv.winding(p), packed.winding(p));
+        }
+        // points exactly on vertices and edges hit the degenerate cases
+        for (PathVector::const_iterator i = pv.begin(); i != pv.end(); ++i) {
+            for (Path::const_iterator j = i->begin(); j != i->end_closed(); ++j) {
+                Point p = j->initialPoint();
+                EXPECT_EQ(pv.winding(p), packed.winding(p));
+                p = j->pointAt(0.5);
+                EXPECT_EQ(pv.winding(p), packed.winding(p));
+            }
+        }
+    }
+
+    PathVector shapes;
+};
+
+TEST_F(PackedPathVectorTest, RoundTrip) {
+    PackedPathVector packed(shapes);
+    EXPECT_EQ(packed.size(), shapes.size());
+    EXPECT_EQ(packed.curveCount(PackedPathVector::OTHER_CURVE), 1u);
+    EXPECT_EQ(packed.curveCount(PackedPathVector::ELLIPTICAL_ARC), 2u);
+
+    PathVector back = packed.toPathVector();
+    ASSERT_EQ(back.size(), shapes.size());
+    for (unsigned i = 0; i < shapes.size(); ++i) {
+        EXPECT_EQ(back[i], shapes[i]);
+        EXPECT_EQ(back[i].closed(), shapes[i].closed());
+    }
+}
+
+TEST_F(PackedPathVectorTest, Views) {
+    PackedPathVector packed(shapes);
+    for (unsigned i = 0; i < shapes.size(); ++i) {
+        PackedPathVector::PathView view = packed[i];
+        Path const &path = shapes[i];
+        EXPECT_EQ(view.size(), path.size());
+        EXPECT_EQ(view.size_open(), path.size_open());
+        EXPECT_EQ(view.size_closed(), path.size_closed());
+        EXPECT_EQ(view.closed(), path.closed());
+        EXPECT_EQ(view.initialPoint(), path.initialPoint());
+        EXPECT_EQ(view.finalPoint(), path.finalPoint());
+        EXPECT_EQ(view.boundsFast(), path.boundsFast());
+
+        Path::const_iterator j = path.begin();
+        for (PackedPathVector::CurveIterator k = view.begin(); k != view.end(); ++k, ++j) {
+            EXPECT_EQ(*k, *j);
+        }
+        EXPECT_TRUE(j == path.end());
+    }
+}
+
+TEST_F(PackedPathVectorTest, Bounds) {
+    PackedPathVector packed(shapes);
+    EXPECT_EQ(packed.boundsFast(), shapes.boundsFast());
+
+    OptRect exact = packed.boundsExact(), expected = shapes.boundsExact();
+    ASSERT_TRUE(exact);
+    ASSERT_TRUE(expected);
+    for (unsigned i = 0; i < 4; ++i) {
+        EXPECT_FLOAT_EQ(exact->corner(i)[X], expected->corner(i)[X]);
+        EXPECT_FLOAT_EQ(exact->corner(i)[Y], expected->corner(i)[Y]);
+    }
+}
+
+TEST_F(PackedPathVectorTest, Winding) {
+    PackedPathVector packed(shapes);
+    checkWinding(shapes, packed);
+}
+
+TEST_F(PackedPathVectorTest, Transform) {
+    Affine m = Rotate(0.3) * Scale(1.5, 0.75) * Translate(12, -7);
+    PackedPathVector packed(shapes);
+    packed *= m;
+    PathVector transformed = shapes * m;
+    EXPECT_EQ(packed.boundsFast(), transformed.boundsFast());
+    checkWinding(transformed, packed);
+
+    packed *= Translate(-3, 5);
+    transformed *= Translate(-3, 5);
+    checkWinding(transformed, packed);
+
+    // the bounds of paths without arcs are transformed without recomputing them
+    packed *= Scale(-2, 0.5) * Translate(1, 1);
+    transformed *= Scale(-2, 0.5) * Translate(1, 1);
+    for (unsigned i = 0; i < packed.size(); ++i) {
+        EXPECT_EQ(packed[i].boundsFast(), transformed[i].boundsFast());
+    }
+    EXPECT_EQ(packed.toPathVector(), transformed);
+}
+
+TEST_F(PackedPathVectorTest, Builder) {
+    // PathSink has no method for higher-order Beziers, so leave out the quartic
+    PathVector fed = shapes;
+    fed.erase(fed.end() - 2);
+
+    PackedPathBuilder builder;
+    builder.feed(fed);
+    PathVector result = builder.peek().toPathVector();
+    ASSERT_EQ(result.size(), fed.size());
+    for (unsigned i = 0; i < fed.size(); ++i) {
+        EXPECT_EQ(result[i], fed[i]);
+        EXPECT_EQ(result[i].closed(), fed[i].closed());
+    }
+
+    // feeding the packed data produces the same paths as feeding the original
+    PathBuilder pb;
+    builder.peek().feed(pb);
+    PathBuilder expected;
+    expected.feed(fed);
+    EXPECT_EQ(pb.peek(), expected.peek());
+
+    // closing removes a final line segment ending at the initial point
+    PackedPathBuilder closing;
+    closing.moveTo(Point(0, 0));
+    closing.lineTo(Point(1, 0));
+    closing.lineTo(Point(1, 1));
+    closing.lineTo(Point(0, 0));
+    closing.closePath();
+    EXPECT_EQ(closing.peek()[0].size_open(), 2u);
+    EXPECT_EQ(closing.peek()[0].size(), 3u);
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,184 @@
+/** @file
+ * @brief Unit tests for PathFlattener.
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include "testing.h"
+#include <vector>
+
+#include <2geom/path-flattener.h>
+#include <2geom/path.h>
+#include <2geom/pathvector.h>
+#include <2geom/sbasis-curve.h>
+#include <2geom/svg-path-parser.h>
+#include <glib.h>
+
+using namespace Geom;
+
+// distance from a point to the nearest segment of a polyline
+static Coord polyline_distance(Point const &p, std::vector<Point> const &pts)
+{
+    Coord result = infinity();
+    for (std::size_t i = 0; i + 1 < pts.size(); ++i) {
+        LineSegment seg(pts[i], pts[i+1]);
+        result = std::min(result, distance(p, seg.pointAt(seg.nearestTime(p))));
+    }
+    return result;
+}
+
+// check that the polyline stays within the tolerance of the curve
+static void expect_within_tolerance(Curve const &c, Coord tolerance)
+{
+    PathFlattener flattener(tolerance);
+    std::vector<Point> pts(1, c.initialPoint());
+    flattener.flatten(c, pts);
+    EXPECT_EQ(pts.size(), flattener.segmentCount(c) + 1);
+    EXPECT_EQ(pts.back(), c.finalPoint());
+
+    for (unsigned i = 0; i <= 1000; ++i) {
+        Point p = c.pointAt(i / 1000.);
+        EXPECT_LE(polyline_distance(p, pts), tolerance * (1 + 1e-9)) << i;
+    }
+}
+
+class PathFlattenerTest : public ::testing::Test {
+protected:
+    PathFlattenerTest() {
+        shapes = parse_svg_path(
+            "M 0,0 L 10,0 10,10 0,10 z "
+            "M 2,2 Q 8,2 8,8 L 2,8 z "
+            "M 10,10 C 100,-50 -50,100 60,60 S 10,90 0,60 "
+            "M 0,0 a 5,10 45 0 1 10,10 a 5,10 45 0 1 -10,-10 z "
+            "M 100,100 A 40,20 0 1 0 150,120");
+    }
+    PathVector shapes;
+};
+
+TEST_F(PathFlattenerTest, Tolerance)
+{
+    Coord tolerances[] = { 1, 0.1, 0.01, 0.001 };
+    for (unsigned t = 0; t < 4; ++t) {
+        for (std::size_t i = 0; i < shapes.size(); ++i) {
+            for (std::size_t j = 0; j < shapes[i].size_default(); ++j) {
+                expect_within_tolerance(shapes[i][j], tolerances[t]);
+            }
+        }
+    }
+}
+
+TEST_F(PathFlattenerTest, RandomBeziers)
+{
+    g_random_set_seed(1234);
+    for (unsigned i = 0; i < 50; ++i) {
+        std::vector<Point> pts;
+        unsigned order = g_random_int_range(2, 6);
+        for (unsigned k = 0; k <= order; ++k) {
+            pts.push_back(Point(g_random_double_range(-100, 100),
+                                g_random_double_range(-100, 100)));
+        }
+        BezierCurve *c = BezierCurve::create(pts);
+        expect_within_tolerance(*c, 0.05);
+        delete c;
+    }
+}
+
+TEST_F(PathFlattenerTest, OtherCurves)
+{
+    // curves without a specialized implementation use the S-basis representation
+    SBasisCurve sb(CubicBezier(Point(0, 0), Point(30, 50), Point(70, -50), Point(100, 0)).toSBasis());
+    expect_within_tolerance(sb, 0.1);
+    expect_within_tolerance(sb, 0.01);
+}
+
+TEST_F(PathFlattenerTest, SegmentCounts)
+{
+    PathFlattener flattener(0.1);
+    EXPECT_EQ(flattener.segmentCount(LineSegment(Point(0, 0), Point(100, 100))), 1u);
+    // degenerate quadratic with the control point on the chord midpoint
+    EXPECT_EQ(flattener.segmentCount(QuadraticBezier(Point(0, 0), Point(5, 5), Point(10, 10))), 1u);
+
+    // halving the tolerance increases the count by about sqrt(2)
+    CubicBezier c(Point(0, 0), Point(0, 100), Point(100, 100), Point(100, 0));
+    unsigned n1 = flattener.segmentCount(c);
+    flattener.setTolerance(0.025);
+    unsigned n2 = flattener.segmentCount(c);
+    EXPECT_GE(n2, 2 * n1 - 1);
+    EXPECT_LE(n2, 2 * n1 + 1);
+}
+
+TEST_F(PathFlattenerTest, Paths)
+{
+    PathFlattener flattener(0.5);
+    std::vector<Point> pts;
+    std::vector<std::size_t> ends;
+    flattener.flatten(shapes, pts, ends);
+    ASSERT_EQ(ends.size(), shapes.size());
+    EXPECT_EQ(ends.back(), pts.size());
+
+    std::size_t start = 0;
+    for (std::size_t i = 0; i < shapes.size(); ++i) {
+        std::size_t expected = 1;
+        for (std::size_t j = 0; j < shapes[i].size_default(); ++j) {
+            expected += flattener.segmentCount(shapes[i][j]);
+        }
+        EXPECT_EQ(ends[i] - start, expected);
+        EXPECT_EQ(pts[start], shapes[i].initialPoint());
+        EXPECT_EQ(pts[ends[i] - 1], shapes[i].finalPoint());
+        if (shapes[i].closed()) {
+            EXPECT_EQ(pts[ends[i] - 1], pts[start]);
+        }
+        start = ends[i];
+    }
+    // the rectangle
+    EXPECT_EQ(ends[0], 5u);
+
+    // reusing the buffer gives the same result without reallocating
+    std::vector<Point> first = pts;
+    Point const *data = &pts[0];
+    pts.clear();
+    ends.clear();
+    flattener.flatten(shapes, pts, ends);
+    EXPECT_EQ(pts, first);
+    EXPECT_EQ(&pts[0], data);
+
+    // single path
+    pts.clear();
+    flattener.flatten(shapes[1], pts);
+    EXPECT_EQ(pts.size(), ends[1] - ends[0]);
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
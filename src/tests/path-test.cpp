@@ -1,7 +1,11 @@
 #include "testing.h"
+#include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 
 #include <2geom/bezier.h>
+#include <2geom/monotone-decomposition.h>
 #include <2geom/path.h>
 #include <2geom/pathvector.h>
 #include <2geom/path-intersection.h>
@@ -9,6 +13,11 @@
 #include <2geom/svg-path-writer.h>
 #include <vector>
 #include <iterator>
+#include <glib.h>
+#if __cplusplus >= 201103L
+#include <atomic>
+#include <thread>
+#endif
 
 using namespace std;
 using namespace Geom;
@@ -238,6 +247,26 @@ TEST_F(PathTest, NearestPoint) {
          << distance(diederik.pointAt(diederik.nearestTime(p)), p) << "  "
          << distance(diederik.pointAt(6.5814033), p) << endl;*/
 
+    // the cached monotone decomposition does not change the result, also for points
+    // on the extrema of the curves, which lie on the edges of the pieces' bounds
+    g_random_set_seed(2345);
+    Path shapes[] = { diederik, cmds, square };
+    for (unsigned i = 0; i < sizeof(shapes) / sizeof(shapes[0]); ++i) {
+        Path cached = shapes[i];
+        cached.monotoneDecomposition();
+        for (unsigned j = 0; j < 200; ++j) {
+            Path fresh(cached.begin(), cached.end_open(), cached.closed());
+            Point q = cached.pointAt(cached.size_default() * j / 200.);
+            if (j % 2) {
+                q += Point(g_random_double_range(-1, 1), g_random_double_range(-1, 1));
+            }
+            Coord dcached, dfresh;
+            PathTime tc = cached.nearestTime(q, &dcached);
+            PathTime tf = fresh.nearestTime(q, &dfresh);
+            EXPECT_EQ(tc, tf) << q;
+            EXPECT_EQ(dcached, dfresh);
+        }
+    }
 }
 
 TEST_F(PathTest, Winding) {
@@ -304,6 +333,93 @@ TEST_F(PathTest, Winding) {
     EXPECT_EQ(hump2.winding(Point(1.75, 1.5)), 1);
 }
 
+TEST_F(PathTest, WindingBatch) {
+    Path paths[] = { square, circle, arcs, diederik, cmds, p_open,
+        string_to_path("M 0,0 A 40 20 90 0 0 0,-80 L -20,-40 z"),
+        string_to_path("M 0,0 Q 1,1 2,0 L 2,2 0,2 Z"),
+        string_to_path("M 0,0 L 2,0 2,2 Q 1,1 0,2 Z") };
+    PathVector all;
+
+    for (unsigned i = 0; i < sizeof(paths) / sizeof(paths[0]); ++i) {
+        Path const &path = paths[i];
+        all.push_back(path);
+
+        // a grid of points which avoids the vertices of the test paths
+        Rect bounds = *path.boundsFast();
+        bounds.expandBy(bounds.width() / 10, bounds.height() / 10);
+        std::vector<Point> points;
+        for (unsigned x = 0; x < 50; ++x) {
+            for (unsigned y = 0; y < 50; ++y) {
+                points.push_back(bounds.min() + Point(bounds.width() * (x + 0.0123) / 50,
+                                                      bounds.height() * (y + 0.0456) / 50));
+            }
+        }
+
+        std::vector<int> result;
+        path.winding(points, result);
+        ASSERT_EQ(result.size(), points.size());
+        for (unsigned j = 0; j < points.size(); ++j) {
+            EXPECT_EQ(result[j], path.winding(points[j]));
+        }
+    }
+
+    std::vector<Point> points;
+    points.push_back(Point(0.5, 0.7));
+    points.push_back(Point(-4.5, 1));
+    points.push_back(Point(250, 30));
+    points.push_back(Point(1.75, 0.5));
+    points.push_back(Point(1e6, 1e6));
+    std::vector<int> result;
+    all.winding(points, result);
+    ASSERT_EQ(result.size(), points.size());
+    for (unsigned j = 0; j < points.size(); ++j) {
+        EXPECT_EQ(result[j], all.winding(points[j]));
+    }
+
+    // empty input
+    points.clear();
+    all.winding(points, result);
+    EXPECT_TRUE(result.empty());
+
+    // generic Bezier curves of order 1 are line segments
+    Path generic(Point(0, 0));
+    generic.append(BezierCurve(D2<Bezier>(Bezier(0., 10.), Bezier(0., 0.))));
+    generic.append(BezierCurve(D2<Bezier>(Bezier(10., 0.), Bezier(0., 10.))));
+    generic.close();
+    for (unsigned x = 0; x < 12; ++x) {
+        for (unsigned y = 0; y < 12; ++y) {
+            points.push_back(Point(x - 0.5, y - 0.25));
+        }
+    }
+    generic.winding(points, result);
+    ASSERT_EQ(result.size(), points.size());
+    for (unsigned j = 0; j < points.size(); ++j) {
+        Point const &p = points[j];
+        int expected = (p[X] > 0 && p[Y] > 0 && p[X] + p[Y] < 10) ? 1 : 0;
+        EXPECT_EQ(generic.winding(p), expected);
+        EXPECT_EQ(result[j], expected) << p;
+    }
+
+    // points within rounding error of a line segment
+    Path thin = string_to_path("M 0.1,0.3 L 10.7,7.9 L 0.3,7.7 Z");
+    points.clear();
+    for (unsigned i = 1; i < 500; ++i) {
+        Point p = lerp(i / 500., Point(0.1, 0.3), Point(10.7, 7.9));
+        for (int k = -2; k <= 2; ++k) {
+            Coord x = p[X];
+            for (int n = 0; n < std::abs(k); ++n) {
+                x = std::nextafter(x, k < 0 ? -1e10 : 1e10);
+            }
+            points.push_back(Point(x, p[Y]));
+        }
+    }
+    thin.winding(points, result);
+    ASSERT_EQ(result.size(), points.size());
+    for (unsigned j = 0; j < points.size(); ++j) {
+        EXPECT_EQ(result[j], thin.winding(points[j])) << points[j];
+    }
+}
+
 TEST_F(PathTest, SVGRoundtrip) {
     SVGPathWriter sw;
 
@@ -357,6 +473,28 @@ TEST_F(PathTest, SVGRoundtrip) {
     }
 }
 
+TEST_F(PathTest, SVGWriterOutputString) {
+    std::string out = "<path d=\"";
+    SVGPathWriter sw(out);
+    sw.feed(square);
+    std::string data = sw.str();
+    EXPECT_EQ(out, "<path d=\"" + data);
+    EXPECT_EQ(data, write_svg_path(PathVector(square)));
+    EXPECT_TRUE(string_to_path(data.c_str()) == square);
+
+    sw.clear();
+    EXPECT_EQ(out, "<path d=\"");
+    EXPECT_EQ(sw.str(), "");
+
+    // fixed precision gives the same output as iostreams
+    sw.setPrecision(4);
+    sw.feed(diederik);
+    std::ostringstream os;
+    os.imbue(std::locale::classic());
+    os << std::setprecision(4) << diederik.initialPoint()[X];
+    EXPECT_EQ(sw.str().substr(2, os.str().size()), os.str());
+}
+
 TEST_F(PathTest, Portion) {
     PathTime a(0, 0.5), b(3, 0.5);
     PathTime c(1, 0.25), d(1, 0.75);
@@ -495,6 +633,405 @@ TEST_F(PathTest, Roots) {
     EXPECT_EQ(roots.size(), 2);
 }
 
+TEST_F(PathTest, IntersectAppend) {
+    Path shapes[4] = { diederik * Scale(0.05), circle * Translate(10, 3), arcs, cmds * Scale(0.05) };
+    std::vector<PathIntersection> out;
+    PathIntersection sentinel(PathTime(7, 0.5), PathTime(8, 0.5), Point(1, 2));
+    for (unsigned i = 0; i < 4; ++i) {
+        for (unsigned j = 0; j < 4; ++j) {
+            if (i == j) continue;
+            // the appended intersections are the same as the returned ones
+            std::vector<PathIntersection> xs = shapes[i].intersect(shapes[j]);
+            out.assign(1, sentinel);
+            shapes[i].intersect(shapes[j], out);
+            ASSERT_EQ(out.size(), xs.size() + 1);
+            EXPECT_EQ(out[0], sentinel);
+            EXPECT_TRUE(std::equal(xs.begin(), xs.end(), out.begin() + 1));
+
+            // same for each pair of curves
+            for (std::size_t ci = 0; ci < shapes[i].size(); ++ci) {
+                for (std::size_t cj = 0; cj < shapes[j].size(); ++cj) {
+                    std::vector<CurveIntersection> cx = shapes[i][ci].intersect(shapes[j][cj]);
+                    std::vector<CurveIntersection> cout(2, CurveIntersection(0.5, 0.5, Point()));
+                    shapes[i][ci].intersect(shapes[j][cj], cout);
+                    ASSERT_EQ(cout.size(), cx.size() + 2);
+                    EXPECT_TRUE(std::equal(cx.begin(), cx.end(), cout.begin() + 2));
+                }
+            }
+        }
+    }
+
+    PathVector a, b;
+    for (unsigned i = 0; i < 4; ++i) {
+        (i % 2 ? b : a).push_back(shapes[i]);
+    }
+    std::vector<PVIntersection> pvx = a.intersect(b);
+    EXPECT_FALSE(pvx.empty());
+    std::vector<PVIntersection> pvout(1, PVIntersection(PathVectorTime(), PathVectorTime(), Point()));
+    a.intersect(b, pvout);
+    ASSERT_EQ(pvout.size(), pvx.size() + 1);
+    EXPECT_TRUE(std::equal(pvx.begin(), pvx.end(), pvout.begin() + 1));
+}
+
+TEST_F(PathTest, IntersectionQueries) {
+    Path shapes[6] = { diederik * Scale(0.05), circle * Translate(10, 3), arcs, cmds * Scale(0.05),
+                       square * Translate(100, 100), string_to_path("M 0,0 L 12,12 0,12 12,0") };
+    for (unsigned i = 0; i < 6; ++i) {
+        for (unsigned j = 0; j < 6; ++j) {
+            if (i == j) continue;
+            std::vector<PathIntersection> xs = shapes[i].intersect(shapes[j]);
+            EXPECT_EQ(shapes[i].intersects(shapes[j]), !xs.empty()) << i << " " << j;
+            boost::optional<PathIntersection> first = shapes[i].firstIntersection(shapes[j]);
+            ASSERT_EQ(bool(first), !xs.empty()) << i << " " << j;
+            if (first) {
+                EXPECT_EQ(*first, xs.front()) << i << " " << j;
+            }
+        }
+    }
+
+    // the first intersection is taken along the first path, not the second one
+    Path zigzag = string_to_path("M 0,0 L 10,0 10,10 0,10 0,20 10,20");
+    Path cross = string_to_path("M 5,25 L 5,-5");
+    boost::optional<PathIntersection> zx = zigzag.firstIntersection(cross);
+    ASSERT_TRUE(zx);
+    EXPECT_EQ(zx->first.curve_index, 0u);
+    EXPECT_TRUE(are_near(zx->point(), Point(5, 0)));
+    zx = cross.firstIntersection(zigzag);
+    ASSERT_TRUE(zx);
+    EXPECT_TRUE(are_near(zx->point(), Point(5, 20)));
+    EXPECT_FALSE(Path().intersects(zigzag));
+    EXPECT_FALSE(zigzag.firstIntersection(Path()));
+
+    PathVector a, b;
+    for (unsigned i = 0; i < 6; ++i) {
+        (i % 2 ? b : a).push_back(shapes[i]);
+    }
+    std::vector<PVIntersection> pvx = a.intersect(b);
+    ASSERT_FALSE(pvx.empty());
+    EXPECT_TRUE(a.intersects(b));
+    boost::optional<PVIntersection> pvfirst = a.firstIntersection(b);
+    ASSERT_TRUE(pvfirst);
+    EXPECT_EQ(*pvfirst, pvx.front());
+    pvfirst = b.firstIntersection(a);
+    ASSERT_TRUE(pvfirst);
+    EXPECT_EQ(*pvfirst, b.intersect(a).front());
+
+    PathVector far = a * Translate(1000, 1000);
+    EXPECT_FALSE(far.intersects(b));
+    EXPECT_FALSE(far.firstIntersection(b));
+    EXPECT_FALSE(PathVector().intersects(b));
+}
+
+TEST_F(PathTest, MonotoneDecomposition) {
+    Path const *paths[] = { &line, &square, &circle, &arcs, &diederik, &cmds, &p_open };
+    for (unsigned k = 0; k < 7; ++k) {
+        Path const &path = *paths[k];
+        MonotoneDecomposition const &md = path.monotoneDecomposition();
+        ASSERT_EQ(md.size(), path.size_closed());
+        for (std::size_t i = 0; i < md.size(); ++i) {
+            ASSERT_TRUE(md.begin(i) != md.end(i));
+            EXPECT_EQ(md.begin(i)->t0, 0);
+            EXPECT_EQ((md.end(i) - 1)->t1, 1);
+            for (MonotoneDecomposition::const_iterator j = md.begin(i); j != md.end(i); ++j) {
+                if (j != md.begin(i)) {
+                    EXPECT_EQ(j->t0, (j - 1)->t1);
+                }
+                // the points within a piece lie in its bounds, in a monotonic order
+                Rect bounds = j->bounds();
+                bounds.expandBy(1e-6);
+                Point prev = j->p0;
+                for (unsigned s = 1; s <= 8; ++s) {
+                    Point pt = path[i].pointAt(lerp(s / 8., j->t0, j->t1));
+                    EXPECT_TRUE(bounds.contains(pt));
+                    for (unsigned d = 0; d < 2; ++d) {
+                        EXPECT_GE((pt[d] - prev[d]) * (j->p1[d] - j->p0[d]), -1e-6);
+                    }
+                    prev = pt;
+                }
+            }
+        }
+    }
+
+    // the decomposition is cached and shared between copies
+    Path copy = diederik;
+    EXPECT_EQ(&diederik.monotoneDecomposition(), &diederik.monotoneDecomposition());
+    EXPECT_EQ(&copy.monotoneDecomposition(), &diederik.monotoneDecomposition());
+
+    // modifications invalidate it
+    copy *= Translate(5, 0);
+    MonotoneDecomposition const &moved = copy.monotoneDecomposition();
+    MonotoneDecomposition const &orig = diederik.monotoneDecomposition();
+    ASSERT_EQ(moved.pieceCount(), orig.pieceCount());
+    EXPECT_TRUE(are_near(moved.begin(0)->p1, orig.begin(0)->p1 + Point(5, 0)));
+    copy.setStitching(true);
+    copy.erase_last();
+    EXPECT_EQ(copy.monotoneDecomposition().size(), copy.size_closed());
+
+    // a moveto-only path does not share its starting point with copies
+    Path moveto(Point(1, 1));
+    Path moved_start = moveto;
+    moved_start.start(Point(2, 2));
+    EXPECT_EQ(moveto.initialPoint(), Point(1, 1));
+}
+
+TEST_F(PathTest, WindingUsesDecomposition) {
+    Path const *paths[] = { &circle, &arcs, &diederik, &cmds };
+    g_random_set_seed(4321);
+    for (unsigned k = 0; k < 4; ++k) {
+        Path const &path = *paths[k];
+        Rect box = *path.boundsFast();
+        for (unsigned i = 0; i < 500; ++i) {
+            Point p(g_random_double_range(box.left(), box.right()),
+                    g_random_double_range(box.top(), box.bottom()));
+            // solve every curve whose bounding box contains the point
+            int expected = 0;
+            for (Path::const_iterator c = path.begin(); c != path.end_closed(); ++c) {
+                Rect cb = c->boundsFast();
+                if (cb.height() == 0 || p[X] > cb.right() || !cb[Y].lowerContains(p[Y])) continue;
+                if (p[X] >= cb.left()) {
+                    expected += c->winding(p);
+                } else if (Interval(c->initialPoint()[Y], c->finalPoint()[Y]).lowerContains(p[Y])) {
+                    expected += c->initialPoint()[Y] < c->finalPoint()[Y] ? 1 : -1;
+                }
+            }
+            EXPECT_EQ(path.winding(p), expected) << k << " " << p;
+        }
+    }
+}
+
+// intersect all pairs of curves, skipping the points where the path joins them;
+// Curve::intersectSelf() is not used, since it reports spurious points at cusps
+static std::vector<Point> brute_force_self_intersections(Path const &path) {
+    std::vector<Point> result;
+    std::size_t n = path.size_default();
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = i + 1; j < n; ++j) {
+            std::vector<CurveIntersection> xs = path[i].intersect(path[j]);
+            for (std::size_t k = 0; k < xs.size(); ++k) {
+                if (j == i + 1 && are_near(xs[k].point(), path[i].finalPoint(), 1e-3)) continue;
+                if (path.closed() && i == 0 && j == n - 1
+                    && are_near(xs[k].point(), path.initialPoint(), 1e-3)) continue;
+                result.push_back(xs[k].point());
+            }
+        }
+    }
+    return result;
+}
+
+// intersections between different curves
+static std::vector<PathIntersection> curve_pair_intersections(std::vector<PathIntersection> const &xs) {
+    std::vector<PathIntersection> result;
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        if (xs[i].first.curve_index != xs[i].second.curve_index) {
+            result.push_back(xs[i]);
+        }
+    }
+    return result;
+}
+
+static void expect_same_points(std::vector<PathIntersection> const &xs,
+                               std::vector<Point> const &expected, Coord eps)
+{
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        bool found = false;
+        for (std::size_t j = 0; j < expected.size() && !found; ++j) {
+            found = are_near(xs[i].point(), expected[j], eps);
+        }
+        EXPECT_TRUE(found) << xs[i].point();
+    }
+    for (std::size_t j = 0; j < expected.size(); ++j) {
+        bool found = false;
+        for (std::size_t i = 0; i < xs.size() && !found; ++i) {
+            found = are_near(xs[i].point(), expected[j], eps);
+        }
+        EXPECT_TRUE(found) << expected[j];
+    }
+}
+
+TEST_F(PathTest, SelfIntersection) {
+    Path eight = string_to_path("M 0,0 L 10,10 10,0 0,10 Z");
+    std::vector<PathIntersection> xs = eight.intersectSelf();
+    ASSERT_EQ(xs.size(), 1u);
+    EXPECT_TRUE(are_near(xs[0].point(), Point(5, 5)));
+    EXPECT_EQ(xs[0].first, PathTime(0, 0.5));
+    EXPECT_EQ(xs[0].second, PathTime(2, 0.5));
+    EXPECT_EQ(self_crossings(eight).size(), 1u);
+
+    Path star = string_to_path("M 5,-1 L 8,11 -1,3 11,3 2,11 Z");
+    xs = star.intersectSelf();
+    EXPECT_EQ(xs.size(), 5u);
+    EXPECT_EQ(self_crossings(star).size(), 5u);
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        EXPECT_LT(xs[i].first, xs[i].second);
+        EXPECT_TRUE(are_near(star.pointAt(xs[i].first), xs[i].point(), 1e-6));
+        EXPECT_TRUE(are_near(star.pointAt(xs[i].second), xs[i].point(), 1e-6));
+    }
+
+    // joints between curves, including the closing point, are not intersections
+    EXPECT_TRUE(square.intersectSelf().empty());
+    EXPECT_TRUE(circle.intersectSelf().empty());
+    EXPECT_TRUE(self_crossings(square).empty());
+    EXPECT_TRUE(self_crossings(circle).empty());
+
+    // open path, a vertical segment and a loop within a single curve
+    Path hook = string_to_path("M 0,0 L 10,0 10,10 5,10 5,-5");
+    xs = hook.intersectSelf();
+    ASSERT_EQ(xs.size(), 1u);
+    EXPECT_TRUE(are_near(xs[0].point(), Point(5, 0)));
+    Path loop = string_to_path("M 0,0 C 15,10 -5,10 10,0");
+    xs = loop.intersectSelf();
+    ASSERT_EQ(xs.size(), 1u);
+    EXPECT_TRUE(are_near(xs[0].point()[X], 5, 1e-6));
+    EXPECT_TRUE(are_near(xs[0].first.t + xs[0].second.t, 1, 1e-6));
+
+    // the end of an open path touching its middle
+    Path touch = string_to_path("M 0,0 L 10,0 10,10 5,0");
+    xs = touch.intersectSelf();
+    ASSERT_EQ(xs.size(), 1u);
+    EXPECT_EQ(xs[0].second, PathTime(2, 1));
+
+    Path const *paths[] = { &circle, &arcs, &diederik, &cmds };
+    for (unsigned k = 0; k < 4; ++k) {
+        expect_same_points(curve_pair_intersections(paths[k]->intersectSelf()),
+                           brute_force_self_intersections(*paths[k]), 1e-4);
+    }
+
+    // random scribbles
+    g_random_set_seed(1234);
+    for (unsigned k = 0; k < 10; ++k) {
+        Path polyline(Point(g_random_double_range(0, 100), g_random_double_range(0, 100)));
+        Path scribble(polyline.initialPoint());
+        for (unsigned i = 0; i < 60; ++i) {
+            Point p(g_random_double_range(0, 100), g_random_double_range(0, 100));
+            Point c1(g_random_double_range(0, 100), g_random_double_range(0, 100));
+            Point c2(g_random_double_range(0, 100), g_random_double_range(0, 100));
+            polyline.appendNew<LineSegment>(p);
+            scribble.appendNew<CubicBezier>(c1, c2, p);
+        }
+        if (k % 2) {
+            polyline.close();
+            scribble.close();
+        }
+        std::vector<Point> expected = brute_force_self_intersections(polyline);
+        xs = polyline.intersectSelf();
+        EXPECT_EQ(xs.size(), expected.size());
+        EXPECT_EQ(self_crossings(polyline).size(), expected.size());
+        expect_same_points(xs, expected, 1e-6);
+        expect_same_points(curve_pair_intersections(scribble.intersectSelf()),
+                           brute_force_self_intersections(scribble), 1e-4);
+    }
+}
+
+TEST_F(PathTest, CloseUnshares) {
+    Path path = string_to_path("M 0,0 L 5,0 5,5 0,0");
+    Path copy = path;
+    copy.close(true);
+    EXPECT_EQ(copy.size_open(), 2u);
+    EXPECT_EQ(path.size_open(), 3u);
+    EXPECT_EQ(path, string_to_path("M 0,0 L 5,0 5,5 0,0"));
+}
+
+TEST_F(PathTest, TransformCachedBounds) {
+    Path const *paths[] = { &diederik, &cmds, &square, &arcs };
+    Affine ms[] = { Translate(3, -4), Scale(-2, 0.5) * Translate(1, 1), Rotate(0.3) };
+    for (unsigned i = 0; i < 4; ++i) {
+        for (unsigned j = 0; j < 3; ++j) {
+            Path cached = *paths[i];
+            cached.boundsFast();
+            cached.boundsExact();
+            cached *= ms[j];
+
+            // a copy of the curves without cached values
+            Path fresh(paths[i]->begin(), paths[i]->end_open(), paths[i]->closed());
+            fresh *= ms[j];
+            EXPECT_EQ(cached.boundsFast(), fresh.boundsFast());
+
+            // transformed exact bounds can differ from recomputed ones by rounding errors
+            OptRect exact = cached.boundsExact(), fresh_exact = fresh.boundsExact();
+            ASSERT_TRUE(exact && fresh_exact);
+            EXPECT_TRUE(are_near(exact->min(), fresh_exact->min(), 1e-12 * fresh_exact->maxExtent()));
+            EXPECT_TRUE(are_near(exact->max(), fresh_exact->max(), 1e-12 * fresh_exact->maxExtent()));
+        }
+    }
+}
+
+TEST_F(PathTest, CachedBoundsInvalidation) {
+    Path path = string_to_path("M 0,0 1,0 1,1 0,1");
+    Path copy = path;
+    OptRect fast = path.boundsFast(), exact = path.boundsExact();
+    EXPECT_EQ(path.boundsExact(), exact);
+
+    path.appendNew<QuadraticBezier>(Point(20, 20), Point(0, 0));
+    EXPECT_NE(path.boundsFast(), fast);
+    EXPECT_NE(path.boundsExact(), exact);
+    EXPECT_EQ(path.boundsExact(), Path(path.begin(), path.end_open()).boundsExact());
+    EXPECT_EQ(copy.boundsFast(), fast);
+    EXPECT_EQ(copy.boundsExact(), exact);
+
+    path *= Rotate(0.5);
+    EXPECT_EQ(path.boundsExact(), Path(path.begin(), path.end_open()).boundsExact());
+
+    PathVector pv;
+    pv.push_back(path);
+    pv.push_back(copy);
+    OptRect pv_exact = pv.boundsExact();
+    EXPECT_EQ(pv_exact, path.boundsExact() | copy.boundsExact());
+    pv.back() *= Translate(100, 0);
+    EXPECT_EQ(pv.boundsExact(), path.boundsExact() | (copy * Translate(100, 0)).boundsExact());
+}
+
+#if __cplusplus >= 201103L
+// Paths sharing data are used from several threads. Run this under ThreadSanitizer
+// to check for data races in the reference counting and in the cached bounds.
+TEST_F(PathTest, ConcurrentSharedAccess) {
+    unsigned const count = 500, nthreads = 8;
+    Path const *bases[] = { &diederik, &cmds, &circle, &arcs };
+
+    // each path has its own data, so that its bounds are computed by the threads
+    std::vector<Path> paths;
+    std::vector<OptRect> expected, expected_exact;
+    std::vector<std::size_t> expected_pieces;
+    for (unsigned i = 0; i < count; ++i) {
+        Path p = *bases[i % 4] * Translate(i, 0);
+        paths.push_back(p);
+        p.setInitial(p.initialPoint()); // unshare before computing the bounds
+        expected.push_back(p.boundsFast());
+        expected_exact.push_back(Path(paths[i].begin(), paths[i].end_open()).boundsExact());
+        expected_pieces.push_back(MonotoneDecomposition(paths[i]).pieceCount());
+    }
+
+    std::atomic<bool> start(false);
+    std::atomic<unsigned> failures(0);
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < nthreads; ++t) {
+        threads.push_back(std::thread([&, t]() {
+            while (!start.load()) {}
+            for (unsigned j = 0; j < count; ++j) {
+                // visit the paths in different orders
+                unsigned i = (j * (2 * t + 1)) % count;
+                Path const &shared = paths[i];
+                if (shared.boundsFast() != expected[i]) ++failures;
+                if (shared.boundsExact() != expected_exact[i]) ++failures;
+                if (shared.monotoneDecomposition().pieceCount() != expected_pieces[i]) ++failures;
+
+                Path local = shared;
+                if (local.boundsFast() != expected[i]) ++failures;
+                local *= Translate(0, 1);
+                local.close(!local.closed());
+                if (!local.boundsFast()) ++failures;
+                if (shared.boundsFast() != expected[i]) ++failures;
+                if (shared.size_open() != bases[i % 4]->size_open()) ++failures;
+            }
+        }));
+    }
+    start = true;
+    for (unsigned t = 0; t < nthreads; ++t) {
+        threads[t].join();
+    }
+    EXPECT_EQ(failures.load(), 0u);
+}
+#endif
+
 /*
   Local Variables:
   mode:c++
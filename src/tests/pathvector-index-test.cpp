@@ -0,0 +1,163 @@
+/** @file
+ * @brief Unit tests for PathVectorIndex.
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include "testing.h"
+#include <algorithm>
+#include <iostream>
+
+#include <2geom/pathvector-index.h>
+#include <2geom/svg-path-parser.h>
+#include <glib.h>
+
+using namespace std;
+using namespace Geom;
+
+class PathVectorIndexTest : public ::testing::Test {
+protected:
+    PathVectorIndexTest() {
+        shapes = parse_svg_path(
+            "M 0,0 L 10,0 10,10 0,10 z "
+            "M 2,2 Q 8,2 8,8 L 2,8 z "
+            "m 262.6037,35.824151 c 0,0 -92.64892,-187.405851 30,-149.999981 104.06976,31.739531 170,109.9999815 170,109.9999815 l -10,-59.9999905 c 0,0 40,79.99999 -40,79.99999 -80,0 -70,-129.999981 -70,-129.999981 l 50,0 C 435.13571,-131.5667 652.76275,126.44872 505.74322,108.05672 358.73876,89.666591 292.6037,-14.175849 292.6037,15.824151 c 0,30 -30,20 -30,20 z "
+            "M 0,0 a 5,10 45 0 1 10,10 a 5,10 45 0 1 -10,-10 z "
+            "M 100,100 H 120 V 130 C 90,140 80,110 100,100 "
+            "M 150,20 L 200,40 170,80");
+        // an empty path
+        shapes.push_back(Path(Point(3, 4)));
+
+        // many small paths, so that the tree has some depth
+        g_random_set_seed(1234);
+        for (unsigned i = 0; i < 200; ++i) {
+            Point origin(g_random_double_range(-100, 500), g_random_double_range(-200, 200));
+            Path p(origin);
+            p.appendNew<LineSegment>(origin + Point(g_random_double_range(0, 20), 0));
+            p.appendNew<CubicBezier>(origin + Point(g_random_double_range(0, 30), 10),
+                                     origin + Point(5, g_random_double_range(10, 20)),
+                                     origin + Point(g_random_double_range(-5, 5), 15));
+            p.close(i % 2 == 0);
+            shapes.push_back(p);
+        }
+    }
+
+    std::vector<Point> testPoints(PathVector const &pv) {
+        std::vector<Point> points;
+        OptRect bounds = pv.boundsFast();
+        g_random_set_seed(3456);
+        for (unsigned i = 0; i < 2000; ++i) {
+            points.push_back(Point(g_random_double_range(bounds->left() - 5, bounds->right() + 5),
+                                   g_random_double_range(bounds->top() - 5, bounds->bottom() + 5)));
+        }
+        // points exactly on vertices and edges hit the degenerate cases
+        for (PathVector::const_iterator i = pv.begin(); i != pv.end(); ++i) {
+            for (Path::const_iterator j = i->begin(); j != i->end_closed(); ++j) {
+                points.push_back(j->initialPoint());
+                points.push_back(j->pointAt(0.5));
+            }
+        }
+        return points;
+    }
+
+    PathVector shapes;
+};
+
+TEST_F(PathVectorIndexTest, Empty) {
+    PathVectorIndex index((PathVector()));
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_FALSE(index.bounds());
+    EXPECT_EQ(index.winding(Point(1, 1)), 0);
+    EXPECT_FALSE(index.nearestTime(Point(1, 1)));
+    EXPECT_TRUE(index.overlappingCurves(Rect(0, 0, 10, 10)).empty());
+}
+
+TEST_F(PathVectorIndexTest, Winding) {
+    std::vector<Point> points = testPoints(shapes);
+    for (unsigned leaf_size = 1; leaf_size <= 16; leaf_size *= 4) {
+        PathVectorIndex index(shapes, leaf_size);
+        for (unsigned i = 0; i < points.size(); ++i) {
+            int w = shapes.winding(points[i]);
+            EXPECT_EQ(index.winding(points[i]), w);
+            EXPECT_EQ(index.contains(points[i]), w != 0);
+            EXPECT_EQ(index.contains(points[i], FILL_EVENODD), w % 2 != 0);
+        }
+    }
+}
+
+TEST_F(PathVectorIndexTest, NearestTime) {
+    // EllipticalArc::nearestTime() crashes on some of the test points, so leave out the arcs
+    PathVector curves = shapes;
+    curves.erase(curves.begin() + 3);
+
+    PathVectorIndex index(curves);
+    std::vector<Point> points = testPoints(curves);
+    for (unsigned i = 0; i < points.size(); ++i) {
+        Coord d1, d2;
+        boost::optional<PathVectorTime> t1 = curves.nearestTime(points[i], &d1);
+        boost::optional<PathVectorTime> t2 = index.nearestTime(points[i], &d2);
+        ASSERT_TRUE(t1);
+        ASSERT_TRUE(t2);
+        EXPECT_EQ(d1, d2);
+        EXPECT_EQ(*t1, *t2);
+    }
+}
+
+TEST_F(PathVectorIndexTest, Overlap) {
+    PathVectorIndex index(shapes);
+    g_random_set_seed(5678);
+    for (unsigned n = 0; n < 200; ++n) {
+        Point a(g_random_double_range(-100, 500), g_random_double_range(-200, 200));
+        Rect r(a, a + Point(g_random_double_range(0, 80), g_random_double_range(0, 80)));
+
+        std::vector<PathVectorIndex::CurveRef> curves;
+        std::vector<PathVectorIndex::size_type> paths;
+        for (unsigned i = 0; i < shapes.size(); ++i) {
+            for (unsigned j = 0; j < shapes[i].size_default(); ++j) {
+                if (shapes[i][j].boundsFast().intersects(r)) {
+                    curves.push_back(PathVectorIndex::CurveRef(i, j));
+                    if (paths.empty() || paths.back() != i) {
+                        paths.push_back(i);
+                    }
+                }
+            }
+        }
+        EXPECT_TRUE(index.overlappingCurves(r) == curves);
+        EXPECT_TRUE(index.overlappingPaths(r) == paths);
+    }
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
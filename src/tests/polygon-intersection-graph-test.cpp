@@ -0,0 +1,237 @@
+/** @file
+ * @brief Unit tests for PolygonIntersectionGraph.
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include "testing.h"
+
+#include <2geom/arena.h>
+#include <2geom/intersection-graph.h>
+#include <2geom/pathvector.h>
+#include <2geom/polygon-intersection-graph.h>
+#include <2geom/svg-path-parser.h>
+#include <2geom/transforms.h>
+#include <glib.h>
+
+using namespace Geom;
+
+class PolygonIntersectionGraphTest : public ::testing::Test {
+protected:
+    PolygonIntersectionGraphTest() {
+        rectangle = parse_svg_path("M 0,0 L 5,0 5,8 0,8 Z");
+        bigh = parse_svg_path("M 2,-3 L 3,-2 1,2 3,4 4,2 6,3 2,11 0,10 2,5 1,4 -1,6 -2,5 Z");
+        g_random_set_seed(2345);
+    }
+
+    // check all operations at random points, using the even-odd rule for the operands
+    void checkRandomPoints(PathVector const &a, PathVector const &b, unsigned npts = 2000) {
+        PolygonIntersectionGraph pig(a, b);
+        PathVector results[5] = {
+            pig.getUnion(), pig.getIntersection(), pig.getAminusB(), pig.getBminusA(), pig.getXOR()
+        };
+        for (unsigned k = 0; k < 5; ++k) {
+            for (std::size_t i = 0; i < results[k].size(); ++i) {
+                EXPECT_TRUE(results[k][i].closed());
+                EXPECT_TRUE(PolygonIntersectionGraph::isPolygonal(results[k]));
+            }
+        }
+
+        Rect bounds = *(a.boundsFast() | b.boundsFast());
+        for (unsigned i = 0; i < npts; ++i) {
+            Point p;
+            p[X] = g_random_double_range(bounds[X].min(), bounds[X].max());
+            p[Y] = g_random_double_range(bounds[Y].min(), bounds[Y].max());
+            bool in_a = a.winding(p) % 2;
+            bool in_b = b.winding(p) % 2;
+            bool expected[5] = { in_a || in_b, in_a && in_b, in_a && !in_b, !in_a && in_b, in_a != in_b };
+            for (unsigned k = 0; k < 5; ++k) {
+                EXPECT_EQ(bool(results[k].winding(p) % 2), expected[k])
+                    << "operation " << k << " at " << p;
+            }
+        }
+    }
+
+    PathVector rectangle, bigh;
+};
+
+TEST_F(PolygonIntersectionGraphTest, Basic) {
+    checkRandomPoints(rectangle, bigh);
+    checkRandomPoints(bigh, rectangle);
+
+    PolygonIntersectionGraph pig(rectangle, bigh);
+    PathIntersectionGraph reference(rectangle, bigh);
+    EXPECT_EQ(pig.getUnion().size(), reference.getUnion().size());
+    EXPECT_EQ(pig.getIntersection().size(), reference.getIntersection().size());
+}
+
+TEST_F(PolygonIntersectionGraphTest, Disjoint) {
+    PathVector far = rectangle * Translate(10, 10);
+    PolygonIntersectionGraph pig(rectangle, far);
+    EXPECT_EQ(pig.getUnion().size(), 2u);
+    EXPECT_TRUE(pig.getIntersection().empty());
+    checkRandomPoints(rectangle, far);
+}
+
+TEST_F(PolygonIntersectionGraphTest, SharedEdges) {
+    // touching along a whole edge
+    checkRandomPoints(rectangle, rectangle * Translate(5, 0));
+    PolygonIntersectionGraph adjacent(rectangle, rectangle * Translate(5, 0));
+    EXPECT_EQ(adjacent.getUnion().size(), 1u);
+    EXPECT_TRUE(adjacent.getIntersection().empty());
+
+    // partially overlapping collinear edges
+    checkRandomPoints(rectangle, rectangle * Translate(2, 0));
+    checkRandomPoints(rectangle, parse_svg_path("M 5,2 L 9,2 9,5 5,5 Z"));
+    checkRandomPoints(rectangle, parse_svg_path("M 1,0 L 4,0 4,-3 1,-3 Z"));
+    // an edge contained within another one
+    checkRandomPoints(rectangle, parse_svg_path("M 1,0 L 4,0 2.5,4 Z"));
+    // touching at a vertex
+    checkRandomPoints(rectangle, parse_svg_path("M 5,8 L 7,9 6,10 Z"));
+    checkRandomPoints(rectangle, parse_svg_path("M 5,4 L 7,2 7,6 Z"));
+}
+
+TEST_F(PolygonIntersectionGraphTest, EqualOperands) {
+    PolygonIntersectionGraph pig(bigh, bigh);
+    EXPECT_TRUE(pig.getAminusB().empty());
+    EXPECT_TRUE(pig.getBminusA().empty());
+    EXPECT_TRUE(pig.getXOR().empty());
+    checkRandomPoints(bigh, bigh);
+
+    // the same shape with the opposite direction and a different starting point
+    checkRandomPoints(rectangle, parse_svg_path("M 5,8 L 5,0 0,0 0,8 Z"));
+}
+
+TEST_F(PolygonIntersectionGraphTest, HolesAndSelfIntersections) {
+    PathVector frame = parse_svg_path("M 0,0 L 10,0 10,10 0,10 Z M 2,2 L 8,2 8,8 2,8 Z");
+    PathVector star = parse_svg_path("M 5,-1 L 8,11 -1,3 11,3 2,11 Z");
+    checkRandomPoints(frame, star);
+    checkRandomPoints(star, bigh);
+    // overlapping edges within a single operand cancel out
+    checkRandomPoints(parse_svg_path("M 0,0 L 4,0 4,4 0,4 Z M 4,0 L 8,0 8,4 4,4 Z"), bigh);
+    // open paths are treated as closed
+    checkRandomPoints(parse_svg_path("M 0,0 L 5,0 5,8 0,8"), bigh);
+}
+
+TEST_F(PolygonIntersectionGraphTest, Degenerate) {
+    PathVector empty;
+    PolygonIntersectionGraph with_empty(bigh, empty);
+    checkRandomPoints(bigh, empty);
+    EXPECT_TRUE(with_empty.getIntersection().empty());
+    EXPECT_FALSE(with_empty.getUnion().empty());
+
+    // zero-length segments and empty paths are ignored
+    checkRandomPoints(parse_svg_path("M 0,0 L 5,0 5,0 5,8 0,8 Z M 3,3 Z"), bigh);
+    PolygonIntersectionGraph nothing(empty, empty);
+    EXPECT_EQ(nothing.size(), 0u);
+    EXPECT_TRUE(nothing.getUnion().empty());
+}
+
+TEST_F(PolygonIntersectionGraphTest, RandomPolygons) {
+    for (unsigned k = 0; k < 20; ++k) {
+        PathVector a, b;
+        for (unsigned w = 0; w < 2; ++w) {
+            Path path(Point(g_random_double_range(0, 100), g_random_double_range(0, 100)));
+            for (unsigned i = 0; i < 30; ++i) {
+                // some vertices lie on a coarse grid, so that collinear edges occur
+                Point p(g_random_double_range(0, 100), g_random_double_range(0, 100));
+                if (i % 3 == 0) p = Point(10 * g_random_int_range(0, 11), 10 * g_random_int_range(0, 11));
+                path.appendNew<LineSegment>(p);
+            }
+            path.close();
+            (w ? b : a).push_back(path);
+        }
+        checkRandomPoints(a, b, 500);
+    }
+}
+
+TEST_F(PolygonIntersectionGraphTest, IntegerGrid) {
+    // several edges crossing at a point which is not representable
+    checkRandomPoints(parse_svg_path("M 1,4 L 2,0 0,3 H 3 Z"),
+                      parse_svg_path("M 0,3 H 1 L 3,1 4,2 Z"));
+    checkRandomPoints(parse_svg_path("M 1,4 H 2 L 3,0 V 4 L 1,2 3,3 2,2 Z"),
+                      parse_svg_path("M 3,4 L 1,0 0,1 V 0 4 H 1 L 4,1 Z"));
+    // edges traversed twice
+    checkRandomPoints(parse_svg_path("M 4,3 L 1,1 1,1 Z"),
+                      parse_svg_path("M 3,1 L 3,1 1,3 Z"));
+    checkRandomPoints(parse_svg_path("M 0,2 H 4 L 0,0 Z"), parse_svg_path("M 4,0 L 3,3 Z"));
+
+    // vertices on a small grid produce many coincidences
+    for (unsigned k = 0; k < 20; ++k) {
+        PathVector a, b;
+        for (unsigned w = 0; w < 2; ++w) {
+            Path path(Point(g_random_int_range(0, 7), g_random_int_range(0, 7)));
+            for (unsigned i = 0; i < 20; ++i) {
+                path.appendNew<LineSegment>(Point(g_random_int_range(0, 7), g_random_int_range(0, 7)));
+            }
+            path.close();
+            (w ? b : a).push_back(path);
+        }
+        checkRandomPoints(a, b, 500);
+    }
+}
+
+TEST_F(PolygonIntersectionGraphTest, ExternalArena) {
+    PolygonIntersectionGraph reference(rectangle, bigh);
+    MonotonicArena arena;
+    for (unsigned k = 0; k < 3; ++k) {
+        arena.reset();
+        PolygonIntersectionGraph pig(rectangle, bigh, &arena);
+        EXPECT_GT(arena.bytesUsed(), 0u);
+        EXPECT_EQ(pig.size(), reference.size());
+        EXPECT_EQ(pig.getUnion(), reference.getUnion());
+        EXPECT_EQ(pig.getXOR(), reference.getXOR());
+    }
+}
+
+TEST_F(PolygonIntersectionGraphTest, AutomaticSelection) {
+    EXPECT_TRUE(PolygonIntersectionGraph::isPolygonal(bigh));
+    PathVector curved = parse_svg_path("M 0,0 L 5,0 Q 7,4 5,8 L 0,8 Z");
+    EXPECT_FALSE(PolygonIntersectionGraph::isPolygonal(curved));
+
+    PolygonIntersectionGraph pig(rectangle, bigh);
+    EXPECT_EQ(boolean_operation(rectangle, bigh, BOOLEAN_UNION), pig.getUnion());
+    EXPECT_EQ(boolean_operation(rectangle, bigh, BOOLEAN_INTERSECTION), pig.getIntersection());
+    EXPECT_EQ(boolean_operation(rectangle, bigh, BOOLEAN_A_MINUS_B), pig.getAminusB());
+    EXPECT_EQ(boolean_operation(rectangle, bigh, BOOLEAN_B_MINUS_A), pig.getBminusA());
+    EXPECT_EQ(boolean_operation(rectangle, bigh, BOOLEAN_XOR), pig.getXOR());
+
+    PathIntersectionGraph reference(curved, bigh);
+    EXPECT_EQ(boolean_operation(curved, bigh, BOOLEAN_UNION), reference.getUnion());
+    EXPECT_EQ(boolean_operation(curved, bigh, BOOLEAN_XOR), reference.getXOR());
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
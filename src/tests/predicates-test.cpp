@@ -0,0 +1,137 @@
+/** @file
+ * @brief Unit tests for the robust geometric predicates.
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include "testing.h"
+#include <cmath>
+
+#include <2geom/predicates.h>
+
+using namespace Geom;
+
+// sign of a value, for comparing predicate results
+static int sgn(Coord x)
+{
+    return (x > 0) - (x < 0);
+}
+
+TEST(PredicatesTest, Orient2dNearlyCollinear) {
+    // points differing from (0.5, 0.5) by a few units in the last place, tested against
+    // the line y = x; the plain floating point determinant gets many of them wrong
+    Point b(12, 12), c(24, 24);
+    Coord const ulp = std::ldexp(1.0, -53);
+    for (int i = 0; i < 64; ++i) {
+        for (int j = 0; j < 64; ++j) {
+            Point a(0.5 + i * ulp, 0.5 + j * ulp);
+            int expected = sgn(j - i);
+            EXPECT_EQ(sgn(orient2d(a, b, c)), expected);
+            EXPECT_EQ(sgn(orient2d(b, c, a)), expected);
+            EXPECT_EQ(sgn(orient2d(c, a, b)), expected);
+            EXPECT_EQ(sgn(orient2d(b, a, c)), -expected);
+        }
+    }
+
+    // counter-clockwise in a coordinate system where Y points up
+    EXPECT_GT(orient2d(Point(0, 0), Point(1, 0), Point(0, 1)), 0);
+    EXPECT_LT(orient2d(Point(0, 0), Point(0, 1), Point(1, 0)), 0);
+    EXPECT_EQ(orient2d(Point(1, 2), Point(2, 4), Point(3, 6)), 0);
+}
+
+TEST(PredicatesTest, CrossDifference) {
+    Point a0(0.1, 0.7), a1(3.3, 1.9);
+    // equal vectors placed at different locations are exactly parallel
+    Point d(std::ldexp(1.0, -3), std::ldexp(1.0, -4));
+    Point b0(0.5, 0.5);
+    EXPECT_EQ(cross_difference(b0, b0 + d, b0 + 2 * d, b0 + 3 * d), 0);
+    EXPECT_EQ(cross_difference(a0, a1, a0, a1), 0);
+    EXPECT_EQ(sgn(cross_difference(a0, a1, Point(0, 0), Point(0, 1))), 1);
+    EXPECT_EQ(sgn(cross_difference(a0, a1, Point(0, 1), Point(0, 0))), -1);
+
+    // same as orient2d when the vectors share their first point
+    Coord const ulp = std::ldexp(1.0, -53);
+    for (int i = 0; i < 16; ++i) {
+        Point a(0.5 + i * ulp, 0.5);
+        EXPECT_EQ(sgn(cross_difference(Point(12, 12), Point(24, 24), Point(12, 12), a)),
+                  sgn(orient2d(Point(12, 12), Point(24, 24), a)));
+    }
+}
+
+TEST(PredicatesTest, Incircle) {
+    // counter-clockwise points on the circle with radius 5 around the origin
+    Point a(5, 0), b(0, 5), c(-5, 0);
+    EXPECT_EQ(incircle(a, b, c, Point(3, 4)), 0);
+    EXPECT_EQ(incircle(a, b, c, Point(-3, -4)), 0);
+    EXPECT_GT(incircle(a, b, c, Point(0, 0)), 0);
+    EXPECT_LT(incircle(a, b, c, Point(10, 10)), 0);
+    // clockwise order reverses the sign
+    EXPECT_LT(incircle(c, b, a, Point(0, 0)), 0);
+
+    // points displaced from the circle by the smallest representable amount
+    Coord const delta = std::ldexp(1.0, -50);
+    EXPECT_LT(incircle(a, b, c, Point(3 + delta, 4)), 0);
+    EXPECT_GT(incircle(a, b, c, Point(3 - delta, 4)), 0);
+    EXPECT_LT(incircle(b, c, a, Point(3, 4 + 2 * delta)), 0);
+    EXPECT_GT(incircle(c, a, b, Point(3, 4 - 2 * delta)), 0);
+
+    // the same configuration far from the origin, where all differences are exact
+    Coord const offset = std::ldexp(1.0, 40);
+    Point o(offset, offset);
+    EXPECT_EQ(incircle(a + o, b + o, c + o, Point(3, 4) + o), 0);
+    EXPECT_GT(incircle(a + o, b + o, c + o, Point(3, 3) + o), 0);
+    EXPECT_LT(incircle(a + o, b + o, c + o, Point(4, 4) + o), 0);
+}
+
+TEST(PredicatesTest, SegmentsIntersect) {
+    EXPECT_TRUE(segments_intersect(Point(0, 0), Point(2, 2), Point(0, 2), Point(2, 0)));
+    EXPECT_FALSE(segments_intersect(Point(0, 0), Point(1, 1), Point(0, 2), Point(2, 3)));
+    // touching at an endpoint or at an interior point
+    EXPECT_TRUE(segments_intersect(Point(0, 0), Point(2, 2), Point(2, 2), Point(3, 0)));
+    EXPECT_TRUE(segments_intersect(Point(0, 0), Point(2, 2), Point(1, 1), Point(3, 0)));
+    EXPECT_TRUE(segments_intersect(Point(0.1, 0.3), Point(0.7, 2.1),
+                                   Point(0.3, 0.1), Point(0.1, 0.3)));
+    // collinear segments
+    EXPECT_TRUE(segments_intersect(Point(0, 0), Point(2, 2), Point(1, 1), Point(3, 3)));
+    EXPECT_TRUE(segments_intersect(Point(0, 0), Point(2, 2), Point(3, 3), Point(2, 2)));
+    EXPECT_FALSE(segments_intersect(Point(0, 0), Point(2, 2), Point(3, 3), Point(4, 4)));
+    EXPECT_FALSE(segments_intersect(Point(0, 0), Point(0, 2), Point(0, 3), Point(0, 4)));
+    // degenerate segments
+    EXPECT_TRUE(segments_intersect(Point(1, 1), Point(1, 1), Point(0, 0), Point(2, 2)));
+    EXPECT_FALSE(segments_intersect(Point(1, 1), Point(1, 1), Point(0, 0), Point(2, 1)));
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
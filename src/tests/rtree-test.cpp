@@ -1,5 +1,8 @@
-/*
- * Copyright 2009  Evangelos Katsikaros <vkatsikaros at yahoo dot gr>
+/** @file
+ * @brief Unit tests for RTree.
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2016 Authors
  *
  * This library is free software; you can redistribute it and/or
  * modify it either under the terms of the GNU Lesser General Public
@@ -25,134 +28,217 @@
  * the specific language governing rights and limitations.
  */
 
-/*
- initial toy for redblack trees
-*/
-
+#include "testing.h"
+#include <algorithm>
+#include <iostream>
 
 #include <2geom/rtree.h>
+#include <2geom/parallel.h>
+#include <glib.h>
 
-#include <time.h>
-#include <vector>
-
-#include <sstream>
-#include <getopt.h>
-
-
-
-
-//using std::vector;
-using namespace Geom;
 using namespace std;
+using namespace Geom;
 
-sadfsdfasdfasdfa
-
-int main(int argc, char **argv) {
-
-	long test_seed = 1243716824;
-
-	char* min_arg = NULL;
-	char* max_arg = NULL;
-	char* filename_arg = NULL;
-
-	int set_min_max = 0;
-
-	int c;
-
-	while (1)
-	{
-		static struct option long_options[] =
-		{
-			/* These options set a flag. */
-			/* These options don't set a flag.
-			We distinguish them by their indices. */
-			{"min-nodes",	required_argument,	0, 'n'},
-			{"max-nodes",	required_argument,	0, 'm'},
-			{"input-file",	required_argument,	0, 'f'},
-			{"help",		no_argument,		0, 'h'},
-			{0, 0, 0, 0}
-		};
-		/* getopt_long stores the option index here. */
-		int option_index = 0;
-
-		c = getopt_long (argc, argv, "n:m:f:h",
-			long_options, &option_index);
-
-		/* Detect the end of the options. */
-		if (c == -1){
-			break;
-		}
-
-		switch (c)
-		{
-			case 'n':
-			min_arg = optarg;
-			set_min_max += 1;
-			break;
-
-
-			case 'm':
-			max_arg = optarg;	
-			set_min_max += 2;
-			break;
-
-			case 'f':
-			filename_arg = optarg;	
-			set_min_max += 3;
-			break;
-
-
-			case 'h':
-			std::cerr << "Usage:  " << argv[0] << " options\n" << std::endl ;
-			std::cerr << 
-				   "  -n  --min-nodes=NUMBER   minimum number in node.\n" <<
-				   "  -m  --max-nodes=NUMBER   maximum number in node.\n" <<
-				   "  -f  --max-nodes=NUMBER   maximum number in node.\n" <<
-				   "  -h  --help               Print this help.\n" << std::endl;
-			exit(1);
-			break;
-
-
-			case '?':
-			/* getopt_long already printed an error message. */
-			break;
-
-			default:
-			abort ();
-		}
-	}
-
-	unsigned rmin = 0;
-	unsigned rmax = 0;
-
-	if(	set_min_max == 6 ){
-		stringstream s1( min_arg );
-		s1 >> rmin;
-
-		stringstream s2( max_arg );
-		s2 >> rmax;
-
-
-		if( rmax <= rmin || rmax < 2 || rmin < 1 ){
-			std::cerr << "Rtree set to 2, 3" << std::endl ;
-			rmin = 2;
-			rmax = 3;			
-		}
-	}
-	else{
-		std::cerr << "Rtree set to 2, 3 ." << std::endl ;
-		rmin = 2;
-		rmax = 3;
-	}
+class RTreeTest : public ::testing::Test {
+protected:
+    RTreeTest() {
+        g_random_set_seed(1234);
+        for (unsigned i = 0; i < 2000; ++i) {
+            Point a(g_random_double_range(0, 1000), g_random_double_range(0, 1000));
+            Point b = a + Point(g_random_double_range(0, 20), g_random_double_range(0, 20));
+            rects.push_back(Rect(a, b));
+        }
+        for (unsigned i = 0; i < 200; ++i) {
+            Point a(g_random_double_range(-50, 1000), g_random_double_range(-50, 1000));
+            Point b = a + Point(g_random_double_range(0, 100), g_random_double_range(0, 100));
+            queries.push_back(Rect(a, b));
+        }
+    }
+
+    // brute force results for the values which are still present
+    std::vector<unsigned> expectedQuery(Rect const &r, std::vector<bool> const &present) {
+        std::vector<unsigned> result;
+        for (unsigned i = 0; i < rects.size(); ++i) {
+            if (present[i] && rects[i].intersects(r)) {
+                result.push_back(i);
+            }
+        }
+        return result;
+    }
+
+    void checkQueries(RTree<unsigned> const &tree, std::vector<bool> const &present) {
+        for (unsigned i = 0; i < queries.size(); ++i) {
+            std::vector<unsigned> found = tree.query(queries[i]);
+            std::sort(found.begin(), found.end());
+            EXPECT_TRUE(found == expectedQuery(queries[i], present));
+        }
+    }
+
+    std::vector<Rect> rects;
+    std::vector<Rect> queries;
+};
+
+TEST_F(RTreeTest, Empty) {
+    RTree<unsigned> tree;
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.height(), 0u);
+    EXPECT_FALSE(tree.bounds());
+    EXPECT_TRUE(tree.query(Rect(0, 0, 10, 10)).empty());
+    EXPECT_TRUE(tree.nearest(Point(0, 0), 5).empty());
+    EXPECT_FALSE(tree.remove(Rect(0, 0, 10, 10), 0));
+}
 
+TEST_F(RTreeTest, Insert) {
+    // small nodes, like in the R-tree toy, give deep trees
+    for (unsigned max_entries = 3; max_entries <= 24; max_entries *= 2) {
+        RTree<unsigned> tree(max_entries);
+        for (unsigned i = 0; i < rects.size(); ++i) {
+            tree.insert(rects[i], i);
+        }
+        EXPECT_EQ(tree.size(), rects.size());
+        checkQueries(tree, std::vector<bool>(rects.size(), true));
+    }
+}
 
+TEST_F(RTreeTest, BulkLoad) {
+    std::vector<std::pair<Rect, unsigned> > items;
+    for (unsigned i = 0; i < rects.size(); ++i) {
+        items.push_back(std::make_pair(rects[i], i));
+    }
+    RTree<unsigned> tree(8);
+    tree.bulkLoad(items.begin(), items.end());
+    EXPECT_EQ(tree.size(), rects.size());
+    // 2000 values fill nodes of 8 in 4 levels
+    EXPECT_EQ(tree.height(), 4u);
+
+    Rect all = rects[0];
+    for (unsigned i = 1; i < rects.size(); ++i) {
+        all.unionWith(rects[i]);
+    }
+    EXPECT_EQ(*tree.bounds(), all);
+
+    std::vector<bool> present(rects.size(), true);
+    checkQueries(tree, present);
+
+    // the tree can still be modified after bulk loading
+    for (unsigned i = 0; i < rects.size(); i += 3) {
+        EXPECT_TRUE(tree.remove(rects[i], i));
+        present[i] = false;
+    }
+    tree.insert(Rect(0, 0, 1, 1), 12345);
+    EXPECT_EQ(tree.query(Rect(0.5, 0.5, 0.75, 0.75)).size(),
+              expectedQuery(Rect(0.5, 0.5, 0.75, 0.75), present).size() + 1);
+}
 
-	std::cout << "rmin: " << rmin << "  rmax:" << rmax << "  filename_arg:" << filename_arg << std::endl;
+TEST_F(RTreeTest, Remove) {
+    RTree<unsigned> tree(4);
+    for (unsigned i = 0; i < rects.size(); ++i) {
+        tree.insert(rects[i], i);
+    }
+    std::vector<bool> present(rects.size(), true);
+
+    // removing with a wrong box or value does nothing
+    EXPECT_FALSE(tree.remove(rects[0], 1));
+    EXPECT_FALSE(tree.remove(rects[1], 0));
+
+    g_random_set_seed(5678);
+    for (unsigned n = 0; n < rects.size() / 2; ++n) {
+        unsigned i = g_random_int_range(0, rects.size());
+        EXPECT_EQ(tree.remove(rects[i], i), present[i]);
+        present[i] = false;
+    }
+    EXPECT_EQ(tree.size(), (std::size_t) std::count(present.begin(), present.end(), true));
+    checkQueries(tree, present);
+
+    for (unsigned i = 0; i < rects.size(); ++i) {
+        if (present[i]) {
+            EXPECT_TRUE(tree.remove(rects[i], i));
+        }
+    }
+    EXPECT_TRUE(tree.empty());
+    EXPECT_TRUE(tree.query(Rect(-100, -100, 1100, 1100)).empty());
+
+    // the emptied tree can be reused
+    tree.insert(rects[5], 5);
+    EXPECT_EQ(tree.query(rects[5]).size(), 1u);
+}
 
-	RTree rtree( rmin, rmax, QUADRATIC_SPIT );
+TEST_F(RTreeTest, Nearest) {
+    RTree<unsigned> tree(6);
+    for (unsigned i = 0; i < rects.size(); ++i) {
+        tree.insert(rects[i], i);
+    }
+    g_random_set_seed(91011);
+    for (unsigned n = 0; n < 100; ++n) {
+        Point p(g_random_double_range(-100, 1100), g_random_double_range(-100, 1100));
+        std::vector<Coord> dists;
+        for (unsigned i = 0; i < rects.size(); ++i) {
+            dists.push_back(distanceSq(p, rects[i]));
+        }
+        std::sort(dists.begin(), dists.end());
+
+        std::vector<unsigned> found = tree.nearest(p, 10);
+        ASSERT_EQ(found.size(), 10u);
+        for (unsigned i = 0; i < found.size(); ++i) {
+            EXPECT_EQ(distanceSq(p, rects[found[i]]), dists[i]);
+        }
+    }
+    EXPECT_EQ(tree.nearest(Point(0, 0), rects.size() + 10).size(), rects.size());
+}
 
-	srand(1243716824);	
-	rand() % 10;
+TEST_F(RTreeTest, Batch) {
+    RTree<unsigned> tree;
+    for (unsigned i = 0; i < rects.size(); ++i) {
+        tree.insert(rects[i], i);
+    }
+    std::vector<Point> points;
+    for (unsigned i = 0; i < queries.size(); ++i) {
+        points.push_back(queries[i].midpoint());
+    }
+
+    set_thread_count(4);
+    std::vector<std::vector<unsigned> > found = tree.batchQuery(queries);
+    std::vector<std::vector<unsigned> > nearest = tree.batchNearest(points, 3);
+    set_thread_count(1);
+
+    ASSERT_EQ(found.size(), queries.size());
+    ASSERT_EQ(nearest.size(), points.size());
+    for (unsigned i = 0; i < queries.size(); ++i) {
+        EXPECT_TRUE(found[i] == tree.query(queries[i]));
+        EXPECT_TRUE(nearest[i] == tree.nearest(points[i], 3));
+    }
+}
 
-    return 0;
+struct DepthCounter {
+    DepthCounter() : nodes(0), max_depth(0) {}
+    void operator()(Rect const &, unsigned depth) {
+        ++nodes;
+        max_depth = std::max(max_depth, depth);
+    }
+    unsigned nodes;
+    unsigned max_depth;
+};
+
+TEST_F(RTreeTest, VisitNodes) {
+    RTree<unsigned> tree(3, 2);
+    EXPECT_EQ(tree.maxEntries(), 3u);
+    EXPECT_EQ(tree.minEntries(), 2u);
+    for (unsigned i = 0; i < 100; ++i) {
+        tree.insert(rects[i], i);
+    }
+    DepthCounter counter;
+    tree.visitNodes(counter);
+    EXPECT_EQ(counter.max_depth + 1, tree.height());
+    EXPECT_GE(counter.nodes, 100u / 3);
 }
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
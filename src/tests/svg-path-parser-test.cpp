@@ -0,0 +1,171 @@
+/** @file
+ * @brief Unit tests for the SVG path data parser.
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2016 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include "testing.h"
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <2geom/parallel.h>
+#include <2geom/path.h>
+#include <2geom/pathvector.h>
+#include <2geom/svg-path-parser.h>
+
+using namespace Geom;
+
+static char const *test_data =
+    "M 10.125,-20.5e1 L 1e-3,30 40.75-50 H 100 V -.5 "
+    "c 1.5.5,2,3 4,5 s 6,7 8,9 q 10,11 12,13 t 14,15 "
+    "a 5,10 45 0 1 10,10 a 5,10 45 1010,10 z "
+    "m 123456.789012,-0.000001 l 1,1 Z";
+
+static PathVector parse_in_blocks(std::string const &data, std::size_t block)
+{
+    PathVector result;
+    PathBuilder builder(result);
+    SVGPathParser parser(builder);
+    for (std::size_t i = 0; i < data.size(); i += block) {
+        parser.feed(data.data() + i, std::min(block, data.size() - i));
+    }
+    parser.finish();
+    return result;
+}
+
+TEST(SVGPathParserTest, BlockBoundaries) {
+    PathVector expected = parse_svg_path(test_data);
+    ASSERT_EQ(expected.size(), 2u);
+    EXPECT_EQ(expected[0].size_default(), 11u);
+
+    // blocks split numbers, commands and flags at every possible place,
+    // and numbers longer than a block span several blocks
+    std::string data(test_data);
+    for (std::size_t block = 1; block <= 16; ++block) {
+        EXPECT_EQ(parse_in_blocks(data, block), expected);
+    }
+}
+
+TEST(SVGPathParserTest, UnterminatedInput) {
+    // the parser must not read past the end of the data,
+    // which is not null-terminated when it is memory-mapped
+    std::string data = "M 1,2 L 3,4";
+    std::vector<char> buffer(data.begin(), data.end());
+    buffer.push_back('5');
+    buffer.push_back('6');
+
+    PathVector pv;
+    PathBuilder builder(pv);
+    SVGPathParser parser(builder);
+    parser.parse(&buffer[0], data.size());
+    ASSERT_EQ(pv.size(), 1u);
+    EXPECT_EQ(pv[0].finalPoint(), Point(3, 4));
+
+    pv.clear();
+    parser.feed(&buffer[0], 10);
+    parser.feed(&buffer[10], 1);
+    parser.finish();
+    ASSERT_EQ(pv.size(), 1u);
+    EXPECT_EQ(pv[0].finalPoint(), Point(3, 4));
+}
+
+TEST(SVGPathParserTest, InvalidInput) {
+    PathVector pv;
+    PathBuilder builder(pv);
+    SVGPathParser parser(builder);
+    parser.feed("M 1,2 L 3", 9);
+    EXPECT_THROW(parser.finish(), SVGPathParseError);
+    EXPECT_THROW(parse_svg_path("M 1,2 L 0x10,4"), SVGPathParseError);
+}
+
+TEST(SVGPathParserTest, Files) {
+    PathVector expected = parse_svg_path(test_data);
+    char const *filename = "svg-path-parser-test.svgd";
+
+    // data longer than the buffer used for C streams
+    std::string data;
+    PathVector many;
+    for (unsigned i = 0; i < 1000; ++i) {
+        data += test_data;
+        data += "\n";
+        many.insert(many.end(), expected.begin(), expected.end());
+    }
+    FILE *f = std::fopen(filename, "w");
+    ASSERT_TRUE(f != NULL);
+    std::fwrite(data.data(), 1, data.size(), f);
+    std::fclose(f);
+
+    EXPECT_EQ(read_svgd(filename), many);
+    f = std::fopen(filename, "r");
+    ASSERT_TRUE(f != NULL);
+    EXPECT_EQ(read_svgd_f(f), many);
+    std::fclose(f);
+
+    // empty files contain no paths
+    f = std::fopen(filename, "w");
+    std::fclose(f);
+    EXPECT_TRUE(read_svgd(filename).empty());
+
+    std::remove(filename);
+    EXPECT_THROW(read_svgd(filename), std::runtime_error);
+}
+
+TEST(SVGPathParserTest, Parallel) {
+    // enough data to be split into many ranges
+    std::string data;
+    for (unsigned i = 0; i < 5000; ++i) {
+        data += test_data;
+        data += "\n";
+    }
+    PathVector expected = parse_svg_path(data.c_str());
+    ASSERT_EQ(expected.size(), 10000u);
+
+    set_thread_count(4);
+    EXPECT_EQ(parse_svg_path_parallel(data), expected);
+    EXPECT_EQ(parse_svg_path_parallel(data.c_str()), expected);
+
+    std::string invalid = data;
+    invalid.insert(data.find('\n', data.size() / 2) + 1, "M 1,2 L 3 ");
+    EXPECT_THROW(parse_svg_path_parallel(invalid), SVGPathParseError);
+    set_thread_count(1);
+
+    EXPECT_EQ(parse_svg_path_parallel(data), expected);
+    EXPECT_TRUE(parse_svg_path_parallel("").empty());
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -38,8 +38,7 @@
 #include <sstream>
 #include <getopt.h>
 
-#include <2geom/orphan-code/rtree.h>
-#include <2geom/orphan-code/rtree.cpp>
+#include <2geom/rtree.h>
 
 
 //using std::vector;
@@ -98,7 +97,7 @@ class RTreeToy: public Toy
 	//int help_counter;	// the "x" of the label of each node
 	static const int label_size = 15 ; // size the label of each node
 
-	Geom::RTree rtree;
+	Geom::RTree<unsigned> rtree;
 
 	void * hit;
 	unsigned rect_id;
@@ -212,7 +211,7 @@ class RTreeToy: public Toy
 					unsigned shape_id_int;
 					shape_id >> shape_id_int;
 
-					rtree.erase( rectangles[i].pos, shape_id_int );
+					rtree.remove( rectangles[i].pos, shape_id_int );
 					rectangles.erase( rectangles.begin() + i );
 //					check_if_deleted( );
 //					check_if_duplicates( );
@@ -242,7 +241,7 @@ class RTreeToy: public Toy
 					rect_id++;
 
 					insert_in_tree_the_last_rect();
-					find_rtree_subtrees_bounding_boxes( rtree );
+					find_rtree_subtrees_bounding_boxes();
 					add_new_rect = false;
 				}
 			}
@@ -251,11 +250,7 @@ class RTreeToy: public Toy
 					ending_point = Point( e->x, e->y );
 					rect_chosen = Rect( starting_point, ending_point );
 
-					std::vector< int > result(0);
-
-					if( rtree.root ){
-						rtree.search( rect_chosen, &result, rtree.root );
-					}
+					std::vector< unsigned > result = rtree.query( rect_chosen );
 					std::cout << "Search results: " << result.size() << std::endl;
 					for(unsigned i = 0; i < result.size(); i++ ){
 						std::cout << result[i] << ", " ;
@@ -268,12 +263,9 @@ class RTreeToy: public Toy
 			else if( mode == DELETE_MODE ) {	// mode: delete
 				if( delete_rect ){
 					delete_rect = false;
-					if( rtree.root ){
-						find_rtree_subtrees_bounding_boxes( rtree );
-					}
-					std::cout << " \nTree:\n" << std::endl;
-					rtree.print_tree( rtree.root, 0 );	
-					std::cout << "...done\n" << std::endl;
+					find_rtree_subtrees_bounding_boxes();
+					std::cout << "Tree: " << rtree.size() << " rectangles, height "
+						<< rtree.height() << std::endl;
 				}
 			}
 		}
@@ -375,41 +367,28 @@ class RTreeToy: public Toy
 
 			// insert in R tree
 			rtree.insert( r1, shape_id_int );
-			std::cout << " \nTree:\n" << std::endl;
-			rtree.print_tree( rtree.root, 0 );	
-			std::cout << "...done\n" << std::endl;
+			std::cout << "Tree: " << rtree.size() << " rectangles, height "
+				<< rtree.height() << std::endl;
 	};
 
 
-	void find_rtree_subtrees_bounding_boxes( Geom::RTree tree ){
-		if( tree.root ){
-			// clear existing bounding boxes 
-			for(unsigned color=0; color < rects_level.size(); color++ ){
-				rects_level[color].clear();
-			}
-			save_bb( tree.root, 0);
+	// collects the bounding boxes of the tree nodes, one vector per depth
+	struct SaveBB {
+		std::vector< std::vector< Rect > > &rects_level;
+		SaveBB( std::vector< std::vector< Rect > > &r ) : rects_level( r ) {}
+		void operator()( Rect const &bounds, unsigned depth ){
+			// if we reached Nth levels of colors, roll back to color 0
+			rects_level[ depth % no_of_colors ].push_back( bounds );
 		}
 	};
 
-	// TODO fix this.
-	void save_bb( Geom::RTreeNode* subtree_root, int depth ) 
-	{	
-		if( subtree_root->children_nodes.size() > 0 ){ 
-
-			// descend in each one of the elements and call print_tree
-			for( unsigned i=0; i < subtree_root->children_nodes.size(); i++ ){
-			    Rect r1( subtree_root->children_nodes[ i ].bounding_box );
-				rects_level[ depth ].push_back( r1 );
-
-				if( depth == no_of_colors - 1 ){	// if we reached Nth levels of colors, roll back to color 0
-					save_bb( subtree_root->children_nodes[ i ].data, 0);
-				}
-				else{
-				    save_bb( subtree_root->children_nodes[ i ].data, depth+1);
-				}
-			}
+	void find_rtree_subtrees_bounding_boxes(){
+		// clear existing bounding boxes 
+		for(unsigned color=0; color < rects_level.size(); color++ ){
+			rects_level[color].clear();
 		}
-		// else do nothing, entries are the rects themselves...
+		SaveBB save_bb( rects_level );
+		rtree.visitNodes( save_bb );
 	};
 
 
@@ -427,7 +406,7 @@ public:
 		mode( INSERT_MODE ), drawBB(true),
 		out_str( insert_str ), 
 		drawBB_str("ON"), drawBB_color_str("all"),
-		rtree( rmin, rmax, QUADRATIC_SPIT ),
+		rtree( rmax, rmin ),
 		hit( 0 ), rect_id( 0 )
 	{
 		// only "bright" colors